@@ -18,6 +18,7 @@ class LABReliableDetector:
         ]
         
         self.last_results = [[0, 0, 0] for _ in range(6)]
+        self.confidence = [0] * 6      # 最近一次 detect() 各圆柱结果的置信度 (0~100): 3 帧投票中多数票的占比
         self.frame_idx = 0
         
         # LAB阈值设置 (L_min, L_max, A_min, A_max, B_min, B_max)
@@ -59,6 +60,7 @@ class LABReliableDetector:
                 
                 final_result = result_counts.index(max(result_counts))
                 colors.append(final_result)
+                self.confidence[i] = result_counts[final_result] * 100 // 3
                 
                 # 可视化
                 if final_result == 1:      # 黑色
@@ -92,6 +94,7 @@ class LABReliableDetector:
             except Exception as e:
                 print(f"ROI {i} error: {e}")
                 colors.append(1)  # 错误时默认为白色
+                self.confidence[i] = 0
         
         self.frame_idx += 1
         
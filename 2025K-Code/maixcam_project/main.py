@@ -16,26 +16,32 @@ def show_roi_preview(img):
     """显示ROI预览并实时检测"""
     colors = detector.detect(img)  # 执行检测，显示红绿框
 
-def detect_and_send_path(img):
-    """检测并发送命令"""
-    colors = detector.detect(img)
+def route_command(colors):
+    """按六个圆柱的颜色选路线命令字, 未匹配任何路线时返回 0"""
     c11, c13, c21, c33, c31, c32 = colors
-    
     if c11 == 1 and c13 == 1 and c31 == 1 and c33 == 1:
         if c21 == 0 and c32 == 0:
-            comm.send_command(0x03)
+            return 0x03
         elif c21 == 0 and c32 == 1:
-            comm.send_command(0x01)
+            return 0x01
         elif c21 == 1 and c32 == 0:
-            comm.send_command(0x04)
+            return 0x04
     elif c11 == 0:
-        comm.send_command(0x01)
+        return 0x01
     elif c13 == 0:
-        comm.send_command(0x02)
+        return 0x02
     elif c31 == 0:
-        comm.send_command(0x03)
+        return 0x03
     elif c33 == 0:
-        comm.send_command(0x04)
+        return 0x04
+    return 0
+
+def detect_and_send_path(img):
+    """检测并发送命令"""
+    colors = detector.detect(img)
+    
+    # 颜色、置信度和命令字一帧发出; 圆柱的场地坐标在主控固件里 (TASK25K_CYLINDER_POS_CM), 主控据此在车上规划路线
+    comm.send_cylinders(route_command(colors), colors, detector.confidence)
 
 commands = {"START": detect_and_send_path}
 
@@ -1,4 +1,19 @@
 from maix import uart
+import struct
+import binascii
+
+# 二进制消息 (与主控 cam_protocol.h 一致), 放在 lwpkt 帧的数据部分:
+#   magic(0xB0|版本) type seq len body crc16, 多字节字段小端, crc16 = CRC-16/CCITT-FALSE 覆盖 magic 到 body
+BIN_VERSION = 1
+MSG_TRACK = 0x01
+MSG_NUMBER = 0x02
+MSG_COMMAND = 0x03
+MSG_OBSTACLES = 0x04
+MSG_CYLINDERS = 0x05
+_HDR = struct.Struct('<BBBB')
+_CRC = struct.Struct('<H')
+_NUMBER = struct.Struct('<i')
+_OBSTACLE = struct.Struct('<hhBB')      # x_cm, y_cm, color, confidence
 
 class CamComm:
     # 预定义常量避免重复计算
@@ -6,8 +21,11 @@ class CamComm:
     _TAIL = 0x55
     _MAX_DATA_LEN = 255
     
-    def __init__(self, device="/dev/ttyS0", baudrate=115200):
+    def __init__(self, device="/dev/ttyS0", baudrate=115200, binary=True):
+        """binary=False 时按旧的 ASCII 格式 ("T:0x33" / "N:123" / "C:0x01") 发送, 兼容旧固件"""
         self.serial = uart.UART(device, baudrate)
+        self.binary = binary
+        self.seq = 0
         # 预分配缓冲区避免频繁内存分配
         self.rx_buffer = bytearray(self._MAX_DATA_LEN + 3)  # header + len + data + tail
         self.data_buffer = bytearray(self._MAX_DATA_LEN)
@@ -77,8 +95,16 @@ class CamComm:
         self.state, self.length, self.count = state, length, count
         return None
     
+    def _send_bin(self, msg_type, body):
+        """二进制消息: 头 + body + crc16, 不做任何文本格式化"""
+        msg = _HDR.pack(0xB0 | BIN_VERSION, msg_type, self.seq, len(body)) + body
+        self.seq = (self.seq + 1) & 0xFF
+        return self._send(msg + _CRC.pack(binascii.crc_hqx(msg, 0xFFFF)))
+    
     def send_track(self, value):
         """优化：预构建格式避免f-string开销"""
+        if self.binary:
+            return self._send_bin(MSG_TRACK, bytes((value & 0xFF,)))
         # 直接构建bytes避免字符串格式化
         hex_str = format(value, '02X').encode()
         packet_len = 4 + len(hex_str)  # "T:0x" + hex
@@ -95,6 +121,8 @@ class CamComm:
     
     def send_number(self, value):
         """优化数字发送"""
+        if self.binary:
+            return self._send_bin(MSG_NUMBER, _NUMBER.pack(value))
         num_str = str(value).encode()
         packet_len = 2 + len(num_str)  # "N:" + number
         
@@ -110,6 +138,8 @@ class CamComm:
     
     def send_command(self, code):
         """优化命令发送"""
+        if self.binary:
+            return self._send_bin(MSG_COMMAND, bytes((code & 0xFF,)))
         hex_str = format(code, '02X').encode()
         packet_len = 4 + len(hex_str)  # "C:0x" + hex
         
@@ -123,6 +153,29 @@ class CamComm:
         packet = bytes(self.rx_buffer[:7+len(hex_str)])
         return self.serial.write(packet) > 0
     
+    def send_obstacles(self, obstacles, confidence=None):
+        """发送圆柱布局: obstacles 为 (颜色, x_cm, y_cm) 列表, 颜色 0 白 1 黑, 坐标以发车点为原点;
+        confidence 为对应的置信度 (0~100) 列表, 省略时为 100 (ASCII 格式不带置信度)"""
+        if self.binary:
+            if confidence is None:
+                confidence = [100] * len(obstacles)
+            body = bytes((len(obstacles), 0)) + b"".join(
+                _OBSTACLE.pack(x, y, c, p) for (c, x, y), p in zip(obstacles, confidence))
+            return self._send_bin(MSG_OBSTACLES, body)
+        body = ";".join("%d,%d,%d" % (c, x, y) for c, x, y in obstacles)
+        return self._send("O:" + body)
+    
+    def send_cylinders(self, command, colors, confidence):
+        """一帧发送六个圆柱的颜色与置信度以及路线命令字 (0 = 未识别出路线), 仅二进制格式;
+        ASCII 格式下只发命令字"""
+        if not self.binary:
+            return self.send_command(command) if command else True
+        body = bytearray((command & 0xFF, 0))
+        for c, p in zip(colors, confidence):
+            body.append(c)
+            body.append(p)
+        return self._send_bin(MSG_CYLINDERS, bytes(body))
+    
     # 快速发送方法：跳过格式化，直接发送常用命令
     def send_raw(self, cmd_bytes):
         """发送原始命令字节，最高性能"""
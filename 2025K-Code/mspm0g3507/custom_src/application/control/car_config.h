@@ -6,6 +6,11 @@
 #define WHEEL_RADIUS_CM            2.4f           // 轮胎半径，单位：cm
 #define PULSE_NUM_PER_CIRCLE       1066           // 轮胎一圈的编码器计数
 #define WHEEL_BASE_CM 24.0f  										  // 轮距，根据实际小车调整
+#define CAR_CONTROL_IN_ISR         1              // 1: 编码器采样+速度环+PWM 在实时定时器中断中执行
+#define CAR_SPEED_PID_Q16          1              // 1: 速度环使用 Q16 定点 PID (参数仍取自 speedPid[])
+#define CAR_SPEED_FEEDFORWARD      1              // 1: 速度环叠加前馈 (PWM-轮速表 + 死区 + 加速度项), 未标定时输出 0
+#define CAR_MOTION_PROFILE         1              // 1: 直行/转向/绕圈按 S 形曲线给设定值, 相邻直行/绕圈段带速度衔接
+#define CAR_ACTION_STATS           1              // 1: 状态机记录每个动作的实际耗时与计划耗时, 见 car_action_stats()
 #ifndef M_PI
 #define M_PI 3.14159265359f												// 定义圆周率
 #endif
@@ -10,6 +10,10 @@
 #include "car_debug.h"
 #include "_74hc595.h"
 #include "car_config.h"
+#include "speed_ff.h"
+#include "motion_profile.h"
+#include "pose_estimator.h"
+#include "path_follower.h"
 
 typedef enum {
     CAR_STATE_GO_STRAIGHT = 0,
@@ -17,8 +21,21 @@ typedef enum {
 		CAR_STATE_TRACK,
     CAR_STATE_STOP,
 		CAR_STATE_CIRCLE,
+		CAR_STATE_AUTOTUNE,
+		CAR_STATE_FF_CALIB,
+		CAR_STATE_PATH,
 } CAR_STATES;
 
+// 继电器自整定的对象环
+typedef enum {
+		CAR_TUNE_SPEED = 0,
+		CAR_TUNE_MILEAGE,
+		CAR_TUNE_STRAIGHT,
+		CAR_TUNE_ANGLE,
+		CAR_TUNE_TRACK,
+		CAR_TUNE_LOOP_COUNT,
+} CAR_TUNE_LOOPS;
+
 typedef enum {
 		UNTIL_BLACK_LINE,
 		UNTIL_WHITE_LINE,
@@ -30,6 +47,7 @@ typedef struct encoder_t {
     int32_t counts[motor_count]; 
     float rpms[motor_count];
     float cmps[motor_count];
+    float odometer_cm[motor_count];     // 累计行程, car_reset() 不清零, 供位姿估计
 } encoder_t;
 
 typedef struct car_t {
@@ -47,20 +65,58 @@ typedef struct car_t {
 
     float circle_last_yaw;      
     float circle_accumulated_angle; 
+
+    CAR_TUNE_LOOPS tune_loop;
+    float tune_ref_yaw;             // 直行/转向环整定时的振荡中心
+    bool open_loop;                 // true: 速度环旁路, 直接输出 open_loop_pwm
+    int open_loop_pwm[motor_count];
+
+    motion_profile_t profile;       // 当前段的 S 形设定曲线 (直行 cm, 转向 deg, 绕圈按弧长 cm)
+    float turn_start_yaw;           // 转向段起点航向, 曲线位置相对于它
+    float segment_origin_cm;        // 当前段起点里程; 带速度衔接时编码器不清零, 里程相对于它计
+    bool blend_pending;             // 上一段已带速度结束, 由下一段接手 (期间按终点速度继续行驶)
+
+    uint8_t goto_phase;             // car_go_to: 0 空闲, 1 转向, 2 直行
+    float goto_yaw;                 // 转向目标 (陀螺仪航向, deg)
+    float goto_distance_cm;
+
+    path_follower_t path;           // car_follow_path 的纯追踪状态
 } car_t;
 
+// 一次自整定的结果, 参数为已写入对应 PID 的离散值
+typedef struct {
+    bool valid;
+    float ku;
+    float tu;
+    float kp;
+    float ki;
+    float kd;
+} car_tune_result_t;
+
 extern car_t car;
 extern bool is_outer_track;
 extern encoder_t encoder;
+extern pose_estimator_t car_pose;      // 全局位姿 (cm, rad), car_start() 时以起点为原点
 extern uint8_t global_stop_mark_count;
+extern car_tune_result_t car_tune_result[CAR_TUNE_LOOP_COUNT];
+extern speed_ff_model_t car_speed_ff[motor_count];
+// 上电时的前馈模型, 标定后可把 car_speed_ff_report() 打印的定义整段替换到 task25k_car_pid_parameter.c
+extern const speed_ff_model_t car_speed_ff_default[motor_count];
 
 void car_task(void);
 void car_init(void);
 void update_encoder(void);
 void update_speed_pid(void);
 float get_mileage_cm(void);
+float get_yaw(void);
 
 bool car_move_cm(float mileage, CAR_STATES move_state);
+
+/**
+ * @brief 同 car_move_cm, 直行段以 exit_speed 结束并交给下一段, 不停车
+ * @param exit_speed 终点速度 (cm/s, 沿行驶方向), 0 为停车; 见 car_blend_speed()
+ */
+bool car_move_cm_blend(float mileage, CAR_STATES move_state, float exit_speed);
 bool spin_turn(float angle);
 bool car_move_until(CAR_STATES move_state, LINE_STATES state);
 
@@ -74,7 +130,75 @@ void car_set_base_speed(float speed);
 void car_zero_speed_mode(void);
 void car_set_outer_track_flag(bool flag);
 bool car_circle(float radius_cm, bool clockwise, float target_angle_deg);
+bool car_circle_blend(float radius_cm, bool clockwise, float target_angle_deg, float exit_speed);
+
+/**
+ * @brief 当前段与下一段之间的衔接速度
+ * @param next 下一段: CAR_STATE_GO_STRAIGHT 或 CAR_STATE_CIRCLE, 其余返回 0 (停车)
+ * @param next_distance 下一段直行的距离 (cm), 衔接速度不超过在这段距离内能停下的速度
+ * @param heading_change 两段之间目标航向改变, 衔接速度限制为过弯速度
+ */
+float car_blend_speed(CAR_STATES next, float next_distance, bool heading_change);
+float car_segment_mileage_cm(void);
 void update_circle_control(void);
 
+/**
+ * @brief 对一个环做继电器反馈自整定, 结束后把整定出的参数写入该环的 PID
+ * @return true 表示整定结束 (成功与否见 car_tune_result[loop].valid)
+ * @note 速度环整定时小车以约 40cm/s 前后窜动, 直行/循迹环整定时会向前行驶 1~2m,
+ *       循迹环请放在直线段上整定
+ */
+bool car_autotune(CAR_TUNE_LOOPS loop);
+
+/**
+ * @brief 把 car_tune_result[loop] 打印到 UART_0 (整定结束时自动调用一次)
+ */
+void car_tune_report(CAR_TUNE_LOOPS loop);
+void update_autotune_control(void);
+
+/**
+ * @brief 运行中更换整套 PID 参数 (同步速度环定点副本)
+ */
+void car_apply_pid_table(const car_pid_table_t *table);
+
+/**
+ * @brief 标定速度环前馈: 两轮开环阶梯加速, 结束后把新模型写入 car_speed_ff[]
+ * @return true 表示标定结束 (失败时保留原模型)
+ * @note 小车会向前行驶约 1.5m, 请预留直道
+ */
+bool car_ff_calibrate(void);
+
+/**
+ * @brief 把 car_speed_ff[] 按 car_speed_ff_default 的 C 定义打印到 UART_0 (标定结束时自动调用一次)
+ */
+void car_speed_ff_report(void);
+void update_ff_calib_control(void);
+
+/**
+ * @brief 运行中更换前馈模型 (下一拍 car_task 起生效)
+ */
+void car_apply_speed_ff(const speed_ff_model_t *models);
+
+/**
+ * @brief 重新设定全局位姿, 协方差清零
+ * @param heading_deg 当前车头在位姿坐标系中的方向, 与陀螺仪航向的差值保存为观测偏置
+ */
+void car_pose_reset(float x_cm, float y_cm, float heading_deg);
+
+/**
+ * @brief 驶向位姿坐标系中的一点: 先原地转向目标方位, 再直行到达
+ * @return true 表示已到达 (与目标相距不超过 1cm 时直接返回 true)
+ * @note 直行距离在转向结束后按当前位姿重新计算
+ */
+bool car_go_to(float x_cm, float y_cm);
+
+/**
+ * @brief 按纯追踪沿航点折线连续行驶 (位姿坐标系), 拐角处不停车
+ * @param points 航点, 第一个点为起点; 数组在行驶期间须保持有效
+ * @return true 表示已到达最后一个航点
+ */
+bool car_follow_path(const path_point_t *points, uint8_t count);
+void update_path_control(void);
+
 
 #endif
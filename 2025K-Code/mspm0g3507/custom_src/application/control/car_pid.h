@@ -4,8 +4,33 @@
 #include "pid.h"
 #include "car_config.h"
 
+// 各环的整定参数, 速度环两侧共用一组
+typedef struct {
+    float kp;
+    float ki;
+    float kd;
+} car_pid_gain_t;
+
+typedef struct {
+    car_pid_gain_t speed;
+    car_pid_gain_t mileage;
+    car_pid_gain_t straight;
+    car_pid_gain_t angle;
+    car_pid_gain_t track;
+} car_pid_table_t;
+
+// 上电默认参数表, 主机侧整定工具 (tests/host/sil/pid_tuner.c) 输出的就是这张表
+extern const car_pid_table_t car_pid_default_table;
+
 void car_pid_init(void);
 
+/**
+ * @brief 只改写各环的 Kp/Ki/Kd, 限幅等配置与控制器状态不变
+ * @note 速度环的定点副本需要同步, 运行中请用 car_apply_pid_table()
+ */
+void car_pid_apply_table(const car_pid_table_t *table);
+void car_pid_get_table(car_pid_table_t *table);
+
 extern PID_Controller_t speedPid[motor_count];
 extern PID_Controller_t mileagePid;
 extern PID_Controller_t straightPid;
@@ -1,6 +1,7 @@
 #include "car_state_machine.h"
 #include "systick.h"
 #include <string.h>
+#include <math.h>
 #include "bluetooth.h"
 
 // 外部标志
@@ -12,125 +13,170 @@ static uint32_t get_time_ms(void) {
     return get_ms();
 }
 
+// 当前执行位置: stack[depth - 1] 为正在执行的程序, stack[0] 为顶层程序
+typedef struct {
+    const car_program_t *program;
+    uint8_t current;
+} sm_frame_t;
+
+// 后台子程序槽位 (ACTION_FORK), program 为 NULL 表示空闲
+typedef struct {
+    const car_program_t *program;
+    uint8_t current;
+    bool first_call;
+    uint32_t start_time;
+} sm_fork_t;
+
+static struct {
+    sm_frame_t stack[CAR_CALL_DEPTH];
+    sm_fork_t forks[CAR_FORK_SLOTS];
+    uint8_t depth;
+    uint8_t loop_count;
+    uint8_t current_loop;
+    bool is_running;
+    bool first_call;
+    uint32_t start_time;
+    uint16_t planned_ms;            // 当前动作的计划耗时
+} sm = {0};
+
+#if CAR_ACTION_STATS
+static struct {
+    car_action_stat_t items[CAR_ACTION_STATS_MAX];
+    uint8_t count;
+} stats;
+#endif
+
+// car_add_*() 拼接的运行时动作表
+static car_action_t ram_actions[MAX_ACTIONS];
+static car_program_t ram_program = { ram_actions, 0 };
+static bool ram_overflow;           // 有 car_add_*() 因表满被拒, 这段动作不完整
+
 /* =============================================================================
  * API实现
  * ============================================================================= */
 
 void car_path_init(void) {
     memset(&sm, 0, sizeof(sm));
+    ram_program.count = 0;
+    ram_overflow = false;
+    sm.stack[0].program = &ram_program;
+    sm.depth = 1;
     task_running_flag = false;
 }
 
-void car_add_straight(float distance) {
-    if (sm.count < MAX_ACTIONS) {
-        sm.actions[sm.count].type = ACTION_GO_STRAIGHT;
-        sm.actions[sm.count].params.move.distance = distance;
-        sm.count++;
-    }
+void car_load_program(const car_program_t *program, uint8_t loop_count) {
+    car_path_init();
+    sm.stack[0].program = program;
+    sm.loop_count = loop_count;
 }
 
-void car_add_turn(float angle) {
-    if (sm.count < MAX_ACTIONS) {
-        sm.actions[sm.count].type = ACTION_SPIN_TURN;
-        sm.actions[sm.count].params.turn.angle = angle;
-        sm.count++;
+// 表满时拒绝并记下, car_start() 不再启动这段被截断的动作
+static bool car_add_action(car_action_t action) {
+    if (ram_program.count >= MAX_ACTIONS) {
+        ram_overflow = true;
+        return false;
     }
+    ram_actions[ram_program.count++] = action;
+    return true;
 }
 
-void car_add_track(float distance) {
-    if (sm.count < MAX_ACTIONS) {
-        sm.actions[sm.count].type = ACTION_TRACK;
-        sm.actions[sm.count].params.move.distance = distance;
-        sm.count++;
-    }
+bool car_add_straight(float distance) {
+    return car_add_action((car_action_t)CAR_ACT_STRAIGHT(distance));
 }
 
-void car_add_move_until_black(int state) {
-    if (sm.count < MAX_ACTIONS) {
-        sm.actions[sm.count].type = ACTION_MOVE_UNTIL_BLACK;
-        sm.actions[sm.count].params.until.state = state;
-        sm.count++;
-    }
+bool car_add_turn(float angle) {
+    return car_add_action((car_action_t)CAR_ACT_TURN(angle));
 }
 
-void car_add_move_until_white(int state) {
-    if (sm.count < MAX_ACTIONS) {
-        sm.actions[sm.count].type = ACTION_MOVE_UNTIL_WHITE;
-        sm.actions[sm.count].params.until.state = state;
-        sm.count++;
-    }
+bool car_add_track(float distance) {
+    return car_add_action((car_action_t)CAR_ACT_TRACK(distance));
 }
 
-void car_add_move_until_stop_mark(int state) {
-    if (sm.count < MAX_ACTIONS) {
-        sm.actions[sm.count].type = ACTION_MOVE_UNTIL_STOP_MARK;
-        sm.actions[sm.count].params.until.state = state;
-        sm.count++;
-    }
+bool car_add_move_until_black(int state) {
+    return car_add_action((car_action_t)CAR_ACT_UNTIL_BLACK(state));
 }
 
-void car_add_delay(uint32_t ms) {
-    if (sm.count < MAX_ACTIONS) {
-        sm.actions[sm.count].type = ACTION_DELAY;
-        sm.actions[sm.count].params.delay.ms = ms;
-        sm.count++;
-    }
+bool car_add_move_until_white(int state) {
+    return car_add_action((car_action_t)CAR_ACT_UNTIL_WHITE(state));
+}
+
+bool car_add_move_until_stop_mark(int state) {
+    return car_add_action((car_action_t)CAR_ACT_UNTIL_STOP_MARK(state));
+}
+
+bool car_add_delay(uint32_t ms) {
+    return car_add_action((car_action_t)CAR_ACT_DELAY(ms));
 }
 
 // 函数调用功能
-void car_add_function(void (*func)(void)) {
-    if (sm.count < MAX_ACTIONS) {
-        sm.actions[sm.count].type = ACTION_FUNCTION;
-        sm.actions[sm.count].params.function.func = func;
-        sm.count++;
-    }
+bool car_add_function(void (*func)(void)) {
+    return car_add_action((car_action_t)CAR_ACT_FUNCTION(func));
 }
 
 // 新增：布尔值设置功能
-void car_add_bool(bool *flag, bool val) {
-    if (sm.count < MAX_ACTIONS) {
-        sm.actions[sm.count].type = ACTION_SET_BOOL;
-        sm.actions[sm.count].params.set_bool.flag = flag;
-        sm.actions[sm.count].params.set_bool.value = val;
-        sm.count++;
-    }
+bool car_add_bool(bool *flag, bool val) {
+    return car_add_action((car_action_t)CAR_ACT_BOOL(flag, val));
 }
 
 // 新增：浮点值设置功能
-void car_add_float(float *var, float val) {
-    if (sm.count < MAX_ACTIONS) {
-        sm.actions[sm.count].type = ACTION_SET_FLOAT;
-        sm.actions[sm.count].params.set_float.var = var;
-        sm.actions[sm.count].params.set_float.value = val;
-        sm.count++;
-    }
+bool car_add_float(float *var, float val) {
+    return car_add_action((car_action_t)CAR_ACT_FLOAT(var, val));
 }
 
 // 新增：字节发送功能
-void car_add_byte(uint8_t byte) {
-    if (sm.count < MAX_ACTIONS) {
-        sm.actions[sm.count].type = ACTION_SEND_BYTE;
-        sm.actions[sm.count].params.send_byte.byte = byte;
-        sm.count++;
-    }
+bool car_add_byte(uint8_t byte) {
+    return car_add_action((car_action_t)CAR_ACT_BYTE(byte));
 }
 
-void car_add_wait_func_true(bool (*func)(void)) {
-    if (sm.count < MAX_ACTIONS) {
-        sm.actions[sm.count].type = ACTION_WAIT_FUNC_TRUE;
-        sm.actions[sm.count].params.wait_func_true.func = func;
-        sm.count++;
-    }
+bool car_add_wait_func_true(bool (*func)(void)) {
+    return car_add_action((car_action_t)CAR_ACT_WAIT_TRUE(func));
 }
 
 // 添加绕圈动作
-void car_add_circle(float radius, bool clockwise, float angle) {
-    if (sm.count < MAX_ACTIONS) {
-        sm.actions[sm.count].type = ACTION_CIRCLE;
-        sm.actions[sm.count].params.circle.radius = radius;
-        sm.actions[sm.count].params.circle.clockwise = clockwise;
-				sm.actions[sm.count].params.circle.angle = angle;
-        sm.count++;
+bool car_add_circle(float radius, bool clockwise, float angle) {
+    return car_add_action((car_action_t)CAR_ACT_CIRCLE(radius, clockwise, angle));
+}
+
+// 添加自整定动作
+bool car_add_autotune(CAR_TUNE_LOOPS loop) {
+    return car_add_action((car_action_t)CAR_ACT_AUTOTUNE(loop));
+}
+
+// 添加前馈标定动作
+bool car_add_ff_calibrate(void) {
+    return car_add_action((car_action_t)CAR_ACT_FF_CALIBRATE());
+}
+
+// 添加驶向目标点动作
+bool car_add_goto(float x, float y) {
+    return car_add_action((car_action_t)CAR_ACT_GOTO(x, y));
+}
+
+// 添加设定位姿动作
+bool car_add_set_pose(float x, float y, float heading) {
+    return car_add_action((car_action_t)CAR_ACT_SET_POSE(x, y, heading));
+}
+
+// 添加航点路径动作
+bool car_add_path(const path_point_t *waypoints, uint8_t n) {
+    car_action_t action = { ACTION_PATH, { .path = { waypoints, n } }, NULL };
+    return car_add_action(action);
+}
+
+// 添加后台子程序动作
+bool car_add_fork(const car_program_t *program) {
+    return car_add_action((car_action_t)CAR_ACT_FORK(program));
+}
+
+// 添加汇合动作
+bool car_add_join(uint32_t timeout_ms) {
+    return car_add_action((car_action_t)CAR_ACT_JOIN(timeout_ms));
+}
+
+void car_add_opts(const car_action_opts_t *opts) {
+    // 上一个动作被拒时不能把选项挂到更早的动作上
+    if (ram_program.count > 0 && !ram_overflow) {
+        ram_actions[ram_program.count - 1].opts = opts;
     }
 }
 
@@ -139,18 +185,30 @@ void car_set_loop(uint8_t loop_count) {
 }
 
 void car_start(void) {
-    if (sm.count > 0) {
+    if (sm.stack[0].program == &ram_program && ram_overflow) {
+        return;
+    }
+    if (sm.depth > 0 && sm.stack[0].program != NULL && sm.stack[0].program->count > 0) {
         sm.is_running = true;
-        sm.current = 0;
+        sm.depth = 1;
+        sm.stack[0].current = 0;
         sm.current_loop = 0;
         sm.first_call = true;
+        memset(sm.forks, 0, sizeof(sm.forks));
+#if CAR_ACTION_STATS
+        stats.count = 0;
+#endif
         task_running_flag = true;
+        // 全局位姿以起点为原点, x 轴为陀螺仪 0°
+        car_pose_reset(0.0f, 0.0f, get_yaw());
     }
 }
 
 void car_stop(void) {
     sm.is_running = false;
+    memset(sm.forks, 0, sizeof(sm.forks));
     car.state = CAR_STATE_STOP;
+    car.goto_phase = 0;
     car_reset();
     task_running_flag = false;
 }
@@ -159,45 +217,324 @@ bool car_is_running(void) {
     return sm.is_running;
 }
 
+bool car_background_busy(void) {
+    for (uint8_t i = 0; i < CAR_FORK_SLOTS; i++) {
+        if (sm.forks[i].program != NULL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if CAR_ACTION_STATS
+const car_action_stat_t *car_action_stats(uint8_t *count) {
+    *count = stats.count;
+    return stats.items;
+}
+#endif
+
 void car_clear_actions(void) {
-    sm.count = 0;
-    sm.current = 0;
+    ram_program.count = 0;
+    ram_overflow = false;
+    sm.stack[0].program = &ram_program;
+    sm.stack[0].current = 0;
+    sm.depth = 1;
 }
 
 /* =============================================================================
  * 状态机核心
  * ============================================================================= */
 
-void car_state_machine(void) {
-    if (!sm.is_running) {
+/**
+ * @brief 当前直行/绕圈段结束时可保留的速度 (look-ahead 衔接)
+ * 跳过不动车的即时动作; 下一段为同向直行或绕圈时不停车, 其余情况 (转向、巡线、延时、FORK/JOIN、末尾) 停车.
+ * 中间改写 car.target_angle 视为航向变化, 衔接速度受限
+ */
+static float lookahead_exit_speed(float current_distance) {
+    const sm_frame_t *f = &sm.stack[sm.depth - 1];
+    bool heading_change = false;
+
+    for (uint8_t i = f->current + 1; i < f->program->count; i++) {
+        const car_action_t *next = &f->program->actions[i];
+        switch (next->type) {
+            case ACTION_SET_FLOAT:
+                if (next->params.set_float.var == &car.target_angle &&
+                    next->params.set_float.value != car.target_angle) {
+                    heading_change = true;
+                }
+                break;
+            case ACTION_SET_BOOL:
+            case ACTION_SET_POSE:
+            case ACTION_FUNCTION:
+            case ACTION_SEND_BYTE:
+                break;
+            case ACTION_FORK:
+            case ACTION_JOIN:
+                // 后台是否还在跑要到本段结束时才知道 (FORK 那时才启动), JOIN 可能要停下来等
+                return 0.0f;
+            case ACTION_GO_STRAIGHT: {
+                float d = next->params.move.distance;
+                if ((d > 0.0f) != (current_distance > 0.0f)) {
+                    return 0.0f;
+                }
+                return car_blend_speed(CAR_STATE_GO_STRAIGHT, fabsf(d), heading_change);
+            }
+            case ACTION_CIRCLE:
+                return (current_distance > 0.0f) ? car_blend_speed(CAR_STATE_CIRCLE, 0.0f, false) : 0.0f;
+            default:
+                return 0.0f;
+        }
+    }
+    return 0.0f;
+}
+
+/**
+ * @brief 进入子程序: 调用者先越过 CALL/SWITCH 动作, 子程序从头执行
+ * @note program 为 NULL、为空或嵌套已满时直接跳过
+ */
+static void sm_call(const car_program_t *program) {
+    sm.stack[sm.depth - 1].current++;
+    sm.first_call = true;
+    if (program != NULL && program->count > 0 && sm.depth < CAR_CALL_DEPTH) {
+        sm.stack[sm.depth].program = program;
+        sm.stack[sm.depth].current = 0;
+        sm.depth++;
+    }
+}
+
+/**
+ * @brief 执行不动车的动作, 前台与后台共用
+ * @param completed 输出动作是否完成
+ * @return false 表示 action 会动车或属于流程控制, 不在这里处理
+ */
+static bool sm_side_action(const car_action_t *action, bool first_call, uint32_t start_time,
+                           bool *completed) {
+    switch (action->type) {
+        case ACTION_DELAY:
+            *completed = (get_time_ms() - start_time) >= action->params.delay.ms;
+            return true;
+
+        case ACTION_FUNCTION:
+            // 立即执行函数, 不等待
+            if (first_call && action->params.function.func != NULL) {
+                action->params.function.func();
+            }
+            *completed = true;
+            return true;
+
+        case ACTION_SET_BOOL:
+            if (action->params.set_bool.flag != NULL) {
+                *(action->params.set_bool.flag) = action->params.set_bool.value;
+            }
+            *completed = true;
+            return true;
+
+        case ACTION_SET_FLOAT:
+            if (action->params.set_float.var != NULL) {
+                *(action->params.set_float.var) = action->params.set_float.value;
+            }
+            *completed = true;
+            return true;
+
+        case ACTION_SEND_BYTE:
+            if (first_call) {
+                bluetooth_send_byte(action->params.send_byte.byte);
+            }
+            *completed = true;
+            return true;
+
+        case ACTION_WAIT_FUNC_TRUE:
+            // 直到返回 true 才完成; NULL 视为立即完成, 防止死锁
+            *completed = (action->params.wait_func_true.func == NULL) || action->params.wait_func_true.func();
+            return true;
+
+        case ACTION_SET_POSE:
+            car_pose_reset(action->params.set_pose.x, action->params.set_pose.y,
+                           action->params.set_pose.heading);
+            *completed = true;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief 检查动作选项
+ * @return CAR_ACTION_DONE 表示可以继续执行, 否则为中止原因
+ */
+static car_action_result_t sm_check_opts(const car_action_t *action, uint32_t start_time) {
+    const car_action_opts_t *opts = action->opts;
+    if (opts == NULL) {
+        return CAR_ACTION_DONE;
+    }
+    if (opts->timeout_ms != 0 && (get_time_ms() - start_time) >= opts->timeout_ms) {
+        return CAR_ACTION_TIMEOUT;
+    }
+    if (opts->guard != NULL && !opts->guard()) {
+        return CAR_ACTION_GUARD;
+    }
+    return CAR_ACTION_DONE;
+}
+
+// 不占控制周期的动作, 不计入耗时统计
+static bool sm_is_instant(action_type_t type) {
+    switch (type) {
+        case ACTION_FUNCTION:
+        case ACTION_SET_BOOL:
+        case ACTION_SET_FLOAT:
+        case ACTION_SEND_BYTE:
+        case ACTION_SET_POSE:
+        case ACTION_CALL:
+        case ACTION_SWITCH:
+        case ACTION_FORK:
+            return true;
+        default:
+            return false;
+    }
+}
+
+#if CAR_ACTION_STATS
+static void sm_record(const sm_frame_t *f, const car_action_t *action, car_action_result_t result) {
+    if (sm_is_instant(action->type) || stats.count >= CAR_ACTION_STATS_MAX) {
         return;
     }
-    
-    // 检查是否完成所有动作
-    if (sm.current >= sm.count) {
-        // 检查循环
-        if (sm.loop_count == 0 || ++sm.current_loop < sm.loop_count) {
-            sm.current = 0;
+    uint32_t actual = get_time_ms() - sm.start_time;
+    car_action_stat_t *s = &stats.items[stats.count++];
+    s->program = f->program;
+    s->index = f->current;
+    s->type = (uint8_t)action->type;
+    s->result = (uint8_t)result;
+    s->actual_ms = (actual > UINT16_MAX) ? UINT16_MAX : (uint16_t)actual;
+    s->planned_ms = sm.planned_ms;
+}
+#else
+#define sm_record(f, action, result)    ((void)0)
+#endif
+
+/**
+ * @brief 动作第一拍之后记下计划耗时: 直行/转向/绕圈取本段 S 形曲线时长, 延时取设定值
+ */
+static uint16_t sm_planned_ms(const car_action_t *action) {
+    switch (action->type) {
+#if CAR_MOTION_PROFILE
+        case ACTION_GO_STRAIGHT:
+        case ACTION_SPIN_TURN:
+        case ACTION_CIRCLE:
+            return (uint16_t)(car.profile.t_total * 1000.0f);
+#endif
+        case ACTION_DELAY:
+            return (action->params.delay.ms > UINT16_MAX) ? UINT16_MAX : (uint16_t)action->params.delay.ms;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief 中止前台当前动作: 停车, 然后进入恢复子程序 (没有则跳到下一个动作)
+ */
+static void sm_abort(sm_frame_t *f, const car_action_t *action, car_action_result_t result) {
+    sm_record(f, action, result);
+    car_reset();
+    car.state = CAR_STATE_STOP;
+    car.goto_phase = 0;
+    if (action->type == ACTION_JOIN) {
+        memset(sm.forks, 0, sizeof(sm.forks));
+    }
+    sm_call(action->opts->recovery);
+}
+
+/**
+ * @brief 在空闲槽位启动后台子程序, 本拍前台动作执行完后即开始执行
+ * @note program 为 NULL、为空或槽位已满时跳过
+ */
+static void sm_fork(const car_program_t *program) {
+    if (program == NULL || program->count == 0) {
+        return;
+    }
+    for (uint8_t i = 0; i < CAR_FORK_SLOTS; i++) {
+        if (sm.forks[i].program == NULL) {
+            sm.forks[i].program = program;
+            sm.forks[i].current = 0;
+            sm.forks[i].first_call = true;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 后台子程序各走一拍: 连续执行已完成的动作, 遇到未完成的 (延时、等待条件) 停下
+ * 会动车或属于流程控制的动作在后台跳过, 车始终只由前台控制
+ */
+static void sm_step_forks(void) {
+    for (uint8_t i = 0; i < CAR_FORK_SLOTS; i++) {
+        sm_fork_t *t = &sm.forks[i];
+        for (uint8_t n = 0; n < CAR_STEPS_PER_TICK && t->program != NULL; n++) {
+            if (t->current >= t->program->count) {
+                t->program = NULL;
+                break;
+            }
+            const car_action_t *action = &t->program->actions[t->current];
+            bool completed = true;
+            if (t->first_call) {
+                t->start_time = get_time_ms();
+            }
+            if (sm_check_opts(action, t->start_time) == CAR_ACTION_DONE) {
+                sm_side_action(action, t->first_call, t->start_time, &completed);
+            }
+            if (!completed) {
+                t->first_call = false;
+                break;
+            }
+            t->current++;
+            t->first_call = true;
+        }
+    }
+}
+
+/**
+ * @brief 前台执行一步
+ * @return true 表示本步完成的是即时动作, 同一拍内接着执行下一个动作
+ */
+static bool sm_step(void) {
+    // 子程序执行完返回调用者; 顶层程序执行完检查循环
+    sm_frame_t *f = &sm.stack[sm.depth - 1];
+    while (f->current >= f->program->count) {
+        if (sm.depth > 1) {
+            sm.depth--;
+            f = &sm.stack[sm.depth - 1];
+            sm.first_call = true;
+        } else if (f->program->count > 0 && (sm.loop_count == 0 || ++sm.current_loop < sm.loop_count)) {
+            f->current = 0;
             sm.first_call = true;
         } else {
             car_stop();
-            return;
+            return false;
         }
     }
     
     // 获取当前动作
-    car_action_t* action = &sm.actions[sm.current];
+    const car_action_t* action = &f->program->actions[f->current];
     bool completed = false;
+    bool instant = false;
     
     // 记录开始时间
     if (sm.first_call) {
         sm.start_time = get_time_ms();
     }
+
+    // 超时或守护条件不成立: 中止, 恢复子程序本拍就开始
+    car_action_result_t fault = sm_check_opts(action, sm.start_time);
+    if (fault != CAR_ACTION_DONE) {
+        sm_abort(f, action, fault);
+        return true;
+    }
     
     // 执行动作
     switch (action->type) {
         case ACTION_GO_STRAIGHT:
-            completed = car_move_cm(action->params.move.distance, CAR_STATE_GO_STRAIGHT);
+            completed = car_move_cm_blend(action->params.move.distance, CAR_STATE_GO_STRAIGHT,
+                                          lookahead_exit_speed(action->params.move.distance));
             break;
             
         case ACTION_SPIN_TURN:
@@ -215,73 +552,88 @@ void car_state_machine(void) {
         case ACTION_MOVE_UNTIL_WHITE:
             completed = car_move_until((CAR_STATES)action->params.until.state, UNTIL_WHITE_LINE);
             break;
-            
-        case ACTION_DELAY:
-            completed = (get_time_ms() - sm.start_time) >= action->params.delay.ms;
-            break;
          
         case ACTION_MOVE_UNTIL_STOP_MARK:
             completed = car_move_until((CAR_STATES)action->params.until.state, UNTIL_STOP_MARK);
             break;
-            
-        case ACTION_FUNCTION:
-            if (sm.first_call) {
-                // 立即执行函数
-                if (action->params.function.func != NULL) {
-                    action->params.function.func();
-                }
-                completed = true; // 立即完成，不等待
-            }
+						
+			case ACTION_CIRCLE:
+            completed = car_circle_blend(action->params.circle.radius, action->params.circle.clockwise,
+                                         action->params.circle.angle, lookahead_exit_speed(1.0f));
             break;
-           
-        case ACTION_SET_BOOL:
-            if (sm.first_call) {
-                // 立即设置布尔值
-                if (action->params.set_bool.flag != NULL) {
-                    *(action->params.set_bool.flag) = action->params.set_bool.value;
-                }
-                completed = true; // 立即完成，不等待
-            }
+        case ACTION_AUTOTUNE:
+            completed = car_autotune(action->params.autotune.loop);
             break;
-     
-				case ACTION_SET_FLOAT:
-            if (sm.first_call) {
-                // 立即设置浮点值
-                if (action->params.set_float.var != NULL) {
-                    *(action->params.set_float.var) = action->params.set_float.value;
-                }
-                completed = true; // 立即完成，不等待
-            }
+        case ACTION_FF_CALIBRATE:
+            completed = car_ff_calibrate();
             break;
-						
-        case ACTION_SEND_BYTE:
-            if (sm.first_call) {
-                // 立即发送蓝牙字节
-                bluetooth_send_byte(action->params.send_byte.byte);
-                completed = true; // 立即完成，不等待
-            }
+        case ACTION_GO_TO:
+            completed = car_go_to(action->params.go_to.x, action->params.go_to.y);
             break;
-       case ACTION_WAIT_FUNC_TRUE:
-						if (action->params.wait_func_true.func != NULL) {
-								completed = action->params.wait_func_true.func();  // 直到返回true才完成
-						} else {
-								completed = true;  // NULL 视为立即完成，防止死锁
-						}
-						break;     
-						
-			case ACTION_CIRCLE:
-            completed = car_circle(action->params.circle.radius, action->params.circle.clockwise, action->params.circle.angle);
+        case ACTION_PATH:
+            completed = car_follow_path(action->params.path.points, action->params.path.count);
             break;
-        default:
+        case ACTION_CALL:
+            sm_call(action->params.call.program);
+            return true;
+        case ACTION_SWITCH: {
+            uint8_t index = (action->params.select.select != NULL) ? action->params.select.select() : 0xFF;
+            sm_call((index < action->params.select.count) ? action->params.select.cases[index] : NULL);
+            return true;
+        }
+        case ACTION_FORK:
+            sm_fork(action->params.call.program);
             completed = true;
+            instant = true;
+            break;
+        case ACTION_JOIN:
+            completed = !car_background_busy();
+            if (!completed && action->params.join.timeout_ms != 0 &&
+                (get_time_ms() - sm.start_time) >= action->params.join.timeout_ms) {
+                // 超时: 取消还没结束的后台子程序, 前台继续
+                memset(sm.forks, 0, sizeof(sm.forks));
+                completed = true;
+            }
+            instant = true;
+            break;
+        default:
+            // 不动车的动作: 延时、等待条件也算, 完成后同一拍内接着往下走
+            if (!sm_side_action(action, sm.first_call, sm.start_time, &completed)) {
+                completed = true;
+            }
+            instant = true;
             break;
     }
     
+    if (sm.first_call) {
+        sm.planned_ms = sm_planned_ms(action);
+    }
+
     // 动作完成，切换到下一个
     if (completed) {
-        sm.current++;
+        sm_record(f, action, CAR_ACTION_DONE);
+        f->current++;
         sm.first_call = true;
     } else {
         sm.first_call = false;
     }
-}
\ No newline at end of file
+    return completed && instant;
+}
+
+void car_state_machine(void) {
+    if (!sm.is_running) {
+        return;
+    }
+
+    // 前台: 即时动作不占控制周期, 连续执行到一个需要等待的动作为止
+    for (uint8_t n = 0; n < CAR_STEPS_PER_TICK && sm.is_running; n++) {
+        if (!sm_step()) {
+            break;
+        }
+    }
+
+    // 后台: 在前台之后执行, 本拍 FORK 的子程序本拍就开始
+    if (sm.is_running) {
+        sm_step_forks();
+    }
+}
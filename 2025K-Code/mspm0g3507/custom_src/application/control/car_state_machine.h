@@ -19,9 +19,20 @@ typedef enum {
     ACTION_SET_FLOAT,       // 新增：浮点值设置动作
 		ACTION_WAIT_FUNC_TRUE,
 		ACTION_SEND_BYTE,
-		ACTION_CIRCLE
+		ACTION_CIRCLE,
+		ACTION_AUTOTUNE,
+		ACTION_FF_CALIBRATE,
+		ACTION_GO_TO,           // 驶向全局位姿坐标中的一点
+		ACTION_SET_POSE,        // 重新设定全局位姿
+		ACTION_PATH,            // 纯追踪沿航点连续行驶
+		ACTION_CALL,            // 调用子程序, 子程序结束后继续下一个动作
+		ACTION_SWITCH,          // 按选择函数的返回值调用 cases[] 中的一个子程序 (越界则跳过)
+		ACTION_FORK,            // 在后台启动一个子程序, 与后面的动作同时执行
+		ACTION_JOIN             // 等待后台子程序全部结束 (可带超时)
 } action_type_t;
 
+typedef struct car_program_s car_program_t;
+
 // 动作参数联合体
 typedef union {
     struct { float distance; } move;                  // 移动参数
@@ -34,45 +45,141 @@ typedef union {
     struct { uint8_t byte; } send_byte;               // 新增：发送字节参数
 		struct { bool (*func)(void); } wait_func_true; // <== 新增
 		struct { float radius; float angle; bool clockwise; } circle;
+		struct { CAR_TUNE_LOOPS loop; } autotune;          // 自整定参数
+		struct { float x; float y; } go_to;                 // cm
+		struct { float x; float y; float heading; } set_pose; // cm, deg
+		struct { const path_point_t *points; uint8_t count; } path;
+		struct { const car_program_t *program; } call;
+		struct { uint8_t (*select)(void); const car_program_t *const *cases; uint8_t count; } select;
+		struct { uint32_t timeout_ms; } join;               // 0 = 不超时
     
 } action_params_t;
 
+/*
+ * 动作选项 (可选, 多个动作可共用一份): 超时、守护条件、失败后的恢复子程序.
+ * 每拍执行动作前检查, 超时或守护条件不成立即中止该动作: 停车, 然后调用 recovery
+ * (为 NULL 则直接执行下一个动作), recovery 结束后从下一个动作继续.
+ * 后台子程序中的动作同样检查超时和守护条件, 但不调用 recovery.
+ */
+typedef struct {
+    uint32_t timeout_ms;                // 从动作开始计, 0 = 不限时
+    bool (*guard)(void);                // 返回 false 时中止, NULL = 不检查
+    const car_program_t *recovery;
+} car_action_opts_t;
+
 // 动作结构体
 typedef struct {
     action_type_t type;
     action_params_t params;
+    const car_action_opts_t *opts;      // NULL = 无超时/守护
 } car_action_t;
 
-// 状态机结构
-#define MAX_ACTIONS 50
-static struct {
-    car_action_t actions[MAX_ACTIONS];
+// 动作结束方式
+typedef enum {
+    CAR_ACTION_DONE = 0,
+    CAR_ACTION_TIMEOUT,
+    CAR_ACTION_GUARD,                   // 守护条件不成立
+} car_action_result_t;
+
+/*
+ * 动作程序: 一张 const 动作表 (放在 flash), 状态机直接按表执行, 不复制到 RAM.
+ * 程序之间用 ACTION_CALL / ACTION_SWITCH 组合, 嵌套深度不超过 CAR_CALL_DEPTH.
+ *
+ *   static const car_action_t part1_actions[] = {
+ *       CAR_ACT_STRAIGHT(240),
+ *       CAR_ACT_TURN(90.0f),
+ *       CAR_ACT_CALL(&park_program),
+ *   };
+ *   static const car_program_t part1_program = CAR_PROGRAM(part1_actions);
+ *   car_load_program(&part1_program, 1);
+ *   car_start();
+ *
+ * 并发: ACTION_FORK 把一个子程序放到后台槽位 (共 CAR_FORK_SLOTS 个) 与前台同时执行, 前台继续
+ * 往下走运动动作, 之后用 ACTION_JOIN 汇合. 后台只执行不动车的动作 (函数、赋值、发字节、延时、
+ * 等待条件、设定位姿), 其余动作在后台直接跳过; JOIN 超时后取消未结束的后台子程序.
+ *
+ *   static const car_action_t cam_request_actions[] = {
+ *       CAR_ACT_FUNCTION(send_start_cmd),
+ *       CAR_ACT_WAIT_TRUE(wait_cam_cmd),
+ *   };
+ *   CAR_ACT_FORK(&cam_request), CAR_ACT_STRAIGHT(60), CAR_ACT_JOIN(3000), CAR_ACT_SWITCH(...)
+ *
+ * 即时动作 (函数、赋值、发字节、设定位姿、CALL/SWITCH/FORK、已满足的 JOIN) 不占控制周期,
+ * 同一拍内接着执行下一个动作, 每拍至多 CAR_STEPS_PER_TICK 个, 运动段之间不因它们多停一拍.
+ *
+ * car_path_init() + car_add_*() 仍可在运行时拼一段动作 (存放在 MAX_ACTIONS 大小的 RAM 表中),
+ * 用于调试、整定等临时序列; 运行中追加的动作会接着执行. 超出容量的动作被拒绝, 这段动作不再启动.
+ */
+struct car_program_s {
+    const car_action_t *actions;
     uint8_t count;
-    uint8_t current;
-    uint8_t loop_count;
-    uint8_t current_loop;
-    bool is_running;
-    bool first_call;
-    uint32_t start_time;
-} sm = {0};
+};
+
+#define MAX_ACTIONS     16              // car_add_*() 的 RAM 动作表容量
+#define CAR_CALL_DEPTH  4               // 子程序嵌套深度 (含顶层程序)
+#define CAR_FORK_SLOTS  2               // 同时运行的后台子程序数
+#define CAR_STEPS_PER_TICK  8           // 每个控制周期内至多连续执行的动作数
+
+#define CAR_PROGRAM(actions)            { (actions), (uint8_t)(sizeof(actions) / sizeof((actions)[0])) }
+
+// 动作表初始化宏, 参数与对应的 car_add_*() 相同
+#define CAR_ACT_STRAIGHT(d)             { ACTION_GO_STRAIGHT, { .move = { (d) } }, NULL }
+#define CAR_ACT_TURN(a)                 { ACTION_SPIN_TURN, { .turn = { (a) } }, NULL }
+#define CAR_ACT_TRACK(d)                { ACTION_TRACK, { .move = { (d) } }, NULL }
+#define CAR_ACT_UNTIL_BLACK(s)          { ACTION_MOVE_UNTIL_BLACK, { .until = { (s) } }, NULL }
+#define CAR_ACT_UNTIL_WHITE(s)          { ACTION_MOVE_UNTIL_WHITE, { .until = { (s) } }, NULL }
+#define CAR_ACT_UNTIL_STOP_MARK(s)      { ACTION_MOVE_UNTIL_STOP_MARK, { .until = { (s) } }, NULL }
+#define CAR_ACT_DELAY(ms)               { ACTION_DELAY, { .delay = { (ms) } }, NULL }
+#define CAR_ACT_FUNCTION(f)             { ACTION_FUNCTION, { .function = { (f) } }, NULL }
+#define CAR_ACT_BOOL(p, v)              { ACTION_SET_BOOL, { .set_bool = { (p), (v) } }, NULL }
+#define CAR_ACT_FLOAT(p, v)             { ACTION_SET_FLOAT, { .set_float = { (p), (v) } }, NULL }
+#define CAR_ACT_BYTE(b)                 { ACTION_SEND_BYTE, { .send_byte = { (b) } }, NULL }
+#define CAR_ACT_WAIT_TRUE(f)            { ACTION_WAIT_FUNC_TRUE, { .wait_func_true = { (f) } }, NULL }
+#define CAR_ACT_CIRCLE(r, cw, a)        { ACTION_CIRCLE, { .circle = { (r), (a), (cw) } }, NULL }
+#define CAR_ACT_AUTOTUNE(l)             { ACTION_AUTOTUNE, { .autotune = { (l) } }, NULL }
+#define CAR_ACT_FF_CALIBRATE()          { .type = ACTION_FF_CALIBRATE, .opts = NULL }     // 无参数, params 按零初始化
+#define CAR_ACT_GOTO(x, y)              { ACTION_GO_TO, { .go_to = { (x), (y) } }, NULL }
+#define CAR_ACT_SET_POSE(x, y, h)       { ACTION_SET_POSE, { .set_pose = { (x), (y), (h) } }, NULL }
+#define CAR_ACT_PATH(p)                 { ACTION_PATH, { .path = { (p), (uint8_t)(sizeof(p) / sizeof((p)[0])) } }, NULL }
+#define CAR_ACT_CALL(prog)              { ACTION_CALL, { .call = { (prog) } }, NULL }
+#define CAR_ACT_SWITCH(sel, cases)      { ACTION_SWITCH, { .select = { (sel), (cases), \
+                                            (uint8_t)(sizeof(cases) / sizeof((cases)[0])) } }, NULL }
+// 带选项的动作: CAR_ACT_EX(&opts, ACTION_WAIT_FUNC_TRUE, .wait_func_true = { wait_cam_cmd })
+#define CAR_ACT_EX(o, t, ...)           { (t), { __VA_ARGS__ }, (o) }
+#define CAR_ACT_FORK(prog)              { ACTION_FORK, { .call = { (prog) } }, NULL }
+#define CAR_ACT_JOIN(ms)                { ACTION_JOIN, { .join = { (ms) } }, NULL }
 
 // 初始化路径（清空之前的所有动作）
 void car_path_init(void);
 
-// 添加动作
-void car_add_straight(float distance);
-void car_add_turn(float angle);
-void car_add_track(float distance);
-void car_add_move_until_black(int state);
-void car_add_move_until_white(int state);
-void car_add_move_until_stop_mark(int state);
-void car_add_delay(uint32_t ms);
-void car_add_function(void (*func)(void));  // 添加函数调用
-void car_add_bool(bool *flag, bool val);    // 添加布尔值设置
-void car_add_float(float *var, float val);  // 添加浮点值设置
-void car_add_byte(uint8_t byte);            // 新增：添加蓝牙字节发送
-void car_add_wait_func_true(bool (*func)(void));
-void car_add_circle(float radius, bool clockwise, float angle);
+/**
+ * @brief 装入一个动作程序 (不复制, program 及其动作表须长期有效), 之后调用 car_start()
+ * @param loop_count 顶层程序执行次数, 0 = 无限循环
+ */
+void car_load_program(const car_program_t *program, uint8_t loop_count);
+
+// 添加动作, RAM 表已满时返回 false 且本段动作作废 (car_start() 不启动), 须 car_path_init() 重拼
+bool car_add_straight(float distance);
+bool car_add_turn(float angle);
+bool car_add_track(float distance);
+bool car_add_move_until_black(int state);
+bool car_add_move_until_white(int state);
+bool car_add_move_until_stop_mark(int state);
+bool car_add_delay(uint32_t ms);
+bool car_add_function(void (*func)(void));  // 添加函数调用
+bool car_add_bool(bool *flag, bool val);    // 添加布尔值设置
+bool car_add_float(float *var, float val);  // 添加浮点值设置
+bool car_add_byte(uint8_t byte);            // 新增：添加蓝牙字节发送
+bool car_add_wait_func_true(bool (*func)(void));
+bool car_add_circle(float radius, bool clockwise, float angle);
+bool car_add_autotune(CAR_TUNE_LOOPS loop);       // 继电器自整定, 见 car_autotune()
+bool car_add_ff_calibrate(void);                  // 速度环前馈标定, 见 car_ff_calibrate()
+bool car_add_goto(float x, float y);              // 驶向 (x, y), 坐标以 car_start() 时的位置为原点、陀螺仪 0° 为 x 轴
+bool car_add_set_pose(float x, float y, float heading); // 把当前位置设为 (x, y), 车头方向 heading (deg)
+bool car_add_path(const path_point_t *waypoints, uint8_t n); // 沿航点连续行驶, 见 car_follow_path(); 航点数组须长期有效
+bool car_add_fork(const car_program_t *program);  // 后台执行子程序, 槽位已满时跳过
+bool car_add_join(uint32_t timeout_ms);           // 等待后台子程序结束, 0 = 不超时
+void car_add_opts(const car_action_opts_t *opts); // 给最后添加的动作加上选项, opts 须长期有效; 表溢出后忽略
 
 // 设置循环
 void car_set_loop(uint8_t loop_count);  // 0 = 无限循环
@@ -81,6 +188,7 @@ void car_set_loop(uint8_t loop_count);  // 0 = 无限循环
 void car_start(void);
 void car_stop(void);
 bool car_is_running(void);
+bool car_background_busy(void);         // 是否还有后台子程序在执行
 
 // 状态机更新（在主循环调用）
 void car_state_machine(void);
@@ -88,4 +196,28 @@ void car_state_machine(void);
 // 动态控制
 void car_clear_actions(void);  // 清空所有动作
 
+#if CAR_ACTION_STATS
+/*
+ * 动作耗时统计: car_start() 时清空, 之后前台每结束一个要等待的动作 (运动、延时、等待条件、JOIN)
+ * 记一条, 满 CAR_ACTION_STATS_MAX 条后不再记录. 计划耗时取自该段 S 形曲线 (直行/转向/绕圈)
+ * 或延时长度, 其余动作为 0.
+ */
+#define CAR_ACTION_STATS_MAX    32
+
+typedef struct {
+    const car_program_t *program;       // 动作所在程序
+    uint16_t actual_ms;
+    uint16_t planned_ms;                // 0 = 无计划耗时
+    uint8_t index;                      // 在程序中的下标
+    uint8_t type;                       // action_type_t
+    uint8_t result;                     // car_action_result_t
+} car_action_stat_t;
+
+/**
+ * @brief 本次运行的动作耗时记录
+ * @param count 输出记录条数
+ */
+const car_action_stat_t *car_action_stats(uint8_t *count);
+#endif
+
 #endif // CAR_STATE_MACHINE_H__
\ No newline at end of file
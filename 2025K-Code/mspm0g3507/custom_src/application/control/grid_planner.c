@@ -0,0 +1,323 @@
+#include "grid_planner.h"
+#include <math.h>
+#include <string.h>
+
+#define CELL_PARENT_MASK    0x07        // 从父格到本格的方向
+#define CELL_OPEN           0x08
+#define CELL_CLOSED         0x10
+#define CELL_BLOCKED        0x20
+
+#define COST_STRAIGHT       10
+#define COST_DIAGONAL       14
+
+// 8 邻域, 前 4 个为直走
+static const int8_t dir_dx[8] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+static const int8_t dir_dy[8] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+
+static const uint8_t clearance_cm[GRID_COLOR_COUNT] = {
+    [GRID_COLOR_WHITE] = GRID_PLANNER_CLEARANCE_WHITE_CM,
+    [GRID_COLOR_BLACK] = GRID_PLANNER_CLEARANCE_BLACK_CM,
+};
+
+_Static_assert(GRID_PLANNER_OPEN_MAX <= 255, "heap_pos[] stores heap indices as uint8_t");
+
+// 工作区 (GRID_PLANNER_RAM_BYTES)
+static uint8_t cell_state[GRID_PLANNER_CELLS];
+static uint16_t cell_g[GRID_PLANNER_CELLS];
+static uint8_t heap_pos[GRID_PLANNER_CELLS];    // 只对 CELL_OPEN 的格子有效
+static uint16_t heap[GRID_PLANNER_OPEN_MAX];
+static uint16_t heap_len;
+
+static const grid_obstacle_t *plan_obstacles;
+static uint8_t plan_obstacle_count;
+static uint8_t goal_col, goal_row;
+
+// ====================  栅格  ====================
+
+static inline uint16_t cell_index(uint8_t col, uint8_t row) {
+    return (uint16_t)row * GRID_PLANNER_COLS + col;
+}
+
+static path_point_t cell_center(uint16_t idx) {
+    path_point_t p = {
+        GRID_PLANNER_ORIGIN_X_CM + (idx % GRID_PLANNER_COLS) * GRID_PLANNER_CELL_CM + 0.5f * GRID_PLANNER_CELL_CM,
+        GRID_PLANNER_ORIGIN_Y_CM + (idx / GRID_PLANNER_COLS) * GRID_PLANNER_CELL_CM + 0.5f * GRID_PLANNER_CELL_CM,
+    };
+    return p;
+}
+
+static bool point_to_cell(path_point_t p, uint8_t *col, uint8_t *row) {
+    float fc = floorf((p.x - GRID_PLANNER_ORIGIN_X_CM) / GRID_PLANNER_CELL_CM);
+    float fr = floorf((p.y - GRID_PLANNER_ORIGIN_Y_CM) / GRID_PLANNER_CELL_CM);
+    if (fc < 0.0f || fc >= GRID_PLANNER_COLS || fr < 0.0f || fr >= GRID_PLANNER_ROWS) {
+        return false;
+    }
+    *col = (uint8_t)fc;
+    *row = (uint8_t)fr;
+    return true;
+}
+
+static uint8_t obstacle_clearance(const grid_obstacle_t *o) {
+    return clearance_cm[(o->color < GRID_COLOR_COUNT) ? o->color : GRID_COLOR_BLACK];
+}
+
+/**
+ * @brief 把一个圆柱的避让圆栅格化: 只扫它的外接方框, 格子中心在圆内即占用 (整数运算)
+ */
+static void rasterize_obstacle(const grid_obstacle_t *o) {
+    int32_t r = obstacle_clearance(o);
+    int32_t c0 = (o->x_cm - r - GRID_PLANNER_ORIGIN_X_CM) / GRID_PLANNER_CELL_CM - 1;
+    int32_t c1 = (o->x_cm + r - GRID_PLANNER_ORIGIN_X_CM) / GRID_PLANNER_CELL_CM + 1;
+    int32_t r0 = (o->y_cm - r - GRID_PLANNER_ORIGIN_Y_CM) / GRID_PLANNER_CELL_CM - 1;
+    int32_t r1 = (o->y_cm + r - GRID_PLANNER_ORIGIN_Y_CM) / GRID_PLANNER_CELL_CM + 1;
+    c0 = (c0 < 0) ? 0 : c0;
+    r0 = (r0 < 0) ? 0 : r0;
+    c1 = (c1 >= GRID_PLANNER_COLS) ? GRID_PLANNER_COLS - 1 : c1;
+    r1 = (r1 >= GRID_PLANNER_ROWS) ? GRID_PLANNER_ROWS - 1 : r1;
+
+    // 中心坐标放大 2 倍, 避免半格的小数
+    for (int32_t row = r0; row <= r1; row++) {
+        int32_t dy = 2 * (GRID_PLANNER_ORIGIN_Y_CM + row * GRID_PLANNER_CELL_CM - o->y_cm) + GRID_PLANNER_CELL_CM;
+        for (int32_t col = c0; col <= c1; col++) {
+            int32_t dx = 2 * (GRID_PLANNER_ORIGIN_X_CM + col * GRID_PLANNER_CELL_CM - o->x_cm) + GRID_PLANNER_CELL_CM;
+            if (dx * dx + dy * dy < 4 * r * r) {
+                cell_state[cell_index((uint8_t)col, (uint8_t)row)] |= CELL_BLOCKED;
+            }
+        }
+    }
+}
+
+bool grid_planner_cell_blocked(uint8_t col, uint8_t row) {
+    if (col >= GRID_PLANNER_COLS || row >= GRID_PLANNER_ROWS) {
+        return true;
+    }
+    return (cell_state[cell_index(col, row)] & CELL_BLOCKED) != 0;
+}
+
+// ====================  开放堆 (按 f = g + h 的最小堆, 带位置索引以支持降键)  ====================
+
+static uint16_t heuristic(uint16_t idx) {
+    int16_t dx = (int16_t)(idx % GRID_PLANNER_COLS) - goal_col;
+    int16_t dy = (int16_t)(idx / GRID_PLANNER_COLS) - goal_row;
+    dx = (dx < 0) ? -dx : dx;
+    dy = (dy < 0) ? -dy : dy;
+    // 八方向距离: 10·max + 4·min
+    return (dx > dy) ? (uint16_t)(COST_STRAIGHT * dx + (COST_DIAGONAL - COST_STRAIGHT) * dy)
+                     : (uint16_t)(COST_STRAIGHT * dy + (COST_DIAGONAL - COST_STRAIGHT) * dx);
+}
+
+// f 相同时 g 大的优先 (更靠近终点), 减少展开数
+static bool heap_less(uint16_t a, uint16_t b) {
+    uint32_t fa = (uint32_t)cell_g[a] + heuristic(a);
+    uint32_t fb = (uint32_t)cell_g[b] + heuristic(b);
+    return (fa != fb) ? (fa < fb) : (cell_g[a] > cell_g[b]);
+}
+
+static void heap_place(uint16_t i, uint16_t idx) {
+    heap[i] = idx;
+    heap_pos[idx] = (uint8_t)i;
+}
+
+static void heap_sift_up(uint16_t i) {
+    uint16_t idx = heap[i];
+    while (i > 0) {
+        uint16_t parent = (uint16_t)((i - 1) / 2);
+        if (!heap_less(idx, heap[parent])) {
+            break;
+        }
+        heap_place(i, heap[parent]);
+        i = parent;
+    }
+    heap_place(i, idx);
+}
+
+static uint16_t heap_pop(void) {
+    uint16_t top = heap[0];
+    uint16_t idx = heap[--heap_len];
+    uint16_t i = 0;
+    for (;;) {
+        uint16_t child = (uint16_t)(2 * i + 1);
+        if (child >= heap_len) {
+            break;
+        }
+        if (child + 1 < heap_len && heap_less(heap[child + 1], heap[child])) {
+            child++;
+        }
+        if (!heap_less(heap[child], idx)) {
+            break;
+        }
+        heap_place(i, heap[child]);
+        i = child;
+    }
+    if (heap_len > 0) {
+        heap_place(i, idx);
+    }
+    return top;
+}
+
+// ====================  视线化简  ====================
+
+/**
+ * @brief 线段 a-b 与每个圆柱的距离不小于避让半径减半格
+ * @note 相邻两个空闲格子中心的连线一定满足 (半径 20、格 10 时最近 18.7cm), 化简总能推进
+ */
+static bool segment_clear(path_point_t a, path_point_t b) {
+    float ex = b.x - a.x, ey = b.y - a.y;
+    float len2 = ex * ex + ey * ey;
+    for (uint8_t i = 0; i < plan_obstacle_count; i++) {
+        const grid_obstacle_t *o = &plan_obstacles[i];
+        float r = obstacle_clearance(o) - 0.5f * GRID_PLANNER_CELL_CM;
+        float t = (len2 > 0.0f) ? ((o->x_cm - a.x) * ex + (o->y_cm - a.y) * ey) / len2 : 0.0f;
+        t = (t < 0.0f) ? 0.0f : (t > 1.0f ? 1.0f : t);
+        float dx = a.x + t * ex - o->x_cm, dy = a.y + t * ey - o->y_cm;
+        if (dx * dx + dy * dy < r * r) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint16_t parent_of(uint16_t idx) {
+    uint8_t d = cell_state[idx] & CELL_PARENT_MASK;
+    return (uint16_t)(idx - dir_dy[d] * GRID_PLANNER_COLS - dir_dx[d]);
+}
+
+/**
+ * @brief 从终点沿父指针倒着走到起点, 保留从当前锚点看不到下一格时的前一格作为拐点
+ */
+static grid_plan_result_t build_waypoints(uint16_t start_idx, uint16_t goal_idx,
+                                          path_point_t start, path_point_t goal, grid_plan_t *plan) {
+    path_point_t rev[GRID_PLANNER_MAX_WAYPOINTS];
+    uint8_t n = 0;
+    path_point_t anchor = goal;
+    path_point_t prev = cell_center(goal_idx);
+
+    rev[n++] = goal;
+    for (uint16_t idx = goal_idx; idx != start_idx;) {
+        idx = parent_of(idx);
+        path_point_t p = cell_center(idx);
+        if (!segment_clear(anchor, p)) {
+            if (n >= GRID_PLANNER_MAX_WAYPOINTS - 1) {
+                return GRID_PLAN_TOO_MANY_WAYPOINTS;
+            }
+            rev[n++] = prev;
+            anchor = prev;
+        }
+        prev = p;
+    }
+    if (!segment_clear(anchor, start)) {
+        if (n >= GRID_PLANNER_MAX_WAYPOINTS - 1) {
+            return GRID_PLAN_TOO_MANY_WAYPOINTS;
+        }
+        rev[n++] = prev;
+    }
+    rev[n++] = start;
+
+    plan->count = n;
+    plan->length_cm = 0.0f;
+    for (uint8_t i = 0; i < n; i++) {
+        plan->points[i] = rev[n - 1 - i];
+        if (i > 0) {
+            plan->length_cm += hypotf(plan->points[i].x - plan->points[i - 1].x,
+                                      plan->points[i].y - plan->points[i - 1].y);
+        }
+    }
+    return GRID_PLAN_OK;
+}
+
+// ====================  A*  ====================
+
+grid_plan_result_t grid_planner_plan(const grid_obstacle_t *obstacles, uint8_t count,
+                                     path_point_t start, path_point_t goal, grid_plan_t *plan) {
+    uint8_t start_col, start_row;
+
+    plan->count = 0;
+    plan->length_cm = 0.0f;
+    plan->expanded = 0;
+    plan->open_peak = 0;
+
+    plan_obstacles = obstacles;
+    plan_obstacle_count = (count > GRID_PLANNER_MAX_OBSTACLES) ? GRID_PLANNER_MAX_OBSTACLES : count;
+    memset(cell_state, 0, sizeof(cell_state));
+    for (uint8_t i = 0; i < plan_obstacle_count; i++) {
+        rasterize_obstacle(&obstacles[i]);
+    }
+
+    if (!point_to_cell(start, &start_col, &start_row) || !point_to_cell(goal, &goal_col, &goal_row)) {
+        return GRID_PLAN_BAD_ENDPOINT;
+    }
+    uint16_t start_idx = cell_index(start_col, start_row);
+    uint16_t goal_idx = cell_index(goal_col, goal_row);
+    if ((cell_state[start_idx] | cell_state[goal_idx]) & CELL_BLOCKED) {
+        return GRID_PLAN_BAD_ENDPOINT;
+    }
+
+    heap_len = 0;
+    cell_g[start_idx] = 0;
+    cell_state[start_idx] |= CELL_OPEN;
+    heap_place(heap_len++, start_idx);
+
+    while (heap_len > 0) {
+        uint16_t cur = heap_pop();
+        cell_state[cur] = (uint8_t)((cell_state[cur] & ~CELL_OPEN) | CELL_CLOSED);
+        plan->expanded++;
+        if (cur == goal_idx) {
+            return build_waypoints(start_idx, goal_idx, start, goal, plan);
+        }
+
+        int16_t col = (int16_t)(cur % GRID_PLANNER_COLS), row = (int16_t)(cur / GRID_PLANNER_COLS);
+        for (uint8_t d = 0; d < 8; d++) {
+            int16_t nc = col + dir_dx[d], nr = row + dir_dy[d];
+            if (nc < 0 || nc >= GRID_PLANNER_COLS || nr < 0 || nr >= GRID_PLANNER_ROWS) {
+                continue;
+            }
+            uint16_t next = cell_index((uint8_t)nc, (uint8_t)nr);
+            if (cell_state[next] & (CELL_BLOCKED | CELL_CLOSED)) {
+                continue;
+            }
+            // 斜走时两侧直邻格都须空闲, 不擦着圆柱切角
+            if (d >= 4 && ((cell_state[cell_index((uint8_t)nc, (uint8_t)row)] |
+                            cell_state[cell_index((uint8_t)col, (uint8_t)nr)]) & CELL_BLOCKED)) {
+                continue;
+            }
+            uint16_t g = (uint16_t)(cell_g[cur] + ((d < 4) ? COST_STRAIGHT : COST_DIAGONAL));
+            if (cell_state[next] & CELL_OPEN) {
+                if (g >= cell_g[next]) {
+                    continue;
+                }
+                cell_g[next] = g;
+                cell_state[next] = (uint8_t)((cell_state[next] & ~CELL_PARENT_MASK) | d);
+                heap_sift_up(heap_pos[next]);
+            } else {
+                if (heap_len >= GRID_PLANNER_OPEN_MAX) {
+                    return GRID_PLAN_OPEN_FULL;
+                }
+                cell_g[next] = g;
+                cell_state[next] = (uint8_t)(cell_state[next] | CELL_OPEN | d);
+                heap_place(heap_len, next);
+                heap_sift_up(heap_len++);
+                if (heap_len > plan->open_peak) {
+                    plan->open_peak = heap_len;
+                }
+            }
+        }
+    }
+    return GRID_PLAN_NO_PATH;
+}
+
+const char *grid_planner_result_string(grid_plan_result_t result) {
+    switch (result) {
+        case GRID_PLAN_OK:
+            return "OK";
+        case GRID_PLAN_BAD_ENDPOINT:
+            return "Bad endpoint";
+        case GRID_PLAN_NO_PATH:
+            return "No path";
+        case GRID_PLAN_TOO_MANY_WAYPOINTS:
+            return "Too many waypoints";
+        case GRID_PLAN_OPEN_FULL:
+            return "Open list full";
+        default:
+            return "Unknown";
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef __GRID_PLANNER_H__
+#define __GRID_PLANNER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "path_follower.h"
+
+/*
+ * 圆柱场地上的栅格路径规划 (A*).
+ *
+ * 场地按 GRID_PLANNER_CELL_CM 划成 COLS x ROWS 的栅格, 格子中心离某个圆柱的距离小于该颜色的
+ * 避让半径 (圆柱半径 + 半车宽 + 余量) 即视为占用. 在 8 邻域上做 A* (直走代价 10, 斜走 14,
+ * 八方向距离启发, 斜走不切占用格的角), 得到的格子路径再按连续几何做视线化简 (线段离每个圆柱
+ * 不小于避让半径减半个格子), 输出可直接交给 car_add_path() 的折线航点.
+ *
+ * 坐标与 pose_estimator / path_follower 一致: cm, 发车点为原点, x 沿发车方向, y 向左.
+ *
+ * 内存: 全部工作区为静态数组, 每格 g 值 2B + 堆位置 1B + 状态 1B, 开放堆另按 GRID_PLANNER_OPEN_MAX
+ * 项各 2B, 共 GRID_PLANNER_RAM_BYTES (默认 34x21 格约 3.3KB), 与障碍物数量无关.
+ * 开放堆只存边界上的格子, 随机布局下峰值约 120, 超过 GRID_PLANNER_OPEN_MAX 时返回 GRID_PLAN_OPEN_FULL.
+ * 时间: 每个格子至多展开一次, 每次展开至多 8 次松弛, 每次堆操作 O(log N), 最坏情况
+ * 与布局无关地受格子数限制; expanded 字段给出实际展开数.
+ */
+
+#define GRID_PLANNER_CELL_CM            10
+#define GRID_PLANNER_ORIGIN_X_CM        (-10)       // 栅格左下角
+#define GRID_PLANNER_ORIGIN_Y_CM        (-80)
+#define GRID_PLANNER_COLS               34          // x: -10 ~ 330
+#define GRID_PLANNER_ROWS               21          // y: -80 ~ 130
+#define GRID_PLANNER_CELLS              (GRID_PLANNER_COLS * GRID_PLANNER_ROWS)
+
+#define GRID_PLANNER_MAX_OBSTACLES      12
+#define GRID_PLANNER_MAX_WAYPOINTS      16
+
+// 各颜色圆柱的避让半径: 圆柱半径 5cm + 半车宽 12cm + 余量
+#define GRID_PLANNER_CLEARANCE_WHITE_CM 20
+#define GRID_PLANNER_CLEARANCE_BLACK_CM 20
+
+#define GRID_PLANNER_OPEN_MAX           255         // 开放堆容量, 堆位置按 uint8_t 存, 不得超过 255
+#define GRID_PLANNER_RAM_BYTES          (GRID_PLANNER_CELLS * 4 + GRID_PLANNER_OPEN_MAX * 2)
+
+typedef enum {
+    GRID_COLOR_WHITE = 0,           // 与摄像头颜色编码一致: 0 白, 1 黑
+    GRID_COLOR_BLACK = 1,
+    GRID_COLOR_COUNT,
+} grid_color_t;
+
+typedef struct {
+    int16_t x_cm;
+    int16_t y_cm;
+    uint8_t color;                  // grid_color_t
+} grid_obstacle_t;
+
+typedef enum {
+    GRID_PLAN_OK = 0,
+    GRID_PLAN_BAD_ENDPOINT,         // 起点或终点在场地外 / 被圆柱占用
+    GRID_PLAN_NO_PATH,
+    GRID_PLAN_TOO_MANY_WAYPOINTS,   // 化简后航点仍超过 GRID_PLANNER_MAX_WAYPOINTS
+    GRID_PLAN_OPEN_FULL,            // 开放堆超过 GRID_PLANNER_OPEN_MAX
+} grid_plan_result_t;
+
+typedef struct {
+    path_point_t points[GRID_PLANNER_MAX_WAYPOINTS];    // 起点, 拐点..., 终点
+    uint8_t count;
+    float length_cm;
+    uint16_t expanded;              // 展开的格子数
+    uint16_t open_peak;             // 开放堆最大长度
+} grid_plan_t;
+
+/**
+ * @brief 在给定的圆柱布局下规划从 start 到 goal 的折线路线
+ * @param obstacles 圆柱列表, 超过 GRID_PLANNER_MAX_OBSTACLES 的部分忽略
+ * @param plan 输出; 航点保存在 plan 内, 交给 car_add_path() 时 plan 须在行驶期间保持有效
+ * @note 不可重入 (共用静态工作区)
+ */
+grid_plan_result_t grid_planner_plan(const grid_obstacle_t *obstacles, uint8_t count,
+                                     path_point_t start, path_point_t goal, grid_plan_t *plan);
+
+/**
+ * @brief 上一次规划的占用栅格中 (col, row) 是否被占用 (调试 / 测试用)
+ */
+bool grid_planner_cell_blocked(uint8_t col, uint8_t row);
+
+const char *grid_planner_result_string(grid_plan_result_t result);
+
+#endif // __GRID_PLANNER_H__
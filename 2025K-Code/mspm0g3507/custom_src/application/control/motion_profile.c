@@ -0,0 +1,166 @@
+#include "motion_profile.h"
+#include <math.h>
+
+#define MOTION_PROFILE_BISECT_ITER  20
+
+/**
+ * @brief 速度改变 dv (≥ 0) 所需的变速段时长
+ * @param t_j 输出加加速度斜坡时长; 达不到 a_max 时为三角形加速度, 总时长 2·t_j
+ */
+static float ramp_time(const motion_limits_t *lim, float dv, float *t_j) {
+    if (dv * lim->j_max < lim->a_max * lim->a_max) {
+        *t_j = sqrtf(dv / lim->j_max);
+        return 2.0f * (*t_j);
+    }
+    *t_j = lim->a_max / lim->j_max;
+    return *t_j + dv / lim->a_max;
+}
+
+// 以 v_peak 为最高速度时加速段 + 减速段的位移
+static float ramps_distance(const motion_limits_t *lim, float v_start, float v_peak, float v_end) {
+    float tj;
+    float ta = ramp_time(lim, v_peak - v_start, &tj);
+    float td = ramp_time(lim, v_peak - v_end, &tj);
+    return 0.5f * (v_start + v_peak) * ta + 0.5f * (v_peak + v_end) * td;
+}
+
+static void motion_profile_plan(motion_profile_t *mp, float h) {
+    const motion_limits_t *lim = &mp->lim;
+    float v0 = mp->v_start, v1 = mp->v_end;
+    float vp;
+
+    if (v1 > v0 && ramps_distance(lim, v0, v1, v1) > h) {
+        // 位移不够加速到终点速度: 降低终点速度
+        float lo = v0, hi = v1;
+        for (int i = 0; i < MOTION_PROFILE_BISECT_ITER; i++) {
+            float mid = 0.5f * (lo + hi);
+            if (ramps_distance(lim, v0, mid, mid) > h) {
+                hi = mid;
+            } else {
+                lo = mid;
+            }
+        }
+        v1 = mp->v_end = lo;
+    }
+
+    float vp_min = (v0 > v1) ? v0 : v1;
+    if (ramps_distance(lim, v0, lim->v_max, v1) <= h) {
+        vp = lim->v_max;
+    } else if (ramps_distance(lim, v0, vp_min, v1) < h) {
+        float lo = vp_min, hi = lim->v_max;
+        for (int i = 0; i < MOTION_PROFILE_BISECT_ITER; i++) {
+            float mid = 0.5f * (lo + hi);
+            if (ramps_distance(lim, v0, mid, v1) > h) {
+                hi = mid;
+            } else {
+                lo = mid;
+            }
+        }
+        vp = lo;
+    } else {
+        // 从 v_start 全力减速也会越过终点
+        vp = vp_min;
+    }
+
+    mp->v_peak = vp;
+    mp->t_a = ramp_time(lim, vp - v0, &mp->t_j1);
+    mp->t_d = ramp_time(lim, vp - v1, &mp->t_j2);
+    float rest = h - ramps_distance(lim, v0, vp, v1);
+    mp->t_v = (rest > 0.0f && vp > 0.0f) ? rest / vp : 0.0f;
+    mp->t_total = mp->t_a + mp->t_v + mp->t_d;
+}
+
+/**
+ * @brief t 时刻沿运动方向的位置/速度/加速度
+ */
+static void motion_profile_eval(const motion_profile_t *mp, float t, float *q, float *v, float *a) {
+    float j = mp->lim.j_max;
+    float v0 = mp->v_start, vp = mp->v_peak, v1 = mp->v_end;
+    float ta = mp->t_a, tj1 = mp->t_j1, tv = mp->t_v, td = mp->t_d, tj2 = mp->t_j2;
+    float qa = 0.5f * (v0 + vp) * ta;           // 加速段末位置
+    float qv = qa + vp * tv;                    // 匀速段末位置
+    float q_end = qv + 0.5f * (vp + v1) * td;
+
+    if (t < ta) {
+        float alim = j * tj1;
+        if (t < tj1) {
+            *q = v0 * t + j * t * t * t / 6.0f;
+            *v = v0 + 0.5f * j * t * t;
+            *a = j * t;
+        } else if (t < ta - tj1) {
+            *q = v0 * t + alim / 6.0f * (3.0f * t * t - 3.0f * tj1 * t + tj1 * tj1);
+            *v = v0 + alim * (t - 0.5f * tj1);
+            *a = alim;
+        } else {
+            float r = ta - t;
+            *q = qa - vp * r + j * r * r * r / 6.0f;
+            *v = vp - 0.5f * j * r * r;
+            *a = j * r;
+        }
+    } else if (t < ta + tv) {
+        *q = qa + vp * (t - ta);
+        *v = vp;
+        *a = 0.0f;
+    } else if (t < mp->t_total) {
+        float s = t - ta - tv;
+        float alim = j * tj2;
+        if (s < tj2) {
+            *q = qv + vp * s - j * s * s * s / 6.0f;
+            *v = vp - 0.5f * j * s * s;
+            *a = -j * s;
+        } else if (s < td - tj2) {
+            *q = qv + vp * s - alim / 6.0f * (3.0f * s * s - 3.0f * tj2 * s + tj2 * tj2);
+            *v = vp - alim * (s - 0.5f * tj2);
+            *a = -alim;
+        } else {
+            float r = mp->t_total - t;
+            *q = q_end - v1 * r - j * r * r * r / 6.0f;
+            *v = v1 + 0.5f * j * r * r;
+            *a = -j * r;
+        }
+    } else {
+        *q = q_end + v1 * (t - mp->t_total);
+        *v = v1;
+        *a = 0.0f;
+    }
+}
+
+void motion_profile_start(motion_profile_t *mp, const motion_limits_t *lim, float distance,
+                          float v_start, float v_end) {
+    mp->lim = *lim;
+    mp->distance = distance;
+    mp->dir = (distance < 0.0f) ? -1 : 1;
+    mp->v_start = (v_start > 0.0f) ? fminf(v_start, lim->v_max) : 0.0f;
+    mp->v_end = (v_end > 0.0f) ? fminf(v_end, lim->v_max) : 0.0f;
+    motion_profile_plan(mp, fabsf(distance));
+
+    mp->t = 0.0f;
+    mp->pos = 0.0f;
+    mp->vel = mp->dir * mp->v_start;
+    mp->acc = 0.0f;
+    mp->done = (mp->t_total <= 0.0f);
+}
+
+void motion_profile_step(motion_profile_t *mp) {
+    float q, v, a;
+
+    mp->t += mp->lim.dt;
+    motion_profile_eval(mp, mp->t, &q, &v, &a);
+    if (mp->t >= mp->t_total) {
+        mp->done = true;
+    }
+    mp->pos = mp->dir * q;
+    mp->vel = mp->dir * v;
+    mp->acc = mp->dir * a;
+}
+
+float motion_profile_stop_speed(const motion_limits_t *lim, float distance) {
+    float d = fabsf(distance);
+    float k = lim->a_max * lim->a_max / lim->j_max;
+    // 三角形加速度: v·sqrt(v/J) = d; 梯形: v/2·(A/J + v/A) = d
+    float v = cbrtf(lim->j_max * d * d);
+    if (v > k) {
+        v = 0.5f * (-k + sqrtf(k * k + 8.0f * lim->a_max * d));
+    }
+    return (v < lim->v_max) ? v : lim->v_max;
+}
@@ -0,0 +1,72 @@
+#ifndef __MOTION_PROFILE_H__
+#define __MOTION_PROFILE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 限加加速度 (S 形, 7 段) 的一维运动曲线, 每个控制周期推进一步, 输出位置/速度/加速度设定值.
+ * 由位置环跟踪设定位置, 设定速度作为速度前馈.
+ *
+ * 起步时一次规划: 加速段 v_start -> v_peak, 匀速段, 减速段 v_peak -> v_end; 两个变速段
+ * 各由 "加加速度 ±j_max 斜坡 + 恒加速度" 组成, 速度差不足以达到 a_max 时退化为三角形加速度.
+ * 位移不够升到 v_max 时二分 v_peak. 之后每拍按时间计算解析式, 不累积误差.
+ * 终点速度不为 0 时用于与下一段衔接: 结束后位置按终点速度继续推进, 等待下一段接手.
+ */
+
+typedef struct {
+    float v_max;                    // 单位/s
+    float a_max;                    // 单位/s²
+    float j_max;                    // 单位/s³
+    float dt;                       // 调用周期, s
+} motion_limits_t;
+
+typedef struct {
+    motion_limits_t lim;
+    float distance;                 // 本段位移 (带符号)
+    float v_start;                  // 以下均为沿运动方向的大小
+    float v_peak;
+    float v_end;
+    int8_t dir;                     // +1 / -1
+
+    // 规划结果, s
+    float t_j1;                     // 加速段加加速度斜坡时长
+    float t_a;                      // 加速段总时长
+    float t_v;                      // 匀速段
+    float t_j2;
+    float t_d;                      // 减速段总时长
+    float t_total;
+    float t;                        // 已推进的时间
+
+    // 设定值 (带符号, 起点为 0)
+    float pos;
+    float vel;
+    float acc;
+    bool done;
+} motion_profile_t;
+
+/**
+ * @brief 开始一段运动
+ * @param distance 位移, 可为负
+ * @param v_start 起点速度, 沿运动方向的大小 (例如上一段的终点速度)
+ * @param v_end 终点速度, 沿运动方向的大小
+ * @note 位移不足以从 v_start 降到 v_end 时按最短减速规划, 设定位置会越过终点
+ */
+void motion_profile_start(motion_profile_t *mp, const motion_limits_t *lim, float distance,
+                          float v_start, float v_end);
+
+/**
+ * @brief 推进一个周期, 更新 pos/vel/acc
+ */
+void motion_profile_step(motion_profile_t *mp);
+
+/**
+ * @brief 能在 distance 内减速到 0 的最大起始速度, 用于规划两段之间的衔接速度
+ */
+float motion_profile_stop_speed(const motion_limits_t *lim, float distance);
+
+static inline bool motion_profile_done(const motion_profile_t *mp) {
+    return mp->done;
+}
+
+#endif // __MOTION_PROFILE_H__
@@ -0,0 +1,157 @@
+#include "path_follower.h"
+#include <math.h>
+
+#define PF_PI       3.14159265359f
+
+void path_follower_init(path_follower_t *pf, const path_point_t *points, uint8_t count,
+                        float speed_cmps, float lookahead_cm, float wheel_base_cm, float dt) {
+    pf->speed_cmps = speed_cmps;
+    pf->lookahead_cm = lookahead_cm;
+    pf->accel_cmps2 = 300.0f;
+    pf->lateral_accel_cmps2 = 250.0f;
+    pf->min_speed_cmps = 8.0f;
+    pf->max_wheel_cmps = 76.0f;
+    pf->spin_angle_deg = 75.0f;
+    pf->spin_rate_dps = 180.0f;
+    pf->goal_tolerance_cm = 1.5f;
+    pf->wheel_base_cm = wheel_base_cm;
+    pf->dt = dt;
+
+    pf->points = points;
+    pf->count = count;
+    pf->segment = 0;
+    pf->v = 0.0f;
+    pf->curvature = 0.0f;
+    pf->target_x = (count > 0) ? points[count - 1].x : 0.0f;
+    pf->target_y = (count > 0) ? points[count - 1].y : 0.0f;
+    pf->remaining_cm = 0.0f;
+    pf->done = (count < 2);
+}
+
+static float segment_length(const path_follower_t *pf, uint8_t i) {
+    return hypotf(pf->points[i + 1].x - pf->points[i].x, pf->points[i + 1].y - pf->points[i].y);
+}
+
+/**
+ * @brief (x, y) 在第 i 段上的投影参数 t (0~1 为段内) 和到投影点 (限制在段内) 的距离
+ */
+static float project(const path_follower_t *pf, uint8_t i, float x, float y, float *dist) {
+    const path_point_t *a = &pf->points[i], *b = &pf->points[i + 1];
+    float ex = b->x - a->x, ey = b->y - a->y;
+    float len2 = ex * ex + ey * ey;
+    float t = (len2 > 0.0f) ? ((x - a->x) * ex + (y - a->y) * ey) / len2 : 1.0f;
+    float tc = (t < 0.0f) ? 0.0f : (t > 1.0f ? 1.0f : t);
+    *dist = hypotf(x - (a->x + tc * ex), y - (a->y + tc * ey));
+    return t;
+}
+
+// 从第 i 段参数 t 处沿路径前进 s 的点; 最后一段沿原方向延长, 终点附近追踪点不收缩到车上
+static path_point_t point_ahead(const path_follower_t *pf, uint8_t i, float t, float s) {
+    for (;;) {
+        float len = segment_length(pf, i);
+        float left = (1.0f - t) * len;
+        if (s <= left || i + 2 >= pf->count) {
+            float u = (len > 0.0f) ? t + s / len : 1.0f;
+            path_point_t p = {
+                pf->points[i].x + u * (pf->points[i + 1].x - pf->points[i].x),
+                pf->points[i].y + u * (pf->points[i + 1].y - pf->points[i].y),
+            };
+            return p;
+        }
+        s -= left;
+        i++;
+        t = 0.0f;
+    }
+}
+
+static bool path_follower_finish(path_follower_t *pf, float *left_cmps, float *right_cmps) {
+    pf->done = true;
+    pf->v = 0.0f;
+    *left_cmps = 0.0f;
+    *right_cmps = 0.0f;
+    return true;
+}
+
+bool path_follower_step(path_follower_t *pf, float x, float y, float theta,
+                        float *left_cmps, float *right_cmps) {
+    if (pf->done) {
+        return path_follower_finish(pf, left_cmps, right_cmps);
+    }
+
+    // 1. 当前线段: 越过末端或离下一段更近时前进
+    float dist, next_dist;
+    float t = project(pf, pf->segment, x, y, &dist);
+    while (pf->segment + 2 < pf->count) {
+        float t_next = project(pf, pf->segment + 1, x, y, &next_dist);
+        if (t < 1.0f && next_dist >= dist) {
+            break;
+        }
+        pf->segment++;
+        t = t_next;
+        dist = next_dist;
+    }
+
+    // 2. 剩余路程; 在最后一段上到达或越过终点即结束 (闭合路径的终点与起点重合)
+    const path_point_t *goal = &pf->points[pf->count - 1];
+    float tc = (t < 0.0f) ? 0.0f : t;
+    float remaining = (1.0f - tc) * segment_length(pf, pf->segment);
+    for (uint8_t i = pf->segment + 1; i + 1 < pf->count; i++) {
+        remaining += segment_length(pf, i);
+    }
+    pf->remaining_cm = remaining;
+    bool last = (pf->segment + 2 >= pf->count);
+    if (last && (hypotf(goal->x - x, goal->y - y) <= pf->goal_tolerance_cm || t >= 1.0f)) {
+        return path_follower_finish(pf, left_cmps, right_cmps);
+    }
+
+    // 3. 追踪点 (车体坐标系)
+    path_point_t target = point_ahead(pf, pf->segment, tc, pf->lookahead_cm);
+    pf->target_x = target.x;
+    pf->target_y = target.y;
+    float c = cosf(theta), s = sinf(theta);
+    float dx = target.x - x, dy = target.y - y;
+    float xl = c * dx + s * dy;
+    float yl = -s * dx + c * dy;
+    float ld2 = xl * xl + yl * yl;
+    float alpha = atan2f(yl, xl);
+    float half_b = 0.5f * pf->wheel_base_cm;
+
+    if (fabsf(alpha) > pf->spin_angle_deg * (PF_PI / 180.0f)) {
+        // 追踪点在侧后方: 原地转向, 转到位后重新起步
+        float w = copysignf(pf->spin_rate_dps * (PF_PI / 180.0f), alpha);
+        pf->v = 0.0f;
+        pf->curvature = 0.0f;
+        *left_cmps = -w * half_b;
+        *right_cmps = w * half_b;
+        return false;
+    }
+
+    // 4. 速度: 加速度、弯道、终点三者取小
+    pf->curvature = (ld2 > 1e-6f) ? 2.0f * yl / ld2 : 0.0f;
+    float v = pf->v + pf->accel_cmps2 * pf->dt;
+    if (v > pf->speed_cmps) {
+        v = pf->speed_cmps;
+    }
+    float k = fabsf(pf->curvature);
+    if (k > 1e-6f) {
+        v = fminf(v, sqrtf(pf->lateral_accel_cmps2 / k));
+    }
+    v = fminf(v, sqrtf(2.0f * pf->accel_cmps2 * remaining));
+    if (v < pf->min_speed_cmps) {
+        v = pf->min_speed_cmps;
+    }
+
+    float w = v * pf->curvature;
+    float left = v - w * half_b, right = v + w * half_b;
+    float peak = fmaxf(fabsf(left), fabsf(right));
+    if (peak > pf->max_wheel_cmps) {
+        float scale = pf->max_wheel_cmps / peak;
+        left *= scale;
+        right *= scale;
+        v *= scale;
+    }
+    pf->v = v;
+    *left_cmps = left;
+    *right_cmps = right;
+    return false;
+}
@@ -0,0 +1,76 @@
+#ifndef __PATH_FOLLOWER_H__
+#define __PATH_FOLLOWER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 纯追踪 (pure pursuit) 路径跟踪: 沿折线航点行驶, 每拍由位姿给出左右轮目标速度.
+ *
+ * 每拍先把车体投影到当前线段上 (越过线段末端或离下一段更近时换到下一段),
+ * 再沿路径向前取 lookahead_cm 处的点作为追踪点; 追踪点在车体坐标系中为 (xl, yl),
+ *     曲率 κ = 2·yl / (xl² + yl²), ω = v·κ, 左右轮 v ∓ ω·b/2
+ * 拐角因此被切成圆弧, 切角量随前视距离增大. 最后一段沿原方向延长取追踪点, 到终点时车头与末段对齐.
+ * 追踪点偏离车头超过 spin_angle_deg 时原地转向.
+ *
+ * 速度: 按 accel 起步, 受弯道横向加速度 v ≤ sqrt(a_lat / |κ|) 和到终点的剩余路程
+ * v ≤ sqrt(2·accel·s) 限制, 最低 min_speed_cmps. 到终点距离不超过 goal_tolerance_cm
+ * 或越过终点时结束.
+ *
+ * 坐标与 pose_estimator 一致: cm, rad, 逆时针为正.
+ */
+
+typedef struct {
+    float x;
+    float y;
+} path_point_t;
+
+typedef struct {
+    // 参数 - 可直接设置
+    float speed_cmps;               // 巡航速度
+    float lookahead_cm;             // 前视距离 (沿路径)
+    float accel_cmps2;              // 起步加速度 / 终点减速度
+    float lateral_accel_cmps2;      // 弯道横向加速度上限
+    float min_speed_cmps;
+    float max_wheel_cmps;           // 单轮速度上限, 超过时两轮等比缩小
+    float spin_angle_deg;           // 追踪点方位超过此角度时原地转向
+    float spin_rate_dps;
+    float goal_tolerance_cm;
+    float wheel_base_cm;
+    float dt;
+
+    // 路径
+    const path_point_t *points;
+    uint8_t count;
+
+    // 运行状态
+    uint8_t segment;                // 当前线段 points[segment] -> points[segment + 1]
+    float v;                        // 当前车体速度指令
+    float curvature;
+    float target_x;                 // 追踪点 (调试用)
+    float target_y;
+    float remaining_cm;             // 沿路径到终点的距离
+    bool done;
+} path_follower_t;
+
+/**
+ * @brief 初始化并开始跟踪一条路径
+ * @param points 航点, 第一个点为起点 (通常是小车当前位置); 数组在跟踪期间须保持有效
+ * @param count 航点数, ≥ 2
+ * @note 其余参数取默认值 (加速度 300cm/s², 横向加速度 250cm/s², 最低 8cm/s, 单轮 76cm/s,
+ *       偏离 75° 以上原地转向, 终点容差 1.5cm), 可在调用后直接修改
+ */
+void path_follower_init(path_follower_t *pf, const path_point_t *points, uint8_t count,
+                        float speed_cmps, float lookahead_cm, float wheel_base_cm, float dt);
+
+/**
+ * @brief 推进一拍
+ * @param theta 航向, rad
+ * @param left_cmps 输出左轮目标速度
+ * @param right_cmps 输出右轮目标速度
+ * @return true 表示已到达终点 (输出为 0)
+ */
+bool path_follower_step(path_follower_t *pf, float x, float y, float theta,
+                        float *left_cmps, float *right_cmps);
+
+#endif // __PATH_FOLLOWER_H__
@@ -0,0 +1,155 @@
+#include "pid_autotune.h"
+#include <math.h>
+
+#define AUTOTUNE_PI                 3.14159265f
+#define AUTOTUNE_MIN_AMPLITUDE      1e-6f
+
+// 整定规则系数: Kp = kp·Ku, Ti = ti·Tu, Td = td·Tu; ti 为 0 表示不用积分
+static const struct {
+    float kp;
+    float ti;
+    float td;
+} tune_rules[PID_TUNE_RULE_COUNT] = {
+    [PID_TUNE_RULE_ZN_P]           = { 0.50f,  0.0f,   0.0f    },
+    [PID_TUNE_RULE_ZN_PID]         = { 0.60f,  0.50f,  0.125f  },
+    [PID_TUNE_RULE_ZN_PI]          = { 0.45f,  0.833f, 0.0f    },
+    [PID_TUNE_RULE_ZN_PD]          = { 0.80f,  0.0f,   0.125f  },
+    [PID_TUNE_RULE_TYREUS_LUYBEN]  = { 0.4545f, 2.20f, 0.1587f },
+    [PID_TUNE_RULE_NO_OVERSHOOT]   = { 0.20f,  0.50f,  0.333f  },
+};
+
+void PID_AutotuneInit(PID_Autotune_t *at, float setpoint, float relay_amplitude,
+                      float hysteresis, float sample_time_s) {
+    at->setpoint = setpoint;
+    at->relay_amplitude = relay_amplitude;
+    at->output_bias = 0.0f;
+    at->hysteresis = hysteresis;
+    at->sample_time_s = sample_time_s;
+    at->settle_cycles = 2;
+    at->measure_cycles = 4;
+    at->enable_bias_adapt = 0;
+    at->timeout_ms = 10000;
+
+    at->state = PID_AUTOTUNE_RUNNING;
+    at->relay_state = 0;            // 第一次调用时按误差符号决定
+    at->output = 0.0f;
+    at->ticks = 0;
+    at->rise_tick = 0;
+    at->fall_tick = 0;
+    at->rise_seen = 0;
+    at->peak_max = -INFINITY;
+    at->peak_min = INFINITY;
+    at->cycle_count = 0;
+    at->measured = 0;
+    at->amplitude_sum = 0.0f;
+    at->period_sum = 0.0f;
+
+    at->ku = 0.0f;
+    at->tu = 0.0f;
+}
+
+// 一个完整周期 (两次切到 +d 之间) 结束: 修正偏置, 累计振幅与周期
+static void PID_AutotuneCycleDone(PID_Autotune_t *at) {
+    uint32_t period = at->ticks - at->rise_tick;
+    uint32_t high = at->fall_tick - at->rise_tick;
+    float amplitude = 0.5f * (at->peak_max - at->peak_min);
+
+    at->cycle_count++;
+    if (at->enable_bias_adapt && period > 0) {
+        // 一个周期内继电器输出的平均值就是维持设定值所需的稳态输出
+        at->output_bias += at->relay_amplitude * (2.0f * (float)high - (float)period) / (float)period;
+    }
+    if (at->cycle_count <= at->settle_cycles) {
+        return;
+    }
+
+    at->amplitude_sum += amplitude;
+    at->period_sum += (float)period;
+    at->measured++;
+    if (at->measured < at->measure_cycles) {
+        return;
+    }
+
+    float a = at->amplitude_sum / at->measured;
+    if (a <= at->hysteresis || a < AUTOTUNE_MIN_AMPLITUDE) {
+        at->state = PID_AUTOTUNE_FAILED;
+        return;
+    }
+    at->ku = 4.0f * at->relay_amplitude / (AUTOTUNE_PI * sqrtf(a * a - at->hysteresis * at->hysteresis));
+    at->tu = at->period_sum / at->measured * at->sample_time_s;
+    at->state = PID_AUTOTUNE_DONE;
+}
+
+float PID_AutotuneStep(PID_Autotune_t *at, float feedback) {
+    if (at->state != PID_AUTOTUNE_RUNNING) {
+        at->output = at->output_bias;
+        return at->output;
+    }
+
+    at->ticks++;
+    float error = at->setpoint - feedback;
+
+    if (feedback > at->peak_max) {
+        at->peak_max = feedback;
+    }
+    if (feedback < at->peak_min) {
+        at->peak_min = feedback;
+    }
+
+    if (at->relay_state == 0) {
+        at->relay_state = (error >= 0.0f) ? 1 : -1;
+    } else if (at->relay_state > 0 && error < -at->hysteresis) {
+        at->relay_state = -1;
+        at->fall_tick = at->ticks;
+    } else if (at->relay_state < 0 && error > at->hysteresis) {
+        at->relay_state = 1;
+        if (at->rise_seen) {
+            PID_AutotuneCycleDone(at);
+        }
+        at->rise_seen = 1;
+        at->rise_tick = at->ticks;
+        at->peak_max = feedback;
+        at->peak_min = feedback;
+    }
+
+    if (at->state == PID_AUTOTUNE_RUNNING &&
+        (float)at->ticks * at->sample_time_s * 1000.0f > (float)at->timeout_ms) {
+        at->state = PID_AUTOTUNE_FAILED;
+    }
+    if (at->state != PID_AUTOTUNE_RUNNING) {
+        at->output = at->output_bias;
+        return at->output;
+    }
+
+    at->output = at->output_bias + at->relay_state * at->relay_amplitude;
+    return at->output;
+}
+
+PID_AutotuneState_e PID_AutotuneGetState(const PID_Autotune_t *at) {
+    return at->state;
+}
+
+int PID_TuneRuleGains(float ku, float tu, PID_TuneRule_e rule, float sample_time_s,
+                      float *kp, float *ki, float *kd) {
+    if (rule >= PID_TUNE_RULE_COUNT || ku <= 0.0f || tu <= 0.0f || sample_time_s <= 0.0f) {
+        return -1;
+    }
+
+    // 连续域 Kp/Ti/Td 换算成按次累加的积分、按次差分的微分
+    float p = tune_rules[rule].kp * ku;
+    float ti = tune_rules[rule].ti * tu;
+    float td = tune_rules[rule].td * tu;
+
+    *kp = p;
+    *ki = (ti > 0.0f) ? p * sample_time_s / ti : 0.0f;
+    *kd = p * td / sample_time_s;
+    return 0;
+}
+
+int PID_AutotuneGetGains(const PID_Autotune_t *at, PID_TuneRule_e rule, float sample_time_s,
+                         float *kp, float *ki, float *kd) {
+    if (at->state != PID_AUTOTUNE_DONE) {
+        return -1;
+    }
+    return PID_TuneRuleGains(at->ku, at->tu, rule, sample_time_s, kp, ki, kd);
+}
@@ -0,0 +1,101 @@
+#ifndef __PID_AUTOTUNE_H__
+#define __PID_AUTOTUNE_H__
+
+#include <stdint.h>
+
+/*
+ * 继电器反馈自整定 (Åström–Hägglund).
+ * 整定时用一个带回差的继电器代替环路里的 PID: 误差为正输出 bias + d, 为负输出 bias - d,
+ * 闭环会进入稳定的极限环. 测得反馈的振幅 a 和周期 Tu 后,
+ *     临界增益 Ku = 4d / (π·sqrt(a² - ε²))      (ε 为回差)
+ * 再按整定规则换算成 PID_Controller_t 使用的离散参数.
+ *
+ * 符号约定与 PID_Calculate(setpoint, feedback, pid) 相同, 继电器输出直接放在原来 PID 输出的位置.
+ * 非对称负载 (静摩擦、需要稳态输出的环) 下继电器上下半周不等长, 打开 enable_bias_adapt 后
+ * 每个周期按占空比修正 bias, 使振荡中心回到设定值.
+ */
+
+typedef enum {
+    PID_AUTOTUNE_IDLE = 0,
+    PID_AUTOTUNE_RUNNING,
+    PID_AUTOTUNE_DONE,
+    PID_AUTOTUNE_FAILED,        // 超时或没有形成极限环
+} PID_AutotuneState_e;
+
+// 整定规则, 系数见 pid_autotune.c
+typedef enum {
+    PID_TUNE_RULE_ZN_P = 0,         // Ziegler-Nichols 纯比例
+    PID_TUNE_RULE_ZN_PID,           // Ziegler-Nichols 经典 PID
+    PID_TUNE_RULE_ZN_PI,            // Ziegler-Nichols PI
+    PID_TUNE_RULE_ZN_PD,            // PD, 用于对象自带积分的位置/角度环
+    PID_TUNE_RULE_TYREUS_LUYBEN,    // 比 ZN 保守, 超调小
+    PID_TUNE_RULE_NO_OVERSHOOT,     // ZN "无超调" 变体
+    PID_TUNE_RULE_COUNT,
+} PID_TuneRule_e;
+
+typedef struct {
+    // 激励参数 - 可直接设置
+    float setpoint;             // 设定值
+    float relay_amplitude;      // 继电器幅值 d
+    float output_bias;          // 继电器中心 (自动修正时为初值)
+    float hysteresis;           // 回差 ε, 应大于反馈噪声
+    float sample_time_s;        // 调用周期
+    uint8_t settle_cycles;      // 起振阶段丢弃的周期数
+    uint8_t measure_cycles;     // 参与平均的周期数
+    uint8_t enable_bias_adapt;  // 偏置自动修正使能
+    uint32_t timeout_ms;        // 超时 (按调用次数 × sample_time_s 计)
+
+    // 运行状态 (自动更新)
+    PID_AutotuneState_e state;
+    int8_t relay_state;         // +1 / -1
+    float output;
+    uint32_t ticks;
+    uint32_t rise_tick;         // 上一次切到 +d 的拍数
+    uint32_t fall_tick;         // 上一次切到 -d 的拍数
+    uint8_t rise_seen;
+    float peak_max;
+    float peak_min;
+    uint8_t cycle_count;
+    uint8_t measured;
+    float amplitude_sum;
+    float period_sum;
+
+    // 结果
+    float ku;                   // 临界增益 (输出单位 / 反馈单位)
+    float tu;                   // 临界周期, 秒
+} PID_Autotune_t;
+
+/**
+ * @brief 初始化并开始一次整定
+ * @param setpoint 振荡中心
+ * @param relay_amplitude 继电器幅值, 取能激出明显振荡又不饱和执行器的值
+ * @param hysteresis 回差
+ * @param sample_time_s 之后 PID_AutotuneStep 的调用周期
+ * @note 其余参数取默认值 (起振 2 周期、测量 4 周期、偏置 0 不修正、超时 10s), 可在调用后直接修改
+ */
+void PID_AutotuneInit(PID_Autotune_t *at, float setpoint, float relay_amplitude,
+                      float hysteresis, float sample_time_s);
+
+/**
+ * @brief 输入一次反馈, 返回继电器输出
+ * @note 结束后 (DONE/FAILED) 返回 output_bias
+ */
+float PID_AutotuneStep(PID_Autotune_t *at, float feedback);
+
+PID_AutotuneState_e PID_AutotuneGetState(const PID_Autotune_t *at);
+
+/**
+ * @brief 按整定规则给出 PID_PositionCalculate 使用的离散参数
+ * @param sample_time_s 目标 PID 的计算周期 (积分按次累加, 微分按次差分)
+ * @return 0 成功, -1 整定未完成或规则无效
+ */
+int PID_AutotuneGetGains(const PID_Autotune_t *at, PID_TuneRule_e rule, float sample_time_s,
+                         float *kp, float *ki, float *kd);
+
+/**
+ * @brief 由 Ku/Tu 直接换算, 供主机侧或记录下来的整定结果使用
+ */
+int PID_TuneRuleGains(float ku, float tu, PID_TuneRule_e rule, float sample_time_s,
+                      float *kp, float *ki, float *kd);
+
+#endif // __PID_AUTOTUNE_H__
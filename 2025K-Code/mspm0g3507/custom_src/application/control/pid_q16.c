@@ -0,0 +1,276 @@
+#include "pid_q16.h"
+
+#define Q16_ANTI_WINDUP_DECAY   Q16(0.95)   // 与浮点版本的 integral *= 0.95f 对应
+
+static inline q16_t q16_abs(q16_t x) {
+    return (x < 0) ? -x : x;
+}
+
+// PID控制器初始化 - 默认值与 PID_Init() 相同
+void PIDQ_Init(PIDQ_Controller_t *pid, PID_Type_e type) {
+    pid->Kp = 0;
+    pid->Ki = 0;
+    pid->Kd = 0;
+
+    pid->target = 0;
+    pid->feedback = 0;
+    pid->error = 0;
+    pid->last_error = 0;
+    pid->last_last_error = 0;
+
+    pid->integral = 0;
+    pid->integral_max = Q16(3000.0);
+    pid->integral_min = Q16(-3000.0);
+    pid->integral_separation_threshold = 0;
+
+    pid->output = 0;
+    pid->output_offset = 0;
+    pid->output_max = Q16(3000.0);
+    pid->output_min = Q16(-3000.0);
+    pid->last_output = 0;
+
+    pid->deadzone = 0;
+
+    pid->derivative_filter_alpha = Q16(0.7);
+    pid->last_derivative = 0;
+
+    pid->type = type;
+    pid->enable_integral_separation = 0;
+    pid->enable_integral_limit = 0;
+    pid->enable_output_limit = 0;
+    pid->enable_deadzone = 0;
+    pid->enable_anti_windup = 1;
+    pid->enable_derivative_filter = 1;
+    pid->first_run = 1;
+}
+
+/**
+ * @brief 按已整定好的浮点控制器配置定点控制器 (参数、限幅、开关, 不含运行状态)
+ */
+void PIDQ_InitFromFloat(PIDQ_Controller_t *pid, const PID_Controller_t *src) {
+    PIDQ_Init(pid, src->type);
+
+    pid->Kp = q16_from_float(src->Kp);
+    pid->Ki = q16_from_float(src->Ki);
+    pid->Kd = q16_from_float(src->Kd);
+    pid->integral_max = q16_from_float(src->integral_max);
+    pid->integral_min = q16_from_float(src->integral_min);
+    pid->integral_separation_threshold = q16_from_float(src->integral_separation_threshold);
+    pid->output_offset = q16_from_float(src->output_offset);
+    pid->output_max = q16_from_float(src->output_max);
+    pid->output_min = q16_from_float(src->output_min);
+    pid->deadzone = q16_from_float(src->deadzone);
+    pid->derivative_filter_alpha = q16_from_float(src->derivative_filter_alpha);
+
+    pid->enable_integral_separation = src->enable_integral_separation;
+    pid->enable_integral_limit = src->enable_integral_limit;
+    pid->enable_output_limit = src->enable_output_limit;
+    pid->enable_deadzone = src->enable_deadzone;
+    pid->enable_anti_windup = src->enable_anti_windup;
+    pid->enable_derivative_filter = src->enable_derivative_filter;
+}
+
+// 死区处理函数
+static q16_t PIDQ_DeadzoneProcess(q16_t error, const PIDQ_Controller_t *pid) {
+    if (!pid->enable_deadzone) {
+        return error;
+    }
+    if (q16_abs(error) < pid->deadzone) {
+        return 0;
+    }
+    return (error > 0) ? error - pid->deadzone : error + pid->deadzone;
+}
+
+// 积分分离检查
+static uint16_t PIDQ_IntegralSeparationCheck(q16_t error, const PIDQ_Controller_t *pid) {
+    if (!pid->enable_integral_separation) {
+        return 1;
+    }
+    return (q16_abs(error) < pid->integral_separation_threshold) ? 1 : 0;
+}
+
+// 抗积分饱和处理
+static void PIDQ_AntiWindupProcess(PIDQ_Controller_t *pid) {
+    if (!pid->enable_anti_windup || !pid->enable_output_limit) {
+        return;
+    }
+    if ((pid->output >= pid->output_max && pid->error > 0) ||
+        (pid->output <= pid->output_min && pid->error < 0)) {
+        pid->integral = q16_mul(pid->integral, Q16_ANTI_WINDUP_DECAY);
+    }
+}
+
+// 积分限幅处理
+static void PIDQ_IntegralLimitProcess(PIDQ_Controller_t *pid) {
+    if (!pid->enable_integral_limit) {
+        return;
+    }
+    if (pid->integral > pid->integral_max) {
+        pid->integral = pid->integral_max;
+    } else if (pid->integral < pid->integral_min) {
+        pid->integral = pid->integral_min;
+    }
+}
+
+// 输出限幅处理
+static void PIDQ_OutputLimitProcess(PIDQ_Controller_t *pid) {
+    if (!pid->enable_output_limit) {
+        return;
+    }
+    if (pid->output > pid->output_max) {
+        pid->output = pid->output_max;
+    } else if (pid->output < pid->output_min) {
+        pid->output = pid->output_min;
+    }
+}
+
+// 微分项滤波处理: alpha * d + (1 - alpha) * last = last + alpha * (d - last)
+static q16_t PIDQ_DerivativeFilter(q16_t derivative, PIDQ_Controller_t *pid) {
+    if (!pid->enable_derivative_filter) {
+        return derivative;
+    }
+    q16_t delta = q16_add_sat(derivative, -pid->last_derivative);
+    pid->last_derivative = q16_add_sat(pid->last_derivative, q16_mul(pid->derivative_filter_alpha, delta));
+    return pid->last_derivative;
+}
+
+// 位置式PID计算
+q16_t PIDQ_PositionCalculate(PIDQ_Controller_t *pid) {
+    q16_t proportional, integral, differential;
+
+    pid->error = PIDQ_DeadzoneProcess(q16_add_sat(pid->target, -pid->feedback), pid);
+
+    proportional = q16_mul(pid->Kp, pid->error);
+
+    if (PIDQ_IntegralSeparationCheck(pid->error, pid)) {
+        q16_t temp_output = q16_add_sat(q16_add_sat(proportional, q16_mul(pid->Ki, pid->integral)),
+                                        pid->output_offset);
+
+        if (!pid->enable_anti_windup ||
+            !((temp_output >= pid->output_max && pid->error > 0) ||
+              (temp_output <= pid->output_min && pid->error < 0))) {
+            pid->integral = q16_add_sat(pid->integral, pid->error);
+        }
+
+        PIDQ_IntegralLimitProcess(pid);
+    }
+    integral = q16_mul(pid->Ki, pid->integral);
+
+    q16_t raw_derivative = q16_mul(pid->Kd, q16_add_sat(pid->error, -pid->last_error));
+    differential = PIDQ_DerivativeFilter(raw_derivative, pid);
+
+    pid->output = q16_add_sat(q16_add_sat(proportional, integral),
+                              q16_add_sat(differential, pid->output_offset));
+
+    PIDQ_OutputLimitProcess(pid);
+    PIDQ_AntiWindupProcess(pid);
+
+    pid->last_error = pid->error;
+    return pid->output;
+}
+
+// 增量式PID计算
+q16_t PIDQ_IncrementCalculate(PIDQ_Controller_t *pid) {
+    q16_t delta_output;
+    q16_t proportional_delta, integral_delta, differential_delta;
+
+    pid->error = PIDQ_DeadzoneProcess(q16_add_sat(pid->target, -pid->feedback), pid);
+
+    proportional_delta = q16_mul(pid->Kp, q16_add_sat(pid->error, -pid->last_error));
+
+    if (PIDQ_IntegralSeparationCheck(pid->error, pid)) {
+        integral_delta = q16_mul(pid->Ki, pid->error);
+    } else {
+        integral_delta = 0;
+    }
+
+    // e(k) - 2e(k-1) + e(k-2)
+    q16_t error_diff2 = q16_add_sat(q16_add_sat(pid->error, pid->last_last_error),
+                                    q16_add_sat(-pid->last_error, -pid->last_error));
+    differential_delta = PIDQ_DerivativeFilter(q16_mul(pid->Kd, error_diff2), pid);
+
+    delta_output = q16_add_sat(q16_add_sat(proportional_delta, integral_delta), differential_delta);
+
+    pid->output = q16_add_sat(pid->last_output, delta_output);
+    if (pid->first_run) {
+        pid->output = q16_add_sat(pid->output, pid->output_offset);
+        pid->first_run = 0;
+    }
+
+    if (pid->enable_anti_windup && pid->enable_output_limit) {
+        if ((pid->output >= pid->output_max && delta_output > 0) ||
+            (pid->output <= pid->output_min && delta_output < 0)) {
+            pid->output = pid->last_output;
+        }
+    }
+
+    PIDQ_OutputLimitProcess(pid);
+
+    pid->last_last_error = pid->last_error;
+    pid->last_error = pid->error;
+    pid->last_output = pid->output;
+    return pid->output;
+}
+
+// PID主计算函数
+q16_t PIDQ_Calculate(q16_t target, q16_t feedback, PIDQ_Controller_t *pid) {
+    pid->target = target;
+    pid->feedback = feedback;
+
+    if (pid->type == PID_TYPE_POSITION) {
+        return PIDQ_PositionCalculate(pid);
+    } else {
+        return PIDQ_IncrementCalculate(pid);
+    }
+}
+
+// 重置PID控制器
+void PIDQ_Reset(PIDQ_Controller_t *pid) {
+    pid->error = 0;
+    pid->last_error = 0;
+    pid->last_last_error = 0;
+    pid->integral = 0;
+    pid->output = 0;
+    pid->last_output = 0;
+    pid->last_derivative = 0;
+}
+
+// 参数设置函数
+void PIDQ_SetParams(PIDQ_Controller_t *pid, float kp, float ki, float kd) {
+    pid->Kp = q16_from_float(kp);
+    pid->Ki = q16_from_float(ki);
+    pid->Kd = q16_from_float(kd);
+}
+
+void PIDQ_SetIntegralLimit(PIDQ_Controller_t *pid, float max_val, float min_val) {
+    pid->integral_max = q16_from_float(max_val);
+    pid->integral_min = q16_from_float(min_val);
+    pid->enable_integral_limit = 1;
+}
+
+void PIDQ_SetOutputLimit(PIDQ_Controller_t *pid, float max_val, float min_val) {
+    pid->output_max = q16_from_float(max_val);
+    pid->output_min = q16_from_float(min_val);
+    pid->enable_output_limit = 1;
+}
+
+void PIDQ_SetDeadzone(PIDQ_Controller_t *pid, float deadzone) {
+    pid->deadzone = q16_from_float(deadzone);
+    pid->enable_deadzone = (deadzone > 0.0f) ? 1 : 0;
+}
+
+void PIDQ_SetIntegralSeparation(PIDQ_Controller_t *pid, float threshold) {
+    pid->integral_separation_threshold = q16_from_float(threshold);
+    pid->enable_integral_separation = (threshold > 0.0f) ? 1 : 0;
+}
+
+void PIDQ_SetAntiWindup(PIDQ_Controller_t *pid, uint8_t enable) {
+    pid->enable_anti_windup = enable;
+}
+
+void PIDQ_SetDerivativeFilter(PIDQ_Controller_t *pid, uint8_t enable, float alpha) {
+    pid->enable_derivative_filter = enable;
+    if (alpha > 0.0f && alpha < 1.0f) {
+        pid->derivative_filter_alpha = q16_from_float(alpha);
+    }
+}
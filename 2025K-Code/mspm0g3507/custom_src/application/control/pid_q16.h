@@ -0,0 +1,109 @@
+#ifndef __PID_Q16_H__
+#define __PID_Q16_H__
+
+#include <stdint.h>
+#include "pid.h"
+
+/*
+ * Q16.16 定点 PID, 功能与 PID_Controller_t 一一对应 (死区、积分分离、
+ * 积分/输出限幅、抗积分饱和、微分滤波、位置式/增量式).
+ * Cortex-M0+ 没有 FPU, 浮点 PID 每次计算要走十几次软浮点库调用;
+ * 定点版本热路径只有整数加减和 32x32->64 乘法.
+ *
+ * 数值范围: 所有量 (目标、反馈、积分、输出、参数) 的绝对值须小于 32768,
+ * 分辨率 1/65536. 积分累加与输出计算做饱和处理, 溢出时钳位而不是回绕.
+ * 参数整定仍用浮点, 只在设置时换算一次.
+ */
+
+typedef int32_t q16_t;
+
+#define Q16_ONE             ((q16_t)0x00010000)
+#define Q16_MAX             ((q16_t)INT32_MAX)
+#define Q16_MIN             ((q16_t)INT32_MIN)
+
+// 编译期常量换算, 运行时换算请用 q16_from_float()
+#define Q16(x)              ((q16_t)((x) * 65536.0 + ((x) >= 0 ? 0.5 : -0.5)))
+
+static inline q16_t q16_from_int(int32_t x) { return (q16_t)(x * 65536); }
+static inline int32_t q16_to_int(q16_t x) { return (x + (Q16_ONE >> 1)) >> 16; }   // 四舍五入
+static inline q16_t q16_from_float(float x) { return (q16_t)(x * 65536.0f + (x >= 0.0f ? 0.5f : -0.5f)); }
+static inline float q16_to_float(q16_t x) { return (float)x * (1.0f / 65536.0f); }
+
+// Q16 乘法, 结果四舍五入并饱和
+static inline q16_t q16_mul(q16_t a, q16_t b) {
+    int64_t product = ((int64_t)a * b + 0x8000) >> 16;
+    if (product > INT32_MAX) return Q16_MAX;
+    if (product < INT32_MIN) return Q16_MIN;
+    return (q16_t)product;
+}
+
+// 饱和加法
+static inline q16_t q16_add_sat(q16_t a, q16_t b) {
+    int32_t sum = (int32_t)((uint32_t)a + (uint32_t)b);
+    if (((a ^ sum) & (b ^ sum)) < 0) {
+        return (a < 0) ? Q16_MIN : Q16_MAX;
+    }
+    return sum;
+}
+
+// 定点PID控制器结构体, 字段含义同 PID_Controller_t
+typedef struct {
+    q16_t Kp;
+    q16_t Ki;
+    q16_t Kd;
+
+    q16_t target;
+    q16_t feedback;
+    q16_t error;
+    q16_t last_error;
+    q16_t last_last_error;
+
+    q16_t integral;
+    q16_t integral_max;
+    q16_t integral_min;
+    q16_t integral_separation_threshold;
+
+    q16_t output;
+    q16_t output_offset;
+    q16_t output_max;
+    q16_t output_min;
+    q16_t last_output;
+
+    q16_t deadzone;
+
+    PID_Type_e type;
+    uint16_t enable_integral_separation;
+    uint16_t enable_integral_limit;
+    uint16_t enable_output_limit;
+    uint16_t enable_deadzone;
+
+    q16_t derivative_filter_alpha;
+    q16_t last_derivative;
+
+    uint8_t enable_anti_windup;
+    uint8_t enable_derivative_filter;
+    uint8_t first_run;               // 增量式首次计算时叠加 output_offset (每个实例独立)
+} PIDQ_Controller_t;
+
+// 函数声明
+void PIDQ_Init(PIDQ_Controller_t *pid, PID_Type_e type);
+void PIDQ_InitFromFloat(PIDQ_Controller_t *pid, const PID_Controller_t *src);
+void PIDQ_Reset(PIDQ_Controller_t *pid);
+q16_t PIDQ_Calculate(q16_t target, q16_t feedback, PIDQ_Controller_t *pid);
+q16_t PIDQ_PositionCalculate(PIDQ_Controller_t *pid);
+q16_t PIDQ_IncrementCalculate(PIDQ_Controller_t *pid);
+
+// 辅助函数
+static inline q16_t PIDQ_GetOutput(const PIDQ_Controller_t *pid) { return pid->output; }
+static inline q16_t PIDQ_GetError(const PIDQ_Controller_t *pid) { return pid->error; }
+
+// 参数设置函数 (浮点参数, 设置时换算)
+void PIDQ_SetParams(PIDQ_Controller_t *pid, float kp, float ki, float kd);
+void PIDQ_SetIntegralLimit(PIDQ_Controller_t *pid, float max_val, float min_val);
+void PIDQ_SetOutputLimit(PIDQ_Controller_t *pid, float max_val, float min_val);
+void PIDQ_SetDeadzone(PIDQ_Controller_t *pid, float deadzone);
+void PIDQ_SetIntegralSeparation(PIDQ_Controller_t *pid, float threshold);
+void PIDQ_SetAntiWindup(PIDQ_Controller_t *pid, uint8_t enable);
+void PIDQ_SetDerivativeFilter(PIDQ_Controller_t *pid, uint8_t enable, float alpha);
+
+#endif // __PID_Q16_H__
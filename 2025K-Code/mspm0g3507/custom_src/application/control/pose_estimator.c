@@ -0,0 +1,93 @@
+#include "pose_estimator.h"
+#include <math.h>
+#include <string.h>
+
+#define POSE_PI     3.14159265359f
+
+float pose_estimator_wrap(float angle) {
+    while (angle > POSE_PI) {
+        angle -= 2.0f * POSE_PI;
+    }
+    while (angle <= -POSE_PI) {
+        angle += 2.0f * POSE_PI;
+    }
+    return angle;
+}
+
+void pose_estimator_init(pose_estimator_t *pe, float wheel_base_cm, float wheel_var, float yaw_var,
+                         float x, float y, float theta) {
+    pe->wheel_base_cm = wheel_base_cm;
+    pe->wheel_var = wheel_var;
+    pe->yaw_var = yaw_var;
+    pose_estimator_reset(pe, x, y, theta);
+}
+
+void pose_estimator_reset(pose_estimator_t *pe, float x, float y, float theta) {
+    pe->x = x;
+    pe->y = y;
+    pe->theta = pose_estimator_wrap(theta);
+    memset(pe->P, 0, sizeof(pe->P));
+}
+
+void pose_estimator_predict(pose_estimator_t *pe, float dl_cm, float dr_cm) {
+    float b = pe->wheel_base_cm;
+    float ds = 0.5f * (dl_cm + dr_cm);
+    float dth = (dr_cm - dl_cm) / b;
+    float th = pe->theta + 0.5f * dth;
+    float c = cosf(th), s = sinf(th);
+
+    pe->x += ds * c;
+    pe->y += ds * s;
+    pe->theta = pose_estimator_wrap(pe->theta + dth);
+
+    // F = ∂f/∂(x, y, θ), 只有第 3 列非平凡: (-ds·s, ds·c, 1)
+    float f0 = -ds * s, f1 = ds * c;
+    float (*P)[3] = pe->P;
+    float p02 = P[0][2] + f0 * P[2][2];
+    float p12 = P[1][2] + f1 * P[2][2];
+    float p00 = P[0][0] + 2.0f * f0 * P[0][2] + f0 * f0 * P[2][2];
+    float p11 = P[1][1] + 2.0f * f1 * P[1][2] + f1 * f1 * P[2][2];
+    float p01 = P[0][1] + f0 * P[1][2] + f1 * P[0][2] + f0 * f1 * P[2][2];
+
+    // G = ∂f/∂(dl, dr), 两轮噪声独立: Q = diag(wheel_var·|dl|, wheel_var·|dr|)
+    float ql = pe->wheel_var * fabsf(dl_cm);
+    float qr = pe->wheel_var * fabsf(dr_cm);
+    float k = ds / (2.0f * b);
+    float gxl = 0.5f * c + k * s, gxr = 0.5f * c - k * s;
+    float gyl = 0.5f * s - k * c, gyr = 0.5f * s + k * c;
+    float gtl = -1.0f / b, gtr = 1.0f / b;
+
+    P[0][0] = p00 + gxl * gxl * ql + gxr * gxr * qr;
+    P[1][1] = p11 + gyl * gyl * ql + gyr * gyr * qr;
+    P[2][2] = P[2][2] + gtl * gtl * ql + gtr * gtr * qr;
+    P[0][1] = P[1][0] = p01 + gxl * gyl * ql + gxr * gyr * qr;
+    P[0][2] = P[2][0] = p02 + gxl * gtl * ql + gxr * gtr * qr;
+    P[1][2] = P[2][1] = p12 + gyl * gtl * ql + gyr * gtr * qr;
+}
+
+void pose_estimator_update_heading(pose_estimator_t *pe, float theta) {
+    float (*P)[3] = pe->P;
+    float innov = pose_estimator_wrap(theta - pe->theta);
+    float S = P[2][2] + pe->yaw_var;
+    if (S <= 0.0f) {
+        return;
+    }
+
+    // H = (0, 0, 1): K = P 的第 3 列 / S
+    float k0 = P[0][2] / S, k1 = P[1][2] / S, k2 = P[2][2] / S;
+    pe->x += k0 * innov;
+    pe->y += k1 * innov;
+    pe->theta = pose_estimator_wrap(pe->theta + k2 * innov);
+
+    // P -= K·H·P, 即减去 K 与 P 第 3 行的外积
+    float r0 = P[2][0], r1 = P[2][1], r2 = P[2][2];
+    P[0][0] -= k0 * r0;
+    P[0][1] -= k0 * r1;
+    P[0][2] -= k0 * r2;
+    P[1][1] -= k1 * r1;
+    P[1][2] -= k1 * r2;
+    P[2][2] -= k2 * r2;
+    P[1][0] = P[0][1];
+    P[2][0] = P[0][2];
+    P[2][1] = P[1][2];
+}
@@ -0,0 +1,60 @@
+#ifndef __POSE_ESTIMATOR_H__
+#define __POSE_ESTIMATOR_H__
+
+#include <stdint.h>
+
+/*
+ * 平面位姿 (x, y, θ) 的扩展卡尔曼滤波, 不随 car_reset() 清零.
+ *
+ * 预测: 左右轮本拍行程 dl, dr 按差速模型推算 (中点航向积分)
+ *     ds = (dl + dr) / 2, dθ = (dr - dl) / b
+ *     x += ds·cos(θ + dθ/2), y += ds·sin(θ + dθ/2), θ += dθ
+ * 每个轮子的行程噪声方差与行程成正比 (wheel_var·|d|), 经雅可比传播到协方差.
+ * 更新: 陀螺仪航向作为 θ 的直接观测 (方差 yaw_var), 新息折叠到 ±π.
+ *
+ * 坐标系: x 为初始化时的车头方向, y 向左, θ 逆时针为正, 单位 cm / rad.
+ */
+
+typedef struct {
+    // 参数 - 可直接设置
+    float wheel_base_cm;            // 轮距 b
+    float wheel_var;                // 单轮行程噪声, cm² / cm
+    float yaw_var;                  // 陀螺仪航向观测噪声, rad²
+
+    // 状态
+    float x;
+    float y;
+    float theta;                    // 折叠到 ±π
+    float P[3][3];                  // 协方差, 顺序 x, y, θ
+} pose_estimator_t;
+
+/**
+ * @brief 设置参数并把位姿置为 (x, y, theta), 协方差清零
+ */
+void pose_estimator_init(pose_estimator_t *pe, float wheel_base_cm, float wheel_var, float yaw_var,
+                         float x, float y, float theta);
+
+/**
+ * @brief 重新设定位姿, 协方差清零 (参数不变)
+ */
+void pose_estimator_reset(pose_estimator_t *pe, float x, float y, float theta);
+
+/**
+ * @brief 预测一步
+ * @param dl_cm 左轮本拍行程
+ * @param dr_cm 右轮本拍行程
+ */
+void pose_estimator_predict(pose_estimator_t *pe, float dl_cm, float dr_cm);
+
+/**
+ * @brief 用航向观测更新
+ * @param theta 观测航向, rad, 与 pose 同一坐标系
+ */
+void pose_estimator_update_heading(pose_estimator_t *pe, float theta);
+
+/**
+ * @brief 折叠到 (-π, π]
+ */
+float pose_estimator_wrap(float angle);
+
+#endif // __POSE_ESTIMATOR_H__
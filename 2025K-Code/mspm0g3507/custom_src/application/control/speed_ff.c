@@ -0,0 +1,165 @@
+#include "speed_ff.h"
+#include <math.h>
+
+// 折线上的第 i 个点, i = 0 为 (0, deadband_pwm)
+static float point_speed(const speed_ff_model_t *model, int i) {
+    return (i == 0) ? 0.0f : model->speed_cmps[i - 1];
+}
+
+static float point_pwm(const speed_ff_model_t *model, int i) {
+    return (i == 0) ? model->deadband_pwm : model->pwm[i - 1];
+}
+
+// |v| 对应的稳态 PWM, 超出最后一个标定点时沿最后一段外推
+static float speed_ff_map(const speed_ff_model_t *model, float speed) {
+    int last = model->count;
+    int i = 1;
+
+    while (i < last && speed > point_speed(model, i)) {
+        i++;
+    }
+    float s0 = point_speed(model, i - 1), s1 = point_speed(model, i);
+    float p0 = point_pwm(model, i - 1), p1 = point_pwm(model, i);
+    if (s1 <= s0) {
+        return p1;
+    }
+    return p0 + (p1 - p0) * (speed - s0) / (s1 - s0);
+}
+
+float speed_ff_output(const speed_ff_model_t *model, float speed_cmps, float accel_cmps2) {
+    if (!model->valid || model->count == 0) {
+        return 0.0f;
+    }
+
+    float s = fabsf(speed_cmps);
+    float pwm;
+    if (s < SPEED_FF_ZERO_BAND_CMPS) {
+        pwm = speed_ff_map(model, SPEED_FF_ZERO_BAND_CMPS) * s / SPEED_FF_ZERO_BAND_CMPS;
+    } else {
+        pwm = speed_ff_map(model, s);
+    }
+    // 外环输出的阶跃与噪声会使差分出的加速度很大, 限到小车实际能达到的量级
+    if (accel_cmps2 > SPEED_FF_ACCEL_LIMIT) {
+        accel_cmps2 = SPEED_FF_ACCEL_LIMIT;
+    } else if (accel_cmps2 < -SPEED_FF_ACCEL_LIMIT) {
+        accel_cmps2 = -SPEED_FF_ACCEL_LIMIT;
+    }
+    return copysignf(pwm, speed_cmps) + model->accel_gain * accel_cmps2;
+}
+
+void speed_ff_calib_init(speed_ff_calib_t *calib, float pwm_step, uint8_t levels,
+                         uint8_t hold_ticks, float sample_time_s) {
+    calib->pwm_step = pwm_step;
+    calib->levels = (levels > SPEED_FF_MAX_POINTS) ? SPEED_FF_MAX_POINTS : levels;
+    calib->hold_ticks = (hold_ticks > SPEED_FF_HOLD_MAX) ? SPEED_FF_HOLD_MAX : hold_ticks;
+    calib->average_ticks = calib->hold_ticks / 2;
+    calib->move_threshold_cmps = 1.0f;
+    calib->sample_time_s = sample_time_s;
+
+    calib->state = SPEED_FF_CALIB_RUNNING;
+    calib->level = 0;
+    calib->tick = 0;
+    calib->last_speed = 0.0f;
+    calib->last_moving = 0;
+    calib->tau_sum = 0.0f;
+    calib->tau_count = 0;
+
+    calib->tau_s = 0.0f;
+    calib->model.valid = 0;
+    calib->model.count = 0;
+    calib->model.deadband_pwm = 0.0f;
+    calib->model.accel_gain = 0.0f;
+}
+
+// 阶跃响应到达 last_speed + frac·(target - last_speed) 的时刻, 单位: 拍, 以阶跃前一拍为 -1
+static float crossing_tick(const speed_ff_calib_t *calib, float target, float frac) {
+    float level = calib->last_speed + frac * (target - calib->last_speed);
+    float prev = calib->last_speed;
+
+    for (int i = 0; i < calib->hold_ticks; i++) {
+        float s = calib->samples[i];
+        if (s >= level) {
+            return (float)(i - 1) + ((s > prev) ? (level - prev) / (s - prev) : 1.0f);
+        }
+        prev = s;
+    }
+    return -1.0f;
+}
+
+// 一级结束: 记录稳态点, 与上一级都在转动时估计时间常数
+static void speed_ff_calib_level_done(speed_ff_calib_t *calib) {
+    speed_ff_model_t *model = &calib->model;
+    uint8_t n = calib->average_ticks ? calib->average_ticks : 1;
+    float sum = 0.0f;
+
+    for (int i = calib->hold_ticks - n; i < calib->hold_ticks; i++) {
+        sum += calib->samples[i];
+    }
+    float speed = sum / n;
+    uint8_t moving = speed > calib->move_threshold_cmps;
+
+    if (moving && (model->count == 0 || speed > model->speed_cmps[model->count - 1])) {
+        model->speed_cmps[model->count] = speed;
+        model->pwm[model->count] = (calib->level + 1) * calib->pwm_step;
+        model->count++;
+
+        if (calib->last_moving && speed - calib->last_speed > calib->move_threshold_cmps) {
+            float t28 = crossing_tick(calib, speed, 0.283f);
+            float t63 = crossing_tick(calib, speed, 0.632f);
+            if (t28 >= 0.0f && t63 > t28) {
+                calib->tau_sum += 1.5f * (t63 - t28) * calib->sample_time_s;
+                calib->tau_count++;
+            }
+        }
+    }
+    calib->last_speed = speed;
+    calib->last_moving = moving;
+}
+
+static void speed_ff_calib_finish(speed_ff_calib_t *calib) {
+    speed_ff_model_t *model = &calib->model;
+
+    if (model->count < 2) {
+        calib->state = SPEED_FF_CALIB_FAILED;
+        return;
+    }
+
+    // 最低两个转动点连线外推到 0 速, 得到克服摩擦所需的 PWM
+    float slope = (model->pwm[1] - model->pwm[0]) / (model->speed_cmps[1] - model->speed_cmps[0]);
+    float deadband = model->pwm[0] - slope * model->speed_cmps[0];
+    if (deadband < 0.0f) {
+        deadband = 0.0f;
+    } else if (deadband > model->pwm[0]) {
+        deadband = model->pwm[0];
+    }
+    model->deadband_pwm = deadband;
+
+    // 加速度项用整条折线的平均斜率
+    float gain = (model->pwm[model->count - 1] - deadband) / model->speed_cmps[model->count - 1];
+    calib->tau_s = calib->tau_count ? calib->tau_sum / calib->tau_count : 0.0f;
+    model->accel_gain = calib->tau_s * gain;
+    model->valid = 1;
+    calib->state = SPEED_FF_CALIB_DONE;
+}
+
+float speed_ff_calib_step(speed_ff_calib_t *calib, float speed_cmps) {
+    if (calib->state != SPEED_FF_CALIB_RUNNING) {
+        return 0.0f;
+    }
+
+    calib->samples[calib->tick++] = speed_cmps;
+    if (calib->tick >= calib->hold_ticks) {
+        speed_ff_calib_level_done(calib);
+        calib->tick = 0;
+        calib->level++;
+        if (calib->level >= calib->levels) {
+            speed_ff_calib_finish(calib);
+            return 0.0f;
+        }
+    }
+    return (calib->level + 1) * calib->pwm_step;
+}
+
+speed_ff_calib_state_e speed_ff_calib_get_state(const speed_ff_calib_t *calib) {
+    return calib->state;
+}
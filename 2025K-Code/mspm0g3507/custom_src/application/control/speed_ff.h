@@ -0,0 +1,85 @@
+#ifndef __SPEED_FF_H__
+#define __SPEED_FF_H__
+
+#include <stdint.h>
+
+/*
+ * 速度环前馈: 由目标轮速直接给出 PWM, PID 只修正残差.
+ *     pwm_ff = sign(v)·map(|v|) + accel_gain·dv/dt
+ * map 为标定得到的 PWM-稳态轮速折线, 首点 (0, deadband_pwm) 即静摩擦/死区补偿;
+ * 加速度项按一阶电机模型 τ·dv/dt + v = K·pwm 取 accel_gain = τ / K.
+ * 只标定正转, 反转按对称处理.
+ *
+ * 标定 (speed_ff_calib_t): 开环阶梯 PWM, 每级保持 hold_ticks 拍,
+ * 取每级末尾 average_ticks 拍的平均轮速作为稳态点;
+ * 相邻两级之间的阶跃用两点法求时间常数 τ = 1.5·(t63 - t28), 与采样/输出延迟无关.
+ * 各级时长固定, 多个车轮各用一个标定器同时运行时步调一致.
+ */
+
+#define SPEED_FF_MAX_POINTS         8
+#define SPEED_FF_HOLD_MAX           32      // 每级最多保持拍数 (样本缓存)
+#define SPEED_FF_ZERO_BAND_CMPS     1.0f    // 目标速度在此以内时前馈按比例减小, 避免过零时 ±死区 跳变
+#define SPEED_FF_ACCEL_LIMIT        500.0f  // 加速度项输入限幅, cm/s²
+
+typedef struct {
+    uint8_t valid;                          // 0: 未标定, 前馈输出 0
+    uint8_t count;                          // 标定点数
+    float deadband_pwm;                     // 起转 PWM (折线在 0 速处的截距)
+    float speed_cmps[SPEED_FF_MAX_POINTS];  // 标定点稳态轮速, 递增
+    float pwm[SPEED_FF_MAX_POINTS];         // 对应 PWM
+    float accel_gain;                       // PWM / (cm/s²)
+} speed_ff_model_t;
+
+typedef enum {
+    SPEED_FF_CALIB_IDLE = 0,
+    SPEED_FF_CALIB_RUNNING,
+    SPEED_FF_CALIB_DONE,
+    SPEED_FF_CALIB_FAILED,                  // 转动的级数不足两级
+} speed_ff_calib_state_e;
+
+typedef struct {
+    // 激励参数 - 可直接设置
+    float pwm_step;                 // 第 k 级 (从 1 起) 输出 k·pwm_step
+    uint8_t levels;                 // 级数, ≤ SPEED_FF_MAX_POINTS
+    uint8_t hold_ticks;             // 每级保持拍数, ≤ SPEED_FF_HOLD_MAX
+    uint8_t average_ticks;          // 每级末尾取平均的拍数
+    float move_threshold_cmps;      // 平均轮速低于此值视为未转动 (仍在死区内)
+    float sample_time_s;
+
+    // 运行状态 (自动更新)
+    speed_ff_calib_state_e state;
+    uint8_t level;
+    uint8_t tick;
+    float samples[SPEED_FF_HOLD_MAX];
+    float last_speed;               // 上一级稳态轮速
+    uint8_t last_moving;
+    float tau_sum;
+    uint8_t tau_count;
+
+    // 结果
+    float tau_s;
+    speed_ff_model_t model;
+} speed_ff_calib_t;
+
+/**
+ * @brief 前馈 PWM
+ * @param speed_cmps 目标轮速
+ * @param accel_cmps2 目标轮速的变化率
+ */
+float speed_ff_output(const speed_ff_model_t *model, float speed_cmps, float accel_cmps2);
+
+/**
+ * @brief 初始化并开始一次标定
+ * @note 其余参数取默认值 (每级末尾 hold_ticks/2 拍取平均, 转动阈值 1cm/s), 可在调用后直接修改
+ */
+void speed_ff_calib_init(speed_ff_calib_t *calib, float pwm_step, uint8_t levels,
+                         uint8_t hold_ticks, float sample_time_s);
+
+/**
+ * @brief 输入一次轮速, 返回下一拍的开环 PWM; 结束后 (DONE/FAILED) 返回 0
+ */
+float speed_ff_calib_step(speed_ff_calib_t *calib, float speed_cmps);
+
+speed_ff_calib_state_e speed_ff_calib_get_state(const speed_ff_calib_t *calib);
+
+#endif // __SPEED_FF_H__
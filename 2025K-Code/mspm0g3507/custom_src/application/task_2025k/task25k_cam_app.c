@@ -2,6 +2,7 @@
 #include "common_include.h"
 //#include "log_config.h"
 #include "log.h"
+#include <string.h>
 
 maixCam_t maix_cam;
 
@@ -29,6 +30,27 @@ static void on_command_data(uint8_t command_code) {
     log_i("Command data received: 0x%02X", command_code);
 }
 
+/**
+ * @brief 圆柱布局回调函数
+ */
+static void on_obstacle_data(const cam_obstacle_t *obstacles, uint8_t count) {
+		memcpy(maix_cam.obstacles, obstacles, count * sizeof(cam_obstacle_t));
+		maix_cam.obstacle_count = count;
+    log_i("Obstacle layout received: %d cylinders", count);
+}
+
+/**
+ * @brief 圆柱识别结果回调函数: 颜色与置信度先存好, 命令字最后写 (状态机以命令字为准开始选路线)
+ */
+static void on_cylinder_data(const cam_msg_cylinders_t *msg) {
+		memcpy(maix_cam.cylinders, msg->items, sizeof(maix_cam.cylinders));
+		maix_cam.cylinders_valid = 1;
+		if (msg->command != 0) {
+			maix_cam.cmd = (CAM_CMD)msg->command;
+		}
+    log_i("Cylinder result received: cmd 0x%02X", msg->command);
+}
+
 // ====================  摄像头数据接收处理  ====================
 /**
  * @brief 在camera.c中的回调函数里调用
@@ -52,6 +74,8 @@ void setup_cam_protocol(void) {
     cam_protocol_set_track_callback(on_track_data);
     cam_protocol_set_number_callback(on_number_data);
     cam_protocol_set_command_callback(on_command_data);
+    cam_protocol_set_obstacle_callback(on_obstacle_data);
+    cam_protocol_set_cylinder_callback(on_cylinder_data);
     log_i("Camera protocol initialized");
 }
 
@@ -1,6 +1,15 @@
 #include "task25k_config.h"
 #include "car_controller.h"
 #include "attitude_algorithm.h"
+#if CAR_CONTROL_IN_ISR
+#include "realtime_task.h"
+#include "double_buffer.h"
+#endif
+#if CAR_SPEED_PID_Q16
+#include "pid_q16.h"
+#endif
+#include "pid_autotune.h"
+#include "hal_uart.h"
 
 #define MAX_DISTANCE 						255
 #define DISTANCE_THRESHOLD_CM 	1
@@ -10,13 +19,95 @@
 #define ARC_LENGTH 							120
 #define CIRCLE_SPEED 						60
 
+#if CAR_MOTION_PROFILE
+// S 形曲线限幅: 直行/绕圈 cm, 转向 deg. 直行最高速度沿用原里程环输出限幅
+#define MP_STRAIGHT_SPEED       76.0f
+#define MP_STRAIGHT_ACCEL       1000.0f
+#define MP_STRAIGHT_JERK        15000.0f
+#define MP_TURN_RATE            280.0f      // 对应轮速约 59cm/s, 不超过角度环输出限幅
+#define MP_TURN_ACCEL           4000.0f
+#define MP_TURN_JERK            60000.0f
+#define MP_CORNER_SPEED         30.0f       // 两段直行之间改变航向时的衔接速度
+#define CIRCLE_CATCHUP_SPEED    12.0f       // 绕圈落后曲线时里程环最多在巡航速度上追加的量
+
+static const motion_limits_t straight_limits = {
+    MP_STRAIGHT_SPEED, MP_STRAIGHT_ACCEL, MP_STRAIGHT_JERK, ENCODER_PERIOD_MS * 0.001f,
+};
+static const motion_limits_t turn_limits = {
+    MP_TURN_RATE, MP_TURN_ACCEL, MP_TURN_JERK, ENCODER_PERIOD_MS * 0.001f,
+};
+static const motion_limits_t circle_limits = {
+    CIRCLE_SPEED, MP_STRAIGHT_ACCEL, MP_STRAIGHT_JERK, ENCODER_PERIOD_MS * 0.001f,
+};
+#endif
+
+// 位姿估计噪声: 单轮行程 cm²/cm, 陀螺仪航向 rad² (约 0.5°)
+#define POSE_WHEEL_VAR          0.02f
+#define POSE_YAW_VAR            7.6e-5f
+#define GOTO_ARRIVE_CM          DISTANCE_THRESHOLD_CM
+#define PATH_SPEED              76.0f       // 纯追踪巡航速度 cm/s, 与里程环输出限幅相同
+#define PATH_LOOKAHEAD_CM       20.0f       // 前视距离, 直角拐角处离折线约 3.5cm
+
 // 定义 encoder 结构体实例
 encoder_t encoder = {0};
+pose_estimator_t car_pose;
+static float pose_last_odometer[motor_count];
+static float pose_yaw_offset;          // 位姿航向 - 陀螺仪航向, rad
 
 static inline float calculate_angle_error(float target, float current);
 static const uint16_t stop_mark_table_8bit[];
 static inline bool is_in_table(const uint16_t *table, uint16_t table_size, uint16_t data);
 static const uint8_t STOP_MARK_TABLE_SIZE;
+static void sample_encoder(encoder_t *enc);
+static void car_pose_update(void);
+static float car_begin_segment(CAR_STATES state);
+static void drive_speed_pid(const float *target_speed, const int *ff_pwm, const encoder_t *enc);
+static void reset_speed_pid(void);
+static void update_speed_ff(void);
+
+#if CAR_SPEED_PID_Q16
+// 速度环定点控制器, 由 car_init() 按 speedPid[] 的整定参数配置
+static PIDQ_Controller_t speed_pid_q16[motor_count];
+#endif
+
+// 速度环前馈模型, car_init() 时取 car_speed_ff_default[]
+speed_ff_model_t car_speed_ff[motor_count];
+// 前馈 PWM 在任务层按 car.target_speed 求出, 速度环 (可能在实时层) 只做整数加法
+static int ff_pwm[motor_count];
+#if CAR_SPEED_FEEDFORWARD
+static float ff_last_target[motor_count];   // 上一拍目标速度, 求加速度项
+#endif
+
+#if CAR_CONTROL_IN_ISR
+// 主循环 -> 实时层: 速度目标与复位请求; open_loop 时旁路速度环直接输出 pwm
+typedef struct {
+    float target_speed[motor_count];
+    uint32_t reset_seq;
+    bool open_loop;
+    int pwm[motor_count];
+    int ff_pwm[motor_count];
+} car_command_t;
+
+// 实时层 -> 主循环: 编码器快照, reset_ack 为实时层已处理的复位序号
+typedef struct {
+    encoder_t encoder;
+    uint32_t reset_ack;
+} car_feedback_t;
+
+static car_command_t command_slots[2];
+static car_feedback_t feedback_slots[2];
+static double_buffer_t command_buffer;
+static double_buffer_t feedback_buffer;
+static bool realtime_buffers_ready = false;
+
+static uint32_t reset_seq = 0;      // 主循环维护
+static encoder_t rt_encoder;        // 实时层私有
+static uint32_t rt_reset_ack = 0;   // 实时层私有
+
+static void car_realtime_init(void);
+static void car_fetch_feedback(void);
+static void car_publish_command(void);
+#endif
 
 car_t car = {
     .state = CAR_STATE_STOP,
@@ -36,7 +127,12 @@ float get_yaw(void) {
 }
 
 void car_task(void) {
+#if CAR_CONTROL_IN_ISR
+    car_fetch_feedback();
+#else
     update_encoder();
+#endif
+    car_pose_update();
     if (car.state == CAR_STATE_GO_STRAIGHT) {
         update_straight_control();
     } else if (car.state == CAR_STATE_TURN) {
@@ -45,10 +141,24 @@ void car_task(void) {
         update_track_control();
     } else if (car.state == CAR_STATE_CIRCLE) {  // 新增
         update_circle_control();
+    } else if (car.state == CAR_STATE_AUTOTUNE) {
+        update_autotune_control();
+    } else if (car.state == CAR_STATE_FF_CALIB) {
+        update_ff_calib_control();
+    } else if (car.state == CAR_STATE_PATH) {
+        update_path_control();
     } else if (car.state == CAR_STATE_STOP) {
 				car_set_base_speed(0);
     }
-    update_speed_pid();
+#if CAR_CONTROL_IN_ISR
+    car_publish_command();
+#else
+    if (car.open_loop) {
+        motor_set_pwms(car.open_loop_pwm);
+    } else {
+        update_speed_pid();
+    }
+#endif
 }
 /**
  * @brief 控制小车直线行驶指定里程
@@ -56,13 +166,34 @@ void car_task(void) {
  * @return true 表示已达到目标里程，false 表示尚未达到
  */
 bool car_move_cm(float mileage, CAR_STATES move_state) {
-    if (car.state != move_state) {
-        car.state = move_state;
-			  car_reset();
+    return car_move_cm_blend(mileage, move_state, 0.0f);
+}
+
+bool car_move_cm_blend(float mileage, CAR_STATES move_state, float exit_speed) {
+    if (car.state != move_state || car.blend_pending) {
+        float start_speed = car_begin_segment(move_state);
 				car.target_mileage_cm = mileage;
+#if CAR_MOTION_PROFILE
+        if (move_state == CAR_STATE_GO_STRAIGHT) {
+            motion_profile_start(&car.profile, &straight_limits, mileage, start_speed, exit_speed);
+        }
+#else
+        (void)start_speed;
+        (void)exit_speed;
+#endif
+    }
+    float remaining = car.target_mileage_cm - car_segment_mileage_cm();
+#if CAR_MOTION_PROFILE
+    if (move_state == CAR_STATE_GO_STRAIGHT && car.profile.v_end > 0.0f) {
+        // 带速度衔接: 设定曲线走完且离终点不足 DISTANCE_THRESHOLD_CM 时交给下一段, 不停车
+        if (motion_profile_done(&car.profile) && remaining * car.profile.dir <= DISTANCE_THRESHOLD_CM) {
+            car.blend_pending = true;
+            return true;
+        }
+        return false;
     }
-    float current_mileage = get_mileage_cm();
-    if (fabsf(car.target_mileage_cm - current_mileage) <= DISTANCE_THRESHOLD_CM) {
+#endif
+    if (fabsf(remaining) <= DISTANCE_THRESHOLD_CM) {
 				car_reset();
         car.state = CAR_STATE_STOP;
         return true; 
@@ -81,6 +212,11 @@ bool spin_turn(float angle) {
         car.target_angle = angle;
         car.turn_initialized = false;
         car_reset();
+#if CAR_MOTION_PROFILE && CURRENT_IMU != NO_GYRO
+        car.turn_start_yaw = get_yaw();
+        motion_profile_start(&car.profile, &turn_limits, calculate_angle_error(angle, car.turn_start_yaw),
+                             0.0f, 0.0f);
+#endif
     }
     
     #if CURRENT_IMU != NO_GYRO
@@ -127,6 +263,9 @@ bool car_move_until(CAR_STATES move_state, LINE_STATES l_state) {
         if (move_state == CAR_STATE_GO_STRAIGHT) {
             car_reset();
             car.target_mileage_cm = MAX_DISTANCE;
+#if CAR_MOTION_PROFILE
+            motion_profile_start(&car.profile, &straight_limits, MAX_DISTANCE, 0.0f, 0.0f);
+#endif
         }
     }
 		 uint16_t sensor_data = gray_read_byte();
@@ -184,38 +323,171 @@ void car_init(void) {
     encoder_application_init();
     motor_init();
 		car_pid_init();
+		for (int i = 0; i < motor_count; i++) {
+				car_speed_ff[i] = car_speed_ff_default[i];
+		}
+    pose_estimator_init(&car_pose, WHEEL_BASE_CM, POSE_WHEEL_VAR, POSE_YAW_VAR, 0.0f, 0.0f, 0.0f);
+#if CAR_SPEED_PID_Q16
+		for (int i = 0; i < motor_count; i++) {
+				PIDQ_InitFromFloat(&speed_pid_q16[i], &speedPid[i]);
+		}
+#endif
 		car_debug_init();
+#if CAR_CONTROL_IN_ISR
+		car_realtime_init();
+#endif
 		car_reset();
 }
 
-void update_encoder(void) {
+static void sample_encoder(encoder_t *enc) {
     for (int i = 0; i < motor_count; i++) {
-        encoder.counts[i] = encoder_manager_read_and_reset(&robot_encoder_manager, i);
-        encoder.rpms[i] = encoder.counts[i] * CIRCLE_TO_RPM / PULSE_NUM_PER_CIRCLE;
-        encoder.cmps[i] = encoder.rpms[i] * RPM_TO_CMPS;
-				encoder.distance_cm[i] += encoder.cmps[i] * TIME_INTERVAL_S;
+        enc->counts[i] = encoder_manager_read_and_reset(&robot_encoder_manager, i);
+        enc->rpms[i] = enc->counts[i] * CIRCLE_TO_RPM / PULSE_NUM_PER_CIRCLE;
+        enc->cmps[i] = enc->rpms[i] * RPM_TO_CMPS;
+				enc->distance_cm[i] += enc->cmps[i] * TIME_INTERVAL_S;
+        enc->odometer_cm[i] += enc->cmps[i] * TIME_INTERVAL_S;
     }
 }
 
-// PID速度控制更新函数
-void update_speed_pid(void) {
-    float outputs[motor_count];
+static void drive_speed_pid(const float *target_speed, const int *ff_pwm, const encoder_t *enc) {
     int pwm_outputs[motor_count];
+#if !CAR_SPEED_FEEDFORWARD
+    (void)ff_pwm;
+#endif
     for (int i = 0; i < motor_count; i++) {
-        outputs[i] = PID_Calculate(car.target_speed[i], 
-                                  encoder.cmps[i], 
-                                  &speedPid[i]);
-        pwm_outputs[i] = (int)outputs[i];
+#if CAR_SPEED_PID_Q16
+        // 目标/反馈仍写回 speedPid[], car_debug 绘图照常使用
+        speedPid[i].target = target_speed[i];
+        speedPid[i].feedback = enc->cmps[i];
+        pwm_outputs[i] = q16_to_int(PIDQ_Calculate(q16_from_float(target_speed[i]),
+                                                   q16_from_float(enc->cmps[i]),
+                                                   &speed_pid_q16[i]));
+#else
+        float output = PID_Calculate(target_speed[i], 
+                                     enc->cmps[i], 
+                                     &speedPid[i]);
+        pwm_outputs[i] = (int)output;
+#endif
+#if CAR_SPEED_FEEDFORWARD
+        // PID 只修正前馈的残差, 总输出由电机驱动限幅
+        pwm_outputs[i] += ff_pwm[i];
+#endif
     }
     motor_set_pwms(pwm_outputs);
 }
 
+/**
+ * @brief 按本拍目标速度求前馈 PWM, 与目标速度同在任务层更新
+ * @note 折线查表、除法和 copysignf 都是软件浮点, 不放进实时层中断
+ */
+static void update_speed_ff(void) {
+#if CAR_SPEED_FEEDFORWARD
+    for (int i = 0; i < motor_count; i++) {
+        float accel = (car.target_speed[i] - ff_last_target[i]) / TIME_INTERVAL_S;
+        ff_last_target[i] = car.target_speed[i];
+        ff_pwm[i] = (int)speed_ff_output(&car_speed_ff[i], car.target_speed[i], accel);
+    }
+#endif
+}
+
+static void reset_speed_pid(void) {
+    for (int i = 0; i < motor_count; i++) {
+        PID_Reset(&speedPid[i]);
+#if CAR_SPEED_PID_Q16
+        PIDQ_Reset(&speed_pid_q16[i]);
+#endif
+    }
+}
+
+void update_encoder(void) {
+    sample_encoder(&encoder);
+}
+
+// PID速度控制更新函数
+void update_speed_pid(void) {
+    update_speed_ff();
+    drive_speed_pid(car.target_speed, ff_pwm, &encoder);
+}
+
+#if CAR_CONTROL_IN_ISR
+/**
+ * @brief 实时层速度环, 每 ENCODER_PERIOD_MS 在定时器中断中执行一次
+ */
+static void car_realtime_loop(void) {
+    car_command_t command;
+    car_feedback_t feedback;
+
+    double_buffer_read(&command_buffer, &command);
+    if (command.reset_seq != rt_reset_ack) {
+        for (int i = 0; i < motor_count; i++) {
+            rt_encoder.distance_cm[i] = 0;
+        }
+        reset_speed_pid();
+        rt_reset_ack = command.reset_seq;
+    }
+
+    sample_encoder(&rt_encoder);
+    if (command.open_loop) {
+        motor_set_pwms(command.pwm);
+    } else {
+        drive_speed_pid(command.target_speed, command.ff_pwm, &rt_encoder);
+    }
+
+    feedback.encoder = rt_encoder;
+    feedback.reset_ack = rt_reset_ack;
+    double_buffer_write(&feedback_buffer, &feedback);
+}
+
+static void car_realtime_init(void) {
+    if (realtime_buffers_ready) {
+        return;
+    }
+    double_buffer_init(&command_buffer, &command_slots[0], &command_slots[1], sizeof(car_command_t));
+    double_buffer_init(&feedback_buffer, &feedback_slots[0], &feedback_slots[1], sizeof(car_feedback_t));
+    realtime_buffers_ready = true;
+    realtime_task_register(car_realtime_loop, REALTIME_DIVIDER_MS(ENCODER_PERIOD_MS));
+}
+
+/**
+ * @brief 取实时层最新的编码器快照
+ * @note 复位请求尚未被实时层处理时保留本地清零后的数据
+ */
+static void car_fetch_feedback(void) {
+    car_feedback_t feedback;
+    double_buffer_read(&feedback_buffer, &feedback);
+    if (feedback.reset_ack == reset_seq) {
+        encoder = feedback.encoder;
+    }
+}
+
+static void car_publish_command(void) {
+    car_command_t command;
+    update_speed_ff();
+    for (int i = 0; i < motor_count; i++) {
+        command.target_speed[i] = car.target_speed[i];
+        command.pwm[i] = car.open_loop_pwm[i];
+        command.ff_pwm[i] = ff_pwm[i];
+    }
+    command.reset_seq = reset_seq;
+    command.open_loop = car.open_loop;
+    double_buffer_write(&command_buffer, &command);
+}
+#endif
+
 void update_straight_control(void)
 {
     /*--------- 1. 里程 PID（输出基础速度） ---------*/
+#if CAR_MOTION_PROFILE
+    // 跟踪曲线的设定位置, 设定速度作为前馈
+    motion_profile_step(&car.profile);
+    float base_speed = car.profile.vel + PID_Calculate(car.profile.pos,
+                                                       car_segment_mileage_cm(),
+                                                       &mileagePid);    // cm/s
+#else
     float base_speed = PID_Calculate(car.target_mileage_cm,
                                      get_mileage_cm(),
                                      &mileagePid);          // cm/s
+#endif
 
     /*--------- 2. 角度 PID（输出修正量） ---------*/
 #if CURRENT_IMU != NO_GYRO
@@ -250,10 +522,18 @@ void update_track_control(void) {
 void update_turn_control(void) {
     #if CURRENT_IMU != NO_GYRO
         float current_angle = get_yaw();
+#if CAR_MOTION_PROFILE
+        // 跟踪曲线的设定航向; 设定角速度换算成轮速前馈, 逆时针 (正) 时左轮后退
+        motion_profile_step(&car.profile);
+        float angle_error = calculate_angle_error(car.turn_start_yaw + car.profile.pos, current_angle);
+        float output = PID_Calculate(0.0f, angle_error, &anglePid)
+                       - car.profile.vel * (M_PI / 180.0f) * (WHEEL_BASE_CM / 2.0f);
+#else
         float angle_error = calculate_angle_error(car.target_angle, current_angle);
         float output = PID_Calculate(0.0f, 
                                      angle_error,  
                                      &anglePid); 
+#endif
         for (int i = 0; i < motor_count; ++i)
             car.target_speed[i] = (i < motor_count / 2) ? output : -output;
     #else    
@@ -288,9 +568,20 @@ void update_turn_control(void) {
 
 
 bool car_circle(float radius_cm, bool clockwise, float target_angle_deg) {
-    if (car.state != CAR_STATE_CIRCLE) {
-        car.state = CAR_STATE_CIRCLE;
-        car_reset();  
+    return car_circle_blend(radius_cm, clockwise, target_angle_deg, 0.0f);
+}
+
+bool car_circle_blend(float radius_cm, bool clockwise, float target_angle_deg, float exit_speed) {
+    if (car.state != CAR_STATE_CIRCLE || car.blend_pending) {
+        float start_speed = car_begin_segment(CAR_STATE_CIRCLE);
+#if CAR_MOTION_PROFILE
+        // 按圆心轨迹弧长规划, 进度由累积转角换算
+        motion_profile_start(&car.profile, &circle_limits, target_angle_deg * (M_PI / 180.0f) * radius_cm,
+                             start_speed, exit_speed);
+#else
+        (void)start_speed;
+        (void)exit_speed;
+#endif
         car.circle_radius_cm = radius_cm;
         car.circle_clockwise = clockwise;
         car.circle_target_angle = target_angle_deg;
@@ -329,11 +620,25 @@ bool car_circle(float radius_cm, bool clockwise, float target_angle_deg) {
     car.circle_last_yaw = current_yaw;
     
     // 检查是否完成
+#if CAR_MOTION_PROFILE
+    // 曲线末端速度趋于 0, 与原地转向一样留 ANGLE_THRESHOLD_DEG 的余量
+    if (car.circle_accumulated_angle >= car.circle_target_angle - ANGLE_THRESHOLD_DEG &&
+        motion_profile_done(&car.profile)) {
+        if (car.profile.v_end > 0.0f) {
+            car.blend_pending = true;
+            return true;
+        }
+        car_reset();
+        car.state = CAR_STATE_STOP;
+        return true;
+    }
+#else
     if (car.circle_accumulated_angle >= car.circle_target_angle) {
         car_reset();
         car.state = CAR_STATE_STOP;
         return true;
     }
+#endif
     
     
     return false;
@@ -343,7 +648,18 @@ bool car_circle(float radius_cm, bool clockwise, float target_angle_deg) {
 void update_circle_control(void) {
 	
     // 计算内外轮速度差
+#if CAR_MOTION_PROFILE
+    // 圆心轨迹弧长跟踪曲线设定位置
+    motion_profile_step(&car.profile);
+    float arc_cm = car.circle_accumulated_angle * (M_PI / 180.0f) * car.circle_radius_cm;
+    float base_speed = car.profile.vel + PID_Calculate(car.profile.pos, arc_cm, &mileagePid);
+    // 外轮比中心快约 1/3, 追赶过猛时外轮跟不上, 轮速比失调, 实际半径偏离设定
+    if (base_speed > CIRCLE_SPEED + CIRCLE_CATCHUP_SPEED) {
+        base_speed = CIRCLE_SPEED + CIRCLE_CATCHUP_SPEED;
+    }
+#else
     float base_speed = CIRCLE_SPEED;  // 基础速度 cm/s
+#endif
     float outer_speed = base_speed * (car.circle_radius_cm + WHEEL_BASE_CM/2) / car.circle_radius_cm;
     float inner_speed = base_speed * (car.circle_radius_cm - WHEEL_BASE_CM/2) / car.circle_radius_cm;
     
@@ -359,6 +675,274 @@ void update_circle_control(void) {
     }
 }
 
+/* =============================================================================
+ * 继电器反馈自整定
+ * 继电器放在被整定 PID 的位置上, 输入输出与 update_xxx_control() 中的 PID_Calculate 一致;
+ * 速度环由继电器直接给 PWM (open_loop), 在主循环 20ms 节拍上运行, 比实时层多一拍延迟,
+ * 测得的 Ku 略小、Tu 略大, 结果偏保守.
+ * ============================================================================= */
+#define TUNE_SPEED_SETPOINT         40.0f       // cm/s
+#define TUNE_MILEAGE_SETPOINT       20.0f       // cm
+#define TUNE_STRAIGHT_BASE_SPEED    30.0f       // cm/s
+
+typedef struct {
+    float relay_amplitude;          // 继电器幅值, 单位同该环 PID 输出
+    float hysteresis;               // 回差, 单位同反馈
+    uint8_t settle_cycles;
+    uint8_t measure_cycles;
+    uint32_t timeout_ms;
+    uint8_t bias_adapt;             // 需要稳态输出的环 (速度环、弯道上的循迹环) 打开偏置修正
+    PID_TuneRule_e rule;
+} car_tune_profile_t;
+
+static const car_tune_profile_t tune_profiles[CAR_TUNE_LOOP_COUNT] = {
+    [CAR_TUNE_SPEED]    = { 600.0f, 2.0f, 3, 4, 8000,  1, PID_TUNE_RULE_TYREUS_LUYBEN },
+    [CAR_TUNE_MILEAGE]  = { 30.0f,  0.5f, 2, 3, 10000, 0, PID_TUNE_RULE_ZN_P },
+    [CAR_TUNE_STRAIGHT] = { 15.0f,  0.5f, 2, 3, 6000,  0, PID_TUNE_RULE_ZN_P },
+    [CAR_TUNE_ANGLE]    = { 25.0f,  0.5f, 2, 4, 10000, 0, PID_TUNE_RULE_ZN_PD },
+    [CAR_TUNE_TRACK]    = { 10.0f,  0.3f, 2, 3, 12000, 1, PID_TUNE_RULE_ZN_PD },
+};
+
+static const char *const tune_loop_names[CAR_TUNE_LOOP_COUNT] = {
+    "speed", "mileage", "straight", "angle", "track",
+};
+
+car_tune_result_t car_tune_result[CAR_TUNE_LOOP_COUNT];
+static PID_Autotune_t autotuner;
+
+static void car_autotune_begin(CAR_TUNE_LOOPS loop) {
+    const car_tune_profile_t *profile = &tune_profiles[loop];
+    float setpoint = 0.0f;
+
+    if (loop == CAR_TUNE_SPEED) {
+        setpoint = TUNE_SPEED_SETPOINT;
+    } else if (loop == CAR_TUNE_MILEAGE) {
+        setpoint = TUNE_MILEAGE_SETPOINT;
+    }
+    PID_AutotuneInit(&autotuner, setpoint, profile->relay_amplitude, profile->hysteresis,
+                     ENCODER_PERIOD_MS * 0.001f);
+    autotuner.settle_cycles = profile->settle_cycles;
+    autotuner.measure_cycles = profile->measure_cycles;
+    autotuner.timeout_ms = profile->timeout_ms;
+    autotuner.enable_bias_adapt = profile->bias_adapt;
+    if (loop == CAR_TUNE_SPEED) {
+        // 继电器从 0 ~ 2d 起步, 由偏置修正找到维持设定速度的 PWM
+        autotuner.output_bias = profile->relay_amplitude;
+        car.open_loop = true;
+    }
+    car.tune_loop = loop;
+    car.tune_ref_yaw = get_yaw();
+    car_tune_result[loop].valid = false;
+}
+
+static void car_autotune_finish(CAR_TUNE_LOOPS loop) {
+    car_tune_result_t *result = &car_tune_result[loop];
+    car_pid_table_t table;
+    car_pid_gain_t *gain;
+
+    if (PID_AutotuneGetGains(&autotuner, tune_profiles[loop].rule, ENCODER_PERIOD_MS * 0.001f,
+                             &result->kp, &result->ki, &result->kd) != 0) {
+        result->valid = false;
+        car_tune_report(loop);
+        return;
+    }
+    result->ku = autotuner.ku;
+    result->tu = autotuner.tu;
+    result->valid = true;
+
+    car_pid_get_table(&table);
+    gain = (loop == CAR_TUNE_SPEED)    ? &table.speed :
+           (loop == CAR_TUNE_MILEAGE)  ? &table.mileage :
+           (loop == CAR_TUNE_STRAIGHT) ? &table.straight :
+           (loop == CAR_TUNE_ANGLE)    ? &table.angle : &table.track;
+    gain->kp = result->kp;
+    gain->ki = result->ki;
+    gain->kd = result->kd;
+    car_apply_pid_table(&table);
+
+    car_tune_report(loop);
+}
+
+void car_tune_report(CAR_TUNE_LOOPS loop) {
+    if (loop >= CAR_TUNE_LOOP_COUNT) {
+        return;
+    }
+    const car_tune_result_t *result = &car_tune_result[loop];
+    if (!result->valid) {
+        usart_printf(UART_0_INST, "autotune %s: no result\r\n", tune_loop_names[loop]);
+        return;
+    }
+    // 后半行与 car_pid_default_table 的写法一致, 可直接抄回 task25k_car_pid_parameter.c
+    usart_printf(UART_0_INST, "autotune %s: Ku=%.3f Tu=%.3fs -> .%s = { %.3ff, %.4ff, %.3ff },\r\n",
+                 tune_loop_names[loop], result->ku, result->tu, tune_loop_names[loop],
+                 result->kp, result->ki, result->kd);
+}
+
+bool car_autotune(CAR_TUNE_LOOPS loop) {
+    if (loop >= CAR_TUNE_LOOP_COUNT) {
+        return true;
+    }
+    if (car.state != CAR_STATE_AUTOTUNE) {
+        car.state = CAR_STATE_AUTOTUNE;
+        car_reset();
+        car_autotune_begin(loop);
+    }
+    if (PID_AutotuneGetState(&autotuner) == PID_AUTOTUNE_RUNNING) {
+        return false;
+    }
+    // 速度环此时仍处于旁路, 在 car_reset() 恢复闭环之前换参数
+    car_autotune_finish(loop);
+    car_reset();
+    car.state = CAR_STATE_STOP;
+    return true;
+}
+
+void update_autotune_control(void) {
+    float left = 0.0f, right = 0.0f;
+
+    switch (car.tune_loop) {
+    case CAR_TUNE_SPEED: {
+        float speed = 0.0f;
+        for (int i = 0; i < motor_count; i++) {
+            speed += encoder.cmps[i];
+        }
+        int pwm = (int)PID_AutotuneStep(&autotuner, speed / motor_count);
+        for (int i = 0; i < motor_count; i++) {
+            car.open_loop_pwm[i] = pwm;
+        }
+        return;
+    }
+    case CAR_TUNE_MILEAGE:
+        left = right = PID_AutotuneStep(&autotuner, get_mileage_cm());
+        break;
+    case CAR_TUNE_STRAIGHT: {
+        float correction = PID_AutotuneStep(&autotuner, calculate_angle_error(car.tune_ref_yaw, get_yaw()));
+        left = TUNE_STRAIGHT_BASE_SPEED + correction;
+        right = TUNE_STRAIGHT_BASE_SPEED - correction;
+        break;
+    }
+    case CAR_TUNE_ANGLE:
+        left = PID_AutotuneStep(&autotuner, calculate_angle_error(car.tune_ref_yaw, get_yaw()));
+        right = -left;
+        break;
+    case CAR_TUNE_TRACK: {
+        float correction = PID_AutotuneStep(&autotuner, gray_get_position());
+        left = car.track_speed + correction;
+        right = car.track_speed - correction;
+        break;
+    }
+    default:
+        break;
+    }
+    for (int i = 0; i < motor_count; ++i)
+        car.target_speed[i] = (i < motor_count / 2) ? left : right;
+}
+
+void car_apply_pid_table(const car_pid_table_t *table) {
+    car_pid_apply_table(table);
+#if CAR_SPEED_PID_Q16
+    // 实时层随时可能进入速度环, 定点副本整组替换
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    for (int i = 0; i < motor_count; i++) {
+        speed_pid_q16[i].Kp = q16_from_float(speedPid[i].Kp);
+        speed_pid_q16[i].Ki = q16_from_float(speedPid[i].Ki);
+        speed_pid_q16[i].Kd = q16_from_float(speedPid[i].Kd);
+    }
+    __set_PRIMASK(primask);
+#endif
+}
+
+/* =============================================================================
+ * 速度环前馈标定
+ * 两轮同时开环阶梯加速 (FF_CALIB_PWM_STEP × 1..FF_CALIB_LEVELS), 每级 FF_CALIB_HOLD_TICKS 拍;
+ * 每个轮子单独得到 PWM-轮速表、死区和时间常数, 两侧电机不一致时前馈也能分别补偿.
+ * 与继电器整定一样在主循环节拍上运行, 两点法求时间常数不受这一拍延迟影响.
+ * ============================================================================= */
+#define FF_CALIB_PWM_STEP           300.0f
+#define FF_CALIB_LEVELS             6           // 最高 1800, 约 60% 占空比
+#define FF_CALIB_HOLD_TICKS         20          // 400ms
+
+static speed_ff_calib_t ff_calib[motor_count];
+
+static void car_ff_calib_begin(void) {
+    for (int i = 0; i < motor_count; i++) {
+        speed_ff_calib_init(&ff_calib[i], FF_CALIB_PWM_STEP, FF_CALIB_LEVELS, FF_CALIB_HOLD_TICKS,
+                            ENCODER_PERIOD_MS * 0.001f);
+    }
+    car.open_loop = true;
+}
+
+static void car_ff_calib_finish(void) {
+    speed_ff_model_t models[motor_count];
+
+    for (int i = 0; i < motor_count; i++) {
+        if (speed_ff_calib_get_state(&ff_calib[i]) != SPEED_FF_CALIB_DONE) {
+            usart_printf(UART_0_INST, "speed ff calibration failed on motor %d\r\n", i);
+            return;
+        }
+        models[i] = ff_calib[i].model;
+    }
+    car_apply_speed_ff(models);
+
+    for (int i = 0; i < motor_count; i++) {
+        usart_printf(UART_0_INST, "speed ff motor %d: tau=%.3fs\r\n", i, ff_calib[i].tau_s);
+    }
+    car_speed_ff_report();
+}
+
+void car_speed_ff_report(void) {
+    // 按 car_speed_ff_default 的定义打印, 整段替换 task25k_car_pid_parameter.c 中的同名定义即可上电生效
+    usart_printf(UART_0_INST, "const speed_ff_model_t car_speed_ff_default[motor_count] = {\r\n");
+    for (int i = 0; i < motor_count; i++) {
+        const speed_ff_model_t *m = &car_speed_ff[i];
+        if (!m->valid || m->count == 0) {
+            usart_printf(UART_0_INST, "    { 0 },\r\n");
+            continue;
+        }
+        usart_printf(UART_0_INST, "    { %u, %u, %.1ff,\r\n      {", (unsigned)m->valid, (unsigned)m->count,
+                     m->deadband_pwm);
+        for (int k = 0; k < m->count; k++) {
+            usart_printf(UART_0_INST, " %.1ff,", m->speed_cmps[k]);
+        }
+        usart_printf(UART_0_INST, " },\r\n      {");
+        for (int k = 0; k < m->count; k++) {
+            usart_printf(UART_0_INST, " %.1ff,", m->pwm[k]);
+        }
+        usart_printf(UART_0_INST, " },\r\n      %.4ff },\r\n", m->accel_gain);
+    }
+    usart_printf(UART_0_INST, "};\r\n");
+}
+
+bool car_ff_calibrate(void) {
+    if (car.state != CAR_STATE_FF_CALIB) {
+        car.state = CAR_STATE_FF_CALIB;
+        car_reset();
+        car_ff_calib_begin();
+    }
+    for (int i = 0; i < motor_count; i++) {
+        if (speed_ff_calib_get_state(&ff_calib[i]) == SPEED_FF_CALIB_RUNNING) {
+            return false;
+        }
+    }
+    car_ff_calib_finish();
+    car_reset();
+    car.state = CAR_STATE_STOP;
+    return true;
+}
+
+void update_ff_calib_control(void) {
+    for (int i = 0; i < motor_count; i++) {
+        car.open_loop_pwm[i] = (int)speed_ff_calib_step(&ff_calib[i], encoder.cmps[i]);
+    }
+}
+
+void car_apply_speed_ff(const speed_ff_model_t *models) {
+    for (int i = 0; i < motor_count; i++) {
+        car_speed_ff[i] = models[i];
+    }
+}
+
 float get_mileage_cm(void) {
     float output = 0;
     for (int i = 0; i < motor_count; i++) {
@@ -367,19 +951,160 @@ float get_mileage_cm(void) {
     return output / motor_count;
 }
 
+/**
+ * @brief 用本拍两侧车轮的累计行程增量预测位姿, 再用陀螺仪航向更新
+ */
+static void car_pose_update(void) {
+    float side[2] = {0.0f, 0.0f};
+    for (int i = 0; i < motor_count; i++) {
+        side[i < motor_count / 2 ? 0 : 1] += encoder.odometer_cm[i] - pose_last_odometer[i];
+        pose_last_odometer[i] = encoder.odometer_cm[i];
+    }
+    pose_estimator_predict(&car_pose, side[0] / (motor_count / 2), side[1] / (motor_count - motor_count / 2));
+#if CURRENT_IMU != NO_GYRO
+    pose_estimator_update_heading(&car_pose, get_yaw() * (M_PI / 180.0f) + pose_yaw_offset);
+#endif
+}
+
+void car_pose_reset(float x_cm, float y_cm, float heading_deg) {
+    for (int i = 0; i < motor_count; i++) {
+        pose_last_odometer[i] = encoder.odometer_cm[i];
+    }
+#if CURRENT_IMU != NO_GYRO
+    pose_yaw_offset = pose_estimator_wrap((heading_deg - get_yaw()) * (M_PI / 180.0f));
+#endif
+    pose_estimator_reset(&car_pose, x_cm, y_cm, heading_deg * (M_PI / 180.0f));
+}
+
+bool car_go_to(float x_cm, float y_cm) {
+    float dx = x_cm - car_pose.x;
+    float dy = y_cm - car_pose.y;
+
+    if (car.goto_phase == 0) {
+        if (hypotf(dx, dy) <= GOTO_ARRIVE_CM) {
+            return true;
+        }
+        // 目标方位与当前位姿航向之差, 加到陀螺仪航向上作为转向目标
+        float turn = pose_estimator_wrap(atan2f(dy, dx) - car_pose.theta) * (180.0f / M_PI);
+        car.goto_yaw = pose_estimator_wrap((get_yaw() + turn) * (M_PI / 180.0f)) * (180.0f / M_PI);
+        car.goto_phase = 1;
+    }
+    if (car.goto_phase == 1) {
+        if (!spin_turn(car.goto_yaw)) {
+            return false;
+        }
+        // 转向后的残余方位误差由直行的航向环消化, 距离取在车头方向上的投影
+        car.goto_distance_cm = dx * cosf(car_pose.theta) + dy * sinf(car_pose.theta);
+        car.goto_phase = 2;
+    }
+    if (car_move_cm(car.goto_distance_cm, CAR_STATE_GO_STRAIGHT)) {
+        car.goto_phase = 0;
+        return true;
+    }
+    return false;
+}
+
+bool car_follow_path(const path_point_t *points, uint8_t count) {
+    if (car.state != CAR_STATE_PATH) {
+        car_reset();
+        car.state = CAR_STATE_PATH;
+        path_follower_init(&car.path, points, count, PATH_SPEED, PATH_LOOKAHEAD_CM, WHEEL_BASE_CM,
+                           TIME_INTERVAL_S);
+    }
+    if (car.path.done) {
+        car_reset();
+        car.state = CAR_STATE_STOP;
+        return true;
+    }
+    return false;
+}
+
+void update_path_control(void) {
+    float left, right;
+    path_follower_step(&car.path, car_pose.x, car_pose.y, car_pose.theta, &left, &right);
+    for (int i = 0; i < motor_count; ++i) {
+        car.target_speed[i] = (i < motor_count / 2) ? left : right;
+    }
+}
+
+float car_segment_mileage_cm(void) {
+    return get_mileage_cm() - car.segment_origin_cm;
+}
+
+/**
+ * @brief 进入新一段运动, 返回本段起点速度
+ * 上一段带速度结束 (blend_pending) 且本段为直行/绕圈时不清零里程与输出, 从上一段的终点速度接着走;
+ * 否则与原来一样 car_reset() 后从静止开始
+ */
+static float car_begin_segment(CAR_STATES state) {
+    float start_speed = 0.0f;
+
+#if CAR_MOTION_PROFILE
+    if (car.blend_pending && (state == CAR_STATE_GO_STRAIGHT || state == CAR_STATE_CIRCLE)) {
+        start_speed = car.profile.v_end;
+        // 以上一段当前的设定位置为新起点, 设定值连续, 跟踪误差带入下一段
+        if (car.state == CAR_STATE_GO_STRAIGHT) {
+            car.segment_origin_cm += car.profile.pos;
+        } else {
+            car.segment_origin_cm = get_mileage_cm();
+        }
+        car.blend_pending = false;
+        PID_Reset(&mileagePid);
+        PID_Reset(&straightPid);
+    } else {
+        car_reset();
+    }
+#else
+    car_reset();
+#endif
+    car.state = state;
+    return start_speed;
+}
+
+float car_blend_speed(CAR_STATES next, float next_distance, bool heading_change) {
+#if CAR_MOTION_PROFILE
+    if (next == CAR_STATE_GO_STRAIGHT) {
+        float speed = motion_profile_stop_speed(&straight_limits, next_distance);
+        return (heading_change && speed > MP_CORNER_SPEED) ? MP_CORNER_SPEED : speed;
+    }
+    if (next == CAR_STATE_CIRCLE) {
+        return CIRCLE_SPEED;
+    }
+#else
+    (void)next;
+    (void)next_distance;
+    (void)heading_change;
+#endif
+    return 0.0f;
+}
+
 void car_reset(void) {
+#if !CAR_CONTROL_IN_ISR
     int pwms[motor_count];
+#endif
     
     // 清零电机相关状态
+    car.open_loop = false;
     for (int i = 0; i < motor_count; i++) {
         car.target_speed[i] = 0;
-        pwms[i] = 0;
-        PID_Reset(&speedPid[i]);
+        car.open_loop_pwm[i] = 0;
         encoder.distance_cm[i] = 0;
+        ff_pwm[i] = 0;
+#if CAR_SPEED_FEEDFORWARD
+        ff_last_target[i] = 0;
+#endif
+#if !CAR_CONTROL_IN_ISR
+        pwms[i] = 0;
+#endif
     }
+#if !CAR_CONTROL_IN_ISR
+    reset_speed_pid();
+#endif
     
     // 清零基本控制参数
     car.target_mileage_cm = 0;
+    car.segment_origin_cm = 0;
+    car.blend_pending = false;
 		
     // 重置所有PID控制器
     PID_Reset(&mileagePid);
@@ -394,8 +1119,14 @@ void car_reset(void) {
     car.circle_last_yaw = 0;           // 新增
     car.circle_accumulated_angle = 0;   // 新增
     
+#if CAR_CONTROL_IN_ISR
+    // 速度环 PID 与里程由实时层在下一拍清零
+    reset_seq++;
+    car_publish_command();
+#else
     // 设置PWM输出为0
     motor_set_pwms(pwms);
+#endif
 }
 
 
@@ -406,7 +1137,7 @@ void car_set_track_speed(float speed) {
 
 void car_set_base_speed(float speed) {
 	for (int i = 0; i < motor_count; i++) {
-		car.target_speed[i] = 0;
+		car.target_speed[i] = speed;
 	}
 }
 
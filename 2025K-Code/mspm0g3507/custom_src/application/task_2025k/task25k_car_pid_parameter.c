@@ -1,5 +1,6 @@
 
 #include "car_pid.h"
+#include "speed_ff.h"
 
 PID_Controller_t speedPid[motor_count];  // 支持最多4个电机
 PID_Controller_t mileagePid;
@@ -7,11 +8,27 @@ PID_Controller_t straightPid;
 PID_Controller_t anglePid;
 PID_Controller_t trackPid;
 
+// 手工整定的结果; 可用 pid_tuner 在仿真中重新整定后整段替换
+const car_pid_table_t car_pid_default_table = {
+    .speed    = { 55.0f, 5.0f, 3.0f },
+    .mileage  = { 5.0f,  0.4f, 0.0f },
+    .straight = { 2.9f,  0.0f, 0.7f },
+    .angle    = { 3.0f,  0.0f, 0.5f },
+    .track    = { 6.0f,  0.0f, 0.1f },
+};
+
+// 速度环前馈模型, 未标定 (valid = 0) 时前馈不起作用; 菜单 "Calib Speed FF" 标定后按 UART_0 打印的定义整段替换
+const speed_ff_model_t car_speed_ff_default[motor_count] = {0};
+
+static void set_gain(PID_Controller_t *pid, const car_pid_gain_t *gain) {
+    PID_SetParams(pid, gain->kp, gain->ki, gain->kd);
+}
+
 /* ------------ 速度 PID ------------ */
 void speed_pid_init(void) {
     for (int i = 0; i < motor_count; i++) {
         PID_Init(&speedPid[i], PID_TYPE_POSITION);    
-        PID_SetParams(&speedPid[i], 55.0, 5.0, 3.0);    
+        set_gain(&speedPid[i], &car_pid_default_table.speed);
         PID_SetOutputLimit(&speedPid[i], 3000.0, -3000.0); 
         PID_SetIntegralLimit(&speedPid[i], 3000.0, -3000.0); 
 
@@ -21,7 +38,7 @@ void speed_pid_init(void) {
 /* ------------ 里程 PID ------------ */
 void mileage_pid_init(void) {
 	PID_Init(&mileagePid, PID_TYPE_POSITION);    
-	PID_SetParams(&mileagePid, 5.0, 0.4, 0.0); 
+	set_gain(&mileagePid, &car_pid_default_table.mileage);
 	PID_SetOutputLimit(&mileagePid, 76.0, -76.0); 
 	PID_SetIntegralLimit(&mileagePid, 76.0, -76.0);
 	PID_SetIntegralSeparation(&mileagePid, 5);
@@ -30,21 +47,21 @@ void mileage_pid_init(void) {
 /* ------------ 直行 PID ------------ */
 void straight_pid_init(void) {
 	PID_Init(&straightPid, PID_TYPE_POSITION);    
-	PID_SetParams(&straightPid, 2.9, 0.0, 0.7);  
+	set_gain(&straightPid, &car_pid_default_table.straight);
 	PID_SetOutputLimit(&straightPid,75.0, -75.0); 
 }
 
 /* ------------ 角度 PID ------------ */
 void angle_pid_init(void) {
 	PID_Init(&anglePid, PID_TYPE_POSITION);    
-	PID_SetParams(&anglePid, 3, 0.0, 0.5);  
+	set_gain(&anglePid, &car_pid_default_table.angle);
 	PID_SetOutputLimit(&anglePid, 60.0, -60.0); 
 }
 
 /* ------------ 循迹 PID ------------ */
 void track_pid_init(void) {
     PID_Init(&trackPid, PID_TYPE_POSITION);
-    PID_SetParams(&trackPid, 6, 0, 0.1);
+    set_gain(&trackPid, &car_pid_default_table.track);
     PID_SetOutputLimit(&trackPid, 20, -20);
 }
 
@@ -57,3 +74,26 @@ void car_pid_init(void) {
 		track_pid_init();
 }
 
+void car_pid_apply_table(const car_pid_table_t *table) {
+    for (int i = 0; i < motor_count; i++) {
+        set_gain(&speedPid[i], &table->speed);
+    }
+    set_gain(&mileagePid, &table->mileage);
+    set_gain(&straightPid, &table->straight);
+    set_gain(&anglePid, &table->angle);
+    set_gain(&trackPid, &table->track);
+}
+
+static void get_gain(const PID_Controller_t *pid, car_pid_gain_t *gain) {
+    gain->kp = pid->Kp;
+    gain->ki = pid->Ki;
+    gain->kd = pid->Kd;
+}
+
+void car_pid_get_table(car_pid_table_t *table) {
+    get_gain(&speedPid[0], &table->speed);
+    get_gain(&mileagePid, &table->mileage);
+    get_gain(&straightPid, &table->straight);
+    get_gain(&anglePid, &table->angle);
+    get_gain(&trackPid, &table->track);
+}
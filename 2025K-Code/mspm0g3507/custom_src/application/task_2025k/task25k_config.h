@@ -2,6 +2,7 @@
 #define TASK_25_H__
 
 #include "stdint.h"
+#include "cam_protocol.h"
 
 typedef enum {
 	CAM_CMD_GO_LEFT = 0x01,
@@ -13,12 +14,37 @@ typedef struct maixCam_t {
 	uint8_t track_data;
 	uint8_t num;
 	CAM_CMD cmd;
+	cam_obstacle_t obstacles[CAM_MAX_OBSTACLES];	// 最近一次收到的圆柱布局
+	uint8_t obstacle_count;
+	cam_cylinder_t cylinders[CAM_CYLINDER_COUNT];	// 最近一次二进制识别结果: 各圆柱颜色与置信度
+	uint8_t cylinders_valid;						// 本次检测已收到 cylinders
 } maixCam_t;
 
 
+typedef enum {
+	TASK25K_BASE_PART1 = 0,
+	TASK25K_BASE_PART2,
+	TASK25K_BASE_PART3,
+	TASK25K_PLAY_PART1,
+	TASK25K_PLAY_PART2,
+	TASK25K_MISSION_COUNT,
+} task25k_mission_t;
+
 void init_task_table(void);
 void menu_init_and_create(void);
 
+/**
+ * @brief 启动一个比赛任务 (与菜单 "Run 25K App" 中对应项相同)
+ * @note 已有任务在运行时只提示 "Running Failed"; 完成与否通过 car_is_running() 查询
+ */
+void run_task25k_mission(task25k_mission_t mission);
+const char *task25k_mission_name(task25k_mission_t mission);
+
+/**
+ * @brief 上一次 Play Part 2 选中的路线: 0~3 固定路线, TASK25K_PART2_ROUTE_PLANNED 车上规划, 其余为未选 / 命令字无效
+ */
+uint8_t task25k_part2_route(void);
+
 #define NO_GYRO 0
 #define WIT_GYRO 1
 #define MPU6050_GYRO 2
@@ -26,6 +52,21 @@ void menu_init_and_create(void);
 
 #define CURRENT_IMU WIT_GYRO
 
+// UART_0 上接 WIT 陀螺仪或蓝牙模块 (共用同一串口, 二选一): 不用 WIT 陀螺仪时 UART_0 给蓝牙
+#define TASK25K_UART0_BLUETOOTH (CURRENT_IMU != WIT_GYRO)
+
+#define TASK25K_PATH_FOLLOW 1      // 1: Play Part 2 的路线按航点纯追踪连续行驶; 0: 直行 + 原地转向
+#define TASK25K_GRID_PLANNER 1     // 1: 摄像头报告了圆柱颜色 (或布局) 时 Play Part 2 在车上规划路线, 否则按命令字选固定路线
+#define TASK25K_PART2_ROUTE_PLANNED 4     // task25k_part2_route(): 车上规划的路线, 0~3 为固定路线 1~4
+// 识别区六个圆柱的场地坐标 (cm, 发车点坐标系), 顺序同摄像头 ROI 与 cam_msg_cylinders_t.items: (1,1) (1,3) (2,1) (3,3) (3,1) (3,2).
+// 行沿 y (第 1 行在左), 列沿 x (第 1 列最近); 按四条固定路线让出的通道推算, 上场前按实测修正
+#define TASK25K_CYLINDER_POS_CM { {115, 75}, {215, 75}, {115, 25}, {215, -25}, {115, -25}, {165, -25} }
+#define TASK25K_PART2_GOAL_X_CM 300.0f     // Play Part 2 终点 (发车点坐标系)
+#define TASK25K_PART2_GOAL_Y_CM 50.0f
+#define TASK25K_PART2_PREFIX_CM 60        // Play Part 2 等摄像头结果的同时先直行的距离 (四条路线公共的起始段, 不超过 85), 0 = 原地等
+#define TASK25K_CAM_TIMEOUT_MS  3000      // 等摄像头命令字的超时
+#define TASK25K_PART2_FALLBACK_CMD 0x01   // 摄像头超时未回复时按此命令字选路线, 0 = 停在起始段终点
+
 void setup_cam_protocol(void);
 extern maixCam_t maix_cam;
 
@@ -20,21 +20,22 @@ void imu_update(void) {
 #endif 
 
 period_task_t task_table[] = {
-   { EVENT_KEY_STATE_UPDATE,  RUN,  button_ticks,         20,  0 },    // 20ms
-   { EVENT_MENU_VAR_UPDATE,   RUN,  oled_menu_tick,       20,  0 },    // 20ms
-   { EVENT_PERIOD_PRINT,      IDLE, debug_task,           500, 0 },    // 500ms
-   { EVENT_ALERT,             RUN,  alert_ticks,          10,  0 },    // 10ms
-   { EVENT_CAR_STATE_MACHINE, IDLE, car_state_machine,    20,  0 },    // 20ms
-   { EVENT_CAR,               RUN,  car_task,             20,  0 },    // 20ms
-	 { EVENT_MUSIC_PLAYER,      RUN,  music_player_update,  5,   0 }, 		// 5ms
+   PERIOD_TASK(EVENT_KEY_STATE_UPDATE,  RUN,  button_ticks,         20,  CATCHUP_RUN_ALL),      // 20ms
+   PERIOD_TASK(EVENT_MENU_VAR_UPDATE,   RUN,  oled_menu_tick,       20,  CATCHUP_SKIP),         // 20ms
+   PERIOD_TASK(EVENT_PERIOD_PRINT,      IDLE, debug_task,           500, CATCHUP_SKIP),         // 500ms
+   PERIOD_TASK(EVENT_ALERT,             RUN,  alert_ticks,          10,  CATCHUP_RUN_ALL),      // 10ms
+   PERIOD_TASK(EVENT_CAR_STATE_MACHINE, IDLE, car_state_machine,    20,  CATCHUP_RUN_ONCE),     // 20ms
+   PERIOD_TASK(EVENT_CAR,               RUN,  car_task,             20,  CATCHUP_RUN_ONCE),     // 20ms
+	 PERIOD_TASK(EVENT_MUSIC_PLAYER,      RUN,  music_player_update,  5,   CATCHUP_RUN_ALL),   		// 5ms
 #if CURRENT_IMU == WIT_GYRO
-	 { EVENT_IMU_UPDATE,			  RUN,  wit_imu_process, 			 10,   0 }, 	  // 2ms
+	 PERIOD_TASK(EVENT_IMU_UPDATE,			  RUN,  wit_imu_process, 			 10,   CATCHUP_RUN_ONCE),  	  // 2ms
 #elif CURRENT_IMU == MPU6050_GYRO
-	 { EVENT_IMU_UPDATE,			  RUN,  mpu6050_dmp_update, 	 10,   0 }, 	  // 2ms
+	 PERIOD_TASK(EVENT_IMU_UPDATE,			  RUN,  mpu6050_dmp_update, 	 10,   CATCHUP_RUN_ONCE),  	  // 2ms
 #elif (CURRENT_IMU == IMU660RA_GYRO)
-	 { EVENT_IMU_UPDATE,			  RUN,  imu_update,	 			     5,   0  },
+	 PERIOD_TASK(EVENT_IMU_UPDATE,			  RUN,  imu_update,	 			     5,   CATCHUP_RUN_ONCE),
 #endif
-	 { EVENT_MAIXCAM, 					RUN,  camera_process,        1,    0 },
+	 PERIOD_TASK(EVENT_MAIXCAM, 					RUN,  camera_process,        PERIOD_EVENT_ONLY, CATCHUP_RUN_ONCE),   // 串口中断投递事件触发
+	 PERIOD_TASK(EVENT_BLUETOOTH, 				RUN,  bluetooth_process,     PERIOD_EVENT_ONLY, CATCHUP_RUN_ONCE),   // 串口中断投递事件触发 (TASK25K_UART0_BLUETOOTH)
 };
 
 void init_task_table(void) {
@@ -3,6 +3,7 @@
 #include "log_config.h"
 #include "log.h"
 #include "common_include.h"
+#include "grid_planner.h"
 
 
 /* =============================================================================
@@ -13,6 +14,8 @@ bool task_running_flag = false;
 void reset_cam(void) {
 	maix_cam.num = 0;
 	maix_cam.cmd = 0;
+	maix_cam.obstacle_count = 0;
+	maix_cam.cylinders_valid = 0;
 }
 
 bool wait_cam_num(void) {
@@ -31,6 +34,8 @@ bool wait_cam_cmd(void) {
 		}
 }
 void send_start_cmd(void) {
+		maix_cam.obstacle_count = 0;      // 只用这次检测报告的布局与颜色
+		maix_cam.cylinders_valid = 0;
 		camera_send_data((uint8_t *)"START", 5);
 }
 
@@ -42,117 +47,51 @@ void send_track_cmd(void) {
 		camera_send_data((uint8_t *)"TRACK", 5);
 }
 
-// 发送命令并等待响应的组合
-void add_send_and_wait(void (*send_func)(void), bool (*wait_func)(void)) {
-    car_add_function(send_func);
-    car_add_wait_func_true(wait_func);
-}
-
-// 简化的setup函数
-static void setup_base_part1(void) {
-	car_path_init();
-	car_add_straight(240);
-	car_add_turn(90.0f);
-	car_add_straight(50);
-	car_add_turn(0.0f);
-	car_add_straight(50);
-	car_set_loop(1);
-}
-
-static void setup_base_part2(void) {
-    car_path_init();
-		car_add_straight(70);
-		car_add_turn(46);
-		car_add_straight(70);
-		car_add_turn(-46);
-		car_add_straight(72);
-		car_add_turn(46);
-		car_add_straight(65);
-		car_add_float(&car.target_angle, 0);
-		car_add_straight(85);
-    car_set_loop(1);
-}
-
-static void setup_base_part3(void) {
-    car_path_init();
-		car_add_straight(115);
-		car_add_circle(35, true, 270);  // 半径20cm，逆时针
-		car_add_float(&car.target_angle, 90);
-		car_add_straight(44);
-		car_add_circle(38, true, 360); 
-		car_add_float(&car.target_angle, 0);
-		car_add_straight(205);
-    car_set_loop(1);
-}
-
-static void setup_play_part1(void) {
-		car_path_init();                                    // 初始化路径规划
-		car_add_straight(90);
-		car_add_turn(90.0f);
-		car_add_straight(95);
-		car_add_turn(0.0f);
-		car_add_straight(100);
-		car_add_turn(-90.0f);
-		car_add_straight(42);
-		car_add_turn(0.0f);
-		car_add_straight(100);
-    car_set_loop(1);
-}
-
-void play_part2_path1(void) {
-  	car_add_straight(87);
-		car_add_turn(90.0f);
-		car_add_straight(45);
-	  car_add_turn(0.0f);
-		car_add_straight(48);
-	  car_add_turn(90.0f);
-		car_add_straight(50);
-    car_add_turn(0.0f);
-		car_add_straight(95);
-    car_add_float(&car.target_angle,-90.0f);
-		car_add_straight(60);
-	  car_add_float(&car.target_angle,0.0f);
-		car_add_straight(70);  
-}
-void play_part2_path2(void) {
-		car_add_straight(97);
-		car_add_turn(90.0f);
-		car_add_straight(100);
-		car_add_turn(0.0f);
-		car_add_straight(95);
-		car_add_turn(-90.0f);
-		car_add_straight(50);
-		car_add_turn(0.0f);
-		car_add_straight(90); 
-}
-
-void play_part2_path3(void) {
-		car_add_straight(142);
-		car_add_turn(-90.0f);
-		car_add_straight(50);
-		car_add_turn(0.0f);
-		car_add_straight(100);
-		car_add_turn(90.0f);
-		car_add_straight(100);
-		car_add_turn(0.0f);
-		car_add_straight(70);   
-}
-
-void play_part2_path4(void) {
-		car_add_straight(85);
-	 	car_add_turn(-90.0f);
-		car_add_straight(50);
-	  car_add_turn(0.0f);
-		car_add_straight(103);
-		car_add_turn(90.0f);
-		car_add_straight(50);
-		car_add_turn(0.0f);
-		car_add_straight(50);
-	  car_add_float(&car.target_angle,90.0f);
-		car_add_straight(57);
-	  car_add_float(&car.target_angle, 0);
-		car_add_straight(80);
-}
+/* =============================================================================
+ * 任务动作程序 (const 表, 状态机直接按表执行)
+ * ============================================================================= */
+static const car_action_t base_part1_actions[] = {
+	CAR_ACT_STRAIGHT(240),
+	CAR_ACT_TURN(90.0f),
+	CAR_ACT_STRAIGHT(50),
+	CAR_ACT_TURN(0.0f),
+	CAR_ACT_STRAIGHT(50),
+};
+
+static const car_action_t base_part2_actions[] = {
+	CAR_ACT_STRAIGHT(70),
+	CAR_ACT_TURN(46),
+	CAR_ACT_STRAIGHT(70),
+	CAR_ACT_TURN(-46),
+	CAR_ACT_STRAIGHT(72),
+	CAR_ACT_TURN(46),
+	CAR_ACT_STRAIGHT(65),
+	CAR_ACT_FLOAT(&car.target_angle, 0),
+	CAR_ACT_STRAIGHT(85),
+};
+
+static const car_action_t base_part3_actions[] = {
+	CAR_ACT_STRAIGHT(115),
+	CAR_ACT_CIRCLE(35, true, 270),  // 半径35cm，顺时针
+	CAR_ACT_FLOAT(&car.target_angle, 90),
+	CAR_ACT_STRAIGHT(44),
+	CAR_ACT_CIRCLE(38, true, 360),
+	CAR_ACT_FLOAT(&car.target_angle, 0),
+	CAR_ACT_STRAIGHT(205),
+};
+
+static const car_action_t play_part1_actions[] = {
+	CAR_ACT_STRAIGHT(90),
+	CAR_ACT_TURN(90.0f),
+	CAR_ACT_STRAIGHT(95),
+	CAR_ACT_TURN(0.0f),
+	CAR_ACT_STRAIGHT(100),
+	CAR_ACT_TURN(-90.0f),
+	CAR_ACT_STRAIGHT(42),
+	CAR_ACT_TURN(0.0f),
+	CAR_ACT_STRAIGHT(100),
+};
+
 void play_1(void) {
 	set_alert_count(1);
 	start_alert();
@@ -172,81 +111,415 @@ void play_4(void) {
 	set_alert_count(4);
 	start_alert();
 }
-void task5_func(void) {
-	if (maix_cam.cmd == 0x01) {
-			car_add_function(play_1);
-			play_part2_path1();
 
-	} else if (maix_cam.cmd == 0x02) {
-			car_add_function(play_2);
-			play_part2_path2();
+// Play Part 2: 四条固定路线, 摄像头命令字 0x01~0x04 选择; 直行/转向版本从公共起始段的终点接着走
+#if TASK25K_PATH_FOLLOW
+// 与下面直行/转向版本同一条折线, 原点为出发点, x 轴为出发时车头方向 (陀螺仪 0°)
+static const path_point_t path1_points[] = {
+		{0, 0}, {87, 0}, {87, 45}, {135, 45}, {135, 95}, {230, 95}, {230, 35}, {300, 35},
+};
+static const path_point_t path2_points[] = {
+		{0, 0}, {97, 0}, {97, 100}, {192, 100}, {192, 50}, {282, 50},
+};
+static const path_point_t path3_points[] = {
+		{0, 0}, {142, 0}, {142, -50}, {242, -50}, {242, 50}, {312, 50},
+};
+static const path_point_t path4_points[] = {
+		{0, 0}, {85, 0}, {85, -50}, {188, -50}, {188, 0}, {238, 0}, {238, 57}, {318, 57},
+};
 
-	} else if (maix_cam.cmd == 0x03) {  
-			car_add_function(play_3);
-			play_part2_path3();
+static const car_action_t part2_path1_actions[] = {
+		CAR_ACT_FUNCTION(play_1),
+		CAR_ACT_PATH(path1_points),
+};
+static const car_action_t part2_path2_actions[] = {
+		CAR_ACT_FUNCTION(play_2),
+		CAR_ACT_PATH(path2_points),
+};
+static const car_action_t part2_path3_actions[] = {
+		CAR_ACT_FUNCTION(play_3),
+		CAR_ACT_PATH(path3_points),
+};
+static const car_action_t part2_path4_actions[] = {
+		CAR_ACT_FUNCTION(play_4),
+		CAR_ACT_PATH(path4_points),
+};
+#else
+static const car_action_t part2_path1_actions[] = {
+		CAR_ACT_FUNCTION(play_1),
+		CAR_ACT_STRAIGHT(87 - TASK25K_PART2_PREFIX_CM),
+		CAR_ACT_TURN(90.0f),
+		CAR_ACT_STRAIGHT(45),
+		CAR_ACT_TURN(0.0f),
+		CAR_ACT_STRAIGHT(48),
+		CAR_ACT_TURN(90.0f),
+		CAR_ACT_STRAIGHT(50),
+		CAR_ACT_TURN(0.0f),
+		CAR_ACT_STRAIGHT(95),
+		CAR_ACT_FLOAT(&car.target_angle, -90.0f),
+		CAR_ACT_STRAIGHT(60),
+		CAR_ACT_FLOAT(&car.target_angle, 0.0f),
+		CAR_ACT_STRAIGHT(70),
+};
+static const car_action_t part2_path2_actions[] = {
+		CAR_ACT_FUNCTION(play_2),
+		CAR_ACT_STRAIGHT(97 - TASK25K_PART2_PREFIX_CM),
+		CAR_ACT_TURN(90.0f),
+		CAR_ACT_STRAIGHT(100),
+		CAR_ACT_TURN(0.0f),
+		CAR_ACT_STRAIGHT(95),
+		CAR_ACT_TURN(-90.0f),
+		CAR_ACT_STRAIGHT(50),
+		CAR_ACT_TURN(0.0f),
+		CAR_ACT_STRAIGHT(90),
+};
+static const car_action_t part2_path3_actions[] = {
+		CAR_ACT_FUNCTION(play_3),
+		CAR_ACT_STRAIGHT(142 - TASK25K_PART2_PREFIX_CM),
+		CAR_ACT_TURN(-90.0f),
+		CAR_ACT_STRAIGHT(50),
+		CAR_ACT_TURN(0.0f),
+		CAR_ACT_STRAIGHT(100),
+		CAR_ACT_TURN(90.0f),
+		CAR_ACT_STRAIGHT(100),
+		CAR_ACT_TURN(0.0f),
+		CAR_ACT_STRAIGHT(70),
+};
+static const car_action_t part2_path4_actions[] = {
+		CAR_ACT_FUNCTION(play_4),
+		CAR_ACT_STRAIGHT(85 - TASK25K_PART2_PREFIX_CM),
+		CAR_ACT_TURN(-90.0f),
+		CAR_ACT_STRAIGHT(50),
+		CAR_ACT_TURN(0.0f),
+		CAR_ACT_STRAIGHT(103),
+		CAR_ACT_TURN(90.0f),
+		CAR_ACT_STRAIGHT(50),
+		CAR_ACT_TURN(0.0f),
+		CAR_ACT_STRAIGHT(50),
+		CAR_ACT_FLOAT(&car.target_angle, 90.0f),
+		CAR_ACT_STRAIGHT(57),
+		CAR_ACT_FLOAT(&car.target_angle, 0),
+		CAR_ACT_STRAIGHT(80),
+};
+#endif
 
-	} else if (maix_cam.cmd == 0x04) {
-			car_add_function(play_4);
-			play_part2_path4();
+static const car_program_t part2_path1 = CAR_PROGRAM(part2_path1_actions);
+static const car_program_t part2_path2 = CAR_PROGRAM(part2_path2_actions);
+static const car_program_t part2_path3 = CAR_PROGRAM(part2_path3_actions);
+static const car_program_t part2_path4 = CAR_PROGRAM(part2_path4_actions);
+
+#if TASK25K_GRID_PLANNER
+// 车上规划的路线: 动作写进 RAM 中的小表, 由 part2_route_select() 在选择路线时填好
+static grid_plan_t part2_plan;      // 航点在行驶期间须保持有效
+#if TASK25K_PATH_FOLLOW
+static car_action_t planned_actions[2];
+#else
+static car_action_t planned_actions[1 + 2 * (GRID_PLANNER_MAX_WAYPOINTS - 1)];
+#endif
+static car_program_t part2_planned = { planned_actions, 0 };
+
+// 报警次数仍按命令字
+static void play_cam_alert(void) {
+	if (maix_cam.cmd >= 0x01 && maix_cam.cmd <= 0x04) {
+		set_alert_count(maix_cam.cmd);
+		start_alert();
+	}
+}
+
+static const int16_t cylinder_pos_cm[CAM_CYLINDER_COUNT][2] = TASK25K_CYLINDER_POS_CM;
+
+/**
+ * @brief 按圆柱布局规划 Play Part 2 路线并填好 part2_planned
+ * @note 摄像头报告了布局时按布局规划; 否则取二进制识别结果中各圆柱的颜色, 位置用固定的 TASK25K_CYLINDER_POS_CM
+ * @return false 表示没有识别结果或规划失败, 由调用者退回固定路线
+ * @note 在状态机任务里同步执行, 期间 car_task 顺延; 此时起始段直行已停车, 速度环 (CAR_CONTROL_IN_ISR) 照常运行.
+ *       展开数不超过格子数, 耗时随日志输出
+ */
+static bool plan_part2_route(void) {
+	grid_obstacle_t obstacles[CAM_MAX_OBSTACLES];
+	uint8_t count;
+
+	if (maix_cam.obstacle_count > 0) {
+		count = maix_cam.obstacle_count;
+		for (uint8_t i = 0; i < count; i++) {
+			obstacles[i].x_cm = maix_cam.obstacles[i].x_cm;
+			obstacles[i].y_cm = maix_cam.obstacles[i].y_cm;
+			obstacles[i].color = maix_cam.obstacles[i].color;
+		}
+	} else if (maix_cam.cylinders_valid) {
+		count = CAM_CYLINDER_COUNT;
+		for (uint8_t i = 0; i < count; i++) {
+			obstacles[i].x_cm = cylinder_pos_cm[i][0];
+			obstacles[i].y_cm = cylinder_pos_cm[i][1];
+			obstacles[i].color = maix_cam.cylinders[i].color;
+		}
+	} else {
+		return false;
+	}
+	path_point_t start = { car_pose.x, car_pose.y };
+	path_point_t goal = { TASK25K_PART2_GOAL_X_CM, TASK25K_PART2_GOAL_Y_CM };
+	uint32_t t0 = get_us();
+	grid_plan_result_t result = grid_planner_plan(obstacles, count, start, goal, &part2_plan);
+	uint32_t plan_us = get_us() - t0;
+	if (result != GRID_PLAN_OK) {
+		log_i("Grid plan failed: %s (%lu us)", grid_planner_result_string(result), (unsigned long)plan_us);
+		return false;
+	}
+	log_i("Grid plan: %d points, %d cm, expanded %d, %lu us", part2_plan.count, (int)part2_plan.length_cm,
+	      part2_plan.expanded, (unsigned long)plan_us);
+
+	uint8_t n = 0;
+	planned_actions[n++] = (car_action_t)CAR_ACT_FUNCTION(play_cam_alert);
+#if TASK25K_PATH_FOLLOW
+	planned_actions[n++] = (car_action_t){ ACTION_PATH, { .path = { part2_plan.points, part2_plan.count } }, NULL };
+#else
+	for (uint8_t i = 1; i < part2_plan.count; i++) {
+		float dx = part2_plan.points[i].x - part2_plan.points[i - 1].x;
+		float dy = part2_plan.points[i].y - part2_plan.points[i - 1].y;
+		planned_actions[n++] = (car_action_t)CAR_ACT_TURN(atan2f(dy, dx) * 180.0f / 3.14159265f);
+		planned_actions[n++] = (car_action_t)CAR_ACT_STRAIGHT(sqrtf(dx * dx + dy * dy));
+	}
+#endif
+	part2_planned.count = n;
+	return true;
+}
+#endif
+
+static uint8_t part2_route = 0xFF;
+
+static const car_program_t *const part2_routes[] = {
+	&part2_path1, &part2_path2, &part2_path3, &part2_path4,
+#if TASK25K_GRID_PLANNER
+	&part2_planned,
+#endif
+};
+
+/**
+ * @brief 选择 Play Part 2 的路线: 有圆柱颜色 (或布局) 且规划成功时走规划路线, 否则按命令字选固定路线
+ * @return part2_routes[] 下标, 命令字无效时越界 (跳过)
+ */
+static uint8_t part2_route_select(void) {
+#if TASK25K_GRID_PLANNER
+	if (plan_part2_route()) {
+		part2_route = TASK25K_PART2_ROUTE_PLANNED;
+		return part2_route;
 	}
+#endif
+	part2_route = (uint8_t)(maix_cam.cmd - 1);
+	return part2_route;
 }
 
+uint8_t task25k_part2_route(void) {
+	return part2_route;
+}
+
+// 发 START 并等命令字, 在后台与起始段直行同时进行
+static const car_action_t cam_request_actions[] = {
+	CAR_ACT_FUNCTION(send_start_cmd),
+	CAR_ACT_WAIT_TRUE(wait_cam_cmd),
+};
+static const car_program_t cam_request_program = CAR_PROGRAM(cam_request_actions);
 
-static void setup_play_part2(void) {
-    car_path_init();
-		add_send_and_wait(send_start_cmd, wait_cam_cmd);  // 使用封装
-    car_add_function(task5_func);
-    car_set_loop(1);
+// 摄像头超时: 放弃这次识别, 按默认命令字走固定路线
+static void use_fallback_cmd(void) {
+	maix_cam.obstacle_count = 0;
+	maix_cam.cylinders_valid = 0;
+	maix_cam.cmd = TASK25K_PART2_FALLBACK_CMD;
 }
+static const car_action_t cam_fallback_actions[] = {
+	CAR_ACT_FUNCTION(use_fallback_cmd),
+};
+static const car_program_t cam_fallback_program = CAR_PROGRAM(cam_fallback_actions);
+static const car_action_opts_t cam_join_opts = { TASK25K_CAM_TIMEOUT_MS, NULL, &cam_fallback_program };
+
+static const car_action_t play_part2_actions[] = {
+	CAR_ACT_FORK(&cam_request_program),
+#if TASK25K_PART2_PREFIX_CM > 0
+	CAR_ACT_STRAIGHT(TASK25K_PART2_PREFIX_CM),
+#endif
+	CAR_ACT_EX(&cam_join_opts, ACTION_JOIN, .join = { 0 }),
+	CAR_ACT_SWITCH(part2_route_select, part2_routes),
+};
+
+static const car_program_t base_part1_program = CAR_PROGRAM(base_part1_actions);
+static const car_program_t base_part2_program = CAR_PROGRAM(base_part2_actions);
+static const car_program_t base_part3_program = CAR_PROGRAM(base_part3_actions);
+static const car_program_t play_part1_program = CAR_PROGRAM(play_part1_actions);
+static const car_program_t play_part2_program = CAR_PROGRAM(play_part2_actions);
 
-static void run_task(const char *task_name, bool *task_flag, void (*setup_func)(void)) {
+static void run_task(const char *task_name, bool *task_flag, const car_program_t *program) {
     if (*task_flag == true) {
         show_message("Running Failed");
         return;
     }
     *task_flag = true;
     show_message(task_name);    
-    setup_func();     // 调用设置函数
+    car_load_program(program, 1);   // 装入动作程序 (不复制)
     car_start();      // 启动状态机
     enable_periodic_task(EVENT_CAR_STATE_MACHINE);
 		enable_periodic_task(EVENT_CAR);
 }
 
+static const struct {
+    const char *name;
+    const car_program_t *program;
+} mission_table[TASK25K_MISSION_COUNT] = {
+    [TASK25K_BASE_PART1] = { "Base Part 01", &base_part1_program },
+    [TASK25K_BASE_PART2] = { "Base Part 02", &base_part2_program },
+    [TASK25K_BASE_PART3] = { "Base Part 03", &base_part3_program },
+    [TASK25K_PLAY_PART1] = { "Play Part 01", &play_part1_program },
+    [TASK25K_PLAY_PART2] = { "Play Part 02", &play_part2_program },
+};
+
+void run_task25k_mission(task25k_mission_t mission) {
+    if (mission >= TASK25K_MISSION_COUNT) {
+        return;
+    }
+    run_task(mission_table[mission].name, &task_running_flag, mission_table[mission].program);
+}
+
+const char *task25k_mission_name(task25k_mission_t mission) {
+    return (mission < TASK25K_MISSION_COUNT) ? mission_table[mission].name : "";
+}
+
 static void run_base_part01_cb(void *arg) {
-    run_task("Base Part 01", &task_running_flag, setup_base_part1);
+    (void)arg;
+    run_task25k_mission(TASK25K_BASE_PART1);
 }
 
 static void run_base_part02_cb(void *arg) {
-    run_task("Base Part 02", &task_running_flag, setup_base_part2);
+    (void)arg;
+    run_task25k_mission(TASK25K_BASE_PART2);
 }
 
 static void run_base_part03_cb(void *arg) {
-    run_task("Base Part 03", &task_running_flag, setup_base_part3);
+    (void)arg;
+    run_task25k_mission(TASK25K_BASE_PART3);
 }
 
 static void run_play_part01_cb(void *arg) {
-    run_task("Play Part 01", &task_running_flag, setup_play_part1);
+    (void)arg;
+    run_task25k_mission(TASK25K_PLAY_PART1);
 }
 
 static void run_play_part02_cb(void *arg) {
-    run_task("Play Part 02", &task_running_flag, setup_play_part2);
+    (void)arg;
+    run_task25k_mission(TASK25K_PLAY_PART2);
+}
+
+// 继电器自整定: 作为单动作任务运行, 结束后参数已写入对应 PID, 结果见 "System Status -> PID Params"
+static const car_action_t autotune_actions[CAR_TUNE_LOOP_COUNT] = {
+    [CAR_TUNE_SPEED]    = CAR_ACT_AUTOTUNE(CAR_TUNE_SPEED),
+    [CAR_TUNE_MILEAGE]  = CAR_ACT_AUTOTUNE(CAR_TUNE_MILEAGE),
+    [CAR_TUNE_STRAIGHT] = CAR_ACT_AUTOTUNE(CAR_TUNE_STRAIGHT),
+    [CAR_TUNE_ANGLE]    = CAR_ACT_AUTOTUNE(CAR_TUNE_ANGLE),
+    [CAR_TUNE_TRACK]    = CAR_ACT_AUTOTUNE(CAR_TUNE_TRACK),
+};
+
+static const car_program_t autotune_programs[CAR_TUNE_LOOP_COUNT] = {
+    [CAR_TUNE_SPEED]    = { &autotune_actions[CAR_TUNE_SPEED], 1 },
+    [CAR_TUNE_MILEAGE]  = { &autotune_actions[CAR_TUNE_MILEAGE], 1 },
+    [CAR_TUNE_STRAIGHT] = { &autotune_actions[CAR_TUNE_STRAIGHT], 1 },
+    [CAR_TUNE_ANGLE]    = { &autotune_actions[CAR_TUNE_ANGLE], 1 },
+    [CAR_TUNE_TRACK]    = { &autotune_actions[CAR_TUNE_TRACK], 1 },
+};
+
+static void run_autotune(CAR_TUNE_LOOPS loop, const char *name) {
+    run_task(name, &task_running_flag, &autotune_programs[loop]);
+}
+
+static void tune_speed_cb(void *arg) {
+    (void)arg;
+    run_autotune(CAR_TUNE_SPEED, "Tune Speed");
+}
+
+static void tune_mileage_cb(void *arg) {
+    (void)arg;
+    run_autotune(CAR_TUNE_MILEAGE, "Tune Mileage");
+}
+
+static void tune_straight_cb(void *arg) {
+    (void)arg;
+    run_autotune(CAR_TUNE_STRAIGHT, "Tune Straight");
+}
+
+static void tune_angle_cb(void *arg) {
+    (void)arg;
+    run_autotune(CAR_TUNE_ANGLE, "Tune Angle");
+}
+
+static void tune_track_cb(void *arg) {
+    (void)arg;
+    run_autotune(CAR_TUNE_TRACK, "Tune Track");
+}
+
+static void tune_report_cb(void *arg) {
+    (void)arg;
+    show_message("Tune -> UART0");
+    for (int i = 0; i < CAR_TUNE_LOOP_COUNT; i++) {
+        car_tune_report((CAR_TUNE_LOOPS)i);
+    }
+}
+
+// 速度环前馈标定, 结束后模型已写入 car_speed_ff[], 结果见 "System Status -> PID Params"
+static const car_action_t ff_calibrate_actions[] = {
+    CAR_ACT_FF_CALIBRATE(),
+};
+static const car_program_t ff_calibrate_program = CAR_PROGRAM(ff_calibrate_actions);
+
+static void calib_speed_ff_cb(void *arg) {
+    (void)arg;
+    run_task("Calib Speed FF", &task_running_flag, &ff_calibrate_program);
+}
+
+static void ff_report_cb(void *arg) {
+    (void)arg;
+    show_message("FF -> UART0");
+    car_speed_ff_report();
 }
 
 static void play_music_1_cb(void *arg) {
+	(void)arg;
 	show_message("Play Music1");
 	music_player_start(music_example_1, music_example_1_size);
 }
 
 static void play_music_2_cb(void *arg) {
+	(void)arg;
 	show_message("Play Music2");
 	music_player_start(music_example_2, music_example_2_size);
 }
 
 static void stop_music_cb(void *arg) {
+	(void)arg;
 	show_message("Stop Music");
 	music_player_stop();
 }
 
+#if PERIODIC_TASK_PROFILE
+static void dump_task_profile_cb(void *arg) {
+	(void)arg;
+	show_message("Profile -> UART0");
+	dump_periodic_task_profile();
+}
+#endif
+
+#if CAR_ACTION_STATS
+// 上一次任务各动作的计划/实际耗时, 找出拖慢整趟的动作
+static void dump_action_stats_cb(void *arg) {
+	(void)arg;
+	uint8_t count;
+	const car_action_stat_t *stats = car_action_stats(&count);
+	show_message("Stats -> UART0");
+	usart_printf(UART_0_INST, "program     idx type result  planned   actual\r\n");
+	for (uint8_t i = 0; i < count; i++) {
+		usart_printf(UART_0_INST, "0x%08lx %4u %4u %6u %6ums %6ums\r\n", (unsigned long)(uintptr_t)stats[i].program,
+		             (unsigned)stats[i].index, (unsigned)stats[i].type, (unsigned)stats[i].result,
+		             (unsigned)stats[i].planned_ms, (unsigned)stats[i].actual_ms);
+	}
+}
+#endif
+
 #if CURRENT_IMU == MPU6050_GYRO
 	extern float yaw, roll, pitch;
 #elif (CURRENT_IMU == IMU660RA_GYRO)
@@ -273,6 +546,42 @@ static menu_variable_t gyro_vars[] = {
 
 static menu_variable_t car_vars[] = {
     MENU_VAR_BINARY_8BIT("Gray", &gray_byte),
+    MENU_VAR_READONLY("Pose X", &car_pose.x, VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("Pose Y", &car_pose.y, VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("Pose Th", &car_pose.theta, VAR_TYPE_FLOAT),
+    MENU_VAR_END
+};
+
+static menu_variable_t pid_vars[] = {
+    MENU_VAR_READONLY("Spd Kp", &speedPid[0].Kp, VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("Spd Ki", &speedPid[0].Ki, VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("Spd Kd", &speedPid[0].Kd, VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("Mil Kp", &mileagePid.Kp, VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("Mil Ki", &mileagePid.Ki, VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("Mil Kd", &mileagePid.Kd, VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("Str Kp", &straightPid.Kp, VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("Str Kd", &straightPid.Kd, VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("Ang Kp", &anglePid.Kp, VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("Ang Kd", &anglePid.Kd, VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("Trk Kp", &trackPid.Kp, VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("Trk Kd", &trackPid.Kd, VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("FF L Dead", &car_speed_ff[0].deadband_pwm, VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("FF L Acc", &car_speed_ff[0].accel_gain, VAR_TYPE_FLOAT),
+    // 折线各点的稳态轮速 (cm/s), 对应的 PWM 见 "FF Report"
+    MENU_VAR_READONLY("FF L v1", &car_speed_ff[0].speed_cmps[0], VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("FF L v2", &car_speed_ff[0].speed_cmps[1], VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("FF L v3", &car_speed_ff[0].speed_cmps[2], VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("FF L v4", &car_speed_ff[0].speed_cmps[3], VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("FF L v5", &car_speed_ff[0].speed_cmps[4], VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("FF L v6", &car_speed_ff[0].speed_cmps[5], VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("FF R Dead", &car_speed_ff[motor_count - 1].deadband_pwm, VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("FF R Acc", &car_speed_ff[motor_count - 1].accel_gain, VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("FF R v1", &car_speed_ff[motor_count - 1].speed_cmps[0], VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("FF R v2", &car_speed_ff[motor_count - 1].speed_cmps[1], VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("FF R v3", &car_speed_ff[motor_count - 1].speed_cmps[2], VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("FF R v4", &car_speed_ff[motor_count - 1].speed_cmps[3], VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("FF R v5", &car_speed_ff[motor_count - 1].speed_cmps[4], VAR_TYPE_FLOAT),
+    MENU_VAR_READONLY("FF R v6", &car_speed_ff[motor_count - 1].speed_cmps[5], VAR_TYPE_FLOAT),
     MENU_VAR_END
 };
 
@@ -291,6 +600,17 @@ void menu_init_and_create(void) {
 		ADD_ACTION(tasks1_menu, _25_task4, "Run Play Part1", run_play_part01_cb);
 		ADD_ACTION(tasks1_menu, _25_task5, "Run Play Part2", run_play_part02_cb);
 	
+		ADD_SUBMENU(main_menu, tune_menu, "PID Auto Tune", NULL);
+		ADD_ACTION(tune_menu, tune_speed, "Tune Speed", tune_speed_cb);
+		ADD_ACTION(tune_menu, tune_mileage, "Tune Mileage", tune_mileage_cb);
+		ADD_ACTION(tune_menu, tune_straight, "Tune Straight", tune_straight_cb);
+		ADD_ACTION(tune_menu, tune_angle, "Tune Angle", tune_angle_cb);
+		ADD_ACTION(tune_menu, tune_track, "Tune Track", tune_track_cb);
+		ADD_ACTION(tune_menu, tune_report, "Tune Report", tune_report_cb);
+
+		ADD_ACTION(main_menu, calib_ff, "Calib Speed FF", calib_speed_ff_cb);
+		ADD_ACTION(main_menu, ff_report, "FF Report", ff_report_cb);
+
 		ADD_SUBMENU(main_menu, PlayMusic, "Play Music", NULL);
 		ADD_ACTION(PlayMusic, music1, "ChunRiYing", play_music_1_cb);
     ADD_ACTION(PlayMusic, music2, "TianKongZhiCheng", play_music_2_cb);
@@ -299,6 +619,13 @@ void menu_init_and_create(void) {
 		ADD_SUBMENU(main_menu, status_menu, "System Status", NULL);
 		ADD_VAR_VIEW(status_menu, gyro_status_view, "Gyro Status", gyro_vars);
 		ADD_VAR_VIEW(status_menu, car_status_view, "Car Status", car_vars);
+		ADD_VAR_VIEW(status_menu, pid_status_view, "PID Params", pid_vars);
+#if PERIODIC_TASK_PROFILE
+		ADD_ACTION(status_menu, task_profile, "Task Profile", dump_task_profile_cb);
+#endif
+#if CAR_ACTION_STATS
+		ADD_ACTION(status_menu, action_stats, "Action Stats", dump_action_stats_cb);
+#endif
     create_oled_menu(&main_menu);
 }
 
@@ -12,6 +12,7 @@
 //==============================================================================
 #include "ti_msp_dl_config.h"               // TI MSP430驱动库配置
 #include "systick.h"                        // 系统定时器
+#include "hal_math.h"                       // 数学运算 (MATHACL 硬件加速)
 #include "mpuiic.h"                         // MPU I2C通信接口
 #include "inv_mpu.h"                        // MPU陀螺仪/加速度计驱动
 
@@ -46,6 +47,9 @@
 //==============================================================================
 #include "serialplot_protocol.h"           // 串口绘图通信协议
 #include "periodic_event_task.h"           // 周期性事件任务管理
+#include "realtime_task.h"                 // 定时器中断实时任务层
+#include "low_power.h"                     // 主循环空闲睡眠
+#include "event_queue.h"                   // 中断 -> 主循环延迟处理队列
 #include "cam_protocol.h"									 // 私有摄像头协议
 
 //==============================================================================
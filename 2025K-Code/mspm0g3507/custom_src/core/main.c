@@ -122,6 +122,7 @@
 void system_init(void) 
 {
     SYSCFG_DL_init();
+		hal_math_init();      // MATHACL 上电自检, 失败时数学运算回退到软件
 		beep_init();
 		systick_init();
 		car_init();
@@ -141,6 +142,9 @@ void main_task_init(void)
 		init_attitude(&attitude, 0.005f);
 #else
 	
+#endif
+#if TASK25K_UART0_BLUETOOTH
+		bluetooth_init();
 #endif
 
 		camera_init();
@@ -154,6 +158,9 @@ void main_task_init(void)
     car_init();
 		gray_detection_init();
 		create_periodic_event_task(); // 初始化任务调度器
+#if CAR_CONTROL_IN_ISR
+		realtime_task_start();        // 启动实时控制层定时器
+#endif
 }
 
 void test_task(void) 
@@ -176,6 +183,9 @@ int main(void)
 
     while (1) {
         periodic_event_task_process(); // 处理所有任务
+#if LOW_POWER_IDLE
+        low_power_idle();              // 没有到期任务时 WFI 睡眠, 中断唤醒
+#endif
     }
 
     return 0;
@@ -184,7 +194,9 @@ int main(void)
 
 void HardFault_Handler(void) 
 {
+    usart_tx_force_commit(UART_0_INST);   // 被打断的发送不会再提交, 否则后面的日志一直不发布
     log_e("!!! Unhandled Interrupt HardFault_Handler !!!\n");
+    usart_flush(UART_0_INST, 0);    // 异常中 TX 中断不会执行, 轮询发完
     
     play_alert_blocking(3, COLOR_RED);
     
@@ -0,0 +1,63 @@
+/**
+ * @file double_buffer.h
+ * @brief 实时中断层与主循环之间交换数据用的无锁双缓冲
+ *
+ * 单写者/单读者:
+ *  - 写者把新数据写入后台槽, 再递增 seq 发布, 永远不碰当前前台槽
+ *  - 读者复制前台槽, 若复制期间 seq 变化 (被写者抢占) 则重读
+ * 写者为中断、读者为主循环时读者可能重试; 写者为主循环、读者为中断时,
+ * 中断不会被主循环打断, 一次即可读到完整数据.
+ */
+#ifndef DOUBLE_BUFFER_H__
+#define DOUBLE_BUFFER_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__ARM_ARCH)
+#include "ti_msp_dl_config.h"
+#define DOUBLE_BUFFER_BARRIER()     __DMB()
+#else
+#define DOUBLE_BUFFER_BARRIER()     __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+typedef struct {
+    void *slot[2];              // 两个数据槽, 由调用者提供
+    size_t size;                // 每个槽的字节数
+    volatile uint32_t seq;      // 已发布次数, 前台槽 = slot[seq & 1]
+} double_buffer_t;
+
+static inline void double_buffer_init(double_buffer_t *db, void *slot0, void *slot1, size_t size) {
+    db->slot[0] = slot0;
+    db->slot[1] = slot1;
+    db->size = size;
+    db->seq = 0;
+    memset(slot0, 0, size);
+    memset(slot1, 0, size);
+}
+
+/**
+ * @brief 发布一份新数据 (写者调用)
+ */
+static inline void double_buffer_write(double_buffer_t *db, const void *src) {
+    uint32_t seq = db->seq;
+    memcpy(db->slot[(seq + 1u) & 1u], src, db->size);
+    DOUBLE_BUFFER_BARRIER();
+    db->seq = seq + 1u;
+}
+
+/**
+ * @brief 读取最近一次发布的完整数据 (读者调用)
+ */
+static inline void double_buffer_read(const double_buffer_t *db, void *dst) {
+    uint32_t seq;
+    do {
+        seq = db->seq;
+        DOUBLE_BUFFER_BARRIER();
+        memcpy(dst, db->slot[seq & 1u], db->size);
+        DOUBLE_BUFFER_BARRIER();
+    } while (seq != db->seq);
+}
+
+#endif // DOUBLE_BUFFER_H__
@@ -0,0 +1,86 @@
+#include "event_queue.h"
+
+#if defined(__ARM_ARCH)
+#include "ti_msp_dl_config.h"
+#define EVENT_QUEUE_BARRIER()       __DMB()
+#else
+#define EVENT_QUEUE_BARRIER()       __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+#define EVENT_QUEUE_MASK            (EVENT_QUEUE_SIZE - 1u)
+
+#if (EVENT_QUEUE_SIZE & EVENT_QUEUE_MASK) != 0 || EVENT_QUEUE_SIZE > 128
+#error "EVENT_QUEUE_SIZE must be a power of two no larger than 128"
+#endif
+
+static volatile uint8_t event_buffer[EVENT_QUEUE_SIZE];
+static volatile uint8_t event_head = 0;     // 只由生产者修改
+static volatile uint8_t event_tail = 0;     // 只由消费者修改
+static volatile uint8_t event_pending[NUM_PERIOD_TASKS];
+static volatile uint32_t event_dropped = 0;
+
+void event_queue_init(void) {
+    event_tail = event_head;
+    for (int i = 0; i < NUM_PERIOD_TASKS; i++) {
+        event_pending[i] = 0;
+    }
+    event_dropped = 0;
+}
+
+/**
+ * @brief 投递一个事件
+ * @param event_id 事件 ID
+ * @return true 已入队或已在队列中等待处理
+ * @note 调用前应先把数据写入对应的接收缓冲区, 处理函数一定能看到这些数据
+ */
+bool event_queue_post(EVENT_IDS event_id) {
+    if ((uint32_t)event_id >= NUM_PERIOD_TASKS) {
+        return false;
+    }
+    if (event_pending[event_id]) {
+        return true;
+    }
+
+    uint8_t head = event_head;
+    if ((uint8_t)(head - event_tail) >= EVENT_QUEUE_SIZE) {
+        event_dropped++;
+        return false;
+    }
+
+    event_pending[event_id] = 1;
+    event_buffer[head & EVENT_QUEUE_MASK] = (uint8_t)event_id;
+    // 先写元素再发布 head, 消费者看到新的 head 时元素一定已就绪
+    EVENT_QUEUE_BARRIER();
+    event_head = (uint8_t)(head + 1u);
+    return true;
+}
+
+/**
+ * @brief 取出一个事件
+ * @param event_id 输出事件 ID
+ * @return false 队列为空
+ * @note 出队时清除 pending 标志, 处理函数执行期间到来的新数据会重新入队
+ */
+bool event_queue_pop(EVENT_IDS *event_id) {
+    uint8_t tail = event_tail;
+    if (tail == event_head) {
+        return false;
+    }
+    EVENT_QUEUE_BARRIER();
+
+    uint8_t id = event_buffer[tail & EVENT_QUEUE_MASK];
+    event_pending[id] = 0;
+    EVENT_QUEUE_BARRIER();
+    event_tail = (uint8_t)(tail + 1u);
+
+    *event_id = (EVENT_IDS)id;
+    return true;
+}
+
+bool event_queue_empty(void) {
+    return event_tail == event_head;
+}
+
+uint32_t event_queue_get_dropped(void) {
+    return event_dropped;
+}
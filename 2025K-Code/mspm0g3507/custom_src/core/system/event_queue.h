@@ -0,0 +1,29 @@
+/**
+ * @file event_queue.h
+ * @brief 中断 -> 主循环的无锁延迟处理队列
+ *
+ * 单生产者/单消费者环形队列, 元素为 EVENT_IDS:
+ *  - 生产者是串口等外设中断 (同一优先级, 不会互相嵌套, 视为单一生产者)
+ *  - 消费者是主循环里的调度器, 取出事件后立即执行对应任务
+ * 每个事件带 pending 标志, 同一事件在被处理前重复投递只入队一次,
+ * 因此队列长度不小于事件种类数时永远不会溢出.
+ */
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "periodic_event_task.h"
+
+// 队列长度, 必须是 2 的幂且不小于 NUM_PERIOD_TASKS
+#ifndef EVENT_QUEUE_SIZE
+#define EVENT_QUEUE_SIZE 16
+#endif
+
+void event_queue_init(void);
+bool event_queue_post(EVENT_IDS event_id);      // 中断中调用
+bool event_queue_pop(EVENT_IDS *event_id);      // 主循环中调用
+bool event_queue_empty(void);
+uint32_t event_queue_get_dropped(void);
+
+#endif // EVENT_QUEUE_H
@@ -0,0 +1,51 @@
+#include "low_power.h"
+#include "ti_msp_dl_config.h"
+#include "periodic_event_task.h"
+#include "systick.h"
+
+static low_power_stats_t low_power_stats;
+
+/**
+ * @brief 主循环空闲处理, 在 periodic_event_task_process() 之后调用
+ * @note 关中断后再检查是否有任务到期, 再执行 WFI:
+ *       检查之后到来的中断会保持挂起, WFI 立即返回, 不会丢失唤醒.
+ *       唤醒后开中断, 挂起的中断服务函数随即执行.
+ *       SysTick 保留 1ms 节拍 (get_ms/get_us 依赖它), 每个节拍最多唤醒一次,
+ *       唤醒后只比较一次堆顶, 开销只有几微秒.
+ */
+void low_power_idle(void) {
+    uint32_t start_us = get_us();
+
+    __disable_irq();
+    if (get_periodic_task_idle_ms() == 0) {
+        __enable_irq();
+        return;
+    }
+    __WFI();
+    __enable_irq();
+
+    low_power_stats.sleep_count++;
+    low_power_stats.sleep_us += get_us() - start_us;
+}
+
+const low_power_stats_t *low_power_get_stats(void) {
+    return &low_power_stats;
+}
+
+/**
+ * @brief 计算统计窗口内的 CPU 占用率
+ * @return 0~100, 窗口为空时返回 0
+ */
+uint8_t low_power_get_cpu_load(void) {
+    uint32_t window_us = get_us() - low_power_stats.window_start_us;
+    if (window_us == 0 || low_power_stats.sleep_us >= window_us) {
+        return 0;
+    }
+    return (uint8_t)(100u - (uint32_t)(low_power_stats.sleep_us * 100u / window_us));
+}
+
+void low_power_clear_stats(void) {
+    low_power_stats.sleep_count = 0;
+    low_power_stats.sleep_us = 0;
+    low_power_stats.window_start_us = get_us();
+}
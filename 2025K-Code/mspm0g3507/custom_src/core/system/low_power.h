@@ -0,0 +1,28 @@
+#ifndef LOW_POWER_H
+#define LOW_POWER_H
+
+#include <stdint.h>
+
+/*
+ * 主循环空闲睡眠: 调度器没有到期任务时执行 WFI, 进入 SysConfig 配置的 SLEEP0.
+ * SLEEP0 只关 CPU 时钟, 外设照常运行, SysTick / TIMG0 / UART / 编码器 GPIO
+ * 中断都能唤醒 CPU, 唤醒后回到主循环重新检查调度器.
+ */
+
+// 主循环空闲睡眠开关, 0 时保持原来的忙等主循环 (便于用逻辑分析仪测量任务耗时)
+#ifndef LOW_POWER_IDLE
+#define LOW_POWER_IDLE 1
+#endif
+
+typedef struct {
+    uint32_t sleep_count;       // 进入 WFI 的次数
+    uint64_t sleep_us;          // 累计睡眠时间 (含唤醒中断本身的执行时间)
+    uint32_t window_start_us;   // 统计窗口起点
+} low_power_stats_t;
+
+void low_power_idle(void);
+const low_power_stats_t *low_power_get_stats(void);
+uint8_t low_power_get_cpu_load(void);   // 统计窗口内 CPU 占用率 (%)
+void low_power_clear_stats(void);
+
+#endif // LOW_POWER_H
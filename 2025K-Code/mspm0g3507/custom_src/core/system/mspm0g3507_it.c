@@ -4,22 +4,37 @@
 #include "wit_jyxx.h"
 #include "bluetooth.h"
 #include "maix_cam.h"
+#include "hal_uart.h"
+#include "hal_timer.h"
+#include "realtime_task.h"
+#include "task25k_config.h"
 
 /**
- * @brief UART 中断处理函数
+ * @brief UART 中断处理函数 - 接收交给 UART_0 上的设备 (WIT 陀螺仪或蓝牙, 见 TASK25K_UART0_BLUETOOTH)
  */
 void UART_0_INST_IRQHandler(void) {
-    uint8_t uart_data;
     DL_UART_IIDX idx = DL_UART_getPendingInterrupt(UART_0_INST);
-		wit_imu_uart_irq_handler(idx);
+    if (idx == DL_UART_IIDX_TX) {
+        usart_tx_irq_handler(UART_0_INST);
+    } else {
+#if TASK25K_UART0_BLUETOOTH
+        bluetooth_irq_handler(idx);
+#else
+        wit_imu_uart_irq_handler(idx);
+#endif
+    }
     DL_UART_clearInterruptStatus(UART_0_INST, idx);
 }
 
-// UART中断处理函数 - 简化版本，只负责接收数据到环形缓冲区
+// UART中断处理函数 - 接收交给摄像头驱动, 发送由 hal_uart 的发送队列接力
 void UART_1_INST_IRQHandler(void) {
     DL_UART_IIDX idx = DL_UART_getPendingInterrupt(UART_1_INST);
 
-		camera_irq_handler(DL_UART_IIDX_RX);
+    if (idx == DL_UART_IIDX_TX) {
+        usart_tx_irq_handler(UART_1_INST);
+    } else {
+        camera_irq_handler(idx);
+    }
     DL_UART_clearInterruptStatus(UART_1_INST, idx);
 }
 
@@ -27,4 +42,11 @@ void GROUP1_IRQHandler(void) {
    if (DL_Interrupt_getStatusGroup(DL_INTERRUPT_GROUP_1, PORTB_INT_IIDX)) {
 			encoder_group1_irq_handler();
     }
-}
\ No newline at end of file
+}
+
+// 实时控制层定时器中断
+void CONTROL_TIMER_INST_IRQHandler(void) {
+    if (hal_control_timer_ack_irq()) {
+        realtime_task_isr();
+    }
+}
@@ -1,42 +1,236 @@
 #include "periodic_event_task.h"
-#include "common_include.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
 //#include "log_config.h"
 #include "log.h"
 #include "systick.h"  // 包含get_ms()
+#include "event_queue.h"
+#if PERIODIC_TASK_PROFILE
+#include "hal_uart.h"   // dump_periodic_task_profile
+#endif
+
+/*
+ * 调度器按 next_run_time_ms 维护一个最小堆 (只含处于 RUN 状态的任务):
+ *  - 空闲时只需比较堆顶, 代价 O(1)
+ *  - 每次执行任务后重新下沉堆顶, 代价 O(log n)
+ *  - 使能/禁用任务时插入/删除堆节点, 代价 O(log n)
+ * 中断通过 event_queue 投递的事件优先处理, 对应任务不等周期到期立即执行.
+ */
+
+#define HEAP_POS_NONE 0xFF
+
+// 堆位置和任务下标都存成 uint8_t, 0xFF 留作 "不在堆中 / 无此任务"
+_Static_assert(PERIODIC_TASK_MAX < HEAP_POS_NONE, "PERIODIC_TASK_MAX must stay below HEAP_POS_NONE (uint8_t heap indices)");
 
 static period_task_t *period_tasks = NULL;
 static uint8_t task_count = 0;
 
+static uint8_t task_heap[PERIODIC_TASK_MAX];   // 堆节点: 任务在 period_tasks[] 中的下标
+static uint8_t heap_pos[PERIODIC_TASK_MAX];    // 任务下标 -> 堆中位置
+static uint8_t heap_size = 0;
+static uint8_t task_index[NUM_PERIOD_TASKS];    // 事件 ID -> 任务下标, 供事件分发查表
+
+#if PERIODIC_TASK_PROFILE
+static task_profile_t task_profiles[NUM_PERIOD_TASKS];
+static const uint32_t jitter_bin_limits_us[TASK_JITTER_BINS - 1] = TASK_JITTER_BIN_LIMITS_US;
+
+static void profile_record(const period_task_t *task, uint32_t deadline_ms,
+                           uint32_t start_us, uint32_t end_us);
+#endif
+
+static inline bool heap_less(uint8_t i, uint8_t j) {
+    return time_before(period_tasks[task_heap[i]].next_run_time_ms,
+                       period_tasks[task_heap[j]].next_run_time_ms);
+}
+
+static inline void heap_swap(uint8_t i, uint8_t j) {
+    uint8_t tmp = task_heap[i];
+    task_heap[i] = task_heap[j];
+    task_heap[j] = tmp;
+    heap_pos[task_heap[i]] = i;
+    heap_pos[task_heap[j]] = j;
+}
+
+static void heap_sift_up(uint8_t pos) {
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (!heap_less(pos, parent)) {
+            break;
+        }
+        heap_swap(pos, parent);
+        pos = parent;
+    }
+}
+
+static void heap_sift_down(uint8_t pos) {
+    for (;;) {
+        // 用 unsigned 计算子节点, 避免 PERIODIC_TASK_MAX 较大时 uint8_t 溢出
+        unsigned left = 2u * pos + 1u;
+        unsigned right = left + 1u;
+        uint8_t smallest = pos;
+
+        if (left < heap_size && heap_less(left, smallest)) {
+            smallest = (uint8_t)left;
+        }
+        if (right < heap_size && heap_less(right, smallest)) {
+            smallest = (uint8_t)right;
+        }
+        if (smallest == pos) {
+            break;
+        }
+        heap_swap(pos, smallest);
+        pos = smallest;
+    }
+}
+
+static void heap_push(uint8_t index) {
+    if (heap_pos[index] != HEAP_POS_NONE || heap_size >= PERIODIC_TASK_MAX) {
+        return;
+    }
+    task_heap[heap_size] = index;
+    heap_pos[index] = heap_size;
+    heap_size++;
+    heap_sift_up(heap_pos[index]);
+}
+
+static void heap_remove(uint8_t index) {
+    uint8_t pos = heap_pos[index];
+    if (pos == HEAP_POS_NONE) {
+        return;
+    }
+
+    heap_size--;
+    if (pos != heap_size) {
+        heap_swap(pos, heap_size);
+        heap_sift_down(pos);
+        heap_sift_up(pos);
+    }
+    heap_pos[index] = HEAP_POS_NONE;
+}
+
+/**
+ * @brief 锁相推进任务的下次到期时间, 并按补偿策略决定本次是否执行
+ * @param task 已到期的任务
+ * @param current_time 当前时间
+ * @return true 本次需要执行任务
+ * @note 下次到期时间总是在原截止时间上按 period_ms 整数倍推进,
+ *       执行延迟不会累积到后续周期
+ */
+static bool schedule_next_run(period_task_t *task, uint32_t current_time) {
+    uint32_t deadline = task->next_run_time_ms;
+
+    if (task->period_ms == 0) {
+        task->next_run_time_ms = current_time;
+        return true;
+    }
+
+    // 落后的完整周期数, 0 表示仍在本周期内 (正常抖动)
+    uint32_t missed = (current_time - deadline) / task->period_ms;
+    if (missed == 0) {
+        task->next_run_time_ms = deadline + task->period_ms;
+        return true;
+    }
+
+    task->overrun_count++;
+
+    switch (task->catch_up) {
+        case CATCHUP_RUN_ALL:
+            if (missed <= PERIODIC_CATCHUP_MAX_BURST) {
+                // 只推进一个周期, 下一轮主循环会继续补跑
+                task->next_run_time_ms = deadline + task->period_ms;
+                return true;
+            }
+            // 落后太多, 按 RUN_ONCE 处理
+            // fall through
+        case CATCHUP_RUN_ONCE:
+        default:
+            task->skipped_count += missed;
+            task->next_run_time_ms = deadline + (missed + 1) * task->period_ms;
+            return true;
+
+        case CATCHUP_SKIP:
+            task->skipped_count += missed + 1;
+            task->next_run_time_ms = deadline + (missed + 1) * task->period_ms;
+            return false;
+    }
+}
+
+/**
+ * @brief 任务是否参与周期调度 (进入截止时间堆)
+ */
+static inline bool task_is_periodic(const period_task_t *task) {
+    return task->is_running == RUN && task->task_handler != NULL &&
+           task->period_ms != PERIOD_EVENT_ONLY;
+}
+
+/**
+ * @brief 按当前时间重置所有任务的执行时间并重建堆
+ */
+static void rebuild_task_heap(uint32_t current_time) {
+    heap_size = 0;
+    for (int i = 0; i < task_count; i++) {
+        heap_pos[i] = HEAP_POS_NONE;
+    }
+    for (int i = 0; i < NUM_PERIOD_TASKS; i++) {
+        task_index[i] = HEAP_POS_NONE;
+    }
+
+    for (int i = 0; i < task_count; i++) {
+        period_tasks[i].last_run_time_ms = current_time;
+        period_tasks[i].next_run_time_ms = current_time + period_tasks[i].period_ms;
+        if ((uint32_t)period_tasks[i].id < NUM_PERIOD_TASKS) {
+            task_index[period_tasks[i].id] = i;
+        }
+        if (task_is_periodic(&period_tasks[i])) {
+            heap_push(i);
+        }
+    }
+}
+
+/**
+ * @brief 执行中断投递的所有事件对应的任务
+ * @note 一次最多处理 EVENT_QUEUE_SIZE 个, 处理期间新投递的事件留到下一轮
+ */
+static void dispatch_pending_events(void) {
+    EVENT_IDS event_id;
+    uint8_t budget = EVENT_QUEUE_SIZE;
+
+    while (budget-- > 0 && event_queue_pop(&event_id)) {
+        uint8_t index = task_index[event_id];
+        if (index == HEAP_POS_NONE) {
+            continue;
+        }
+        period_task_t *task = &period_tasks[index];
+        if (task->is_running == RUN && task->task_handler != NULL) {
+            task->task_handler();
+            task->last_run_time_ms = get_ms();
+        }
+    }
+}
+
 /**
  * @brief 初始化任务调度器
  * @param table 任务数组指针
- * @param count 任务数量
+ * @param count 任务数量 (超过 PERIODIC_TASK_MAX 的部分被忽略)
  */
 void init_task_scheduler(period_task_t *table, uint8_t count) {
     period_tasks = table;
-    task_count = count;
+    task_count = (count > PERIODIC_TASK_MAX) ? PERIODIC_TASK_MAX : count;
 
-    uint32_t current_time = get_ms();
-    
     // 初始化所有任务的上次执行时间
-    for (int i = 0; i < task_count; i++) {
-        period_tasks[i].last_run_time_ms = current_time;
-    }
-    
-    log_i("Task scheduler initialized with %d tasks", count);
+    rebuild_task_heap(get_ms());
+
+    log_i("Task scheduler initialized with %d tasks", task_count);
 }
 
 /**
  * @brief 初始化周期性任务调度器
  */
 void create_periodic_event_task(void) {
-    uint32_t current_time = get_ms();
-    
     // 初始化所有任务的上次执行时间
-    for (int i = 0; i < task_count; i++) {
-        period_tasks[i].last_run_time_ms = current_time;
-    }
-    
+    rebuild_task_heap(get_ms());
+
     log_i("Periodic task scheduler initialized");
 }
 
@@ -46,25 +240,41 @@ void create_periodic_event_task(void) {
  */
 void periodic_event_task_process(void) {
     uint32_t current_time = get_ms();
-    
-    // 遍历所有任务
-    for (int i = 0; i < task_count; i++) {
-        period_task_t *task = &period_tasks[i];
-        
-        // 检查任务是否需要执行
-        if (task->is_running == RUN && task->task_handler != NULL) {
-            // 计算距离上次执行的时间
-            uint32_t time_since_last_run = current_time - task->last_run_time_ms;
-            
-            // 检查是否到了执行时间
-            if (time_since_last_run >= task->period_ms) {
-                // 执行任务
-                task->task_handler();
-                
-                // 更新上次执行时间
-                task->last_run_time_ms = current_time;
-            }
+    // 每次调用每个任务最多执行一次, 避免 period_ms 为 0 的任务独占主循环
+    uint8_t budget = heap_size;
+
+    dispatch_pending_events();
+
+    while (heap_size > 0 && budget-- > 0) {
+        uint8_t index = task_heap[0];
+        period_task_t *task = &period_tasks[index];
+
+        // 堆顶任务未到期, 其余任务也都未到期
+        if (time_before(current_time, task->next_run_time_ms)) {
+            break;
         }
+
+#if PERIODIC_TASK_PROFILE
+        uint32_t deadline_ms = task->next_run_time_ms;
+#endif
+        if (schedule_next_run(task, current_time)) {
+#if PERIODIC_TASK_PROFILE
+            uint32_t start_us = get_us();
+            task->task_handler();
+            profile_record(task, deadline_ms, start_us, get_us());
+#else
+            task->task_handler();
+#endif
+            task->last_run_time_ms = current_time;
+        }
+
+        // 任务回调里可能禁用/重新使能了自身, 按当前位置调整
+        if (heap_pos[index] != HEAP_POS_NONE) {
+            heap_sift_down(heap_pos[index]);
+        }
+
+        // 长任务执行期间到来的事件不必等到下一轮主循环
+        dispatch_pending_events();
     }
 }
 
@@ -76,6 +286,11 @@ void enable_periodic_task(EVENT_IDS event_id) {
         if (period_tasks[i].id == event_id) {
             period_tasks[i].is_running = RUN;
             period_tasks[i].last_run_time_ms = get_ms();  // 重置执行时间
+            period_tasks[i].next_run_time_ms = period_tasks[i].last_run_time_ms + period_tasks[i].period_ms;
+            heap_remove(i);
+            if (task_is_periodic(&period_tasks[i])) {
+                heap_push(i);
+            }
             log_i("Task %d enabled", event_id);
             break;
         }
@@ -89,8 +304,155 @@ void disable_periodic_task(EVENT_IDS event_id) {
     for (int i = 0; i < task_count; i++) {
         if (period_tasks[i].id == event_id) {
             period_tasks[i].is_running = IDLE;
+            heap_remove(i);
             log_i("Task %d disabled", event_id);
             break;
         }
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 查询距离下一个任务到期还有多少毫秒
+ * @return 0 表示堆顶任务已到期或有待处理的事件; PERIODIC_IDLE_FOREVER 表示没有运行中的任务
+ * @note 只读堆顶, O(1), 供主循环决定能否进入睡眠
+ */
+uint32_t get_periodic_task_idle_ms(void) {
+    if (!event_queue_empty()) {
+        return 0;
+    }
+    if (heap_size == 0) {
+        return PERIODIC_IDLE_FOREVER;
+    }
+
+    uint32_t current_time = get_ms();
+    uint32_t deadline = period_tasks[task_heap[0]].next_run_time_ms;
+    if (!time_before(current_time, deadline)) {
+        return 0;
+    }
+    return deadline - current_time;
+}
+
+static period_task_t *find_periodic_task(EVENT_IDS event_id) {
+    for (int i = 0; i < task_count; i++) {
+        if (period_tasks[i].id == event_id) {
+            return &period_tasks[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 获取任务落后超过一个周期的次数
+ */
+uint32_t get_periodic_task_overrun(EVENT_IDS event_id) {
+    period_task_t *task = find_periodic_task(event_id);
+    return (task != NULL) ? task->overrun_count : 0;
+}
+
+/**
+ * @brief 获取任务被丢弃 (未执行) 的周期数
+ */
+uint32_t get_periodic_task_skipped(EVENT_IDS event_id) {
+    period_task_t *task = find_periodic_task(event_id);
+    return (task != NULL) ? task->skipped_count : 0;
+}
+
+/**
+ * @brief 清零所有任务的超时统计
+ */
+void clear_periodic_task_stats(void) {
+    for (int i = 0; i < task_count; i++) {
+        period_tasks[i].overrun_count = 0;
+        period_tasks[i].skipped_count = 0;
+    }
+}
+
+#if PERIODIC_TASK_PROFILE
+/**
+ * @brief 记录一次任务执行的耗时与启动抖动
+ * @param task 刚执行完的任务
+ * @param deadline_ms 本次执行对应的截止时间
+ * @param start_us 开始执行时间
+ * @param end_us 执行结束时间
+ */
+static void profile_record(const period_task_t *task, uint32_t deadline_ms,
+                           uint32_t start_us, uint32_t end_us) {
+    if ((uint32_t)task->id >= NUM_PERIOD_TASKS) {
+        return;
+    }
+    task_profile_t *prof = &task_profiles[task->id];
+
+    uint32_t run_us = end_us - start_us;
+    int32_t late = (int32_t)(start_us - deadline_ms * 1000u);
+    uint32_t jitter_us = (late > 0) ? (uint32_t)late : 0;
+
+    if (prof->run_count == 0 || run_us < prof->min_us) {
+        prof->min_us = run_us;
+    }
+    if (run_us > prof->max_us) {
+        prof->max_us = run_us;
+    }
+    prof->total_us += run_us;
+    prof->run_count++;
+
+    if (jitter_us > prof->max_jitter_us) {
+        prof->max_jitter_us = jitter_us;
+    }
+    uint8_t bin = 0;
+    while (bin < TASK_JITTER_BINS - 1 && jitter_us >= jitter_bin_limits_us[bin]) {
+        bin++;
+    }
+    prof->jitter_hist[bin]++;
+
+    if (task->period_ms > 0 && jitter_us + run_us > task->period_ms * 1000u) {
+        prof->missed_deadlines++;
+    }
+}
+
+/**
+ * @brief 获取指定任务的运行统计
+ */
+const task_profile_t *get_periodic_task_profile(EVENT_IDS event_id) {
+    if ((uint32_t)event_id >= NUM_PERIOD_TASKS) {
+        return NULL;
+    }
+    return &task_profiles[event_id];
+}
+
+/**
+ * @brief 清零所有任务的运行统计
+ */
+void clear_periodic_task_profile(void) {
+    memset(task_profiles, 0, sizeof(task_profiles));
+}
+
+/**
+ * @brief 通过调试串口输出统计表
+ * @note 阻塞发送, 只在需要时手动调用
+ */
+void dump_periodic_task_profile(void) {
+    usart_printf(UART_0_INST, "id  period  runs      min     mean      max   jit_max  miss  ovr  "
+                              "<100 <500 <1ms <2ms <5ms >5ms\r\n");
+    for (int i = 0; i < task_count; i++) {
+        const period_task_t *task = &period_tasks[i];
+        const task_profile_t *prof = get_periodic_task_profile(task->id);
+        if (prof == NULL || prof->run_count == 0) {
+            continue;
+        }
+        usart_printf(UART_0_INST, "%2d %5lums %6lu %6luus %6luus %6luus %7luus %5lu %4lu ",
+                     (int)task->id,
+                     (unsigned long)task->period_ms,
+                     (unsigned long)prof->run_count,
+                     (unsigned long)prof->min_us,
+                     (unsigned long)(prof->total_us / prof->run_count),
+                     (unsigned long)prof->max_us,
+                     (unsigned long)prof->max_jitter_us,
+                     (unsigned long)prof->missed_deadlines,
+                     (unsigned long)task->overrun_count);
+        for (int b = 0; b < TASK_JITTER_BINS; b++) {
+            usart_printf(UART_0_INST, "%4lu ", (unsigned long)prof->jitter_hist[b]);
+        }
+        usart_printf(UART_0_INST, "\r\n");
+    }
+}
+#endif
@@ -20,26 +20,89 @@ typedef enum {
     NUM_PERIOD_TASKS
 } EVENT_IDS;
 
+// 调度器可管理的最大任务数 (决定截止时间堆的大小)
+#ifndef PERIODIC_TASK_MAX
+#define PERIODIC_TASK_MAX NUM_PERIOD_TASKS
+#endif
+
+// RUN_ALL 策略一次最多补跑的周期数, 落后更多时退化为 RUN_ONCE
+#ifndef PERIODIC_CATCHUP_MAX_BURST
+#define PERIODIC_CATCHUP_MAX_BURST 4
+#endif
+
+// 任务执行时间/启动抖动统计开关, 0 时相关代码全部编译掉
+#ifndef PERIODIC_TASK_PROFILE
+#define PERIODIC_TASK_PROFILE 0
+#endif
+
+// 只由中断事件 (event_queue_post) 触发、不参与周期调度的任务, 填在 period_ms 字段
+#define PERIOD_EVENT_ONLY UINT32_MAX
+
+// 没有处于 RUN 状态的任务时, get_periodic_task_idle_ms() 的返回值
+#define PERIODIC_IDLE_FOREVER UINT32_MAX
+
 // 定义运行状态枚举
 typedef enum {
     RUN,
     IDLE,
 } TASK_STATE;
 
+// 错过截止时间 (落后超过一个周期) 时的补偿策略, 三种策略都保持相位不漂移
+typedef enum {
+    CATCHUP_RUN_ONCE = 0,   // 立即补跑一次, 丢弃其余错过的周期 (默认)
+    CATCHUP_SKIP,           // 本次不执行, 直接等到下一个相位点
+    CATCHUP_RUN_ALL,        // 逐个补跑每个错过的周期
+} TASK_CATCHUP;
+
 // 简化的任务结构体
 typedef struct {
     EVENT_IDS id;
     TASK_STATE is_running;
     void (*task_handler)(void);
     uint32_t period_ms;
+    TASK_CATCHUP catch_up;          // 错过周期后的补偿策略
     uint32_t last_run_time_ms;      // 上次执行时间
+    uint32_t next_run_time_ms;      // 下次到期时间 (调度器维护, 按 period_ms 锁相递增)
+    uint32_t overrun_count;         // 落后超过一个周期的次数
+    uint32_t skipped_count;         // 被丢弃 (未执行) 的周期数
 } period_task_t;
 
+// 任务表条目, 其余字段由调度器维护
+#define PERIOD_TASK(evt, state, handler, period, catchup) \
+    { .id = (evt), .is_running = (state), .task_handler = (handler), .period_ms = (period), .catch_up = (catchup) }
+
 // 基础API函数
 void init_task_scheduler(period_task_t *table, uint8_t count);
 void create_periodic_event_task(void);
 void periodic_event_task_process(void);
 void enable_periodic_task(EVENT_IDS event_id);
 void disable_periodic_task(EVENT_IDS event_id);
+uint32_t get_periodic_task_idle_ms(void);   // 距最早到期任务的毫秒数, 0 表示已有任务到期
+
+// 统计接口
+uint32_t get_periodic_task_overrun(EVENT_IDS event_id);
+uint32_t get_periodic_task_skipped(EVENT_IDS event_id);
+void clear_periodic_task_stats(void);
+
+#if PERIODIC_TASK_PROFILE
+// 启动抖动直方图分档上限 (us), 最后一档为超出最大上限的部分
+#define TASK_JITTER_BIN_LIMITS_US   { 100, 500, 1000, 2000, 5000 }
+#define TASK_JITTER_BINS            6
+
+// 单个任务的运行统计 (按 EVENT_IDS 索引)
+typedef struct {
+    uint32_t run_count;                         // 执行次数
+    uint32_t min_us;                            // 最短执行时间
+    uint32_t max_us;                            // 最长执行时间
+    uint64_t total_us;                          // 累计执行时间, 均值 = total_us / run_count
+    uint32_t max_jitter_us;                     // 最大启动延迟
+    uint32_t jitter_hist[TASK_JITTER_BINS];     // 启动延迟 (实际启动 - 截止时间) 分布
+    uint32_t missed_deadlines;                  // 执行结束时已超过下一个截止时间的次数
+} task_profile_t;
+
+const task_profile_t *get_periodic_task_profile(EVENT_IDS event_id);
+void clear_periodic_task_profile(void);
+void dump_periodic_task_profile(void);     // 通过调试串口输出统计表
+#endif
 
-#endif // PERIODIC_EVENT_TASK_H
\ No newline at end of file
+#endif // PERIODIC_EVENT_TASK_H
@@ -0,0 +1,90 @@
+#include "realtime_task.h"
+#include <stddef.h>
+#include "hal_timer.h"
+#include "systick.h"
+
+typedef struct {
+    realtime_job_t job;
+    uint16_t divider;       // 每 divider 个节拍执行一次
+    uint16_t counter;
+} realtime_slot_t;
+
+static realtime_slot_t realtime_jobs[REALTIME_JOB_MAX];
+static volatile uint8_t realtime_job_count = 0;
+static realtime_stats_t realtime_stats;
+static bool realtime_timer_ready = false;
+
+/**
+ * @brief 注册一个实时任务
+ * @param job 任务函数, 在定时器中断上下文执行, 不得阻塞
+ * @param divider 执行分频, 周期 = divider * REALTIME_TICK_US
+ * @return true 注册成功或已注册
+ */
+bool realtime_task_register(realtime_job_t job, uint16_t divider) {
+    if (job == NULL) {
+        return false;
+    }
+    if (divider == 0) {
+        divider = 1;
+    }
+
+    for (uint8_t i = 0; i < realtime_job_count; i++) {
+        if (realtime_jobs[i].job == job) {
+            return true;
+        }
+    }
+    if (realtime_job_count >= REALTIME_JOB_MAX) {
+        return false;
+    }
+
+    // 相同分频的任务按注册顺序错开节拍, 避免挤在同一个中断里
+    realtime_slot_t *slot = &realtime_jobs[realtime_job_count];
+    slot->job = job;
+    slot->divider = divider;
+    slot->counter = realtime_job_count % divider;
+
+    // 先填好槽位再计数, 运行中注册也不会被中断看到半成品
+    realtime_job_count++;
+    return true;
+}
+
+/**
+ * @brief 启动实时控制层定时器
+ */
+void realtime_task_start(void) {
+    if (!realtime_timer_ready) {
+        hal_control_timer_init(REALTIME_TICK_US);
+        realtime_timer_ready = true;
+    }
+    hal_control_timer_start();
+}
+
+void realtime_task_stop(void) {
+    hal_control_timer_stop();
+}
+
+/**
+ * @brief 实时层节拍处理, 在定时器中断里调用
+ */
+void realtime_task_isr(void) {
+    uint32_t start_us = get_us();
+
+    realtime_stats.tick_count++;
+    for (uint8_t i = 0; i < realtime_job_count; i++) {
+        realtime_slot_t *slot = &realtime_jobs[i];
+        if (++slot->counter >= slot->divider) {
+            slot->counter = 0;
+            slot->job();
+        }
+    }
+
+    uint32_t elapsed_us = get_us() - start_us;
+    realtime_stats.last_isr_us = elapsed_us;
+    if (elapsed_us > realtime_stats.max_isr_us) {
+        realtime_stats.max_isr_us = elapsed_us;
+    }
+}
+
+const realtime_stats_t *realtime_task_get_stats(void) {
+    return &realtime_stats;
+}
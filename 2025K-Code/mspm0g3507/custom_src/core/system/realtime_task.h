@@ -0,0 +1,40 @@
+#ifndef REALTIME_TASK_H
+#define REALTIME_TASK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 实时控制层: 由硬件定时器中断按固定节拍抢占式执行的硬实时任务
+ * (编码器采样、速度环、PWM 输出), 与主循环里 task_table[] 的软任务分开调度.
+ * 两层之间的数据交换使用 double_buffer.h.
+ */
+
+// 定时器节拍 (us)
+#ifndef REALTIME_TICK_US
+#define REALTIME_TICK_US 1000
+#endif
+
+// 可注册的实时任务数
+#ifndef REALTIME_JOB_MAX
+#define REALTIME_JOB_MAX 4
+#endif
+
+// 把毫秒周期换算成节拍分频数
+#define REALTIME_DIVIDER_MS(ms)     ((uint16_t)((ms) * 1000u / REALTIME_TICK_US))
+
+typedef void (*realtime_job_t)(void);
+
+typedef struct {
+    uint32_t tick_count;        // 已处理的定时器节拍数
+    uint32_t last_isr_us;       // 最近一次中断耗时
+    uint32_t max_isr_us;        // 最长中断耗时
+} realtime_stats_t;
+
+bool realtime_task_register(realtime_job_t job, uint16_t divider);
+void realtime_task_start(void);
+void realtime_task_stop(void);
+void realtime_task_isr(void);
+const realtime_stats_t *realtime_task_get_stats(void);
+
+#endif // REALTIME_TASK_H
@@ -10,7 +10,7 @@
 #define TICKS_PER_US          (CPUCLK_FREQ / 1000000)     // 每微秒的tick数
 
 // 全局变量
-static volatile uint32_t system_ms_count = 0;    // 毫秒计数器
+static volatile uint64_t system_ms_count = 0;    // 毫秒计数器, 64 位不回绕
 
 /**
  * @brief 初始化系统时间模块
@@ -30,24 +30,55 @@ void SysTick_Handler(void) {
     system_ms_count++;
 }
 
+/**
+ * @brief 读取一致的 (毫秒计数, 本毫秒内已过 tick 数) 快照
+ * @note SysTick 在两次读取之间归零、或调用者关着中断导致 SysTick 中断挂起时,
+ *       毫秒计数还没加 1 而 VAL 已经重装, 直接组合会倒退 1ms.
+ *       用 ICSR.PENDSTSET 判断是否有未处理的归零: 挂起时重读 VAL 并补 1ms.
+ *       (不用 CTRL.COUNTFLAG, 读 CTRL 会清除该标志, 影响其他读者)
+ *       只保存/恢复 PRIMASK, 在关中断的临界区里调用也不会误开中断.
+ */
+static void systick_snapshot(uint64_t *ms, uint32_t *elapsed_ticks) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint64_t count = system_ms_count;
+    uint32_t val = SysTick->VAL;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+        val = SysTick->VAL;
+        count++;
+    }
+
+    __set_PRIMASK(primask);
+
+    *ms = count;
+    *elapsed_ticks = (SYSTICK_LOAD_VALUE - 1u) - val;   // VAL 从 LOAD-1 递减到 0
+}
+
 /**
  * @brief 获取系统运行时间（毫秒）
  * @return 系统运行时间（毫秒）
  */
 uint32_t get_ms(void) {
-    return system_ms_count;
+    // 32 位读取是原子的, 低位即可
+    return (uint32_t)system_ms_count;
+}
+
+uint64_t get_us64(void) {
+    uint64_t ms;
+    uint32_t ticks;
+    systick_snapshot(&ms, &ticks);
+    // 毫秒内部分用 32 位除法, 避免在 M0+ 上做 64 位除法
+    return ms * 1000u + ticks / TICKS_PER_US;
 }
 
 uint32_t get_us(void) {
-    uint32_t ms, ticks;
-    __disable_irq();
-    ms = system_ms_count;
-    ticks = SysTick->VAL;
-    __enable_irq();
-    
-    // 使用64位计算避免精度损失
-    uint32_t elapsed_ticks = SYSTICK_LOAD_VALUE - ticks;
-    uint32_t elapsed_us = ((uint64_t)elapsed_ticks * 1000000ULL) / CPUCLK_FREQ;
-    
-    return ms * 1000 + elapsed_us;
-}
\ No newline at end of file
+    return (uint32_t)get_us64();
+}
+
+uint64_t get_cycles(void) {
+    uint64_t ms;
+    uint32_t ticks;
+    systick_snapshot(&ms, &ticks);
+    return ms * SYSTICK_LOAD_VALUE + ticks;
+}
@@ -1,12 +1,17 @@
 /**
  * @file system_time.h
  * @brief MSP M0G3507 简单毫秒时间管理
+ *
+ * 时间基准为 SysTick 1ms 中断 + 64 位毫秒计数, 计数器回绕 (运行 5.8 亿年) 不需考虑.
+ * 32 位的 get_ms()/get_us() 分别约 49 天/71 分钟回绕一次,
+ * 比较先后或计算间隔时请使用下面的 time_* 工具函数, 它们在回绕时依然正确.
  */
 
 #ifndef SYSTICK_H__
 #define SYSTICK_H__
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -19,7 +24,7 @@ void systick_init(void);
 
 /**
  * @brief 获取系统运行时间（毫秒）
- * @return 系统运行时间（毫秒）
+ * @return 系统运行时间（毫秒）, 约 49 天回绕
  */
 uint32_t get_ms(void);
 
@@ -31,12 +36,53 @@ void system_time_delay_ms(uint32_t ms);
 
 /**
  * @brief 获取系统运行时间（微秒）
- * @return 系统运行时间（微秒）
+ * @return 系统运行时间（微秒）, 即 get_us64() 的低 32 位, 约 71 分钟回绕
  */
 uint32_t get_us(void);
 
+/**
+ * @brief 获取 64 位单调递增的系统运行时间（微秒）
+ * @note 日志时间戳、传感器融合 dt 等需要长时间单调的场合使用
+ */
+uint64_t get_us64(void);
+
+/**
+ * @brief 获取上电以来的 CPU 周期数 (12.5ns @ 80MHz)
+ * @note 用于代码段计时, 两次读数相减即可
+ */
+uint64_t get_cycles(void);
+
+/**
+ * @brief 时间点 a 是否早于 b (毫秒或微秒计数均可, 允许 32 位回绕)
+ * @note 两个时间点相差不得超过 2^31 个单位
+ */
+static inline bool time_before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+/**
+ * @brief 时间点 a 是否等于或晚于 b
+ */
+static inline bool time_after_eq(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) >= 0;
+}
+
+/**
+ * @brief 截止时间 deadline_ms 是否已到
+ */
+static inline bool time_reached_ms(uint32_t deadline_ms) {
+    return time_after_eq(get_ms(), deadline_ms);
+}
+
+/**
+ * @brief 从 start 到现在经过的时间 (毫秒), 回绕时依然正确
+ */
+static inline uint32_t time_elapsed_ms(uint32_t start_ms) {
+    return get_ms() - start_ms;
+}
+
 #ifdef __cplusplus
 }
 #endif
 
-#endif /* SYSTEM_TIME_H */
\ No newline at end of file
+#endif /* SYSTEM_TIME_H */
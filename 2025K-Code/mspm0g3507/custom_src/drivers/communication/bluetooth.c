@@ -8,11 +8,15 @@
 #include "lwrb.h" 
 
 #include "hal_uart.h"
+#include "hal_uart_rx.h"
+#include "event_queue.h"
 
 // ====================  配置定义  ====================
 
 #define BLUETOOTH_UART          UART_0_INST
 #define BLUETOOTH_UART_IRQ      UART_0_INST_INT_IRQN
+#define BLUETOOTH_RX_DMA_CHANNEL 1                  // 与陀螺仪共用 UART_0, 二者只初始化其一
+#define BLUETOOTH_RX_DMA_TRIGGER DMA_UART0_RX_TRIG
 
 #define BT_RX_BUFFER_SIZE       128
 #define BT_TX_BUFFER_SIZE       128
@@ -23,6 +27,7 @@ static lwpkt_t bluetooth_pkt;
 static uint8_t bt_rx_buffer[BT_RX_BUFFER_SIZE];
 static uint8_t bt_tx_buffer[BT_TX_BUFFER_SIZE];
 static lwrb_t bt_rx_rb, bt_tx_rb;
+static uart_rx_t bt_rx;
 static volatile bool bluetooth_data_ready = false;
 
 // ====================  内部函数声明  ====================
@@ -46,6 +51,8 @@ bluetooth_result_t bluetooth_init(void) {
     // 设置回调函数
     lwpkt_set_evt_fn(&bluetooth_pkt, bluetooth_packet_callback);
     
+    uart_rx_init(&bt_rx, BLUETOOTH_UART, &bt_rx_rb, BLUETOOTH_RX_DMA_CHANNEL, BLUETOOTH_RX_DMA_TRIGGER);
+    
     // 启用UART中断
     NVIC_EnableIRQ(BLUETOOTH_UART_IRQ);
     
@@ -57,15 +64,16 @@ bluetooth_result_t bluetooth_init(void) {
 // ====================  中断处理  ====================
 
 void bluetooth_irq_handler(DL_UART_IIDX idx) {
-    if (idx == DL_UART_IIDX_RX) {
-        uint8_t received_byte = DL_UART_Main_receiveData(BLUETOOTH_UART);
-        
-        if (lwrb_write(&bt_rx_rb, &received_byte, 1) == 1) {
-            bluetooth_data_ready = true;
-        }
+    if (uart_rx_irq_handler(&bt_rx, idx) & UART_RX_EVT_DATA) {
+        bluetooth_data_ready = true;
+        event_queue_post(EVENT_BLUETOOTH);   // 通知调度器立即执行接收处理任务
     }
 }
 
+const uart_rx_stats_t* bluetooth_get_rx_stats(void) {
+    return &bt_rx.stats;
+}
+
 // ====================  发送函数  ====================
 
 bluetooth_result_t bluetooth_send_byte(uint8_t byte) {
@@ -93,29 +101,26 @@ bluetooth_result_t bluetooth_send_data(const uint8_t* data, size_t length) {
 }
 
 static bluetooth_result_t bluetooth_flush_tx(void) {
-    size_t available = lwrb_get_full(&bt_tx_rb);
-    
-    if (available == 0) {
-        return BLUETOOTH_OK;
-    }
-    
-    uint8_t temp_buffer[available];
-    size_t read_bytes = lwrb_read(&bt_tx_rb, temp_buffer, available);
-    
-    if (read_bytes > 0) {
-        usart_send_bytes(BLUETOOTH_UART, temp_buffer, read_bytes);
-        return BLUETOOTH_OK;
+    // 按线性块直接交给串口发送队列, 不经栈上中转
+    lwrb_sz_t len;
+    while ((len = lwrb_get_linear_block_read_length(&bt_tx_rb)) > 0) {
+        size_t sent = usart_send_bytes(BLUETOOTH_UART, (const uint8_t*)lwrb_get_linear_block_read_address(&bt_tx_rb), len);
+        lwrb_skip(&bt_tx_rb, len);
+        if (sent < len) {
+            lwrb_skip(&bt_tx_rb, lwrb_get_full(&bt_tx_rb));    // 串口发送队列已满, 丢弃本包其余字节
+            return BLUETOOTH_ERROR;
+        }
     }
     
-    return BLUETOOTH_ERROR;
+    return BLUETOOTH_OK;
 }
 
 // ====================  接收处理  ====================
 
 void bluetooth_process(void) {
     if (bluetooth_data_ready) {
+        bluetooth_data_ready = false;   // 先清标志, 处理期间收到的字节会重新置位
         lwpkt_process(&bluetooth_pkt, 128);
-        bluetooth_data_ready = false;
     }
 }
 
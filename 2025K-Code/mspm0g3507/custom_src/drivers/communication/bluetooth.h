@@ -11,6 +11,7 @@
 #include <stddef.h>
 #include "lwpkt.h"
 #include "ti_msp_dl_config.h"
+#include "hal_uart_rx.h"
 
 // ====================  返回值定义  ====================
 
@@ -47,7 +48,7 @@ bluetooth_result_t bluetooth_send_byte(uint8_t byte);
 bluetooth_result_t bluetooth_send_data(const uint8_t* data, size_t length);
 
 /**
- * @brief 处理蓝牙接收（在主循环中调用）
+ * @brief 处理蓝牙接收（由 EVENT_BLUETOOTH 事件触发或在主循环中调用）
  */
 void bluetooth_process(void);
 
@@ -59,5 +60,6 @@ void bluetooth_process(void);
 void bluetooth_data_received(const uint8_t* data, size_t length);
 
 void bluetooth_irq_handler(DL_UART_IIDX idx);
+const uart_rx_stats_t* bluetooth_get_rx_stats(void);
 
 #endif // BLUETOOTH_H
\ No newline at end of file
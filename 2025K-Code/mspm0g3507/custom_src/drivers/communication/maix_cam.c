@@ -7,12 +7,16 @@
 #include "lwpkt.h"
 #include "lwrb.h"
 #include "hal_uart.h"
+#include "hal_uart_rx.h"
+#include "event_queue.h"
 #include <string.h>
 
 // ====================  配置定义  ====================
 
 #define CAMERA_UART             UART_1_INST    // 假设使用UART1与摄像头通信
 #define CAMERA_UART_IRQ         UART_1_INST_INT_IRQN
+#define CAMERA_RX_DMA_CHANNEL   0
+#define CAMERA_RX_DMA_TRIGGER   DMA_UART3_RX_TRIG   // UART_1_INST 即 UART3
 
 #define CAMERA_RX_BUFFER_SIZE   256            // 摄像头可能发送较多数据
 #define CAMERA_TX_BUFFER_SIZE   128
@@ -23,6 +27,7 @@ static lwpkt_t camera_pkt;
 static uint8_t camera_rx_buffer[CAMERA_RX_BUFFER_SIZE];
 static uint8_t camera_tx_buffer[CAMERA_TX_BUFFER_SIZE];
 static lwrb_t camera_rx_rb, camera_tx_rb;
+static uart_rx_t camera_rx;
 static volatile bool camera_data_ready = false;
 
 // ====================  内部函数声明  ====================
@@ -46,6 +51,9 @@ camera_result_t camera_init(void) {
     // 设置回调函数
     lwpkt_set_evt_fn(&camera_pkt, camera_packet_callback);
     
+    // DMA 接收, 线路空闲时提交一帧
+    uart_rx_init(&camera_rx, CAMERA_UART, &camera_rx_rb, CAMERA_RX_DMA_CHANNEL, CAMERA_RX_DMA_TRIGGER);
+    
     // 启用UART中断
     NVIC_EnableIRQ(CAMERA_UART_IRQ);
     
@@ -57,15 +65,16 @@ camera_result_t camera_init(void) {
 // ====================  中断处理  ====================
 
 void camera_irq_handler(DL_UART_IIDX idx) {
-    if (idx == DL_UART_IIDX_RX) {
-        uint8_t received_byte = DL_UART_Main_receiveData(CAMERA_UART);
-        
-        if (lwrb_write(&camera_rx_rb, &received_byte, 1) == 1) {
-            camera_data_ready = true;
-        }
+    if (uart_rx_irq_handler(&camera_rx, idx) & UART_RX_EVT_DATA) {
+        camera_data_ready = true;
+        event_queue_post(EVENT_MAIXCAM);   // 通知调度器立即执行接收处理任务
     }
 }
 
+const uart_rx_stats_t* camera_get_rx_stats(void) {
+    return &camera_rx.stats;
+}
+
 // ====================  发送函数  ====================
 
 camera_result_t camera_send_byte(uint8_t byte) {
@@ -102,29 +111,26 @@ camera_result_t camera_send_string(const char* str) {
 }
 
 static camera_result_t camera_flush_tx(void) {
-    size_t available = lwrb_get_full(&camera_tx_rb);
-    
-    if (available == 0) {
-        return CAMERA_OK;
-    }
-    
-    uint8_t temp_buffer[available];
-    size_t read_bytes = lwrb_read(&camera_tx_rb, temp_buffer, available);
-    
-    if (read_bytes > 0) {
-        usart_send_bytes(CAMERA_UART, temp_buffer, read_bytes);
-        return CAMERA_OK;
+    // 按线性块直接交给串口发送队列, 不经栈上中转
+    lwrb_sz_t len;
+    while ((len = lwrb_get_linear_block_read_length(&camera_tx_rb)) > 0) {
+        size_t sent = usart_send_bytes(CAMERA_UART, (const uint8_t*)lwrb_get_linear_block_read_address(&camera_tx_rb), len);
+        lwrb_skip(&camera_tx_rb, len);
+        if (sent < len) {
+            lwrb_skip(&camera_tx_rb, lwrb_get_full(&camera_tx_rb));    // 串口发送队列已满, 丢弃本包其余字节
+            return CAMERA_ERROR;
+        }
     }
     
-    return CAMERA_ERROR;
+    return CAMERA_OK;
 }
 
 // ====================  接收处理  ====================
 
 void camera_process(void) {
     if (camera_data_ready) {
+        camera_data_ready = false;   // 先清标志, 处理期间收到的字节会重新置位
         lwpkt_process(&camera_pkt, 256);  // 摄像头数据较多，处理更多字节
-        camera_data_ready = false;
     }
 }
 
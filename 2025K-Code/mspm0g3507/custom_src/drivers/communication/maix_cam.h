@@ -10,6 +10,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include "ti_msp_dl_config.h"
+#include "hal_uart_rx.h"
 
 // ====================  返回值定义  ====================
 
@@ -53,7 +54,7 @@ camera_result_t camera_send_string(const char* str);
 
 /**
  * @brief 处理摄像头通信数据
- * @note 需要在主循环中定期调用
+ * @note 由串口中断投递的 EVENT_MAIXCAM 事件触发, 也可在主循环中定期调用
  */
 void camera_process(void);
 
@@ -64,6 +65,11 @@ void camera_process(void);
  */
 void camera_irq_handler(DL_UART_IIDX idx);
 
+/**
+ * @brief 接收统计 (空闲帧数、DMA 整段数、溢出字节数)
+ */
+const uart_rx_stats_t* camera_get_rx_stats(void);
+
 // ====================  回调函数（用户实现）  ====================
 
 /**
@@ -3,12 +3,11 @@
 #include "string.h"
 #include "delay.h"
 #include "hal_soft_i2c.h"  // 包含你的软件I2C头文件
-
-#define M_PI 3.14
+#include "hal_math.h"
 
 #define BOOT_TIME         (10)
 #define I2C_TIMEOUT_MS    (10)
-#define RAD_TO_DEG        (180.0f / M_PI)
+#define RAD_TO_DEG        HAL_MATH_RAD2DEG
 
 #define LSM6DSV16X_ADDR   (0x6B)
 
@@ -39,7 +38,7 @@ static int32_t platform_write(void *handle, uint8_t reg, const uint8_t *bufp, ui
 static int32_t platform_read(void *handle, uint8_t reg, uint8_t *bufp, uint16_t len);
 static void platform_delay(uint32_t ms);
 
-// 四元数转欧拉角函数保持不变
+// 四元数转欧拉角, atan2/asin 走 hal_math (MATHACL)
 static void quat_to_euler(const float q[4], float *roll, float *pitch, float *yaw)
 {
     // q = [x, y, z, w] 格式
@@ -51,19 +50,16 @@ static void quat_to_euler(const float q[4], float *roll, float *pitch, float *ya
     // Roll (x-axis rotation)
     float sinr_cosp = 2.0f * (w * x + y * z);
     float cosr_cosp = 1.0f - 2.0f * (x * x + y * y);
-    *roll = atan2f(sinr_cosp, cosr_cosp);
+    *roll = hal_atan2f(sinr_cosp, cosr_cosp);
 
     // Pitch (y-axis rotation)
     float sinp = 2.0f * (w * y - z * x);
-    if (fabsf(sinp) >= 1.0f)
-        *pitch = copysignf(M_PI / 2.0f, sinp); // use 90 degrees if out of range
-    else
-        *pitch = asinf(sinp);
+    *pitch = hal_asinf(sinp);   // 超出 [-1, 1] 时限幅为 ±90 度
 
     // Yaw (z-axis rotation)
     float siny_cosp = 2.0f * (w * z + x * y);
     float cosy_cosp = 1.0f - 2.0f * (y * y + z * z);
-    *yaw = atan2f(siny_cosp, cosy_cosp);
+    *yaw = hal_atan2f(siny_cosp, cosy_cosp);
 
     *roll *= RAD_TO_DEG;
     *pitch *= RAD_TO_DEG;
@@ -5,6 +5,8 @@ uint16_t gray_byte = 0x00;
 #define SEPARATED_PATTERN_OUTPUT  3.0
 static float gray_status_backup = 0.0f; // 初始备份值设为0
 
+static inline bool is_separated_pattern(uint8_t sensor_pattern);
+
 #ifdef USE_PCA9555 
 // I2C 硬件配置 - 适配新的软件I2C结构体
 static soft_iic_info_struct pca9555_i2c = {
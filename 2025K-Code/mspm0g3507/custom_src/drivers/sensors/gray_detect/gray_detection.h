@@ -28,8 +28,6 @@ float gray_get_position(void);
 float gray_get_position_22c_ti_contest(bool flag);
 uint16_t gray_read_byte(void);
 
-static inline bool is_separated_pattern(uint8_t sensor_pattern);
-
 extern uint16_t gray_byte;
 
 #ifdef USE_GPIO
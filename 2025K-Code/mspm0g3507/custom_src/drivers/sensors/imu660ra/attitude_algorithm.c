@@ -1,6 +1,7 @@
 #include "attitude_algorithm.h"
 #include "math.h"
 #include "delay.h"
+#include "systick.h"
 
 // Inner func
 void gyro_error_correct(Attitude_module* attitude_module) {
@@ -107,14 +108,35 @@ void init_attitude(Attitude_module* attitude_module, float sampling_period) {
     attitude_module->attitude_correct.min_effective_gyro_z = 0.3f;
 
     attitude_module->sampling_period = sampling_period;
+    attitude_module->last_update_us = 0;
 
     calc_gyro_zero_drift(attitude_module);
 
     attitude_module->is_init = true;
 }
 
+/**
+ * @brief 计算两次融合之间的实际时间间隔
+ * @note 任务调度有抖动, 用标称周期积分陀螺仪会累积航向误差;
+ *       首次调用或间隔异常 (调试暂停、长时间未调度) 时退回标称周期
+ */
+static float attitude_measure_dt(Attitude_module* attitude_module) {
+    uint64_t now_us = get_us64();
+    float nominal = attitude_module->sampling_period;
+    float dt = nominal;
+
+    if (attitude_module->last_update_us != 0) {
+        dt = (float)(now_us - attitude_module->last_update_us) * 1e-6f;
+        if (dt < 0.5f * nominal || dt > 2.0f * nominal) {
+            dt = nominal;
+        }
+    }
+    attitude_module->last_update_us = now_us;
+    return dt;
+}
+
 void update_attitude(Attitude_module* attitude_module) {
     get_acc(attitude_module);
     get_gyro(attitude_module);
-    calculatePose_Module(&(attitude_module->pose_module), attitude_module->sampling_period);
+    calculatePose_Module(&(attitude_module->pose_module), attitude_measure_dt(attitude_module));
 }
@@ -2,6 +2,7 @@
 #define _ATTITUDE_ALGORITHM_H_
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "pose.h"
 
@@ -33,7 +34,8 @@ typedef struct Attitude_module {
     Pose_Module pose_module;
     Attitude_data attitude_data;
     Attitude_correct attitude_correct;
-    float sampling_period;
+    float sampling_period;          // 标称采样周期 (s)
+    uint64_t last_update_us;        // 上次融合的时间戳, 用实测 dt 代替标称周期
     bool is_init;
 #ifdef USE_IMU660RA
     imu660ra_measurement_data_struct gyro_measurement_data, acc_measurement_data;
@@ -1,6 +1,5 @@
 #include "pose.h"
-#include "pose_math.h"
-#include "math.h"
+#include "hal_math.h"
 #include "Fusion.h"
 
 // 全局AHRS实例
@@ -82,9 +81,9 @@ void calculatePose_Module(Pose_Module *pose, float cycle)
     };
     
     // 检查加速度计数据是否有效
-    length = sqrt(accelerometer.axis.x * accelerometer.axis.x + 
-                  accelerometer.axis.y * accelerometer.axis.y + 
-                  accelerometer.axis.z * accelerometer.axis.z);
+    length = hal_sqrtf(accelerometer.axis.x * accelerometer.axis.x + 
+                       accelerometer.axis.y * accelerometer.axis.y + 
+                       accelerometer.axis.z * accelerometer.axis.z);
     
     // 陀螺仪零偏校正
     FusionVector corrected_gyroscope = FusionOffsetUpdate(&offset, gyroscope);
@@ -131,13 +130,15 @@ void calculatePose_Module(Pose_Module *pose, float cycle)
                             pose->data.rotate_matrix[1][2] * *(pose->interface.data.a_y) + 
                             pose->data.rotate_matrix[2][2] * *(pose->interface.data.a_z);
 
-		// 求解欧拉角 - 使用与原版本相同的公式
-		pose->data.rol = arctan2(pose->data.rotate_matrix[2][2], pose->data.rotate_matrix[1][2]);
-		pose->data.pit = -arcsin(pose->data.rotate_matrix[0][2]);
-		pose->data.yaw = arctan2(pose->data.rotate_matrix[0][0], pose->data.rotate_matrix[0][1]);
+		// 求解欧拉角 - 公式与原版本相同, atan2/asin 改走 hal_math (MATHACL)
+		pose->data.rol = hal_atan2f(pose->data.rotate_matrix[1][2], pose->data.rotate_matrix[2][2]) * HAL_MATH_RAD2DEG;
+		pose->data.pit = -hal_asinf(pose->data.rotate_matrix[0][2]) * HAL_MATH_RAD2DEG;
+		pose->data.yaw = hal_atan2f(pose->data.rotate_matrix[0][1], pose->data.rotate_matrix[0][0]) * HAL_MATH_RAD2DEG;
 		
-    // 计算机体坐标系矫正后的加速度
-    pose->data.acc_correct.x = pose->data.acc_world.x * cos_pose(pose->data.yaw) + pose->data.acc_world.y * sin_pose(pose->data.yaw);
-    pose->data.acc_correct.y = -pose->data.acc_world.x * sin_pose(pose->data.yaw) + pose->data.acc_world.y * cos_pose(pose->data.yaw);
+    // 计算机体坐标系矫正后的加速度, 一次 sincos 同时得到两个值
+    float sin_yaw, cos_yaw;
+    hal_sincosf(pose->data.yaw * HAL_MATH_DEG2RAD, &sin_yaw, &cos_yaw);
+    pose->data.acc_correct.x = pose->data.acc_world.x * cos_yaw + pose->data.acc_world.y * sin_yaw;
+    pose->data.acc_correct.y = -pose->data.acc_world.x * sin_yaw + pose->data.acc_world.y * cos_yaw;
     pose->data.acc_correct.z = pose->data.acc_world.z;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "wit_jyxx.h"
 
 #include "hal_uart.h"
+#include "hal_uart_rx.h"
 #include "delay.h"
 #include "lwrb.h"
 
@@ -8,6 +9,8 @@
 
 #define WIT_IMU_UART          UART_0_INST
 #define WIT_IMU_UART_IRQ      UART_0_INST_INT_IRQN
+#define WIT_RX_DMA_CHANNEL    1                     // 与蓝牙共用 UART_0, 二者只初始化其一
+#define WIT_RX_DMA_TRIGGER    DMA_UART0_RX_TRIG
 
 #define WIT_UART_RX_BUFFER_SIZE       256
 
@@ -15,6 +18,7 @@
 // 环形缓冲区相关定义
 static uint8_t uart_rx_buffer[WIT_UART_RX_BUFFER_SIZE];
 static lwrb_t uart_rx_rb;
+static uart_rx_t wit_rx;
 
 static uint8_t cmd_unlock[] = {0xFF, 0xAA, 0x69, 0x88, 0xB5};
 static uint8_t cmd_calibration_z[] = {0xFF, 0xAA, 0x01, 0x04, 0x00};
@@ -29,6 +33,9 @@ void wit_imu_init(void) {
     // 初始化环形缓冲区
     lwrb_init(&uart_rx_rb, uart_rx_buffer, sizeof(uart_rx_buffer));
     
+    // DMA 接收: 高回传速率下不再每字节进中断, 数据仍由 wit_imu_process 轮询解析
+    uart_rx_init(&wit_rx, WIT_IMU_UART, &uart_rx_rb, WIT_RX_DMA_CHANNEL, WIT_RX_DMA_TRIGGER);
+    
     // 启用UART中断
     NVIC_EnableIRQ(WIT_IMU_UART_IRQ);
 }
@@ -93,10 +100,11 @@ static void process_received_data(void) {
 }
 
 void wit_imu_uart_irq_handler(DL_UART_IIDX idx) {
-		if (idx == DL_UART_IIDX_RX) {
-        uint8_t uartData = DL_UART_Main_receiveData(WIT_IMU_UART);
-        lwrb_write(&uart_rx_rb, &uartData, 1);
-    }
+    uart_rx_irq_handler(&wit_rx, idx);
+}
+
+const uart_rx_stats_t* wit_imu_get_rx_stats(void) {
+    return &wit_rx.stats;
 }
 
 // 在主循环中调用此函数来处理数据
@@ -2,6 +2,7 @@
 #define __JYXX_H
 
 #include "ti_msp_dl_config.h"
+#include "hal_uart_rx.h"
 #include "stdio.h"
 
 #define WAIT_HEADER1 0
@@ -33,6 +34,7 @@ typedef struct {
 void wit_imu_init(void);
 void wit_imu_process(void);
 void wit_imu_uart_irq_handler(DL_UART_IIDX idx);
+const uart_rx_stats_t* wit_imu_get_rx_stats(void);
 void wit_imu_set_yaw_zero(void);
 void wit_imu_get_euler_angle(float *yaw, float *roll, float *pitch);
 
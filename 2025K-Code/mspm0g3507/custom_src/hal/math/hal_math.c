@@ -0,0 +1,275 @@
+#include "hal_math.h"
+#include "ti_msp_dl_config.h"
+#include <math.h>
+#include <stddef.h>
+
+#if HAL_MATH_USE_MATHACL && defined(__MSPM0_HAS_MATHACL__)
+#define MATHACL_BACKEND 1
+#else
+#define MATHACL_BACKEND 0
+#endif
+
+#if MATHACL_BACKEND
+
+#define Q31_ONE             2147483648.0f       // 2^31
+#define Q30_SHIFT           30
+#define SQRT2               1.41421356237f
+#define SELF_TEST_TOLERANCE 1e-4f
+#define SINCOS_MAX_RAD      (8.0f * HAL_MATH_PI)    // 超过 4 圈 (以及 INF/NaN) 走 libm, 大角度的约简精度由 libm 保证
+
+// MATHACL 自检通过后才置位, 之前 (以及自检失败时) 全部走软件路径
+static bool mathacl_ready = false;
+
+typedef union {
+    float f;
+    uint32_t u;
+} f32_bits_t;
+
+/**
+ * @brief 构造 2^n 的 float, n 必须在 [-126, 127]
+ */
+static inline float pow2f(int n) {
+    f32_bits_t b;
+    b.u = (uint32_t)(n + 127) << 23;
+    return b.f;
+}
+
+/**
+ * @brief 取正规化 float 的二进制指数, |v| 落在 [2^e, 2^(e+1))
+ */
+static inline int exponent_of(float v) {
+    f32_bits_t b;
+    b.f = v;
+    return (int)((b.u >> 23) & 0xFFU) - 127;
+}
+
+/**
+ * @brief 启动一次 MATHACL 运算并等待结果
+ * 协处理器只有一组寄存器, 整个过程关中断, 防止实时层中断中途改写操作数
+ */
+static uint32_t mathacl_run(uint32_t ctl, uint32_t op1, uint32_t op2, uint32_t *res2) {
+    uint32_t primask = __get_PRIMASK();
+    uint32_t res1;
+
+    __disable_irq();
+    MATHACL->CTL = ctl;
+    MATHACL->OP2 = op2;
+    MATHACL->OP1 = op1;                 // 写 OP1 触发运算
+    DL_MathACL_waitForOperation(MATHACL);
+    res1 = MATHACL->RES1;
+    if (res2 != NULL) {
+        *res2 = MATHACL->RES2;
+    }
+    __set_PRIMASK(primask);
+    return res1;
+}
+
+#define CORDIC_CTL(func)    ((func) | ((uint32_t)HAL_MATH_CORDIC_ITERATIONS << MATHACL_CTL_NUMITER_OFS))
+
+/**
+ * @brief atan2, 两个输入按较大者的指数同比缩放到 Q31 (只有比值有意义)
+ * 输出为 Q31 格式的 angle / pi
+ */
+static float mathacl_atan2f(float y, float x) {
+    float ay = fabsf(y), ax = fabsf(x);
+    float m = (ay > ax) ? ay : ax;
+    int e;
+
+    if (m == 0.0f) {
+        return 0.0f;
+    }
+    e = exponent_of(m);
+    if (e < -96 || e > 96) {
+        return atan2f(y, x);
+    }
+    // m * 2^(30-e) 落在 [2^30, 2^31), 不会溢出 int32
+    float scale = pow2f(30 - e);
+    int32_t qy = (int32_t)(y * scale);
+    int32_t qx = (int32_t)(x * scale);
+
+    int32_t r = (int32_t)mathacl_run(CORDIC_CTL(MATHACL_CTL_FUNC_ATAN2), (uint32_t)qy, (uint32_t)qx, NULL);
+    return (float)r * (HAL_MATH_PI / Q31_ONE);
+}
+
+/**
+ * @brief sqrt, x = m * 2^e 中 m 取 [1,2) 的 UQ30 送入硬件, 指数部分由软件处理
+ */
+static float mathacl_sqrtf(float x) {
+    int e;
+    float m, r;
+
+    if (!(x > 0.0f)) {
+        return 0.0f;
+    }
+    e = exponent_of(x);
+    if (e < -96 || e > 96) {
+        return sqrtf(x);
+    }
+    m = x * pow2f(-e);
+    uint32_t qm = (uint32_t)(m * (float)(1UL << Q30_SHIFT));
+    uint32_t qr = mathacl_run(CORDIC_CTL(MATHACL_CTL_FUNC_SQRT) | MATHACL_CTL_QVAL_Q30, qm, 0, NULL);
+
+    // sqrt(2^e) = 2^(e>>1) * (e 为奇数时再乘 sqrt(2)), >> 对负数按算术右移处理
+    r = (float)qr * pow2f((e >> 1) - Q30_SHIFT);
+    return (e & 1) ? r * SQRT2 : r;
+}
+
+/**
+ * @brief sin/cos, 输入为 Q31 格式的 rad / pi, RES1 = cos, RES2 = sin
+ * 器件头文件标注了 SINCOS 的边界缺陷 (_IQMATH_MATHACL_SINCOS_BUG_WORKAROUND_),
+ * 这里把 -pi (0x80000000) 挪到开区间内
+ * @note 调用者保证 |rad| <= SINCOS_MAX_RAD; 已在 [-pi, pi) 内时不做 fmodf
+ */
+static void mathacl_sincosf(float rad, float *sin_out, float *cos_out) {
+    uint32_t rs;
+
+    if (rad >= HAL_MATH_PI || rad < -HAL_MATH_PI) {
+        rad = fmodf(rad, 2.0f * HAL_MATH_PI);
+        if (rad >= HAL_MATH_PI) {
+            rad -= 2.0f * HAL_MATH_PI;
+        } else if (rad < -HAL_MATH_PI) {
+            rad += 2.0f * HAL_MATH_PI;
+        }
+    }
+
+    float qf = rad * (Q31_ONE / HAL_MATH_PI);
+    int32_t q = (qf >= Q31_ONE) ? INT32_MAX : (int32_t)qf;     // 略小于 pi 的输入乘完可能舍入到 2^31
+    if (q == INT32_MIN) {
+        q = INT32_MIN + 1;
+    }
+    uint32_t rc = mathacl_run(CORDIC_CTL(MATHACL_CTL_FUNC_SINCOS), (uint32_t)q, 0, &rs);
+    if (sin_out != NULL) *sin_out = (float)(int32_t)rs * (1.0f / Q31_ONE);
+    if (cos_out != NULL) *cos_out = (float)(int32_t)rc * (1.0f / Q31_ONE);
+}
+
+static int32_t mathacl_div_s32(int32_t num, int32_t den, int32_t *rem) {
+    uint32_t r;
+    int32_t q = (int32_t)mathacl_run(MATHACL_CTL_FUNC_DIV | MATHACL_CTL_OPTYPE_SIGNED | MATHACL_CTL_QVAL_Q0,
+                                     (uint32_t)num, (uint32_t)den, &r);
+    if (rem != NULL) *rem = (int32_t)r;
+    return q;
+}
+
+static bool close_to(float a, float b) {
+    return fabsf(a - b) <= SELF_TEST_TOLERANCE * (1.0f + fabsf(b));
+}
+
+/**
+ * @brief 用几组已知输入对比硬件与 libm 的结果
+ * 覆盖 atan2 的操作数顺序、各象限、sqrt 的奇偶指数和有符号除法
+ */
+static bool mathacl_self_test(void) {
+    static const float atan2_cases[][2] = {
+        { 1.0f, 0.0f }, { 1.0f, 2.0f }, { -1.0f, -1.0f }, { 0.25f, -3.0f }, { -700.0f, 20.0f },
+    };
+    static const float sqrt_cases[] = { 2.0f, 0.3f, 1.0f, 1234.5f, 1e-4f };
+    static const float angle_cases[] = { 0.5f, -2.5f, 3.0f, -0.01f, 20.0f, -15.0f };
+    float s, c;
+    int32_t rem;
+
+    for (size_t i = 0; i < sizeof(atan2_cases) / sizeof(atan2_cases[0]); i++) {
+        float y = atan2_cases[i][0], x = atan2_cases[i][1];
+        if (!close_to(mathacl_atan2f(y, x), atan2f(y, x))) return false;
+    }
+    for (size_t i = 0; i < sizeof(sqrt_cases) / sizeof(sqrt_cases[0]); i++) {
+        if (!close_to(mathacl_sqrtf(sqrt_cases[i]), sqrtf(sqrt_cases[i]))) return false;
+    }
+    for (size_t i = 0; i < sizeof(angle_cases) / sizeof(angle_cases[0]); i++) {
+        mathacl_sincosf(angle_cases[i], &s, &c);
+        if (!close_to(s, sinf(angle_cases[i])) || !close_to(c, cosf(angle_cases[i]))) return false;
+    }
+    if (mathacl_div_s32(-100, 7, &rem) != -14 || rem != -2) return false;
+    return true;
+}
+
+#endif // MATHACL_BACKEND
+
+/**
+ * @brief 上电 MATHACL 并自检, 自检失败时保持软件路径
+ * 在 SYSCFG_DL_init() 之后调用; 未调用前所有接口同样可用 (软件路径)
+ */
+void hal_math_init(void) {
+#if MATHACL_BACKEND
+    DL_MathACL_reset(MATHACL);
+    DL_MathACL_enablePower(MATHACL);
+    delay_cycles(POWER_STARTUP_DELAY);
+    mathacl_ready = mathacl_self_test();
+#endif
+}
+
+bool hal_math_is_accelerated(void) {
+#if MATHACL_BACKEND
+    return mathacl_ready;
+#else
+    return false;
+#endif
+}
+
+float hal_sqrtf(float x) {
+#if MATHACL_BACKEND
+    if (mathacl_ready) return mathacl_sqrtf(x);
+#endif
+    return (x > 0.0f) ? sqrtf(x) : 0.0f;
+}
+
+float hal_atan2f(float y, float x) {
+#if MATHACL_BACKEND
+    if (mathacl_ready) return mathacl_atan2f(y, x);
+#endif
+    return atan2f(y, x);
+}
+
+/**
+ * @brief asin(x) = atan2(x, sqrt(1 - x^2)), 输入先限幅, 避免 |x| 略大于 1 时得到 NaN
+ */
+float hal_asinf(float x) {
+    if (x >= 1.0f) return HAL_MATH_PI / 2.0f;
+    if (x <= -1.0f) return -HAL_MATH_PI / 2.0f;
+#if MATHACL_BACKEND
+    if (mathacl_ready) return mathacl_atan2f(x, mathacl_sqrtf(1.0f - x * x));
+#endif
+    return asinf(x);
+}
+
+void hal_sincosf(float rad, float *sin_out, float *cos_out) {
+#if MATHACL_BACKEND
+    if (mathacl_ready && fabsf(rad) <= SINCOS_MAX_RAD) {        // NaN 比较为假, 同样走 libm
+        mathacl_sincosf(rad, sin_out, cos_out);
+        return;
+    }
+#endif
+    if (sin_out != NULL) *sin_out = sinf(rad);
+    if (cos_out != NULL) *cos_out = cosf(rad);
+}
+
+float hal_sinf(float rad) {
+    float s;
+    hal_sincosf(rad, &s, NULL);
+    return s;
+}
+
+float hal_cosf(float rad) {
+    float c;
+    hal_sincosf(rad, NULL, &c);
+    return c;
+}
+
+/**
+ * @brief 有符号整数除法, 向零取整 (与 C 语义一致)
+ * M0+ 没有硬件除法指令, 软件 __aeabi_idiv 需要数十到上百周期
+ */
+int32_t hal_div_s32(int32_t num, int32_t den, int32_t *rem) {
+    if (den == 0) {
+        if (rem != NULL) *rem = num;
+        return 0;
+    }
+    if (num == INT32_MIN && den == -1) {        // 商溢出, 饱和
+        if (rem != NULL) *rem = 0;
+        return INT32_MAX;
+    }
+#if MATHACL_BACKEND
+    if (mathacl_ready) return mathacl_div_s32(num, den, rem);
+#endif
+    if (rem != NULL) *rem = num % den;
+    return num / den;
+}
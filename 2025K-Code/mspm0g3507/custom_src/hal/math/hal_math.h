@@ -0,0 +1,41 @@
+#ifndef HAL_MATH_H__
+#define HAL_MATH_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 数学运算抽象层
+ *  - MSPM0G3507 上使用 MATHACL 协处理器 (CORDIC sin/cos/atan2/sqrt + 硬件除法)
+ *  - 主机构建或关闭加速时回退到 <math.h>
+ * 接口均为 float 进出, 可以直接替换 sqrtf/atan2f/asinf 等调用.
+ * M0+ 没有 FPU, 软浮点 atan2f/asinf 每次数千周期, 硬件路径只剩 float <-> 定点转换的开销.
+ */
+
+// 是否启用 MATHACL 后端, 芯片没有 MATHACL 时强制为 0
+#ifndef HAL_MATH_USE_MATHACL
+#define HAL_MATH_USE_MATHACL 1
+#endif
+
+// CORDIC 迭代次数 (1~31), 次数越少越快, 31 次约 1e-9 rad 精度
+#ifndef HAL_MATH_CORDIC_ITERATIONS
+#define HAL_MATH_CORDIC_ITERATIONS 31
+#endif
+
+#define HAL_MATH_PI         3.14159265358979f
+#define HAL_MATH_RAD2DEG    (180.0f / HAL_MATH_PI)
+#define HAL_MATH_DEG2RAD    (HAL_MATH_PI / 180.0f)
+
+void hal_math_init(void);
+bool hal_math_is_accelerated(void);     // 自检通过且正在使用 MATHACL
+
+float hal_sqrtf(float x);
+float hal_atan2f(float y, float x);
+float hal_asinf(float x);               // 输入限幅到 [-1, 1]
+void hal_sincosf(float rad, float *sin_out, float *cos_out);
+float hal_sinf(float rad);
+float hal_cosf(float rad);
+
+int32_t hal_div_s32(int32_t num, int32_t den, int32_t *rem);    // 整数除法, den 为 0 时返回 0, rem 可为 NULL
+
+#endif
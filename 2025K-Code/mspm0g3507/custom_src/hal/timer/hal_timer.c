@@ -0,0 +1,55 @@
+#include "hal_timer.h"
+
+/*
+ * TIMG0 位于 PD0 电源域, BUSCLK = 40MHz
+ * 8 分频 + 预分频 5 后计数频率为 1MHz, 一个计数即 1us
+ */
+static const DL_TimerG_ClockConfig control_timer_clock_config = {
+    .clockSel    = DL_TIMER_CLOCK_BUSCLK,
+    .divideRatio = DL_TIMER_CLOCK_DIVIDE_8,
+    .prescale    = 4U,
+};
+
+/**
+ * @brief 初始化实时控制层周期定时器 (不启动)
+ * @param period_us 中断周期, 单位 us
+ */
+void hal_control_timer_init(uint32_t period_us) {
+    DL_TimerG_TimerConfig timer_config = {
+        .timerMode    = DL_TIMER_TIMER_MODE_PERIODIC,
+        .period       = period_us - 1U,     // 实际周期 = (period + 1) 个计数
+        .startTimer   = DL_TIMER_STOP,
+        .genIntermInt = DL_TIMER_INTERM_INT_DISABLED,
+        .counterVal   = 0,
+    };
+
+    DL_TimerG_reset(CONTROL_TIMER_INST);
+    DL_TimerG_enablePower(CONTROL_TIMER_INST);
+    delay_cycles(POWER_STARTUP_DELAY);
+
+    DL_TimerG_setClockConfig(CONTROL_TIMER_INST, (DL_TimerG_ClockConfig *) &control_timer_clock_config);
+    DL_TimerG_initTimerMode(CONTROL_TIMER_INST, &timer_config);
+    DL_TimerG_enableInterrupt(CONTROL_TIMER_INST, DL_TIMERG_INTERRUPT_ZERO_EVENT);
+    DL_TimerG_enableClock(CONTROL_TIMER_INST);
+
+    NVIC_SetPriority(CONTROL_TIMER_INST_INT_IRQN, CONTROL_TIMER_IRQ_PRIORITY);
+}
+
+void hal_control_timer_start(void) {
+    NVIC_ClearPendingIRQ(CONTROL_TIMER_INST_INT_IRQN);
+    NVIC_EnableIRQ(CONTROL_TIMER_INST_INT_IRQN);
+    DL_TimerG_startCounter(CONTROL_TIMER_INST);
+}
+
+void hal_control_timer_stop(void) {
+    DL_TimerG_stopCounter(CONTROL_TIMER_INST);
+    NVIC_DisableIRQ(CONTROL_TIMER_INST_INT_IRQN);
+}
+
+/**
+ * @brief 读取并清除定时器中断
+ * @return true 为周期 (计数归零) 中断
+ */
+bool hal_control_timer_ack_irq(void) {
+    return DL_TimerG_getPendingInterrupt(CONTROL_TIMER_INST) == DL_TIMERG_IIDX_ZERO;
+}
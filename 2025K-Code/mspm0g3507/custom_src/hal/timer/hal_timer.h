@@ -0,0 +1,19 @@
+#ifndef HAL_TIMER_H__
+#define HAL_TIMER_H__
+
+#include "ti_msp_dl_config.h"
+
+// 实时控制层使用的硬件定时器 (SysConfig 未占用的 TIMG0)
+#define CONTROL_TIMER_INST                  TIMG0
+#define CONTROL_TIMER_INST_IRQHandler       TIMG0_IRQHandler
+#define CONTROL_TIMER_INST_INT_IRQN         (TIMG0_INT_IRQn)
+
+// 中断优先级低于编码器 GPIO / UART (默认 0), 保证计数与收包不被控制任务阻塞
+#define CONTROL_TIMER_IRQ_PRIORITY          1
+
+void hal_control_timer_init(uint32_t period_us);
+void hal_control_timer_start(void);
+void hal_control_timer_stop(void);
+bool hal_control_timer_ack_irq(void);
+
+#endif
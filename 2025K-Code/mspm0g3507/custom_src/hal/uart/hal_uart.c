@@ -1,13 +1,169 @@
 #include "hal_uart.h"
+#include "lwrb_mp.h"
+#include "systick.h"
 
 __attribute__((aligned(8))) static char buffer[MAX_TX_BUFFER_SIZE];
 
+#if UART_TX_ASYNC
+
+typedef struct {
+    UART_Regs *uart;
+    lwrb_mp_t mp;               // 主循环和各中断都可能写入 (多生产者), TX 中断读出
+    volatile bool active;       // TX 中断链正在运行 (中断已打开)
+    usart_tx_stats_t stats;
+} usart_tx_t;
+
+static uint8_t uart0_tx_buffer[UART_0_TX_QUEUE_SIZE];
+static uint8_t uart1_tx_buffer[UART_1_TX_QUEUE_SIZE];
+
+static usart_tx_t usart_tx[] = {
+    { .uart = UART_0_INST, .mp = { .rb = { .buff = uart0_tx_buffer, .size = sizeof(uart0_tx_buffer) } } },
+    { .uart = UART_1_INST, .mp = { .rb = { .buff = uart1_tx_buffer, .size = sizeof(uart1_tx_buffer) } } },
+};
+
+static usart_tx_t *usart_tx_find(UART_Regs *uart) {
+    for (size_t i = 0; i < sizeof(usart_tx) / sizeof(usart_tx[0]); i++) {
+        if (usart_tx[i].uart == uart) {
+            return &usart_tx[i];
+        }
+    }
+    return NULL;
+}
+
+// 从队列取字节填满 UART 发送缓冲 (TX 中断中或关中断时调用)
+static void usart_tx_fill(usart_tx_t *tx) {
+    uint8_t byte;
+    while (!DL_UART_Main_isTXFIFOFull(tx->uart) && lwrb_read(&tx->mp.rb, &byte, 1) == 1) {
+        DL_UART_Main_transmitData(tx->uart, byte);
+    }
+}
+
+// TX 中断链没在运行时, 打开 TX 中断并写入第一批字节, 后续由中断接力
+static void usart_tx_start(usart_tx_t *tx) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (!tx->active && lwrb_get_full(&tx->mp.rb) > 0) {
+        tx->active = true;
+        DL_UART_Main_enableInterrupt(tx->uart, DL_UART_MAIN_INTERRUPT_TX);
+        usart_tx_fill(tx);
+    }
+    __set_PRIMASK(primask);
+}
+
+// TX 中断无法执行: 关中断中, 或在异常处理中 (如 HardFault)
+static bool usart_tx_irq_blocked(void) {
+#if defined(__ARM_ARCH)
+    return __get_PRIMASK() != 0 || __get_IPSR() != 0;
+#else
+    return __get_PRIMASK() != 0;
+#endif
+}
+
+#endif // UART_TX_ASYNC
+
+void usart_tx_irq_handler(UART_Regs* uart) {
+#if UART_TX_ASYNC
+    usart_tx_t *tx = usart_tx_find(uart);
+    if (tx != NULL && lwrb_get_full(&tx->mp.rb) > 0) {
+        usart_tx_fill(tx);
+        return;
+    }
+    if (tx != NULL) {
+        tx->active = false;
+    }
+#endif
+    DL_UART_Main_disableInterrupt(uart, DL_UART_MAIN_INTERRUPT_TX);
+}
+
+const usart_tx_stats_t* usart_tx_get_stats(UART_Regs* uart) {
+#if UART_TX_ASYNC
+    usart_tx_t *tx = usart_tx_find(uart);
+    return (tx != NULL) ? &tx->stats : NULL;
+#else
+    (void)uart;
+    return NULL;
+#endif
+}
+
+#if UART_TX_ASYNC
+// 入队并启动发送; all 为 true 时放不下就整包丢弃. 可在中断中调用
+static size_t usart_tx_enqueue(usart_tx_t *tx, const uint8_t *data, size_t length, bool all) {
+    size_t n = lwrb_mp_write(&tx->mp, data, length, all ? LWRB_FLAG_WRITE_ALL : 0);
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    size_t full = lwrb_get_full(&tx->mp.rb);
+    tx->stats.queued += n;
+    if (n < length) {
+        tx->stats.dropped += length - n;
+        tx->stats.full_events++;
+    }
+    if (full > tx->stats.peak) {
+        tx->stats.peak = full;
+    }
+    __set_PRIMASK(primask);
+
+    usart_tx_start(tx);
+    return n;
+}
+#endif
 
 // 发送字节数组
-void usart_send_bytes(UART_Regs* uart, const uint8_t* data, size_t length) {
+size_t usart_send_bytes(UART_Regs* uart, const uint8_t* data, size_t length) {
+#if UART_TX_ASYNC
+    usart_tx_t *tx = usart_tx_find(uart);
+    if (tx != NULL) {
+        return usart_tx_enqueue(tx, data, length, false);
+    }
+#endif
     for (size_t i = 0; i < length; i++) {
         DL_UART_Main_transmitDataBlocking(uart, data[i]);
     }
+    return length;
+}
+
+bool usart_send_packet(UART_Regs* uart, const uint8_t* data, size_t length) {
+#if UART_TX_ASYNC
+    usart_tx_t *tx = usart_tx_find(uart);
+    if (tx != NULL) {
+        return usart_tx_enqueue(tx, data, length, true) == length;
+    }
+#endif
+    usart_send_bytes(uart, data, length);
+    return true;
+}
+
+bool usart_flush(UART_Regs* uart, uint32_t timeout_ms) {
+#if UART_TX_ASYNC
+    usart_tx_t *tx = usart_tx_find(uart);
+    uint32_t start = get_ms();
+    while (tx != NULL && lwrb_get_full(&tx->mp.rb) > 0) {
+        if (usart_tx_irq_blocked()) {
+            uint8_t byte;
+            if (lwrb_read(&tx->mp.rb, &byte, 1) == 1) {
+                DL_UART_Main_transmitDataBlocking(uart, byte);
+            }
+        } else if (time_elapsed_ms(start) >= timeout_ms) {
+            return false;
+        }
+    }
+#else
+    (void)timeout_ms;
+#endif
+    while (DL_UART_Main_isBusy(uart)) {
+    }
+    return true;
+}
+
+void usart_tx_force_commit(UART_Regs* uart) {
+#if UART_TX_ASYNC
+    usart_tx_t *tx = usart_tx_find(uart);
+    if (tx != NULL) {
+        lwrb_mp_force_commit(&tx->mp);
+    }
+#else
+    (void)uart;
+#endif
 }
 
 // 格式化并发送字符串
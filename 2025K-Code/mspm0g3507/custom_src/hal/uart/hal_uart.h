@@ -6,10 +6,65 @@
 #include "stdarg.h"
 #include "stdio.h"
 #include "string.h"
+#include <stdbool.h>
 
 #define MAX_TX_BUFFER_SIZE 256
 
+/*
+ * 异步发送: UART_0 / UART_1 各有一个 lwrb 发送队列, 写入即返回, 由 TX 中断逐次填满 UART 发送缓冲.
+ * 队列满时多出的字节丢弃并计入统计 (不阻塞调用者); 需要确认发完 (如复位、进入死循环前) 时调用
+ * usart_flush(). 关中断或在异常处理中 (TX 中断无法执行) 时 usart_flush() 改为轮询发送.
+ * 发送队列是多生产者的 (lwrb_mp), 主循环和中断可以同时写同一个串口, 每次调用的数据保持连续.
+ * UART_TX_ASYNC 为 0 时退回逐字节阻塞发送.
+ */
+#ifndef UART_TX_ASYNC
+#define UART_TX_ASYNC           1
+#endif
+
+#define UART_0_TX_QUEUE_SIZE    512         // 日志 / 调试输出
+#define UART_1_TX_QUEUE_SIZE    256         // 摄像头
+
+typedef struct {
+    uint32_t queued;            // 入队字节数
+    uint32_t dropped;           // 队列满丢弃的字节数
+    uint32_t full_events;       // 写入时队列放不下 (部分或全部丢弃) 的次数
+    uint32_t peak;              // 队列最高水位 (字节)
+} usart_tx_stats_t;
+
 void usart_printf(UART_Regs* uart, const char* format, ...);
-void usart_send_bytes(UART_Regs* uart, const uint8_t* data, size_t length);
+
+/**
+ * @brief 发送字节数组, 放入发送队列后立即返回
+ * @return 实际入队的字节数, 小于 length 表示队列已满, 其余字节被丢弃
+ */
+size_t usart_send_bytes(UART_Regs* uart, const uint8_t* data, size_t length);
+
+/**
+ * @brief 整包入队: 放不下时整包丢弃 (计入统计), 不会只发出半包
+ * @return false 表示队列已满, 本包被丢弃
+ */
+bool usart_send_packet(UART_Regs* uart, const uint8_t* data, size_t length);
+
+/**
+ * @brief 等待发送队列和 UART 发送缓冲清空
+ * @return false 表示超时仍未发完
+ */
+bool usart_flush(UART_Regs* uart, uint32_t timeout_ms);
+
+/**
+ * @brief 异常处理专用: 发布被打断的写入已预留的数据 (可能只写了一半), 之后的发送才能发出
+ * @note 只在不会返回被打断代码的场合调用 (HardFault 等), 先于本处理中的第一次发送
+ */
+void usart_tx_force_commit(UART_Regs* uart);
+
+/**
+ * @brief TX 中断处理, 在对应串口中断中 DL_UART_IIDX_TX 时调用
+ */
+void usart_tx_irq_handler(UART_Regs* uart);
+
+/**
+ * @brief 发送统计, 没有发送队列的串口返回 NULL
+ */
+const usart_tx_stats_t* usart_tx_get_stats(UART_Regs* uart);
 
 #endif
@@ -0,0 +1,145 @@
+#include "hal_uart_rx.h"
+
+// UART 中残留的字节由 CPU 读入 lwrb (逐字节模式的 RX 中断, DMA 模式下缓冲区满期间积压的字节)
+static lwrb_sz_t uart_rx_drain(uart_rx_t *rx) {
+    lwrb_sz_t n = 0;
+    while (!DL_UART_Main_isRXFIFOEmpty(rx->uart)) {
+        uint8_t byte = DL_UART_Main_receiveData(rx->uart);
+        if (lwrb_write(rx->rb, &byte, 1) == 1) {
+            n++;
+        } else {
+            rx->stats.overflows++;
+        }
+    }
+    rx->stats.cpu_bytes += n;
+    return n;
+}
+
+#if UART_RX_DMA
+
+// 把当前线性空闲区布置给 DMA; 缓冲区满时不布置
+static void uart_rx_arm(uart_rx_t *rx) {
+    lwrb_sz_t len = lwrb_get_linear_block_write_length(rx->rb);
+    if (len > UINT16_MAX) {
+        len = UINT16_MAX;
+    }
+    rx->armed = len;
+    if (len == 0) {
+        return;
+    }
+    DL_DMA_setDestAddr(DMA, rx->dma_channel, (uintptr_t)lwrb_get_linear_block_write_address(rx->rb));
+    DL_DMA_setTransferSize(DMA, rx->dma_channel, (uint16_t)len);
+    DL_DMA_enableChannel(DMA, rx->dma_channel);
+}
+
+// 停 DMA 并提交已写入的字节; 整段传完时通道已自动关闭, 剩余计数为 0
+static lwrb_sz_t uart_rx_commit(uart_rx_t *rx) {
+    if (rx->armed == 0) {
+        return 0;
+    }
+    DL_DMA_disableChannel(DMA, rx->dma_channel);
+    lwrb_sz_t done = rx->armed - DL_DMA_getTransferSize(DMA, rx->dma_channel);
+    rx->armed = 0;
+    if (done > 0) {
+        lwrb_advance(rx->rb, done);
+    }
+    return done;
+}
+
+// 消费者读出数据后, DMA 若因缓冲区满而停着则重新布置 (主循环中调用, 与串口中断互斥)
+static void uart_rx_rb_evt(lwrb_t *rb, lwrb_evt_type_t evt, lwrb_sz_t bp) {
+    (void)bp;
+    uart_rx_t *rx = (uart_rx_t *)lwrb_get_arg(rb);
+    if (evt != LWRB_EVT_READ || rx->armed != 0) {
+        return;
+    }
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (rx->armed == 0) {
+        uart_rx_arm(rx);
+    }
+    __set_PRIMASK(primask);
+}
+
+#endif // UART_RX_DMA
+
+void uart_rx_init(uart_rx_t *rx, UART_Regs *uart, lwrb_t *rb, uint8_t dma_channel, uint32_t dma_trigger) {
+    rx->uart = uart;
+    rx->rb = rb;
+    rx->dma_channel = dma_channel;
+    rx->armed = 0;
+    rx->stats = (uart_rx_stats_t){ 0 };
+
+#if UART_RX_DMA
+    DL_DMA_Config config = {
+        .trigger = dma_trigger,
+        .triggerType = DL_DMA_TRIGGER_TYPE_EXTERNAL,
+        .transferMode = DL_DMA_SINGLE_TRANSFER_MODE,
+        .extendedMode = DL_DMA_NORMAL_MODE,
+        .destWidth = DL_DMA_WIDTH_BYTE,
+        .srcWidth = DL_DMA_WIDTH_BYTE,
+        .destIncrement = DL_DMA_ADDR_INCREMENT,
+        .srcIncrement = DL_DMA_ADDR_UNCHANGED,
+    };
+    DL_DMA_initChannel(DMA, dma_channel, &config);
+    DL_DMA_setSrcAddr(DMA, dma_channel, (uintptr_t)&uart->RXDATA);
+
+    lwrb_set_arg(rb, rx);
+    lwrb_set_evt_fn(rb, uart_rx_rb_evt);
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    // 关闭 FIFO 时 DMA 每字节触发一次, 接收寄存器总是空的, RX 超时永远不会产生
+    DL_UART_Main_changeConfig(uart);
+    DL_UART_Main_enableFIFOs(uart);
+    DL_UART_Main_setRXFIFOThreshold(uart, UART_RX_DMA_FIFO_LEVEL);
+    DL_UART_Main_enable(uart);
+    DL_UART_Main_setRXInterruptTimeout(uart, UART_RX_TIMEOUT_BITS);
+    DL_UART_Main_disableInterrupt(uart, DL_UART_MAIN_INTERRUPT_RX);
+    DL_UART_Main_enableDMAReceiveEvent(uart, DL_UART_MAIN_DMA_INTERRUPT_RX);
+    DL_UART_Main_enableInterrupt(uart, DL_UART_MAIN_INTERRUPT_RX_TIMEOUT_ERROR |
+                                       DL_UART_MAIN_INTERRUPT_DMA_DONE_RX);
+    uart_rx_drain(rx);              // 初始化前已收到的字节
+    uart_rx_arm(rx);
+    __set_PRIMASK(primask);
+#else
+    (void)dma_trigger;
+#endif
+}
+
+uint32_t uart_rx_irq_handler(uart_rx_t *rx, DL_UART_IIDX idx) {
+    uint32_t evt = 0;
+
+    switch (idx) {
+#if UART_RX_DMA
+        case DL_UART_IIDX_DMA_DONE_RX:
+            rx->stats.dma_blocks++;
+            if (uart_rx_commit(rx) > 0) {
+                evt |= UART_RX_EVT_DATA;
+            }
+            uart_rx_arm(rx);
+            break;
+
+        case DL_UART_IIDX_RX_TIMEOUT_ERROR:
+            rx->stats.idle_events++;
+            if (uart_rx_commit(rx) > 0) {
+                evt |= UART_RX_EVT_DATA;
+            }
+            if (uart_rx_drain(rx) > 0) {
+                evt |= UART_RX_EVT_DATA;
+            }
+            uart_rx_arm(rx);
+            evt |= UART_RX_EVT_IDLE;
+            break;
+#endif
+        case DL_UART_IIDX_RX:
+            if (uart_rx_drain(rx) > 0) {
+                evt |= UART_RX_EVT_DATA;
+            }
+            break;
+
+        default:
+            break;
+    }
+    return evt;
+}
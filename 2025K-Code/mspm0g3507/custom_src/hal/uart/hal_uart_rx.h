@@ -0,0 +1,69 @@
+#ifndef __HAL_UART_RX_H__
+#define __HAL_UART_RX_H__
+
+#include "ti_msp_dl_config.h"
+#include "lwrb.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 串口接收引擎: DMA 直接写入 lwrb 的线性空闲区, 用 lwrb_advance 提交, 不再每字节进一次中断.
+ *
+ *  - 每次把当前线性空闲区整段布置给 DMA, 传完 (DMA_DONE_RX) 提交整段并布置下一段,
+ *    环回处自然分成两段;
+ *  - 线路空闲 UART_RX_TIMEOUT_BITS 个位时间产生 RX 超时中断: 停 DMA, 按剩余计数提交已写入的
+ *    字节后重新布置, 同时作为帧边界通知. 连续收发时一帧只进一次中断;
+ *  - RX 超时只在接收 FIFO 非空时计时, 所以打开 FIFO 并把 DMA 触发门限设在 1 字节以上
+ *    (UART_RX_DMA_FIFO_LEVEL): DMA 总在 FIFO 里留下不足门限的尾巴, 超时中断中由 CPU 读出;
+ *  - 缓冲区满时不布置 DMA, 字节留在 UART 中, 空闲中断时由 CPU 读出 (写不进去的计入 overflows);
+ *    消费者读走数据后 (lwrb 读事件) 自动重新布置. 因此接收 lwrb 的事件回调归本模块所有.
+ *
+ * UART_RX_DMA 为 0 时退回逐字节 RX 中断, 接口与事件不变 (没有 IDLE 事件).
+ */
+
+#ifndef UART_RX_DMA
+#define UART_RX_DMA                 1
+#endif
+
+#ifndef UART_RX_TIMEOUT_BITS
+#define UART_RX_TIMEOUT_BITS        15          // 最大 15 个位时间, 115200 下约 130us
+#endif
+
+#ifndef UART_RX_DMA_FIFO_LEVEL
+#define UART_RX_DMA_FIFO_LEVEL      DL_UART_RX_FIFO_LEVEL_1_2_FULL  // 4 字节 FIFO 中 >= 2 字节才触发 DMA
+#endif
+
+// uart_rx_irq_handler 的返回值 (按位)
+#define UART_RX_EVT_DATA            (1u << 0)   // 有新字节提交到 lwrb
+#define UART_RX_EVT_IDLE            (1u << 1)   // 线路空闲 (一帧结束)
+
+typedef struct {
+    uint32_t idle_events;       // RX 超时 (帧边界) 次数
+    uint32_t dma_blocks;        // DMA 整段传完次数
+    uint32_t cpu_bytes;         // 由 CPU 读出的字节 (逐字节模式或 DMA 未布置时)
+    uint32_t overflows;         // 缓冲区满丢弃的字节
+} uart_rx_stats_t;
+
+typedef struct {
+    UART_Regs *uart;
+    lwrb_t *rb;
+    uint8_t dma_channel;
+    volatile lwrb_sz_t armed;   // 当前布置给 DMA 的长度, 0 表示未布置
+    uart_rx_stats_t stats;
+} uart_rx_t;
+
+/**
+ * @brief 初始化接收引擎并开始接收
+ * @param rb 已 lwrb_init 的接收缓冲区
+ * @param dma_channel / dma_trigger DMA 通道与 UART 接收触发源 (DMA_UARTx_RX_TRIG), 逐字节模式下忽略
+ * @note 在 SysConfig 初始化之后调用; DMA 模式下打开 FIFO, 关闭 RX 中断, 改开 RX 超时与 DMA 完成中断
+ */
+void uart_rx_init(uart_rx_t *rx, UART_Regs *uart, lwrb_t *rb, uint8_t dma_channel, uint32_t dma_trigger);
+
+/**
+ * @brief 在串口中断中调用, idx 为 DL_UART_getPendingInterrupt 的结果
+ * @return UART_RX_EVT_* 的组合
+ */
+uint32_t uart_rx_irq_handler(uart_rx_t *rx, DL_UART_IIDX idx);
+
+#endif // __HAL_UART_RX_H__
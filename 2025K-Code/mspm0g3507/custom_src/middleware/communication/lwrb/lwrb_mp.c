@@ -0,0 +1,137 @@
+#include "lwrb_mp.h"
+
+#if defined(__ARM_ARCH)
+#include "ti_msp_dl_config.h"
+
+typedef uint32_t lwrb_mp_lock_t;
+
+static inline lwrb_mp_lock_t lwrb_mp_lock(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+static inline void lwrb_mp_unlock(lwrb_mp_lock_t primask) {
+    __set_PRIMASK(primask);
+}
+#else
+// 主机: 生产者是线程, 用全局自旋锁代替关中断
+typedef int lwrb_mp_lock_t;
+
+static volatile char lwrb_mp_spin;
+
+static inline lwrb_mp_lock_t lwrb_mp_lock(void) {
+    while (__atomic_test_and_set(&lwrb_mp_spin, __ATOMIC_ACQUIRE)) {
+    }
+    return 0;
+}
+
+static inline void lwrb_mp_unlock(lwrb_mp_lock_t unused) {
+    (void)unused;
+    __atomic_clear(&lwrb_mp_spin, __ATOMIC_RELEASE);
+}
+#endif
+
+// 与消费者之间传递读写指针
+#define LWRB_MP_LOAD(var)           __atomic_load_n(&(var), __ATOMIC_ACQUIRE)
+#define LWRB_MP_STORE(var, val)     __atomic_store_n(&(var), (val), __ATOMIC_RELEASE)
+
+uint8_t lwrb_mp_init(lwrb_mp_t* mp, void* buffdata, lwrb_sz_t size) {
+    if (mp == NULL || !lwrb_init(&mp->rb, buffdata, size)) {
+        return 0;
+    }
+    mp->reserve_ptr = 0;
+    mp->pending = 0;
+    return 1;
+}
+
+lwrb_sz_t lwrb_mp_reserve(lwrb_mp_t* mp, lwrb_sz_t len, uint16_t flags, lwrb_mp_resv_t* resv) {
+    resv->len = 0;
+    if (mp->rb.buff == NULL || len == 0) {
+        return 0;
+    }
+    lwrb_mp_lock_t lock = lwrb_mp_lock();
+    lwrb_sz_t size = mp->rb.size;
+    lwrb_sz_t r_ptr = LWRB_MP_LOAD(mp->rb.r_ptr);
+    lwrb_sz_t pos = mp->reserve_ptr;
+    // 与 lwrb_get_free 相同, 只是以 reserve_ptr 代替 w_ptr
+    lwrb_sz_t free = (pos >= r_ptr) ? (size - (pos - r_ptr)) : (r_ptr - pos);
+    free--;
+    if (len > free) {
+        len = (flags & LWRB_FLAG_WRITE_ALL) ? 0 : free;
+    }
+    if (len > 0) {
+        lwrb_sz_t next = pos + len;
+        mp->reserve_ptr = (next >= size) ? (next - size) : next;
+        mp->pending++;
+        resv->pos = pos;
+        resv->len = len;
+    }
+    lwrb_mp_unlock(lock);
+    return len;
+}
+
+void lwrb_mp_fill(lwrb_mp_t* mp, const lwrb_mp_resv_t* resv, lwrb_sz_t offset, const void* data, lwrb_sz_t len) {
+    if (offset >= resv->len) {
+        return;
+    }
+    if (len > resv->len - offset) {
+        len = resv->len - offset;
+    }
+    lwrb_sz_t size = mp->rb.size;
+    lwrb_sz_t pos = resv->pos + offset;
+    if (pos >= size) {
+        pos -= size;
+    }
+    lwrb_sz_t first = size - pos;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(&mp->rb.buff[pos], data, first);
+    memcpy(mp->rb.buff, (const uint8_t*)data + first, len - first);
+}
+
+// 发布 [w_ptr, reserve_ptr), 须在临界区内调用; 返回发布的字节数
+static lwrb_sz_t lwrb_mp_publish(lwrb_mp_t* mp) {
+    lwrb_sz_t w_ptr = mp->rb.w_ptr;
+    lwrb_sz_t next = mp->reserve_ptr;
+    LWRB_MP_STORE(mp->rb.w_ptr, next);
+    return (next >= w_ptr) ? (next - w_ptr) : (mp->rb.size - w_ptr + next);
+}
+
+uint8_t lwrb_mp_commit(lwrb_mp_t* mp, const lwrb_mp_resv_t* resv) {
+    if (resv->len == 0) {
+        return 0;
+    }
+    lwrb_sz_t published = 0;
+    lwrb_mp_lock_t lock = lwrb_mp_lock();
+    if (mp->pending > 0 && --mp->pending == 0) {
+        published = lwrb_mp_publish(mp);
+    }
+    lwrb_mp_unlock(lock);
+
+    if (published == 0) {
+        return 0;
+    }
+    if (mp->rb.evt_fn != NULL) {
+        mp->rb.evt_fn(&mp->rb, LWRB_EVT_WRITE, published);
+    }
+    return 1;
+}
+
+lwrb_sz_t lwrb_mp_write(lwrb_mp_t* mp, const void* data, lwrb_sz_t len, uint16_t flags) {
+    lwrb_mp_resv_t resv;
+    if (lwrb_mp_reserve(mp, len, flags, &resv) == 0) {
+        return 0;
+    }
+    lwrb_mp_fill(mp, &resv, 0, data, resv.len);
+    lwrb_mp_commit(mp, &resv);
+    return resv.len;
+}
+
+void lwrb_mp_force_commit(lwrb_mp_t* mp) {
+    lwrb_mp_lock_t lock = lwrb_mp_lock();
+    mp->pending = 0;
+    lwrb_mp_publish(mp);
+    lwrb_mp_unlock(lock);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file lwrb_mp.h
+ * @brief lwrb 多生产者扩展: 预留 -> 填充 -> 提交
+ *
+ * lwrb 本身只支持单生产者/单消费者. 主循环写到一半被中断打断, 中断里再写同一个缓冲区,
+ * 两边拿到同一个 w_ptr, 数据互相覆盖. 这里把写入拆成三步:
+ *  1. lwrb_mp_reserve(): 在临界区内移动 reserve_ptr, 划出一段只属于调用者的空间 (O(1));
+ *  2. lwrb_mp_fill():    在临界区外拷贝数据, 可分多次填;
+ *  3. lwrb_mp_commit():  在临界区内把未提交计数减一, 减到 0 时把 w_ptr 推到 reserve_ptr,
+ *                        此前所有预留一起对消费者可见.
+ * 单核上嵌套的中断总是先于被它打断的代码提交, 所以外层提交时整批发布; 消费者看不到填了一半的数据.
+ *
+ * 临界区: 目标板上关中断 (PRIMASK, Cortex-M0+ 没有 LDREX/STREX); 主机上用自旋锁, 生产者可以是线程.
+ * 读写指针的发布用 acquire/release 的 32 位读写 (M0+ 上是普通 LDR/STR 加 DMB), 不依赖原子读改写.
+ *
+ * 消费者 (只能有一个) 照常对 mp->rb 调用 lwrb_read / lwrb_get_linear_block_read_* / lwrb_skip;
+ * 生产者只能用 lwrb_mp_* 写入, 不能再直接调用 lwrb_write.
+ */
+#ifndef LWRB_MP_H
+#define LWRB_MP_H
+
+#include "lwrb_opts.h"
+#include "lwrb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    lwrb_t rb;                  // 底层缓冲区, w_ptr 为已发布的位置
+    lwrb_sz_t reserve_ptr;      // 下一个可预留的位置, [w_ptr, reserve_ptr) 为已预留未发布的数据
+    lwrb_sz_t pending;          // 已预留未提交的个数
+} lwrb_mp_t;
+
+/**
+ * @brief 一次预留, 由 lwrb_mp_reserve 填写, 填充和提交时传回
+ */
+typedef struct {
+    lwrb_sz_t pos;              // 起始位置 (可能在缓冲区末尾回绕)
+    lwrb_sz_t len;              // 预留长度, 0 表示没有预留到空间
+} lwrb_mp_resv_t;
+
+/**
+ * @brief 初始化, 可用字节数为 size - 1 (同 lwrb_init)
+ * @return 1 成功, 0 参数无效
+ */
+uint8_t lwrb_mp_init(lwrb_mp_t* mp, void* buffdata, lwrb_sz_t size);
+
+/**
+ * @brief 预留 len 字节
+ * @param flags LWRB_FLAG_WRITE_ALL: 放不下时不预留; 0: 放不下时预留剩余的全部空间
+ * @return 预留到的字节数 (同 resv->len); 大于 0 时必须随后调用 lwrb_mp_commit
+ */
+lwrb_sz_t lwrb_mp_reserve(lwrb_mp_t* mp, lwrb_sz_t len, uint16_t flags, lwrb_mp_resv_t* resv);
+
+/**
+ * @brief 向预留区写入数据, offset 为相对预留起点的偏移, 超出预留长度的部分忽略
+ */
+void lwrb_mp_fill(lwrb_mp_t* mp, const lwrb_mp_resv_t* resv, lwrb_sz_t offset, const void* data, lwrb_sz_t len);
+
+/**
+ * @brief 提交预留; 是最后一个未提交的预留时发布全部已预留数据 (触发 LWRB_EVT_WRITE)
+ * @return 1 本次提交发布了数据, 0 还有别的预留未提交 (数据随其提交一起发布)
+ */
+uint8_t lwrb_mp_commit(lwrb_mp_t* mp, const lwrb_mp_resv_t* resv);
+
+/**
+ * @brief 预留 + 填充 + 提交
+ * @return 写入的字节数
+ */
+lwrb_sz_t lwrb_mp_write(lwrb_mp_t* mp, const void* data, lwrb_sz_t len, uint16_t flags);
+
+/**
+ * @brief 异常处理专用: 被打断的生产者不会再回来提交, 把所有预留 (可能只填了一半) 当作已提交发布
+ */
+void lwrb_mp_force_commit(lwrb_mp_t* mp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LWRB_MP_H
@@ -12,11 +12,21 @@
 static cam_track_callback_t   track_callback = NULL;
 static cam_number_callback_t  number_callback = NULL; 
 static cam_command_callback_t command_callback = NULL;
+static cam_obstacle_callback_t obstacle_callback = NULL;
+static cam_cylinder_callback_t cylinder_callback = NULL;
+
+static cam_protocol_stats_t bin_stats;
+static uint8_t last_seq;
+static bool seq_valid = false;
 
 // ====================  内部函数声明  ====================
 
+#if CAM_PROTOCOL_ASCII
 static uint8_t hex_char_to_byte(char high, char low);
 static uint8_t hex_char_to_nibble(char c);
+static bool parse_obstacles(const uint8_t* data, size_t length, cam_protocol_data_t* parsed_data);
+#endif
+static void process_binary(const cam_msg_header_t* hdr);
 
 // ====================  公共函数实现  ====================
 
@@ -24,12 +34,98 @@ void cam_protocol_init(void) {
     track_callback = NULL;
     number_callback = NULL;
     command_callback = NULL;
+    obstacle_callback = NULL;
+    cylinder_callback = NULL;
+    memset(&bin_stats, 0, sizeof(bin_stats));
+    seq_valid = false;
+}
+
+// CRC-16/CCITT-FALSE, 半字节查表 (32 字节表)
+uint16_t cam_protocol_crc16(const uint8_t* data, size_t length) {
+    static const uint16_t table[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    };
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc = (uint16_t)((crc << 4) ^ table[(crc >> 12) ^ (data[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ table[(crc >> 12) ^ (data[i] & 0x0F)]);
+    }
+    return crc;
+}
+
+/**
+ * @brief 各类型消息 body 应有的长度, 类型未知时返回 -1
+ */
+static int expected_body_len(uint8_t type, const uint8_t* body, uint8_t len) {
+    switch (type) {
+        case CAM_MSG_TRACK:     return sizeof(cam_msg_track_t);
+        case CAM_MSG_NUMBER:    return sizeof(cam_msg_number_t);
+        case CAM_MSG_COMMAND:   return sizeof(cam_msg_command_t);
+        case CAM_MSG_CYLINDERS: return sizeof(cam_msg_cylinders_t);
+        case CAM_MSG_OBSTACLES:
+            if (len < 2 || body[0] > CAM_MAX_OBSTACLES) {
+                return -1;
+            }
+            return 2 + body[0] * (int)sizeof(cam_obstacle_t);
+        default:
+            return -1;
+    }
+}
+
+const cam_msg_header_t *cam_protocol_check(const uint8_t* data, size_t length, cam_parse_result_t* result) {
+    cam_parse_result_t r = CAM_PARSE_OK;
+    const cam_msg_header_t* hdr = (const cam_msg_header_t*)data;
+
+    if (data == NULL) {
+        r = CAM_PARSE_ERROR;
+    } else if (length < CAM_BIN_OVERHEAD || length != (size_t)CAM_BIN_OVERHEAD + hdr->len) {
+        r = CAM_PARSE_INVALID_LENGTH;
+    } else if (hdr->magic != CAM_BIN_MAGIC) {
+        r = CAM_PARSE_BAD_VERSION;
+    } else if (expected_body_len(hdr->type, data + CAM_BIN_HEADER_LEN, hdr->len) != hdr->len) {
+        r = CAM_PARSE_INVALID_FORMAT;
+    } else {
+        size_t n = CAM_BIN_HEADER_LEN + hdr->len;
+        uint16_t crc = (uint16_t)(data[n] | (data[n + 1] << 8));
+        if (crc != cam_protocol_crc16(data, n)) {
+            r = CAM_PARSE_CRC_ERROR;
+        }
+    }
+    if (result != NULL) {
+        *result = r;
+    }
+    return (r == CAM_PARSE_OK) ? hdr : NULL;
+}
+
+size_t cam_protocol_encode(cam_msg_type_t type, uint8_t seq, const void* body, uint8_t body_len,
+                           uint8_t* out, size_t out_size) {
+    size_t n = CAM_BIN_HEADER_LEN + body_len;
+    if (out == NULL || out_size < n + CAM_BIN_CRC_LEN) {
+        return 0;
+    }
+    out[0] = CAM_BIN_MAGIC;
+    out[1] = (uint8_t)type;
+    out[2] = seq;
+    out[3] = body_len;
+    if (body_len > 0) {
+        memcpy(&out[CAM_BIN_HEADER_LEN], body, body_len);
+    }
+    uint16_t crc = cam_protocol_crc16(out, n);
+    out[n] = (uint8_t)(crc & 0xFF);
+    out[n + 1] = (uint8_t)(crc >> 8);
+    return n + CAM_BIN_CRC_LEN;
 }
 
 cam_parse_result_t cam_protocol_parse(const uint8_t* data, size_t length, cam_protocol_data_t* parsed_data) {
     if (data == NULL || parsed_data == NULL) {
         return CAM_PARSE_ERROR;
     }
+#if !CAM_PROTOCOL_ASCII
+    (void)length;
+    parsed_data->valid = false;
+    return CAM_PARSE_ASCII_DISABLED;
+#else
     
     // 初始化结果
     parsed_data->valid = false;
@@ -77,12 +173,34 @@ cam_parse_result_t cam_protocol_parse(const uint8_t* data, size_t length, cam_pr
             }
             return CAM_PARSE_INVALID_FORMAT;
             
+        case CAM_DATA_OBSTACLE: // O:1,60,-25;0,150,25
+            if (parse_obstacles(&data[2], length - 2, parsed_data)) {
+                parsed_data->valid = true;
+                return CAM_PARSE_OK;
+            }
+            return CAM_PARSE_INVALID_FORMAT;
+            
         default:
             return CAM_PARSE_INVALID_FORMAT;
     }
+#endif
 }
 
 cam_parse_result_t cam_protocol_process(const uint8_t* data, size_t length) {
+    // 二进制消息: 校验后直接在接收缓冲区上分发
+    if (data != NULL && length > 0 && (data[0] & 0xF0) == (CAM_BIN_MAGIC & 0xF0)) {
+        cam_parse_result_t result;
+        const cam_msg_header_t* hdr = cam_protocol_check(data, length, &result);
+        if (hdr != NULL) {
+            process_binary(hdr);
+        } else if (result == CAM_PARSE_CRC_ERROR) {
+            bin_stats.crc_errors++;
+        } else {
+            bin_stats.format_errors++;
+        }
+        return result;
+    }
+
     cam_protocol_data_t parsed_data;
     cam_parse_result_t result = cam_protocol_parse(data, length, &parsed_data);
     
@@ -106,6 +224,12 @@ cam_parse_result_t cam_protocol_process(const uint8_t* data, size_t length) {
                     command_callback(parsed_data.data.command_code);
                 }
                 break;
+                
+            case CAM_DATA_OBSTACLE:
+                if (obstacle_callback != NULL) {
+                    obstacle_callback(parsed_data.data.obstacles.items, parsed_data.data.obstacles.count);
+                }
+                break;
         }
     }
     
@@ -124,6 +248,18 @@ void cam_protocol_set_command_callback(cam_command_callback_t callback) {
     command_callback = callback;
 }
 
+void cam_protocol_set_obstacle_callback(cam_obstacle_callback_t callback) {
+    obstacle_callback = callback;
+}
+
+void cam_protocol_set_cylinder_callback(cam_cylinder_callback_t callback) {
+    cylinder_callback = callback;
+}
+
+const cam_protocol_stats_t *cam_protocol_get_stats(void) {
+    return &bin_stats;
+}
+
 const char* cam_protocol_get_error_string(cam_parse_result_t result) {
     switch (result) {
         case CAM_PARSE_OK:
@@ -134,6 +270,12 @@ const char* cam_protocol_get_error_string(cam_parse_result_t result) {
             return "Invalid format";
         case CAM_PARSE_INVALID_LENGTH:
             return "Invalid length";
+        case CAM_PARSE_CRC_ERROR:
+            return "CRC error";
+        case CAM_PARSE_BAD_VERSION:
+            return "Bad version";
+        case CAM_PARSE_ASCII_DISABLED:
+            return "ASCII disabled";
         default:
             return "Unknown error";
     }
@@ -141,6 +283,50 @@ const char* cam_protocol_get_error_string(cam_parse_result_t result) {
 
 // ====================  内部函数实现  ====================
 
+static void process_binary(const cam_msg_header_t* hdr) {
+    bin_stats.frames++;
+    if (seq_valid && hdr->seq != (uint8_t)(last_seq + 1)) {
+        bin_stats.seq_gaps++;
+    }
+    last_seq = hdr->seq;
+    seq_valid = true;
+
+    switch (hdr->type) {
+        case CAM_MSG_TRACK:
+            if (track_callback != NULL) {
+                track_callback(CAM_MSG_BODY(hdr, cam_msg_track_t)->value);
+            }
+            break;
+
+        case CAM_MSG_NUMBER:
+            if (number_callback != NULL) {
+                number_callback(CAM_MSG_BODY(hdr, cam_msg_number_t)->value);
+            }
+            break;
+
+        case CAM_MSG_COMMAND:
+            if (command_callback != NULL) {
+                command_callback(CAM_MSG_BODY(hdr, cam_msg_command_t)->code);
+            }
+            break;
+
+        case CAM_MSG_OBSTACLES: {
+            const cam_msg_obstacles_t* msg = CAM_MSG_BODY(hdr, cam_msg_obstacles_t);
+            if (obstacle_callback != NULL) {
+                obstacle_callback(msg->items, msg->count);
+            }
+            break;
+        }
+
+        case CAM_MSG_CYLINDERS:
+            if (cylinder_callback != NULL) {
+                cylinder_callback(CAM_MSG_BODY(hdr, cam_msg_cylinders_t));
+            }
+            break;
+    }
+}
+
+#if CAM_PROTOCOL_ASCII
 static uint8_t hex_char_to_byte(char high, char low) {
     return (hex_char_to_nibble(high) << 4) | hex_char_to_nibble(low);
 }
@@ -154,4 +340,60 @@ static uint8_t hex_char_to_nibble(char c) {
         return c - 'a' + 10;
     }
     return 0;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 解析有符号十进制整数, 成功时 *pos 移到数字之后
+ */
+static bool parse_int(const uint8_t* data, size_t length, size_t* pos, int32_t* value) {
+    size_t i = *pos;
+    bool negative = false;
+    int32_t v = 0;
+    
+    if (i < length && (data[i] == '-' || data[i] == '+')) {
+        negative = (data[i] == '-');
+        i++;
+    }
+    if (i >= length || data[i] < '0' || data[i] > '9') {
+        return false;
+    }
+    while (i < length && data[i] >= '0' && data[i] <= '9') {
+        if (v > 9999) {
+            return false;      // 场地坐标不会超过 4 位数
+        }
+        v = v * 10 + (data[i] - '0');
+        i++;
+    }
+    *value = negative ? -v : v;
+    *pos = i;
+    return true;
+}
+
+/**
+ * @brief 解析 "c,x,y;c,x,y;..." 形式的圆柱列表, 末尾的 ';' 可有可无
+ */
+static bool parse_obstacles(const uint8_t* data, size_t length, cam_protocol_data_t* parsed_data) {
+    size_t pos = 0;
+    uint8_t count = 0;
+    
+    while (pos < length) {
+        int32_t color, x, y;
+        if (count >= CAM_MAX_OBSTACLES ||
+            !parse_int(data, length, &pos, &color) || pos >= length || data[pos++] != ',' ||
+            !parse_int(data, length, &pos, &x) || pos >= length || data[pos++] != ',' ||
+            !parse_int(data, length, &pos, &y)) {
+            return false;
+        }
+        parsed_data->data.obstacles.items[count].x_cm = (int16_t)x;
+        parsed_data->data.obstacles.items[count].y_cm = (int16_t)y;
+        parsed_data->data.obstacles.items[count].color = (uint8_t)color;
+        parsed_data->data.obstacles.items[count].confidence = 100;
+        count++;
+        if (pos < length && data[pos++] != ';') {
+            return false;
+        }
+    }
+    parsed_data->data.obstacles.count = count;
+    return true;
+}
+#endif
@@ -13,6 +13,15 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+// ====================  配置  ====================
+
+// 1: 兼容旧的 ASCII 消息 ("T:0x33" / "N:123" / "C:0x01" / "O:..."), 0: 只接收二进制消息
+#ifndef CAM_PROTOCOL_ASCII
+#define CAM_PROTOCOL_ASCII  1
+#endif
+
+#define CAM_PACKED          __attribute__((packed))
+
 // ====================  数据类型定义  ====================
 
 /**
@@ -21,9 +30,79 @@
 typedef enum {
     CAM_DATA_TRACK   = 'T',    // 循迹数据: T:0x33
     CAM_DATA_NUMBER  = 'N',    // 数字数据: N:123  
-    CAM_DATA_COMMAND = 'C'     // 命令数据: C:0x01
+    CAM_DATA_COMMAND = 'C',    // 命令数据: C:0x01
+    CAM_DATA_OBSTACLE = 'O'    // 圆柱布局: O:1,60,-25;0,150,25  (颜色,x,y 每组以 ';' 分隔, 单位 cm)
 } cam_data_type_t;
 
+#define CAM_MAX_OBSTACLES   12
+#define CAM_CYLINDER_COUNT  6          // 识别区的圆柱数
+
+/**
+ * @brief 一个圆柱的颜色与场地坐标 (发车点为原点, x 沿发车方向, y 向左)
+ * @note 与二进制消息中的布局相同 (小端, 无填充), 接收时直接指向接收缓冲区, 按 packed 访问不要求对齐
+ */
+typedef struct CAM_PACKED {
+    int16_t x_cm;
+    int16_t y_cm;
+    uint8_t color;             // 0 白, 1 黑
+    uint8_t confidence;        // 0~100, ASCII 消息为 100
+} cam_obstacle_t;
+
+/*
+ * 二进制消息 (lwpkt 帧的数据部分), 所有多字节字段为小端:
+ *
+ *   偏移  0     1     2     3     4 ... 3+len    4+len  5+len
+ *        magic type  seq   len   body           crc16 (低字节在前)
+ *
+ * magic = 0xB0 | 版本号, 与 ASCII 消息的首字符 ('T' 'N' 'C' 'O') 不会重合;
+ * crc16 为 CRC-16/CCITT-FALSE (多项式 0x1021, 初值 0xFFFF), 覆盖 magic 到 body 末尾.
+ * 各类型 body 为下面的定长结构 (圆柱布局按 count 截断), 校验通过后直接按结构读取接收缓冲区, 不复制、不解析.
+ */
+#define CAM_BIN_VERSION     1
+#define CAM_BIN_MAGIC       (0xB0 | CAM_BIN_VERSION)
+#define CAM_BIN_HEADER_LEN  4
+#define CAM_BIN_CRC_LEN     2
+#define CAM_BIN_OVERHEAD    (CAM_BIN_HEADER_LEN + CAM_BIN_CRC_LEN)
+
+typedef enum {
+    CAM_MSG_TRACK = 0x01,       // cam_msg_track_t
+    CAM_MSG_NUMBER,             // cam_msg_number_t
+    CAM_MSG_COMMAND,            // cam_msg_command_t
+    CAM_MSG_OBSTACLES,          // cam_msg_obstacles_t
+    CAM_MSG_CYLINDERS,          // cam_msg_cylinders_t: 六个圆柱的颜色与置信度 + 路线命令字, 一帧送达
+} cam_msg_type_t;
+
+typedef struct CAM_PACKED {
+    uint8_t magic;
+    uint8_t type;              // cam_msg_type_t
+    uint8_t seq;               // 发送端递增, 用于统计丢帧
+    uint8_t len;               // body 长度
+} cam_msg_header_t;
+
+typedef struct CAM_PACKED { uint8_t value; } cam_msg_track_t;
+typedef struct CAM_PACKED { int32_t value; } cam_msg_number_t;
+typedef struct CAM_PACKED { uint8_t code; } cam_msg_command_t;
+
+typedef struct CAM_PACKED {
+    uint8_t count;
+    uint8_t reserved;
+    cam_obstacle_t items[CAM_MAX_OBSTACLES];   // 实际长度 count 项
+} cam_msg_obstacles_t;
+
+typedef struct CAM_PACKED {
+    uint8_t color;             // 0 白, 1 黑
+    uint8_t confidence;        // 0~100
+} cam_cylinder_t;
+
+typedef struct CAM_PACKED {
+    uint8_t command;           // 路线命令字, 0 = 未识别出路线
+    uint8_t reserved;
+    cam_cylinder_t items[CAM_CYLINDER_COUNT];
+} cam_msg_cylinders_t;
+
+// 取消息 body, 仅在 cam_protocol_check() 通过后使用
+#define CAM_MSG_BODY(hdr, type)     ((const type *)((const uint8_t *)(hdr) + CAM_BIN_HEADER_LEN))
+
 /**
  * @brief 协议解析结果
  */
@@ -31,9 +110,22 @@ typedef enum {
     CAM_PARSE_OK = 0,          // 解析成功
     CAM_PARSE_ERROR,           // 解析错误
     CAM_PARSE_INVALID_FORMAT,  // 格式无效
-    CAM_PARSE_INVALID_LENGTH   // 长度无效
+    CAM_PARSE_INVALID_LENGTH,  // 长度无效
+    CAM_PARSE_CRC_ERROR,       // 二进制消息校验失败
+    CAM_PARSE_BAD_VERSION,     // 二进制消息版本不符
+    CAM_PARSE_ASCII_DISABLED   // 收到 ASCII 消息但 CAM_PROTOCOL_ASCII 为 0
 } cam_parse_result_t;
 
+/**
+ * @brief 二进制消息收包统计
+ */
+typedef struct {
+    uint32_t frames;           // 校验通过的帧
+    uint32_t crc_errors;
+    uint32_t format_errors;    // 版本、类型或长度不符
+    uint32_t seq_gaps;         // seq 不连续的次数 (可能丢帧)
+} cam_protocol_stats_t;
+
 /**
  * @brief 解析后的数据结构
  */
@@ -43,6 +135,10 @@ typedef struct {
         uint8_t track_value;   // 循迹数据值 (T类型)
         int32_t number_value;  // 数字数据值 (N类型)  
         uint8_t command_code;  // 命令代码值 (C类型)
+        struct {
+            cam_obstacle_t items[CAM_MAX_OBSTACLES];
+            uint8_t count;
+        } obstacles;           // 圆柱布局 (O类型)
     } data;
     bool valid;                // 数据是否有效
 } cam_protocol_data_t;
@@ -67,6 +163,19 @@ typedef void (*cam_number_callback_t)(int32_t number_value);
  */
 typedef void (*cam_command_callback_t)(uint8_t command_code);
 
+/**
+ * @brief 圆柱布局回调函数类型
+ * @param obstacles 圆柱列表 (回调返回后失效, 需要时自行复制)
+ * @param count 圆柱数量
+ */
+typedef void (*cam_obstacle_callback_t)(const cam_obstacle_t *obstacles, uint8_t count);
+
+/**
+ * @brief 圆柱识别结果回调函数类型 (仅二进制消息)
+ * @param msg 指向接收缓冲区中的消息 body, 回调返回后失效
+ */
+typedef void (*cam_cylinder_callback_t)(const cam_msg_cylinders_t *msg);
+
 // ====================  公共函数  ====================
 
 /**
@@ -75,7 +184,23 @@ typedef void (*cam_command_callback_t)(uint8_t command_code);
 void cam_protocol_init(void);
 
 /**
- * @brief 解析摄像头数据
+ * @brief 校验一条二进制消息 (版本、类型、长度、CRC)
+ * @param result 输出校验结果, 可为 NULL
+ * @return 通过时返回指向 data 的消息头, 之后用 CAM_MSG_BODY() 直接读取 body; 否则返回 NULL
+ */
+const cam_msg_header_t *cam_protocol_check(const uint8_t* data, size_t length, cam_parse_result_t* result);
+
+/**
+ * @brief 把一条二进制消息写入 out (摄像头端的 C 实现与测试用)
+ * @return 消息总长度, out_size 不够时返回 0
+ */
+size_t cam_protocol_encode(cam_msg_type_t type, uint8_t seq, const void* body, uint8_t body_len,
+                           uint8_t* out, size_t out_size);
+
+uint16_t cam_protocol_crc16(const uint8_t* data, size_t length);
+
+/**
+ * @brief 解析 ASCII 摄像头数据 (兼容模式, 二进制消息由 cam_protocol_process() 直接处理)
  * @param data 原始数据
  * @param length 数据长度
  * @param parsed_data 解析结果输出
@@ -84,7 +209,7 @@ void cam_protocol_init(void);
 cam_parse_result_t cam_protocol_parse(const uint8_t* data, size_t length, cam_protocol_data_t* parsed_data);
 
 /**
- * @brief 处理摄像头数据(自动调用回调)
+ * @brief 处理摄像头数据(自动调用回调), 按首字节区分二进制消息与 ASCII 消息
  * @param data 原始数据
  * @param length 数据长度  
  * @return cam_parse_result_t 处理结果
@@ -109,6 +234,23 @@ void cam_protocol_set_number_callback(cam_number_callback_t callback);
  */
 void cam_protocol_set_command_callback(cam_command_callback_t callback);
 
+/**
+ * @brief 设置圆柱布局回调函数
+ * @param callback 回调函数指针
+ */
+void cam_protocol_set_obstacle_callback(cam_obstacle_callback_t callback);
+
+/**
+ * @brief 设置圆柱识别结果回调函数
+ * @param callback 回调函数指针
+ */
+void cam_protocol_set_cylinder_callback(cam_cylinder_callback_t callback);
+
+/**
+ * @brief 二进制消息收包统计
+ */
+const cam_protocol_stats_t *cam_protocol_get_stats(void);
+
 /**
  * @brief 获取错误描述字符串
  * @param result 解析结果
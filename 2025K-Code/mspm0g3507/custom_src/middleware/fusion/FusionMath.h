@@ -13,6 +13,7 @@
 #include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include "hal_math.h" // sqrt/atan2/asin are routed through the MATHACL-backed HAL
 
 //------------------------------------------------------------------------------
 // Definitions
@@ -152,7 +153,7 @@ static inline float FusionAsin(const float value) {
     if (value >= 1.0f) {
         return (float) M_PI / 2.0f;
     }
-    return asinf(value);
+    return hal_asinf(value);
 }
 
 //------------------------------------------------------------------------------
@@ -305,7 +306,7 @@ static inline float FusionVectorMagnitudeSquared(const FusionVector vector) {
  * @return Vector magnitude.
  */
 static inline float FusionVectorMagnitude(const FusionVector vector) {
-    return sqrtf(FusionVectorMagnitudeSquared(vector));
+    return hal_sqrtf(FusionVectorMagnitudeSquared(vector));
 }
 
 /**
@@ -315,7 +316,7 @@ static inline float FusionVectorMagnitude(const FusionVector vector) {
  */
 static inline FusionVector FusionVectorNormalise(const FusionVector vector) {
 #ifdef FUSION_USE_NORMAL_SQRT
-    const float magnitudeReciprocal = 1.0f / sqrtf(FusionVectorMagnitudeSquared(vector));
+    const float magnitudeReciprocal = 1.0f / hal_sqrtf(FusionVectorMagnitudeSquared(vector));
 #else
     const float magnitudeReciprocal = FusionFastInverseSqrt(FusionVectorMagnitudeSquared(vector));
 #endif
@@ -392,7 +393,7 @@ static inline FusionQuaternion FusionQuaternionMultiplyVector(const FusionQuater
 static inline FusionQuaternion FusionQuaternionNormalise(const FusionQuaternion quaternion) {
 #define Q quaternion.element
 #ifdef FUSION_USE_NORMAL_SQRT
-    const float magnitudeReciprocal = 1.0f / sqrtf(Q.w * Q.w + Q.x * Q.x + Q.y * Q.y + Q.z * Q.z);
+    const float magnitudeReciprocal = 1.0f / hal_sqrtf(Q.w * Q.w + Q.x * Q.x + Q.y * Q.y + Q.z * Q.z);
 #else
     const float magnitudeReciprocal = FusionFastInverseSqrt(Q.w * Q.w + Q.x * Q.x + Q.y * Q.y + Q.z * Q.z);
 #endif
@@ -467,9 +468,9 @@ static inline FusionEuler FusionQuaternionToEuler(const FusionQuaternion quatern
 #define Q quaternion.element
     const float halfMinusQySquared = 0.5f - Q.y * Q.y; // calculate common terms to avoid repeated operations
     const FusionEuler euler = {.angle = {
-            .roll = FusionRadiansToDegrees(atan2f(Q.w * Q.x + Q.y * Q.z, halfMinusQySquared - Q.x * Q.x)),
+            .roll = FusionRadiansToDegrees(hal_atan2f(Q.w * Q.x + Q.y * Q.z, halfMinusQySquared - Q.x * Q.x)),
             .pitch = FusionRadiansToDegrees(FusionAsin(2.0f * (Q.w * Q.y - Q.z * Q.x))),
-            .yaw = FusionRadiansToDegrees(atan2f(Q.w * Q.z + Q.x * Q.y, halfMinusQySquared - Q.z * Q.z)),
+            .yaw = FusionRadiansToDegrees(hal_atan2f(Q.w * Q.z + Q.x * Q.y, halfMinusQySquared - Q.z * Q.z)),
     }};
     return euler;
 #undef Q
@@ -1,4 +1,218 @@
 #include "log.h"
+#include "systick.h"
+
+#if LOG_DEFERRED
+
+// ID 0 的格式串, 同时是格式串 ID 的基准地址 (解码器按此符号定位)
+const char log_fmt_base[] = "%lu log message(s) dropped";
+
+static volatile uint32_t log_dropped;       // 累计丢弃条数
+static uint32_t log_dropped_reported;       // 已补发过通知的条数
+
+static uint8_t *log_put_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+static bool log_is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * @brief 按格式串的转换说明取出参数原值, 依次写到 p 之后
+ * @return 写入后的位置; 放不下时返回 NULL
+ * @note 只扫描格式串找 '%', 不做任何格式化
+ */
+static uint8_t *log_pack_args(uint8_t *p, const uint8_t *end, const char *f, va_list args) {
+    while (*f != '\0') {
+        if (*f++ != '%') {
+            continue;
+        }
+        if (*f == '%') {
+            f++;
+            continue;
+        }
+        while (*f == '-' || *f == '+' || *f == ' ' || *f == '#' || *f == '0') {
+            f++;
+        }
+        for (int part = 0; part < 2; part++) {          // 宽度, 精度
+            if (part == 1) {
+                if (*f != '.') {
+                    break;
+                }
+                f++;
+            }
+            if (*f == '*') {
+                if (end - p < 4) {
+                    return NULL;
+                }
+                p = log_put_u32(p, (uint32_t)va_arg(args, int));
+                f++;
+            }
+            while (log_is_digit(*f)) {
+                f++;
+            }
+        }
+
+        // 长度修饰: 0 int, 1 long, 2 long long, 3 size_t, 4 intmax_t, 5 long double
+        int length = 0;
+        if (*f == 'h') {
+            f += (f[1] == 'h') ? 2 : 1;
+        } else if (*f == 'l') {
+            length = (f[1] == 'l') ? 2 : 1;
+            f += length;
+        } else if (*f == 'z' || *f == 't') {
+            length = 3;
+            f++;
+        } else if (*f == 'j') {
+            length = 4;
+            f++;
+        } else if (*f == 'L') {
+            length = 5;
+            f++;
+        }
+
+        char conv = *f;
+        if (conv == '\0') {
+            break;
+        }
+        f++;
+        switch (conv) {
+            case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': {
+                uint64_t v;
+                if (length == 1) {
+                    v = (uint64_t)va_arg(args, long);
+                } else if (length == 2) {
+                    v = (uint64_t)va_arg(args, long long);
+                } else if (length == 3) {
+                    v = (uint64_t)va_arg(args, size_t);
+                } else if (length == 4) {
+                    v = (uint64_t)va_arg(args, intmax_t);
+                } else {
+                    v = (uint64_t)va_arg(args, int);
+                }
+                bool wide = (length == 2 || length == 4);
+                if (end - p < (wide ? 8 : 4)) {
+                    return NULL;
+                }
+                p = log_put_u32(p, (uint32_t)v);
+                if (wide) {
+                    p = log_put_u32(p, (uint32_t)(v >> 32));
+                }
+                break;
+            }
+            case 'c':
+                if (end - p < 1) {
+                    return NULL;
+                }
+                *p++ = (uint8_t)va_arg(args, int);
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+                float v = (length == 5) ? (float)va_arg(args, long double) : (float)va_arg(args, double);
+                uint32_t bits;
+                memcpy(&bits, &v, sizeof(bits));
+                if (end - p < 4) {
+                    return NULL;
+                }
+                p = log_put_u32(p, bits);
+                break;
+            }
+            case 's': {
+                const char *str = va_arg(args, const char *);
+                if (str == NULL) {
+                    str = "(null)";
+                }
+                size_t n = strlen(str);
+                if (n > LOG_DEFER_MAX_STR - 1) {
+                    n = LOG_DEFER_MAX_STR - 1;
+                }
+                if ((size_t)(end - p) < n + 1) {
+                    return NULL;
+                }
+                memcpy(p, str, n);
+                p += n;
+                *p++ = 0;
+                break;
+            }
+            case 'p':
+                if (end - p < 4) {
+                    return NULL;
+                }
+                p = log_put_u32(p, (uint32_t)(uintptr_t)va_arg(args, void *));
+                break;
+            case 'n':
+                (void)va_arg(args, int *);
+                break;
+            default:
+                break;
+        }
+    }
+    return p;
+}
+
+// 本条丢弃; requeue: 没发出去的通知里的条数, 退回为未报告
+static void log_count_dropped(uint32_t requeue) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    log_dropped++;
+    log_dropped_reported -= requeue;
+    __set_PRIMASK(primask);
+}
+
+// 组帧头: 起始字节, 长度 (最后填), ID, 级别, 时间戳
+static uint8_t *log_frame_begin(uint8_t *frame, const char *format, int level) {
+    uint8_t *p = frame + 2;
+    p = log_put_u32(p, (uint32_t)(int32_t)((intptr_t)format - (intptr_t)log_fmt_base));
+#if LOG_TIMESTAMP_ENABLED
+    *p++ = (uint8_t)(level | LOG_FRAME_TIMESTAMP);
+    p = log_put_u32(p, get_us());
+#else
+    *p++ = (uint8_t)level;
+#endif
+    frame[0] = LOG_FRAME_START;
+    return p;
+}
+
+static bool log_frame_send(uint8_t *frame, const uint8_t *end) {
+    frame[1] = (uint8_t)(end - frame - 2);
+    return usart_send_packet(UART_0_INST, frame, (size_t)(end - frame));
+}
+
+static void log_print(int level, const char *format, va_list args) {
+    if (level > MODULE_LOG_LEVEL) {
+        return;
+    }
+    uint8_t frame[LOG_DEFER_MAX_RECORD];
+
+    // 先补发丢弃通知; 主循环和中断都可能记日志, 计数的读改写放在临界区内
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t unreported = log_dropped - log_dropped_reported;
+    log_dropped_reported = log_dropped;
+    __set_PRIMASK(primask);
+    if (unreported > 0) {
+        uint8_t *p = log_frame_begin(frame, log_fmt_base, LOG_LEVEL_WARN);
+        p = log_put_u32(p, unreported);
+        if (!log_frame_send(frame, p)) {
+            log_count_dropped(unreported);  // 通知没发出去, 连同本条下次再报
+            return;
+        }
+    }
+
+    uint8_t *p = log_pack_args(log_frame_begin(frame, format, level), frame + sizeof(frame), format, args);
+    if (p == NULL || !log_frame_send(frame, p)) {
+        log_count_dropped(0);               // 参数过长或发送队列满
+    }
+}
+
+uint32_t log_get_dropped(void) {
+    return log_dropped;
+}
+
+#else
 
 static char buffer[MAX_LOG_SIZE];
 
@@ -23,10 +237,24 @@ static void log_print(int level, const char *format, va_list args) {
                 break;
         }
         vsnprintf(buffer, sizeof(buffer), format, args);
+#if LOG_TIMESTAMP_ENABLED
+        // 32 位毫秒 (约 49 天回绕), M0+ 上只做 32 位除法, 不调用 64 位除法库函数
+        uint32_t now_ms = get_ms();
+        usart_printf(UART_0_INST, "[%5lu.%03lu] %s %s\r\n",
+                     (unsigned long)(now_ms / 1000u), (unsigned long)(now_ms % 1000u),
+                     level_tag, buffer);
+#else
         usart_printf(UART_0_INST, "%s %s\r\n", level_tag, buffer);
+#endif
     }
 }
 
+uint32_t log_get_dropped(void) {
+    return 0;
+}
+
+#endif // LOG_DEFERRED
+
 void LOG_D(const char *format, ...) {
     va_list args;
     va_start(args, format);
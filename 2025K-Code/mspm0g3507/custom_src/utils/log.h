@@ -27,6 +27,42 @@
 #define MODULE_LOG_LEVEL LOG_LEVEL_EMPTY
 #endif
 
+// 每条日志前加时间戳: 文本日志为 [秒.毫秒] (取自 get_ms), 二进制日志为 32 位微秒 (取自 get_us)
+#ifndef LOG_TIMESTAMP_ENABLED
+#define LOG_TIMESTAMP_ENABLED 1
+#endif
+
+/*
+ * 延迟格式化 (defmt 风格) 的二进制日志: 运行时不调用 vsnprintf, 只把格式串 ID 和参数原值
+ * 整条放进 UART_0 的发送队列, 由主机端 tests/host/log_decode 按 ELF 还原成文本.
+ *  - 格式串 ID: 格式串地址相对 log_fmt_base 的偏移 (链接时确定), 解码器在 ELF 中按
+ *    log_fmt_base 的符号地址 + ID 找到格式串;
+ *  - 参数按格式串的转换说明取出: 整数/指针 4 字节 (ll/j 为 8 字节), %c 1 字节,
+ *    浮点转成 float 4 字节, %s 拷贝字符串 (最长 LOG_DEFER_MAX_STR - 1 字节, 含结尾 0);
+ *  - 帧: LOG_FRAME_START, 长度, ID (int32 小端), 级别 (bit7 表示带时间戳),
+ *    [get_us() 4 字节], 参数. 与 usart_printf 的文本输出混在同一串口, 文本中不会出现 0x1E;
+ *  - 队列放不下时整条丢弃, 累计数由 log_get_dropped() 返回, 下次写入成功前先补发一条
+ *    "N log message(s) dropped" (即 ID 0 的格式串).
+ * 格式串必须是字面量 (在 flash 中), 运行时拼出来的格式串无法解码.
+ *
+ * 默认关闭 (LOG_DEFERRED 为 0, vsnprintf 文本输出): 二进制帧在普通串口助手里是乱码.
+ * 打开后的使用步骤:
+ *  1. Keil 工程 C/C++ 选项的 Define 中加 LOG_DEFERRED=1, 重新编译;
+ *  2. 在 mspm0g3507 目录下编译解码器: gcc -O2 tests/host/log_decode.c -o log_decode (CMake 也会生成);
+ *  3. 用串口工具按原始字节把 UART_0 保存成文件, 或直接接到标准输入:
+ *       log_decode project/Keil/Objects/EmbedBolt316.axf capture.bin
+ *       stty -F /dev/ttyUSB0 115200 raw && log_decode project/Keil/Objects/EmbedBolt316.axf < /dev/ttyUSB0
+ *     解码时必须用与板上固件同一次编译产生的 .axf, 否则格式串 ID 对不上.
+ */
+#ifndef LOG_DEFERRED
+#define LOG_DEFERRED 0
+#endif
+
+#define LOG_FRAME_START         0x1E
+#define LOG_FRAME_TIMESTAMP     0x80        // 级别字节: 帧内带时间戳
+#define LOG_DEFER_MAX_RECORD    96          // 一条日志的最大帧长 (字节)
+#define LOG_DEFER_MAX_STR       32
+
 #ifndef MODULE_LOG_ENABLED
 #define MODULE_LOG_ENABLED 0
 #endif
@@ -50,4 +86,7 @@ void LOG_I(const char *format, ...);
 void LOG_W(const char *format, ...);
 void LOG_E(const char *format, ...);
 
+// 因发送队列满而丢弃的日志条数 (累计); 文本模式下恒为 0
+uint32_t log_get_dropped(void);
+
 #endif // LOG_H
\ No newline at end of file
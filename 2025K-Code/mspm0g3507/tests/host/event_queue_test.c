@@ -0,0 +1,224 @@
+/**
+ * @file event_queue_test.c
+ * @brief 中断延迟处理队列的主机端测试
+ *
+ *  1. 基本语义: FIFO 顺序、同一事件合并、非法 ID
+ *  2. 双线程压力测试: 生产者线程模拟中断投递, 消费者线程出队,
+ *     检查每个事件最后一次投递前写入的数据都被处理函数看到 (无丢失唤醒)
+ *  3. 调度器集成: 虚拟时钟下对比摄像头任务 1ms 轮询与事件触发的响应延迟
+ *
+ * 构建 (在 mspm0g3507 目录下):
+ *   gcc -O2 -pthread -Itests/host/sim_hal -Icustom_src/core/system -Icustom_src/utils \
+ *       -Icustom_src/hal/uart tests/host/event_queue_test.c \
+ *       custom_src/core/system/periodic_event_task.c custom_src/core/system/event_queue.c \
+ *       -o event_queue_test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "periodic_event_task.h"
+#include "event_queue.h"
+#include "host_check.h"
+
+#define STRESS_POSTS            2000000
+#define SIM_DURATION_US         (2ULL * 1000 * 1000)
+#define LOOP_CHECK_US           3
+#define CAM_BYTES_PER_FRAME     16
+#define CAM_FRAME_PERIOD_US     33333
+
+// ====================  虚拟时钟  ====================
+
+static uint64_t sim_us;
+
+uint32_t get_ms(void) { return (uint32_t)(sim_us / 1000); }
+uint32_t get_us(void) { return (uint32_t)sim_us; }
+
+// ====================  1. 基本语义  ====================
+
+static void test_semantics(void) {
+    EVENT_IDS id;
+
+    event_queue_init();
+    CHECK(event_queue_empty(), "queue starts empty");
+    CHECK(!event_queue_pop(&id), "pop on empty queue");
+
+    CHECK(event_queue_post(EVENT_MAIXCAM), "post camera");
+    CHECK(event_queue_post(EVENT_BLUETOOTH), "post bluetooth");
+    CHECK(event_queue_post(EVENT_MAIXCAM), "repeated post is accepted");
+
+    CHECK(event_queue_pop(&id) && id == EVENT_MAIXCAM, "FIFO order 1");
+    CHECK(event_queue_pop(&id) && id == EVENT_BLUETOOTH, "FIFO order 2");
+    CHECK(!event_queue_pop(&id), "repeated post merged into one entry");
+
+    // 出队后再次投递需要重新入队
+    CHECK(event_queue_post(EVENT_MAIXCAM), "post after pop");
+    CHECK(event_queue_pop(&id) && id == EVENT_MAIXCAM, "re-queued after pop");
+
+    CHECK(!event_queue_post(NUM_PERIOD_TASKS), "invalid id rejected");
+
+    // 所有事件各投递一次也不会溢出
+    for (int i = 0; i < NUM_PERIOD_TASKS; i++) {
+        CHECK(event_queue_post((EVENT_IDS)i), "post every id");
+    }
+    int count = 0;
+    while (event_queue_pop(&id)) {
+        count++;
+    }
+    CHECK(count == NUM_PERIOD_TASKS, "every id queued once");
+    CHECK(event_queue_get_dropped() == 0, "no drops");
+}
+
+// ====================  2. 双线程压力测试  ====================
+
+static uint32_t produced[NUM_PERIOD_TASKS];     // 生产者写入的 "接收数据"
+static uint32_t handled[NUM_PERIOD_TASKS];      // 处理函数看到的最新数据
+static volatile bool producer_done;
+
+static void *producer_thread(void *arg) {
+    (void)arg;
+    uint32_t seed = 12345;
+    for (uint32_t n = 0; n < STRESS_POSTS; n++) {
+        seed = seed * 1103515245u + 12345u;
+        EVENT_IDS id = (EVENT_IDS)((seed >> 16) % NUM_PERIOD_TASKS);
+        // 先写数据再投递, 与 camera_irq_handler 先写 lwrb 再投递一致
+        __atomic_store_n(&produced[id], n + 1, __ATOMIC_SEQ_CST);
+        while (!event_queue_post(id)) {
+            // 合并机制下不应出现, 出现时由 dropped 计数报告
+        }
+    }
+    __atomic_store_n(&producer_done, true, __ATOMIC_SEQ_CST);
+    return NULL;
+}
+
+static void *consumer_thread(void *arg) {
+    (void)arg;
+    EVENT_IDS id;
+    for (;;) {
+        if (event_queue_pop(&id)) {
+            handled[id] = __atomic_load_n(&produced[id], __ATOMIC_SEQ_CST);
+        } else if (__atomic_load_n(&producer_done, __ATOMIC_SEQ_CST) && event_queue_empty()) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+static void test_threaded(void) {
+    pthread_t prod, cons;
+
+    event_queue_init();
+    producer_done = false;
+    pthread_create(&cons, NULL, consumer_thread, NULL);
+    pthread_create(&prod, NULL, producer_thread, NULL);
+    pthread_join(prod, NULL);
+    pthread_join(cons, NULL);
+
+    for (int i = 0; i < NUM_PERIOD_TASKS; i++) {
+        CHECK(handled[i] == produced[i], "event %d: last produced %u, last handled %u", i, produced[i], handled[i]);
+    }
+    CHECK(event_queue_get_dropped() == 0, "no drops under stress");
+}
+
+// ====================  3. 调度器集成: 响应延迟  ====================
+
+static uint64_t next_byte_us;
+static uint32_t frame_byte;
+static uint32_t bytes_waiting;          // 已到达但未处理的字节数
+static uint64_t oldest_byte_us;
+static bool use_events;
+static uint64_t latency_total_us;
+static uint64_t latency_max_us;
+static uint32_t latency_samples;
+
+static void camera_rx_isr(void) {
+    if (bytes_waiting == 0) {
+        oldest_byte_us = sim_us;
+    }
+    bytes_waiting++;
+    if (use_events) {
+        event_queue_post(EVENT_MAIXCAM);
+    }
+}
+
+static void consume(uint32_t us) {
+    uint64_t end = sim_us + us;
+    while (next_byte_us <= end) {
+        sim_us = next_byte_us;
+        camera_rx_isr();
+        if (++frame_byte < CAM_BYTES_PER_FRAME) {
+            next_byte_us += 87;                         // 115200bps 一个字节
+        } else {
+            frame_byte = 0;
+            next_byte_us += CAM_FRAME_PERIOD_US - 87 * (CAM_BYTES_PER_FRAME - 1);
+        }
+    }
+    sim_us = end;
+}
+
+static void camera_task(void) {
+    if (bytes_waiting) {
+        uint64_t latency = sim_us - oldest_byte_us;
+        latency_total_us += latency;
+        if (latency > latency_max_us) latency_max_us = latency;
+        latency_samples++;
+        bytes_waiting = 0;
+    }
+    consume(4);
+}
+
+static void button_task(void) { consume(30); }
+static void menu_task(void)   { consume(800); }
+static void alert_task(void)  { consume(10); }
+static void car_task(void)    { consume(120); }
+static void music_task(void)  { consume(10); }
+static void imu_task(void)    { consume(50); }
+
+static period_task_t sim_table[] = {
+   PERIOD_TASK(EVENT_KEY_STATE_UPDATE,  RUN,  button_task,  20,  CATCHUP_RUN_ALL),
+   PERIOD_TASK(EVENT_MENU_VAR_UPDATE,   RUN,  menu_task,    20,  CATCHUP_SKIP),
+   PERIOD_TASK(EVENT_ALERT,             RUN,  alert_task,   10,  CATCHUP_RUN_ALL),
+   PERIOD_TASK(EVENT_CAR,               RUN,  car_task,     20,  CATCHUP_RUN_ONCE),
+   PERIOD_TASK(EVENT_MUSIC_PLAYER,      RUN,  music_task,   5,   CATCHUP_RUN_ALL),
+   PERIOD_TASK(EVENT_IMU_UPDATE,        RUN,  imu_task,     10,  CATCHUP_RUN_ONCE),
+   PERIOD_TASK(EVENT_MAIXCAM,           RUN,  camera_task,  1,   CATCHUP_RUN_ONCE),
+};
+
+#define SIM_TASK_COUNT (sizeof(sim_table) / sizeof(sim_table[0]))
+
+static void run_latency(bool events) {
+    sim_us = 0;
+    next_byte_us = 1234;
+    frame_byte = 0;
+    bytes_waiting = 0;
+    latency_total_us = 0;
+    latency_max_us = 0;
+    latency_samples = 0;
+    use_events = events;
+
+    sim_table[SIM_TASK_COUNT - 1].period_ms = events ? PERIOD_EVENT_ONLY : 1;
+    event_queue_init();
+    init_task_scheduler(sim_table, SIM_TASK_COUNT);
+
+    while (sim_us < SIM_DURATION_US) {
+        periodic_event_task_process();
+        consume(LOOP_CHECK_US);
+    }
+
+    printf("%-16s %8u %12.1f %12llu\n", events ? "event driven" : "1ms polling",
+           latency_samples, latency_samples ? (double)latency_total_us / latency_samples : 0.0,
+           (unsigned long long)latency_max_us);
+}
+
+int main(void) {
+    test_semantics();
+    test_threaded();
+
+    printf("%-16s %8s %12s %12s\n", "camera task", "runs", "avg lat(us)", "max lat(us)");
+    run_latency(false);
+    uint64_t polled_max = latency_max_us;
+    run_latency(true);
+    CHECK(latency_max_us < polled_max, "event dispatch reduces worst-case latency");
+
+    return host_check_summary();
+}
@@ -0,0 +1,242 @@
+/**
+ * @file grid_planner_bench.c
+ * @brief 栅格 A* 规划器的主机端测试与基准
+ *
+ *  - 空场地给出起点到终点的一条直线; 一排封死场地的圆柱返回 GRID_PLAN_NO_PATH;
+ *  - 随机布局 (3~GRID_PLANNER_MAX_OBSTACLES 个圆柱, 颜色随机, 一半挤在中部): 规划成功时航点首尾为起终点,
+ *    每段离各圆柱不小于避让半径减半格, 长度不短于直线距离; 规划失败 (NO_PATH) 时用独立的
+ *    洪水填充确认栅格上确实不连通;
+ *  - 输出规划耗时 (最小/平均/99%/最大) 与展开格子数, 展开数不超过格子总数,
+ *    开放堆峰值不超过 GRID_PLANNER_OPEN_MAX 的一半.
+ *
+ * 主机耗时只作相对比较; 展开数与开放堆峰值与平台无关, M0+ 上的最坏耗时按最坏展开数估算.
+ *
+ * 构建 (在 mspm0g3507 目录下):
+ *   gcc -O2 -Icustom_src/application/control tests/host/grid_planner_bench.c \
+ *       custom_src/application/control/grid_planner.c -lm -o grid_planner_bench
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include "grid_planner.h"
+#include "host_check.h"
+
+#define LAYOUTS             5000
+#define START_X             0.0f
+#define START_Y             0.0f
+#define GOAL_X              300.0f
+#define GOAL_Y              50.0f
+
+static uint32_t rng_state = 20250731u;
+
+static uint32_t rng(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+static int rand_range(int lo, int hi) {
+    return lo + (int)(rng() % (uint32_t)(hi - lo + 1));
+}
+
+static inline uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static float clearance(const grid_obstacle_t *o) {
+    return (o->color == GRID_COLOR_WHITE) ? GRID_PLANNER_CLEARANCE_WHITE_CM : GRID_PLANNER_CLEARANCE_BLACK_CM;
+}
+
+static float segment_distance(path_point_t a, path_point_t b, float x, float y) {
+    float ex = b.x - a.x, ey = b.y - a.y;
+    float len2 = ex * ex + ey * ey;
+    float t = (len2 > 0.0f) ? ((x - a.x) * ex + (y - a.y) * ey) / len2 : 0.0f;
+    t = (t < 0.0f) ? 0.0f : (t > 1.0f ? 1.0f : t);
+    return hypotf(a.x + t * ex - x, a.y + t * ey - y);
+}
+
+/**
+ * @brief 在上一次规划的占用栅格上做 8 邻域洪水填充 (同样不切角), 判断起终点格是否连通
+ */
+static bool grid_connected(path_point_t start, path_point_t goal) {
+    static uint16_t queue[GRID_PLANNER_CELLS];
+    static bool seen[GRID_PLANNER_CELLS];
+    static const int dx[8] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+    static const int dy[8] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+    int sc = (int)floorf((start.x - GRID_PLANNER_ORIGIN_X_CM) / GRID_PLANNER_CELL_CM);
+    int sr = (int)floorf((start.y - GRID_PLANNER_ORIGIN_Y_CM) / GRID_PLANNER_CELL_CM);
+    int gc = (int)floorf((goal.x - GRID_PLANNER_ORIGIN_X_CM) / GRID_PLANNER_CELL_CM);
+    int gr = (int)floorf((goal.y - GRID_PLANNER_ORIGIN_Y_CM) / GRID_PLANNER_CELL_CM);
+    int head = 0, tail = 0;
+
+    memset(seen, 0, sizeof(seen));
+    queue[tail++] = (uint16_t)(sr * GRID_PLANNER_COLS + sc);
+    seen[sr * GRID_PLANNER_COLS + sc] = true;
+    while (head < tail) {
+        int c = queue[head] % GRID_PLANNER_COLS, r = queue[head] / GRID_PLANNER_COLS;
+        head++;
+        if (c == gc && r == gr) {
+            return true;
+        }
+        for (int d = 0; d < 8; d++) {
+            int nc = c + dx[d], nr = r + dy[d];
+            if (nc < 0 || nr < 0 || grid_planner_cell_blocked((uint8_t)nc, (uint8_t)nr)) {
+                continue;
+            }
+            if (d >= 4 && (grid_planner_cell_blocked((uint8_t)nc, (uint8_t)r) ||
+                           grid_planner_cell_blocked((uint8_t)c, (uint8_t)nr))) {
+                continue;
+            }
+            if (!seen[nr * GRID_PLANNER_COLS + nc]) {
+                seen[nr * GRID_PLANNER_COLS + nc] = true;
+                queue[tail++] = (uint16_t)(nr * GRID_PLANNER_COLS + nc);
+            }
+        }
+    }
+    return false;
+}
+
+static void check_plan(const grid_obstacle_t *obs, uint8_t n, path_point_t start, path_point_t goal,
+                       const grid_plan_t *plan, const char *name) {
+    CHECK(plan->count >= 2 && plan->count <= GRID_PLANNER_MAX_WAYPOINTS, "%s: waypoint count %d", name, plan->count);
+    if (plan->count < 2) {
+        return;
+    }
+    CHECK(plan->points[0].x == start.x && plan->points[0].y == start.y, "%s: starts at the start point", name);
+    CHECK(plan->points[plan->count - 1].x == goal.x && plan->points[plan->count - 1].y == goal.y,
+          "%s: ends at the goal", name);
+    CHECK(plan->length_cm >= hypotf(goal.x - start.x, goal.y - start.y) - 1e-3f, "%s: length", name);
+    for (uint8_t i = 0; i + 1 < plan->count; i++) {
+        for (uint8_t k = 0; k < n; k++) {
+            float d = segment_distance(plan->points[i], plan->points[i + 1], obs[k].x_cm, obs[k].y_cm);
+            float min_d = clearance(&obs[k]) - 0.5f * GRID_PLANNER_CELL_CM - 1e-3f;
+            CHECK(d >= min_d, "%s: segment %d passes %.1fcm from cylinder %d (min %.1f)", name, i, d, k, min_d);
+        }
+    }
+}
+
+static void test_fixed_layouts(void) {
+    path_point_t start = { START_X, START_Y }, goal = { GOAL_X, GOAL_Y };
+    grid_plan_t plan;
+
+    grid_plan_result_t res = grid_planner_plan(NULL, 0, start, goal, &plan);
+    printf("empty field           %s, %d points, %.1fcm, expanded %d\n",
+           grid_planner_result_string(res), plan.count, plan.length_cm, plan.expanded);
+    CHECK(res == GRID_PLAN_OK && plan.count == 2, "empty field gives a straight line");
+
+    // 一排 x = 150 的圆柱, 间距 30cm 覆盖整个场地高度
+    grid_obstacle_t wall[GRID_PLANNER_MAX_OBSTACLES];
+    uint8_t n = 0;
+    for (int y = -80; y <= 130 && n < GRID_PLANNER_MAX_OBSTACLES; y += 30) {
+        wall[n++] = (grid_obstacle_t){ 150, (int16_t)y, GRID_COLOR_BLACK };
+    }
+    res = grid_planner_plan(wall, n, start, goal, &plan);
+    printf("wall of %2d cylinders  %s, expanded %d\n", n, grid_planner_result_string(res), plan.expanded);
+    CHECK(res == GRID_PLAN_NO_PATH, "wall blocks the field");
+
+    // 终点被占用
+    grid_obstacle_t on_goal = { (int16_t)GOAL_X, (int16_t)GOAL_Y, GRID_COLOR_WHITE };
+    res = grid_planner_plan(&on_goal, 1, start, goal, &plan);
+    CHECK(res == GRID_PLAN_BAD_ENDPOINT, "cylinder on the goal");
+
+    // 3x3 阵列, 行距 50cm, 中间一列留出通道
+    grid_obstacle_t lattice[9];
+    n = 0;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            lattice[n++] = (grid_obstacle_t){ (int16_t)(60 + 90 * i), (int16_t)(-25 + 50 * j), (uint8_t)((i + j) & 1) };
+        }
+    }
+    res = grid_planner_plan(lattice, n, start, goal, &plan);
+    printf("3x3 lattice           %s, %d points, %.1fcm, expanded %d\n",
+           grid_planner_result_string(res), plan.count, plan.length_cm, plan.expanded);
+    CHECK(res == GRID_PLAN_OK, "3x3 lattice has a route");
+    if (res == GRID_PLAN_OK) {
+        check_plan(lattice, n, start, goal, &plan, "3x3 lattice");
+    }
+}
+
+static void bench_random_layouts(void) {
+    static uint64_t times[LAYOUTS];
+    path_point_t start = { START_X, START_Y }, goal = { GOAL_X, GOAL_Y };
+    grid_plan_t plan;
+    int ok = 0, no_path = 0, bad_endpoint = 0, too_many = 0, open_full = 0;
+    uint16_t max_expanded = 0, max_open = 0;
+    uint8_t max_points = 0;
+    uint64_t total = 0;
+
+    for (int l = 0; l < LAYOUTS; l++) {
+        grid_obstacle_t obs[GRID_PLANNER_MAX_OBSTACLES];
+        uint8_t n = (uint8_t)rand_range(3, GRID_PLANNER_MAX_OBSTACLES);
+        // 奇数号布局把圆柱挤在场地中部的一条带里, 制造窄通道和封死的情况
+        int x0 = (l & 1) ? 130 : 40, x1 = (l & 1) ? 170 : 270;
+        for (uint8_t k = 0; k < n; k++) {
+            obs[k].x_cm = (int16_t)rand_range(x0, x1);
+            obs[k].y_cm = (int16_t)rand_range(-60, 110);
+            obs[k].color = (uint8_t)(rng() & 1);
+        }
+
+        uint64_t t0 = now_ns();
+        grid_plan_result_t res = grid_planner_plan(obs, n, start, goal, &plan);
+        times[l] = now_ns() - t0;
+        total += times[l];
+
+        if (plan.expanded > max_expanded) {
+            max_expanded = plan.expanded;
+        }
+        if (plan.open_peak > max_open) {
+            max_open = plan.open_peak;
+        }
+        switch (res) {
+            case GRID_PLAN_OK:
+                ok++;
+                if (plan.count > max_points) {
+                    max_points = plan.count;
+                }
+                check_plan(obs, n, start, goal, &plan, "random");
+                break;
+            case GRID_PLAN_NO_PATH:
+                no_path++;
+                CHECK(!grid_connected(start, goal), "layout %d: NO_PATH but the grid is connected", l);
+                break;
+            case GRID_PLAN_BAD_ENDPOINT:
+                bad_endpoint++;
+                break;
+            case GRID_PLAN_OPEN_FULL:
+                open_full++;
+                break;
+            default:
+                too_many++;
+                break;
+        }
+    }
+
+    qsort(times, LAYOUTS, sizeof(times[0]), cmp_u64);
+    printf("random layouts %d: ok %d, no path %d, endpoint blocked %d, too many waypoints %d\n",
+           LAYOUTS, ok, no_path, bad_endpoint, too_many);
+    printf("latency us            min %.1f  avg %.1f  p99 %.1f  max %.1f\n",
+           times[0] / 1e3, total / 1e3 / LAYOUTS, times[LAYOUTS * 99 / 100] / 1e3, times[LAYOUTS - 1] / 1e3);
+    printf("worst case            expanded %d / %d cells, open heap %d / %d, %d waypoints, workspace %d bytes\n",
+           max_expanded, GRID_PLANNER_CELLS, max_open, GRID_PLANNER_OPEN_MAX, max_points, GRID_PLANNER_RAM_BYTES);
+
+    CHECK(ok > LAYOUTS / 2 && no_path > 0, "most random layouts have a route, some are blocked");
+    CHECK(too_many == 0, "waypoint buffer large enough");
+    CHECK(open_full == 0 && max_open <= GRID_PLANNER_OPEN_MAX / 2, "open heap capacity has headroom");
+    CHECK(max_expanded <= GRID_PLANNER_CELLS, "each cell expanded at most once");
+}
+
+int main(void) {
+    test_fixed_layouts();
+    bench_random_layouts();
+    return host_check_summary();
+}
@@ -0,0 +1,38 @@
+/**
+ * @file host_check.h
+ * @brief 主机测试共用的检查宏与结果汇总
+ *
+ * 每个测试程序只包含一次: 失败计数是本文件内的静态变量.
+ * CHECK 失败时打印说明 (可带 printf 格式参数) 与行号并计数, 不中断测试;
+ * main() 最后 return host_check_summary().
+ */
+#ifndef HOST_CHECK_H
+#define HOST_CHECK_H
+
+#include <stdio.h>
+
+static int host_check_failures;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        printf("FAIL: "); \
+        printf(__VA_ARGS__); \
+        printf(" (line %d)\n", __LINE__); \
+        host_check_failures++; \
+    } \
+} while (0)
+
+/**
+ * @brief 打印失败数或 PASS
+ * @return 进程退出码: 有失败为 1, 否则 0
+ */
+static inline int host_check_summary(void) {
+    if (host_check_failures) {
+        printf("%d check(s) failed\n", host_check_failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
+
+#endif // HOST_CHECK_H
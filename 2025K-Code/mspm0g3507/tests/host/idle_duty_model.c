@@ -0,0 +1,296 @@
+/**
+ * @file idle_duty_model.c
+ * @brief 主循环 WFI 空闲睡眠的主机端占空比模型
+ *
+ * 用虚拟时钟驱动真实的 periodic_event_task.c 与 low_power.c:
+ *  - 任务表与 task25k_mission_table.c 一致, 各任务按估算耗时推进虚拟时间
+ *  - 中断源: SysTick 1ms, TIMG0 实时层 1ms, 编码器 GPIO 边沿, 摄像头 UART 收字节
+ *    (收字节中断投递 EVENT_MAIXCAM, 与 camera_irq_handler 一致)
+ *  - __WFI() 把虚拟时间推进到下一个中断, 期间计为睡眠
+ * 每个场景分别跑忙等主循环与 WFI 主循环, 输出 CPU 占空比,
+ * 并检查睡眠没有改变任何任务的执行次数和最大启动延迟, 不一致时返回非 0.
+ *
+ * 构建 (在 mspm0g3507 目录下):
+ *   gcc -O2 -Itests/host/sim_hal -Icustom_src/core/system -Icustom_src/utils \
+ *       -Icustom_src/hal/uart tests/host/idle_duty_model.c \
+ *       custom_src/core/system/periodic_event_task.c custom_src/core/system/low_power.c \
+ *       custom_src/core/system/event_queue.c -o idle_duty_model
+ */
+#include <stdio.h>
+#include <stdbool.h>
+#include "periodic_event_task.h"
+#include "low_power.h"
+#include "event_queue.h"
+
+#define SIM_DURATION_US         (10ULL * 1000 * 1000)   // 每个场景仿真 10s
+#define LOOP_CHECK_US           3                       // 主循环一圈 (比较堆顶 + 空闲检查)
+
+// 中断服务函数耗时估算 (us, 80MHz Cortex-M0+)
+#define ISR_SYSTICK_US          1
+#define ISR_RT_TICK_US          2                       // TIMG0 节拍, 不含速度环
+#define ISR_SPEED_LOOP_US       60                      // 每 20ms 一次的速度环
+#define ISR_ENCODER_US          2
+#define ISR_UART_BYTE_US        2
+
+// ====================  场景  ====================
+
+typedef struct {
+    const char *name;
+    uint32_t menu_cost_us;          // oled_menu_tick 单次耗时
+    uint32_t encoder_edges_per_s;   // 所有编码器通道的总边沿数
+    uint32_t cam_bytes_per_s;       // 摄像头串口收字节速率
+    bool realtime_tier;             // CAR_CONTROL_IN_ISR
+} scenario_t;
+
+static const scenario_t scenarios[] = {
+    // 停车, 菜单静止, 摄像头 30 帧/s x 16 字节
+    { "parked, menu static",     80,   0,    480,  true  },
+    // 行驶: 两轮各约 3000 边沿/s (1456 边沿/圈, 约 2 圈/s)
+    { "driving, menu static",    80,   6000, 480,  true  },
+    // 行驶且菜单每个节拍整屏刷新 (滚动/编辑变量时)
+    { "driving, menu redraw",    9000, 6000, 480,  true  },
+    // 速度环仍在 car_task 里 (CAR_CONTROL_IN_ISR = 0)
+    { "driving, no ISR tier",    80,   6000, 480,  false },
+};
+
+// ====================  虚拟时钟与中断源  ====================
+
+typedef struct {
+    uint64_t next_us;
+    uint64_t period_ns;     // 用 ns 累加, 避免非整数微秒周期的误差累积
+    uint64_t phase_ns;
+    uint32_t cost_us;
+    uint32_t fired;
+} irq_source_t;
+
+enum { IRQ_SYSTICK, IRQ_RT_TICK, IRQ_ENCODER, IRQ_UART, IRQ_COUNT };
+
+static const scenario_t *cur;
+static irq_source_t irqs[IRQ_COUNT];
+static uint64_t sim_us;
+static uint64_t sleep_us;
+static bool irq_masked;
+static bool in_isr;
+
+uint32_t get_ms(void) { return (uint32_t)(sim_us / 1000); }
+uint32_t get_us(void) { return (uint32_t)sim_us; }
+
+static void irq_setup(irq_source_t *src, uint32_t rate_per_s, uint32_t cost_us) {
+    src->fired = 0;
+    src->cost_us = cost_us;
+    if (rate_per_s == 0) {
+        src->period_ns = 0;
+        src->next_us = UINT64_MAX;
+        return;
+    }
+    src->period_ns = 1000000000ULL / rate_per_s;
+    src->phase_ns = src->period_ns;
+    src->next_us = src->phase_ns / 1000;
+}
+
+static uint64_t next_irq_us(void) {
+    uint64_t next = UINT64_MAX;
+    for (int i = 0; i < IRQ_COUNT; i++) {
+        if (irqs[i].next_us < next) {
+            next = irqs[i].next_us;
+        }
+    }
+    return next;
+}
+
+/**
+ * @brief 执行所有已到期的中断, 中断耗时推进虚拟时间
+ */
+static void service_irqs(void) {
+    if (irq_masked || in_isr) {
+        return;
+    }
+    in_isr = true;
+    for (;;) {
+        int due = -1;
+        for (int i = 0; i < IRQ_COUNT; i++) {
+            if (irqs[i].next_us <= sim_us && (due < 0 || irqs[i].next_us < irqs[due].next_us)) {
+                due = i;
+            }
+        }
+        if (due < 0) {
+            break;
+        }
+        irq_source_t *src = &irqs[due];
+        src->fired++;
+        src->phase_ns += src->period_ns;
+        src->next_us = src->phase_ns / 1000;
+        sim_us += src->cost_us;
+        if (due == IRQ_RT_TICK && src->fired % 20 == 0) {
+            sim_us += ISR_SPEED_LOOP_US;
+        }
+        if (due == IRQ_UART) {
+            event_queue_post(EVENT_MAIXCAM);
+        }
+    }
+    in_isr = false;
+}
+
+/**
+ * @brief 主循环上下文推进虚拟时间, 途中到期的中断立即抢占
+ */
+static void consume(uint32_t us) {
+    uint64_t end = sim_us + us;
+    for (;;) {
+        uint64_t next = next_irq_us();
+        if (irq_masked || in_isr || next > end) {
+            break;
+        }
+        uint64_t before = (next > sim_us) ? next : sim_us;
+        sim_us = before;
+        service_irqs();
+        end += sim_us - before;
+    }
+    sim_us = end;
+}
+
+void sim_disable_irq(void) { irq_masked = true; }
+
+void sim_enable_irq(void) {
+    irq_masked = false;
+    service_irqs();
+}
+
+/**
+ * @brief WFI: 睡到下一个中断 (PRIMASK 置位时中断挂起, 由 sim_enable_irq 执行)
+ */
+void sim_wfi(void) {
+    uint64_t next = next_irq_us();
+    if (next > sim_us) {
+        sleep_us += next - sim_us;
+        sim_us = next;
+    }
+}
+
+// ====================  被调度的任务  ====================
+
+typedef struct {
+    uint32_t runs;
+    uint32_t max_late_us;
+} task_trace_t;
+
+static task_trace_t traces[NUM_PERIOD_TASKS];
+static const period_task_t *sched_table;    // 指向下面的 task_table[]
+
+static void trace_task(EVENT_IDS id, uint32_t cost_us) {
+    task_trace_t *tr = &traces[id];
+    tr->runs++;
+    // 相对截止时间的启动延迟; 截止时间已被调度器推进一个周期, 事件任务不统计
+    for (int i = 0; ; i++) {
+        if (sched_table[i].id == id) {
+            if (sched_table[i].period_ms == PERIOD_EVENT_ONLY) {
+                break;
+            }
+            uint64_t deadline_us = (uint64_t)(sched_table[i].next_run_time_ms - sched_table[i].period_ms) * 1000;
+            uint32_t late = (sim_us > deadline_us) ? (uint32_t)(sim_us - deadline_us) : 0;
+            if (late > tr->max_late_us) tr->max_late_us = late;
+            break;
+        }
+    }
+    consume(cost_us);
+}
+
+static void button_task(void) { trace_task(EVENT_KEY_STATE_UPDATE, 30); }
+static void menu_task(void)   { trace_task(EVENT_MENU_VAR_UPDATE, cur->menu_cost_us); }
+static void debug_task(void)  { trace_task(EVENT_PERIOD_PRINT, 5200); }
+static void alert_task(void)  { trace_task(EVENT_ALERT, 10); }
+static void sm_task(void)     { trace_task(EVENT_CAR_STATE_MACHINE, 20); }
+static void car_task(void)    { trace_task(EVENT_CAR, cur->realtime_tier ? 120 : 180); }
+static void music_task(void)  { trace_task(EVENT_MUSIC_PLAYER, 10); }
+static void imu_task(void)    { trace_task(EVENT_IMU_UPDATE, 50); }
+static void camera_task(void) { trace_task(EVENT_MAIXCAM, 4); }
+
+// 与 task25k_mission_table.c 中的 task_table[] 保持一致
+static period_task_t task_table[] = {
+   PERIOD_TASK(EVENT_KEY_STATE_UPDATE,  RUN,  button_task,  20,  CATCHUP_RUN_ALL),
+   PERIOD_TASK(EVENT_MENU_VAR_UPDATE,   RUN,  menu_task,    20,  CATCHUP_SKIP),
+   PERIOD_TASK(EVENT_PERIOD_PRINT,      IDLE, debug_task,   500, CATCHUP_SKIP),
+   PERIOD_TASK(EVENT_ALERT,             RUN,  alert_task,   10,  CATCHUP_RUN_ALL),
+   PERIOD_TASK(EVENT_CAR_STATE_MACHINE, IDLE, sm_task,      20,  CATCHUP_RUN_ONCE),
+   PERIOD_TASK(EVENT_CAR,               RUN,  car_task,     20,  CATCHUP_RUN_ONCE),
+   PERIOD_TASK(EVENT_MUSIC_PLAYER,      RUN,  music_task,   5,   CATCHUP_RUN_ALL),
+   PERIOD_TASK(EVENT_IMU_UPDATE,        RUN,  imu_task,     10,  CATCHUP_RUN_ONCE),
+   PERIOD_TASK(EVENT_MAIXCAM,           RUN,  camera_task,  PERIOD_EVENT_ONLY, CATCHUP_RUN_ONCE),
+};
+
+#define TASK_COUNT (sizeof(task_table) / sizeof(task_table[0]))
+
+// ====================  仿真主循环  ====================
+
+typedef struct {
+    double duty;                // 模型统计的 CPU 占空比
+    uint8_t measured_load;      // low_power_get_cpu_load() 的结果
+    uint32_t wakeups;
+    task_trace_t traces[NUM_PERIOD_TASKS];
+} run_result_t;
+
+static run_result_t run(const scenario_t *sc, bool use_wfi) {
+    run_result_t r = {0};
+
+    cur = sc;
+    sim_us = 0;
+    sleep_us = 0;
+    irq_masked = false;
+    in_isr = false;
+    for (size_t i = 0; i < NUM_PERIOD_TASKS; i++) {
+        traces[i] = (task_trace_t){0};
+    }
+    irq_setup(&irqs[IRQ_SYSTICK], 1000, ISR_SYSTICK_US);
+    irq_setup(&irqs[IRQ_RT_TICK], sc->realtime_tier ? 1000 : 0, ISR_RT_TICK_US);
+    irq_setup(&irqs[IRQ_ENCODER], sc->encoder_edges_per_s, ISR_ENCODER_US);
+    irq_setup(&irqs[IRQ_UART], sc->cam_bytes_per_s, ISR_UART_BYTE_US);
+
+    sched_table = task_table;
+    init_task_scheduler(task_table, TASK_COUNT);
+    create_periodic_event_task();
+    event_queue_init();
+    low_power_clear_stats();
+
+    while (sim_us < SIM_DURATION_US) {
+        periodic_event_task_process();
+        consume(LOOP_CHECK_US);
+        if (use_wfi) {
+            low_power_idle();
+        }
+    }
+
+    r.duty = 1.0 - (double)sleep_us / (double)sim_us;
+    r.measured_load = low_power_get_cpu_load();
+    r.wakeups = low_power_get_stats()->sleep_count;
+    for (size_t i = 0; i < NUM_PERIOD_TASKS; i++) {
+        r.traces[i] = traces[i];
+    }
+    return r;
+}
+
+int main(void) {
+    int failures = 0;
+
+    printf("%-24s %10s %10s %10s %12s\n", "scenario", "busy loop", "WFI duty", "measured", "wakeups/s");
+    for (size_t s = 0; s < sizeof(scenarios) / sizeof(scenarios[0]); s++) {
+        const scenario_t *sc = &scenarios[s];
+        run_result_t busy = run(sc, false);
+        run_result_t idle = run(sc, true);
+
+        printf("%-24s %9.1f%% %9.1f%% %9u%% %12.0f\n", sc->name, 100.0, idle.duty * 100.0,
+               idle.measured_load, idle.wakeups / (SIM_DURATION_US / 1e6));
+
+        // 睡眠只能省掉空转, 不能让任何任务少跑或更晚启动 (允许 1 个中断的误差)
+        for (size_t i = 0; i < TASK_COUNT; i++) {
+            EVENT_IDS id = task_table[i].id;
+            const task_trace_t *a = &busy.traces[id];
+            const task_trace_t *b = &idle.traces[id];
+            if (a->runs != b->runs || b->max_late_us > a->max_late_us + ISR_SPEED_LOOP_US) {
+                printf("  task %d differs: runs %u/%u, max late %u/%u us\n",
+                       (int)id, a->runs, b->runs, a->max_late_us, b->max_late_us);
+                failures++;
+            }
+        }
+    }
+    return failures ? 1 : 0;
+}
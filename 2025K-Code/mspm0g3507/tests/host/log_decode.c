@@ -0,0 +1,372 @@
+/**
+ * @file log_decode.c
+ * @brief 延迟格式化日志的解码工具: 按固件 ELF 把串口抓到的二进制日志帧还原成文本
+ *
+ * 帧格式与参数编码见 custom_src/utils/log.h (LOG_DEFERRED). 帧外的字节 (usart_printf 的文本输出)
+ * 原样输出. 解码器从 ELF 的符号表找到 log_fmt_base, 格式串地址 = log_fmt_base + ID, 再按节头
+ * 换算成文件偏移读出格式串, 所以 32 位 (Keil .axf) 和 64 位 (主机构建) 的 ELF 都能用.
+ *
+ * 用法:
+ *   log_decode <firmware.axf> [capture.bin]      # 不给抓包文件时从标准输入读, 可接串口
+ *
+ * 构建 (在 mspm0g3507 目录下, 也由 CMake 生成):
+ *   gcc -O2 tests/host/log_decode.c -o log_decode
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "log_decode.h"
+
+// 与 custom_src/utils/log.h 一致
+#define LOG_FRAME_START         0x1E
+#define LOG_FRAME_TIMESTAMP     0x80
+
+static const char *const level_tags[] = { "[UNKNOWN]", "[ERROR]", "[WARN]", "[INFO]", "[DEBUG]" };
+
+// ====================  ELF  ====================
+
+static uint64_t rd(const uint8_t *p, int n) {
+    uint64_t v = 0;
+    for (int i = n - 1; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+typedef struct {
+    uint32_t name, type, link;
+    uint64_t flags, addr, offset, size, entsize;
+} elf_section_t;
+
+static bool elf_section(const log_decoder_t *d, unsigned index, elf_section_t *s) {
+    const uint8_t *e = d->elf;
+    bool is64 = (e[4] == 2);
+    uint64_t shoff = is64 ? rd(e + 0x28, 8) : rd(e + 0x20, 4);
+    unsigned shentsize = (unsigned)rd(e + (is64 ? 0x3A : 0x2E), 2);
+    uint64_t at = shoff + (uint64_t)index * shentsize;
+    if (at + shentsize > d->elf_size) {
+        return false;
+    }
+    const uint8_t *h = e + at;
+    s->name = (uint32_t)rd(h, 4);
+    s->type = (uint32_t)rd(h + 4, 4);
+    if (is64) {
+        s->flags = rd(h + 0x08, 8);
+        s->addr = rd(h + 0x10, 8);
+        s->offset = rd(h + 0x18, 8);
+        s->size = rd(h + 0x20, 8);
+        s->link = (uint32_t)rd(h + 0x28, 4);
+        s->entsize = rd(h + 0x38, 8);
+    } else {
+        s->flags = rd(h + 0x08, 4);
+        s->addr = rd(h + 0x0C, 4);
+        s->offset = rd(h + 0x10, 4);
+        s->size = rd(h + 0x14, 4);
+        s->link = (uint32_t)rd(h + 0x18, 4);
+        s->entsize = rd(h + 0x24, 4);
+    }
+    return s->offset + (s->type == 8 ? 0 : s->size) <= d->elf_size;    // SHT_NOBITS 不占文件
+}
+
+static unsigned elf_section_count(const log_decoder_t *d) {
+    return (unsigned)rd(d->elf + (d->elf[4] == 2 ? 0x3C : 0x30), 2);
+}
+
+static bool elf_find_symbol(log_decoder_t *d, const char *name, uint64_t *value) {
+    bool is64 = (d->elf[4] == 2);
+    for (unsigned i = 0; i < elf_section_count(d); i++) {
+        elf_section_t symtab, strtab;
+        if (!elf_section(d, i, &symtab) || symtab.type != 2 || symtab.entsize == 0 ||   // SHT_SYMTAB
+            !elf_section(d, symtab.link, &strtab)) {
+            continue;
+        }
+        for (uint64_t off = 0; off + symtab.entsize <= symtab.size; off += symtab.entsize) {
+            const uint8_t *sym = d->elf + symtab.offset + off;
+            uint32_t sym_name = (uint32_t)rd(sym, 4);
+            if (sym_name >= strtab.size) {
+                continue;
+            }
+            const char *s = (const char *)d->elf + strtab.offset + sym_name;
+            if (strncmp(s, name, strtab.size - sym_name) == 0) {
+                *value = is64 ? rd(sym + 8, 8) : rd(sym + 4, 4);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// 链接地址处的字符串 (须在占内存且文件中有内容的节里, 且以 0 结尾); MSPM0 的 flash 从地址 0 开始
+static const char *elf_string_at(const log_decoder_t *d, uint64_t addr) {
+    for (unsigned i = 0; i < elf_section_count(d); i++) {
+        elf_section_t s;
+        if (!elf_section(d, i, &s) || s.type == 8 || !(s.flags & 2) || addr < s.addr || addr >= s.addr + s.size) {
+            continue;
+        }
+        const char *str = (const char *)d->elf + s.offset + (addr - s.addr);
+        if (memchr(str, 0, s.size - (addr - s.addr)) != NULL) {
+            return str;
+        }
+    }
+    return NULL;
+}
+
+bool log_decoder_open(log_decoder_t *d, const char *elf_path) {
+    memset(d, 0, sizeof(*d));
+    FILE *f = fopen(elf_path, "rb");
+    if (f == NULL) {
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    d->elf = (size > 0x40) ? malloc((size_t)size) : NULL;
+    bool ok = d->elf != NULL && fread(d->elf, 1, (size_t)size, f) == (size_t)size;
+    fclose(f);
+    d->elf_size = ok ? (size_t)size : 0;
+    ok = ok && memcmp(d->elf, "\x7f" "ELF", 4) == 0 && (d->elf[4] == 1 || d->elf[4] == 2) && d->elf[5] == 1 &&
+         elf_find_symbol(d, "log_fmt_base", &d->base_addr);
+    if (!ok) {
+        log_decoder_close(d);
+    }
+    return ok;
+}
+
+void log_decoder_close(log_decoder_t *d) {
+    free(d->elf);
+    d->elf = NULL;
+    d->elf_size = 0;
+}
+
+// ====================  帧解码  ====================
+
+// 按格式串逐个转换说明消费参数字节并输出; 参数不够时停止
+static void render(FILE *out, const char *f, const uint8_t *p, const uint8_t *end) {
+    while (*f != '\0') {
+        if (*f != '%') {
+            fputc(*f++, out);
+            continue;
+        }
+        const char *start = f++;
+        if (*f == '%') {
+            fputc('%', out);
+            f++;
+            continue;
+        }
+        // 重建不带长度修饰的转换说明, '*' 替换成帧里的数值
+        char spec[48];
+        size_t n = 0;
+        spec[n++] = '%';
+        while (*f == '-' || *f == '+' || *f == ' ' || *f == '#' || *f == '0') {
+            spec[n++] = *f++;
+        }
+        for (int part = 0; part < 2; part++) {
+            if (part == 1) {
+                if (*f != '.') {
+                    break;
+                }
+                spec[n++] = *f++;
+            }
+            if (*f == '*') {
+                if (end - p < 4) {
+                    return;
+                }
+                n += (size_t)snprintf(spec + n, sizeof(spec) - n - 8, "%d", (int)(int32_t)rd(p, 4));
+                p += 4;
+                f++;
+            }
+            while (*f >= '0' && *f <= '9' && n < sizeof(spec) - 8) {
+                spec[n++] = *f++;
+            }
+        }
+        bool wide = false;
+        if (*f == 'h') {
+            f += (f[1] == 'h') ? 2 : 1;
+        } else if (*f == 'l') {
+            wide = (f[1] == 'l');
+            f += wide ? 2 : 1;
+        } else if (*f == 'j') {
+            wide = true;
+            f++;
+        } else if (*f == 'z' || *f == 't' || *f == 'L') {
+            f++;
+        }
+        char conv = *f;
+        if (conv == '\0') {
+            fputs(start, out);
+            return;
+        }
+        f++;
+
+        switch (conv) {
+            case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': {
+                if (end - p < (wide ? 8 : 4)) {
+                    return;
+                }
+                if (wide) {
+                    memcpy(spec + n, "ll", 2);
+                    n += 2;
+                }
+                spec[n++] = conv;
+                spec[n] = '\0';
+                bool is_signed = (conv == 'd' || conv == 'i');
+                if (wide) {
+                    uint64_t v = rd(p, 8);
+                    if (is_signed) {
+                        fprintf(out, spec, (long long)v);
+                    } else {
+                        fprintf(out, spec, (unsigned long long)v);
+                    }
+                    p += 8;
+                } else {
+                    uint32_t v = (uint32_t)rd(p, 4);
+                    if (is_signed) {
+                        fprintf(out, spec, (int)(int32_t)v);
+                    } else {
+                        fprintf(out, spec, (unsigned)v);
+                    }
+                    p += 4;
+                }
+                break;
+            }
+            case 'c':
+                if (end - p < 1) {
+                    return;
+                }
+                spec[n++] = 'c';
+                spec[n] = '\0';
+                fprintf(out, spec, *p++);
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+                if (end - p < 4) {
+                    return;
+                }
+                uint32_t bits = (uint32_t)rd(p, 4);
+                float v;
+                memcpy(&v, &bits, sizeof(v));
+                p += 4;
+                spec[n++] = conv;
+                spec[n] = '\0';
+                fprintf(out, spec, (double)v);
+                break;
+            }
+            case 's': {
+                const uint8_t *z = memchr(p, 0, (size_t)(end - p));
+                if (z == NULL) {
+                    return;
+                }
+                spec[n++] = 's';
+                spec[n] = '\0';
+                fprintf(out, spec, (const char *)p);
+                p = z + 1;
+                break;
+            }
+            case 'p':
+                if (end - p < 4) {
+                    return;
+                }
+                fprintf(out, "0x%08" PRIx32, (uint32_t)rd(p, 4));
+                p += 4;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+static void decode_frame(log_decoder_t *d, const uint8_t *p, size_t len, FILE *out) {
+    d->frames++;
+    if (len < 5) {
+        fprintf(out, "<short log frame>\n");
+        return;
+    }
+    int32_t id = (int32_t)rd(p, 4);
+    uint8_t level = p[4];
+    const uint8_t *end = p + len;
+    p += 5;
+    if (level & LOG_FRAME_TIMESTAMP) {
+        if (end - p < 4) {
+            fprintf(out, "<short log frame>\n");
+            return;
+        }
+        uint32_t us = (uint32_t)rd(p, 4);
+        p += 4;
+        fprintf(out, "[%5" PRIu32 ".%06" PRIu32 "] ", us / 1000000u, us % 1000000u);
+    }
+    level &= (uint8_t)~LOG_FRAME_TIMESTAMP;
+    fprintf(out, "%s ", level_tags[level < 5 ? level : 0]);
+
+    const char *format = elf_string_at(d, d->base_addr + (uint64_t)(int64_t)id);
+    if (format == NULL) {
+        d->unknown_ids++;
+        fprintf(out, "<unknown log id %" PRId32 ">\n", id);
+        return;
+    }
+    render(out, format, p, end);
+    if (format[0] == '\0' || format[strlen(format) - 1] != '\n') {
+        fputc('\n', out);
+    }
+}
+
+void log_decoder_feed(log_decoder_t *d, const uint8_t *data, size_t len, FILE *out) {
+    for (size_t i = 0; i < len; i++) {
+        uint8_t b = data[i];
+        switch (d->state) {
+            case 0:
+                if (b == LOG_FRAME_START) {
+                    d->state = 1;
+                } else {
+                    fputc(b, out);
+                }
+                break;
+            case 1:
+                d->need = b;
+                d->got = 0;
+                d->state = 2;
+                if (d->need == 0) {
+                    decode_frame(d, d->frame, 0, out);
+                    d->state = 0;
+                }
+                break;
+            default:
+                d->frame[d->got++] = b;
+                if (d->got == d->need) {
+                    decode_frame(d, d->frame, d->got, out);
+                    d->state = 0;
+                }
+                break;
+        }
+    }
+}
+
+#ifndef LOG_DECODE_LIBRARY
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <firmware.axf> [capture.bin]\n", argv[0]);
+        return 2;
+    }
+    static log_decoder_t d;
+    if (!log_decoder_open(&d, argv[1])) {
+        fprintf(stderr, "%s: not a little-endian ELF with a log_fmt_base symbol\n", argv[1]);
+        return 1;
+    }
+    FILE *in = (argc > 2) ? fopen(argv[2], "rb") : stdin;
+    if (in == NULL) {
+        perror(argv[2]);
+        return 1;
+    }
+    uint8_t buf[256];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0) {
+        log_decoder_feed(&d, buf, n, stdout);
+        fflush(stdout);
+    }
+    if (d.unknown_ids) {
+        fprintf(stderr, "%" PRIu32 " frame(s) with unknown ids: ELF does not match the firmware?\n", d.unknown_ids);
+    }
+    log_decoder_close(&d);
+    return 0;
+}
+
+#endif
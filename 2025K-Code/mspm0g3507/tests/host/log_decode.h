@@ -0,0 +1,36 @@
+/**
+ * @file log_decode.h
+ * @brief 延迟格式化日志 (utils/log.c, LOG_DEFERRED) 的主机端解码器
+ */
+#ifndef LOG_DECODE_H
+#define LOG_DECODE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct {
+    uint8_t *elf;               // 整个 ELF 文件
+    size_t elf_size;
+    uint64_t base_addr;         // log_fmt_base 的链接地址
+    // 流解析状态: 帧外的字节原样输出 (usart_printf 的文本)
+    uint8_t frame[256];
+    int state;                  // 0 帧外, 1 等长度, 2 收帧体
+    size_t need, got;
+    uint32_t frames, unknown_ids;
+} log_decoder_t;
+
+/**
+ * @brief 读入固件 ELF (Keil 的 .axf 或主机构建的可执行文件), 找到 log_fmt_base
+ * @return false: 文件读不了、不是小端 ELF 或没有 log_fmt_base 符号
+ */
+bool log_decoder_open(log_decoder_t *d, const char *elf_path);
+void log_decoder_close(log_decoder_t *d);
+
+/**
+ * @brief 喂入串口抓到的字节流, 还原出的文本写到 out
+ */
+void log_decoder_feed(log_decoder_t *d, const uint8_t *data, size_t len, FILE *out);
+
+#endif // LOG_DECODE_H
@@ -0,0 +1,166 @@
+/**
+ * @file log_defer_test.c
+ * @brief 延迟格式化日志: 固件端编码 -> UART_0 发送记录 -> log_decode 按本程序 ELF 还原, 与 vsnprintf 比较
+ *
+ * 检查:
+ *  - 各类转换说明 (有/无符号、长度修饰、%c、浮点、%s、'*' 宽度、%%) 解码结果与 snprintf 相同
+ *    (浮点参数按 float 传输, 期望值也按 float 计算);
+ *  - 混在日志帧之间的 usart_printf 文本原样输出;
+ *  - 发送队列满时整条丢弃并计数, 恢复后先补发 "N log message(s) dropped";
+ *  - 编码开销: 与文本模式 (vsnprintf + usart_printf) 比较每条日志的耗时和串口字节数.
+ *
+ * 固件默认是文本日志, 这里单独以 -DLOG_DEFERRED=1 编译 utils/log.c (见 tests/host/CMakeLists.txt).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sim_hal.h"
+#include "log.h"
+#include "log_decode.h"
+#include "host_check.h"
+
+#if !LOG_DEFERRED
+#error "build with -DLOG_DEFERRED=1"
+#endif
+
+static log_decoder_t decoder;
+
+// 解码 UART_0 的发送记录, 去掉每行的 "[秒.微秒] " 时间戳
+static void decode_tx(char *text, size_t size) {
+    char *raw = NULL;
+    size_t raw_len = 0;
+    FILE *out = open_memstream(&raw, &raw_len);
+    log_decoder_feed(&decoder, UART_0_INST->tx_log, UART_0_INST->tx_len, out);
+    fclose(out);
+
+    size_t n = 0;
+    for (const char *line = raw; *line != '\0' && n + 1 < size; ) {
+        if (line[0] == '[' && strchr(line, ']') != NULL && line[1] == ' ') {
+            line = strchr(line, ']') + 2;
+        }
+        while (*line != '\0' && n + 1 < size) {
+            char c = *line++;
+            text[n++] = c;
+            if (c == '\n') {
+                break;
+            }
+        }
+    }
+    text[n] = '\0';
+    free(raw);
+}
+
+static void test_formats(void) {
+    sim_hal_reset();
+    sim_uart_tx_clear(UART_0_INST);
+
+    const char *name = "autotune";
+    float pi = 3.14159265f, big = -12345.678f;
+    LOG_I("Track data received: 0x%02X", 0x33);
+    LOG_W("%s: %d/%u %ld %lld %c", name, -5, 7u, -100000L, -(1LL << 40), 'x');
+    usart_printf(UART_0_INST, "plain text %d\r\n", 12);
+    LOG_E("pi %.3f %10.2e %g", pi, big, 0.5);
+    LOG_D("width [%*d] [%-6s] [%.*f] 100%%", 5, 42, "ab", 2, 1.005);
+    LOG_I("hex %08lx size %zu ptr-free %5.1f%%", 0xBEEFUL, (size_t)300, 99.5);
+
+    char expected[1024];
+    int n = 0;
+    n += snprintf(expected + n, sizeof(expected) - n, "[INFO] Track data received: 0x%02X\n", 0x33);
+    n += snprintf(expected + n, sizeof(expected) - n, "[WARN] %s: %d/%u %ld %lld %c\n",
+                  name, -5, 7u, -100000L, -(1LL << 40), 'x');
+    n += snprintf(expected + n, sizeof(expected) - n, "plain text %d\r\n", 12);
+    n += snprintf(expected + n, sizeof(expected) - n, "[ERROR] pi %.3f %10.2e %g\n", pi, big, (double)0.5f);
+    n += snprintf(expected + n, sizeof(expected) - n, "[DEBUG] width [%*d] [%-6s] [%.*f] 100%%\n",
+                  5, 42, "ab", 2, (double)1.005f);
+    n += snprintf(expected + n, sizeof(expected) - n, "[INFO] hex %08lx size %zu ptr-free %5.1f%%\n",
+                  0xBEEFUL, (size_t)300, (double)99.5f);
+
+    char text[1024];
+    decode_tx(text, sizeof(text));
+    CHECK(strcmp(text, expected) == 0, "decoded text matches snprintf");
+    if (strcmp(text, expected) != 0) {
+        printf("--- expected\n%s--- decoded\n%s---\n", expected, text);
+    }
+    CHECK(decoder.frames == 5 && decoder.unknown_ids == 0, "five log frames, all ids resolved");
+}
+
+static void test_dropped(void) {
+    sim_hal_reset();
+    sim_uart_tx_clear(UART_0_INST);
+    uint32_t dropped_before = log_get_dropped();
+
+    // 线路堵住: 队列写满后整条丢弃, 队列里不会留下半条
+    UART_0_INST->tx_stalled = true;
+    int sent = 0;
+    for (int i = 0; i < 100; i++) {
+        LOG_I("sample %d of %d", i, 100);
+        sent++;
+    }
+    uint32_t dropped = log_get_dropped() - dropped_before;
+    CHECK(dropped > 0 && dropped < (uint32_t)sent, "some messages dropped while the line is stalled");
+
+    UART_0_INST->tx_stalled = false;
+    sim_uart_tx_event(UART_0_INST);
+    LOG_I("resumed");
+
+    char text[8192];
+    decode_tx(text, sizeof(text));
+    // 堵塞期间短的丢弃通知可能先挤进队列, 所有通知的条数之和应等于丢弃数
+    unsigned long reported = 0;
+    for (const char *line = text; (line = strstr(line, "[WARN] ")) != NULL; line++) {
+        unsigned long n;
+        if (sscanf(line, "[WARN] %lu log message(s) dropped", &n) == 1) {
+            reported += n;
+        }
+    }
+    CHECK(reported == dropped, "drop notices account for every dropped message");
+    const char *tail = "log message(s) dropped\n[INFO] resumed\n";
+    size_t len = strlen(text), tlen = strlen(tail);
+    CHECK(len >= tlen && strcmp(text + len - tlen, tail) == 0, "drop notice precedes the next message");
+    char last_kept[64];
+    snprintf(last_kept, sizeof(last_kept), "[INFO] sample %u of 100\n", (unsigned)(sent - dropped - 1));
+    CHECK(strstr(text, last_kept) != NULL, "messages before the drop decoded intact");
+}
+
+// 编码开销: 同一条日志, 延迟格式化对比 vsnprintf 文本
+static void bench(void) {
+    enum { N = 20000 };
+    char buf[256];
+    float v = 12.5f;
+
+    sim_hal_reset();
+    clock_t t0 = clock();
+    for (int i = 0; i < N; i++) {
+        sim_uart_tx_clear(UART_0_INST);
+        LOG_I("speed ff motor %d: tau=%.3fs deadband=%.0f accel_gain=%.3f", i & 1, v, v, v);
+    }
+    clock_t t1 = clock();
+    size_t frame_bytes = UART_0_INST->tx_len;
+    for (int i = 0; i < N; i++) {
+        sim_uart_tx_clear(UART_0_INST);
+        snprintf(buf, sizeof(buf), "speed ff motor %d: tau=%.3fs deadband=%.0f accel_gain=%.3f", i & 1, v, v, v);
+        usart_printf(UART_0_INST, "[%5lu.%03lu] %s %s\r\n", 0ul, 0ul, LOG_TAG_INFO, buf);
+    }
+    clock_t t2 = clock();
+    printf("deferred: %5.0f ns/msg %3zu bytes   text: %5.0f ns/msg %3zu bytes\n",
+           (double)(t1 - t0) * 1e9 / CLOCKS_PER_SEC / N, frame_bytes,
+           (double)(t2 - t1) * 1e9 / CLOCKS_PER_SEC / N, UART_0_INST->tx_len);
+    CHECK(frame_bytes < UART_0_INST->tx_len / 2, "binary frame under half the text size");
+}
+
+int main(int argc, char **argv) {
+    (void)argc;
+    if (!log_decoder_open(&decoder, "/proc/self/exe") && !log_decoder_open(&decoder, argv[0])) {
+        printf("FAIL: cannot load own ELF\n");
+        return 1;
+    }
+    test_formats();
+#if UART_TX_ASYNC
+    test_dropped();                 // 同步发送没有队列, 不会丢弃
+#endif
+    bench();
+    log_decoder_close(&decoder);
+
+    return host_check_summary();
+}
@@ -0,0 +1,284 @@
+/**
+ * @file lwrb_mp_test.c
+ * @brief lwrb 多生产者扩展 (lwrb_mp) 的主机端测试
+ *
+ *  1. 基本语义: 嵌套预留 (模拟中断打断主循环) 时数据在最外层提交后才整批可见、顺序与预留顺序一致;
+ *     整包/部分预留、缓冲区末尾回绕、force_commit
+ *  2. 多线程压力测试: 多个生产者线程写变长记录, 一个消费者线程读出, 检查
+ *     每次读到的数据都以完整记录结束 (看不到填了一半的记录)、每个生产者的序号连续、内容无损坏
+ *  3. 吞吐量对比: 同样负载下 lwrb_mp 与 "lwrb + 互斥锁" (现有 lwrb 多生产者时只能这样用),
+ *     以及单生产者时 lwrb_mp_write 相对 lwrb_write 的开销
+ *
+ * 构建 (在 mspm0g3507 目录下):
+ *   gcc -O2 -pthread -Icustom_src/middleware/communication/lwrb tests/host/lwrb_mp_test.c \
+ *       custom_src/middleware/communication/lwrb/lwrb.c custom_src/middleware/communication/lwrb/lwrb_mp.c \
+ *       -o lwrb_mp_test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include "lwrb_mp.h"
+#include "host_check.h"
+
+#define RING_SIZE               4096
+#define PRODUCERS               4
+#define RECORDS_PER_PRODUCER    200000
+#define RECORD_HEADER           6           // 长度, 生产者号, 序号 (4 字节)
+#define RECORD_MAX              64
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// ====================  基本语义  ====================
+
+static void test_nested(void) {
+    static uint8_t data[16];
+    lwrb_mp_t mp;
+    lwrb_mp_resv_t outer, inner;
+    uint8_t out[16];
+
+    CHECK(lwrb_mp_init(&mp, data, sizeof(data)), "init");
+
+    // 主循环预留后被 "中断" 打断, 中断写完整条; 主循环提交前消费者什么都看不到
+    CHECK(lwrb_mp_reserve(&mp, 4, LWRB_FLAG_WRITE_ALL, &outer) == 4, "outer reserve");
+    CHECK(lwrb_mp_reserve(&mp, 3, LWRB_FLAG_WRITE_ALL, &inner) == 3, "inner reserve");
+    lwrb_mp_fill(&mp, &inner, 0, "xyz", 3);
+    CHECK(lwrb_mp_commit(&mp, &inner) == 0, "inner commit does not publish");
+    CHECK(lwrb_get_full(&mp.rb) == 0, "nothing visible while outer is pending");
+    lwrb_mp_fill(&mp, &outer, 0, "ab", 2);
+    lwrb_mp_fill(&mp, &outer, 2, "cdEXTRA", 7);          // 超出预留的部分被忽略
+    CHECK(lwrb_mp_commit(&mp, &outer) == 1, "outer commit publishes");
+    CHECK(lwrb_read(&mp.rb, out, sizeof(out)) == 7 && memcmp(out, "abcdxyz", 7) == 0,
+          "both records visible in reservation order");
+
+    // 空间: 可用 15 字节, 已读走 7 字节, 下一次预留从位置 7 开始, 12 字节会在末尾回绕
+    CHECK(lwrb_mp_reserve(&mp, 16, LWRB_FLAG_WRITE_ALL, &outer) == 0 && outer.len == 0, "write-all rejects oversize");
+    CHECK(lwrb_mp_commit(&mp, &outer) == 0, "empty reservation commit is a no-op");
+    CHECK(lwrb_mp_write(&mp, "0123456789AB", 12, LWRB_FLAG_WRITE_ALL) == 12, "wrapping write");
+    CHECK(lwrb_mp_write(&mp, "CDEFG", 5, 0) == 3, "partial reservation takes the remaining space");
+    CHECK(lwrb_read(&mp.rb, out, sizeof(out)) == 15 && memcmp(out, "0123456789ABCDE", 15) == 0,
+          "wrapped data intact");
+
+    // 异常处理: 打断的写入不会再提交, force_commit 后后续数据照常发布
+    CHECK(lwrb_mp_reserve(&mp, 2, 0, &outer) == 2, "abandoned reserve");
+    lwrb_mp_fill(&mp, &outer, 0, "!!", 2);
+    lwrb_mp_force_commit(&mp);
+    CHECK(lwrb_mp_write(&mp, "ok", 2, LWRB_FLAG_WRITE_ALL) == 2 && lwrb_get_full(&mp.rb) == 4,
+          "writes publish after force_commit");
+}
+
+// ====================  压力测试 / 吞吐量  ====================
+
+typedef enum { MODE_MP, MODE_LOCKED } ring_mode_t;
+
+typedef struct {
+    ring_mode_t mode;
+    int producers;
+    bool preempt;               // 预留和提交之间随机让出 CPU, 单核主机上也能制造交错
+    lwrb_mp_t mp;
+    pthread_mutex_t lock;
+    volatile int done;
+    // 消费者统计
+    uint64_t bytes, records;
+    uint32_t torn, bad, gaps;
+} stress_t;
+
+typedef struct {
+    stress_t *st;
+    int id;
+} producer_arg_t;
+
+static uint8_t ring_data[RING_SIZE];
+
+static void fill_record(uint8_t *rec, uint8_t len, uint8_t id, uint32_t seq) {
+    rec[0] = len;
+    rec[1] = id;
+    memcpy(&rec[2], &seq, 4);
+    for (int i = RECORD_HEADER; i < len; i++) {
+        rec[i] = (uint8_t)(seq * 31 + id * 7 + i);
+    }
+}
+
+static void *producer_thread(void *p) {
+    producer_arg_t *arg = p;
+    stress_t *st = arg->st;
+    uint8_t rec[RECORD_MAX];
+    uint32_t rnd = 0x9E3779B9u * (arg->id + 1);
+
+    for (uint32_t seq = 0; seq < RECORDS_PER_PRODUCER; seq++) {
+        rnd = rnd * 1664525u + 1013904223u;
+        uint8_t len = (uint8_t)(RECORD_HEADER + (rnd >> 24) % (RECORD_MAX - RECORD_HEADER + 1));
+        if (st->mode == MODE_MP) {
+            // 直接填到预留区, 不经过中间缓冲
+            lwrb_mp_resv_t resv;
+            while (lwrb_mp_reserve(&st->mp, len, LWRB_FLAG_WRITE_ALL, &resv) == 0) {
+                sched_yield();
+            }
+            fill_record(rec, len, (uint8_t)arg->id, seq);
+            lwrb_mp_fill(&st->mp, &resv, 0, rec, RECORD_HEADER);
+            if (st->preempt && (rnd & 0x70) == 0) {
+                sched_yield();
+            }
+            lwrb_mp_fill(&st->mp, &resv, RECORD_HEADER, rec + RECORD_HEADER, len - RECORD_HEADER);
+            lwrb_mp_commit(&st->mp, &resv);
+        } else {
+            fill_record(rec, len, (uint8_t)arg->id, seq);
+            for (;;) {
+                lwrb_sz_t n = 0;
+                pthread_mutex_lock(&st->lock);
+                lwrb_write_ex(&st->mp.rb, rec, len, &n, LWRB_FLAG_WRITE_ALL);
+                pthread_mutex_unlock(&st->lock);
+                if (n == len) {
+                    break;
+                }
+                sched_yield();
+            }
+        }
+    }
+    return NULL;
+}
+
+static void *consumer_thread(void *p) {
+    stress_t *st = p;
+    static uint8_t buf[RING_SIZE];
+    uint32_t next_seq[PRODUCERS] = {0};
+
+    for (;;) {
+        int finished = st->done;
+        lwrb_sz_t n = lwrb_read(&st->mp.rb, buf, sizeof(buf));
+        if (n == 0) {
+            if (finished) {
+                break;
+            }
+            sched_yield();
+            continue;
+        }
+        st->bytes += n;
+        // 已发布的数据只由整条记录组成
+        size_t pos = 0;
+        while (pos < n) {
+            uint8_t len = buf[pos];
+            if (len < RECORD_HEADER || len > RECORD_MAX || pos + len > n) {
+                st->torn++;
+                break;
+            }
+            uint8_t id = buf[pos + 1];
+            uint32_t seq;
+            memcpy(&seq, &buf[pos + 2], 4);
+            uint8_t expect[RECORD_MAX];
+            if (id >= st->producers) {
+                st->bad++;
+                break;
+            }
+            fill_record(expect, len, id, seq);
+            if (memcmp(expect, &buf[pos], len) != 0) {
+                st->bad++;
+            }
+            if (seq != next_seq[id]) {
+                st->gaps++;
+            }
+            next_seq[id] = seq + 1;
+            st->records++;
+            pos += len;
+        }
+    }
+    return NULL;
+}
+
+static double run_stress(stress_t *st, ring_mode_t mode, int producers, bool preempt) {
+    memset(st, 0, sizeof(*st));
+    st->mode = mode;
+    st->producers = producers;
+    st->preempt = preempt;
+    lwrb_mp_init(&st->mp, ring_data, sizeof(ring_data));
+    pthread_mutex_init(&st->lock, NULL);
+
+    pthread_t cons, prod[PRODUCERS];
+    producer_arg_t args[PRODUCERS];
+    double t0 = now_s();
+    pthread_create(&cons, NULL, consumer_thread, st);
+    for (int i = 0; i < producers; i++) {
+        args[i].st = st;
+        args[i].id = i;
+        pthread_create(&prod[i], NULL, producer_thread, &args[i]);
+    }
+    for (int i = 0; i < producers; i++) {
+        pthread_join(prod[i], NULL);
+    }
+    st->done = 1;
+    pthread_join(cons, NULL);
+    double elapsed = now_s() - t0;
+    pthread_mutex_destroy(&st->lock);
+    return elapsed;
+}
+
+static void check_stress(const stress_t *st, int producers) {
+    CHECK(st->torn == 0, "no partially published record");
+    CHECK(st->bad == 0, "record contents intact");
+    CHECK(st->gaps == 0, "per-producer sequence without gaps");
+    CHECK(st->records == (uint64_t)producers * RECORDS_PER_PRODUCER, "every record delivered");
+}
+
+static void test_stress(void) {
+    static stress_t st;
+    const char *names[] = { "lwrb_mp", "lwrb+mutex" };
+
+    // 正确性: 填到一半时让出 CPU, 其他生产者的提交不能把这条半成品发布出去
+    run_stress(&st, MODE_MP, PRODUCERS, true);
+    printf("lwrb_mp    %d producer(s), preempted fills: torn=%u bad=%u gaps=%u\n",
+           PRODUCERS, st.torn, st.bad, st.gaps);
+    check_stress(&st, PRODUCERS);
+
+    for (int producers = 1; producers <= PRODUCERS; producers *= 2) {
+        for (int mode = MODE_MP; mode <= MODE_LOCKED; mode++) {
+            double t = run_stress(&st, (ring_mode_t)mode, producers, false);
+            printf("%-10s %d producer(s): %7.1f MB/s %6.2f Mrec/s  torn=%u bad=%u gaps=%u\n",
+                   names[mode], producers, st.bytes / t / 1e6, st.records / t / 1e6,
+                   st.torn, st.bad, st.gaps);
+            check_stress(&st, producers);
+        }
+    }
+}
+
+// 单生产者单线程: 每条记录 reserve/fill/commit 相对 lwrb_write 的额外开销
+static void bench_single(void) {
+    enum { N = 2000000, LEN = 24 };
+    static uint8_t data[RING_SIZE];
+    uint8_t rec[LEN], out[LEN];
+    memset(rec, 0x5A, sizeof(rec));
+
+    lwrb_t rb;
+    lwrb_init(&rb, data, sizeof(data));
+    double t0 = now_s();
+    for (int i = 0; i < N; i++) {
+        lwrb_write(&rb, rec, LEN);
+        lwrb_read(&rb, out, LEN);
+    }
+    double t_rb = now_s() - t0;
+
+    lwrb_mp_t mp;
+    lwrb_mp_init(&mp, data, sizeof(data));
+    t0 = now_s();
+    for (int i = 0; i < N; i++) {
+        lwrb_mp_write(&mp, rec, LEN, LWRB_FLAG_WRITE_ALL);
+        lwrb_read(&mp.rb, out, LEN);
+    }
+    double t_mp = now_s() - t0;
+    printf("single producer, %d-byte write+read: lwrb %.1f ns, lwrb_mp %.1f ns\n",
+           LEN, t_rb * 1e9 / N, t_mp * 1e9 / N);
+}
+
+int main(void) {
+    test_nested();
+    test_stress();
+    bench_single();
+
+    return host_check_summary();
+}
@@ -0,0 +1,124 @@
+/**
+ * @file motion_profile_test.c
+ * @brief S 形运动曲线的主机端测试
+ *
+ * 对直行、原地转向两组限幅和若干位移/起点速度/终点速度组合逐拍推进曲线, 检查:
+ *  - 速度、加速度不超限, 加速度每拍变化不超过 j_max·dt;
+ *  - 设定位置不越过终点, 结束时到达终点 (带终点速度时最多多走一拍)、速度等于终点速度,
+ *    结束那一拍速度跳变很小;
+ *  - 静止到静止的长距离运动用时接近理论最短时间 D/v + v/a + a/j;
+ *  - 以 motion_profile_stop_speed(d) 进入一段长 d 的运动, 能在终点前停下.
+ *
+ * 构建 (在 mspm0g3507 目录下):
+ *   gcc -O2 -Icustom_src/application/control tests/host/motion_profile_test.c \
+ *       custom_src/application/control/motion_profile.c -lm -o motion_profile_test
+ */
+#include <stdio.h>
+#include <math.h>
+#include "motion_profile.h"
+#include "host_check.h"
+
+#define MAX_STEPS           2000
+#define TIME_SLACK          1.10f       // 长距离用时 / 理论最短时间 上限
+
+typedef struct {
+    const char *name;
+    motion_limits_t lim;
+    float distance;
+    float v_start;
+    float v_end;
+} profile_case_t;
+
+// 与 task25k_car_controller.c 中的限幅一致: 直行 cm, 转向 deg
+#define STRAIGHT_LIMITS     { 76.0f, 1000.0f, 15000.0f, 0.02f }
+#define TURN_LIMITS         { 280.0f, 4000.0f, 60000.0f, 0.02f }
+
+static const profile_case_t cases[] = {
+    { "straight 240",         STRAIGHT_LIMITS, 240.0f, 0.0f,  0.0f  },
+    { "straight 50",          STRAIGHT_LIMITS, 50.0f,  0.0f,  0.0f  },
+    { "straight 5",           STRAIGHT_LIMITS, 5.0f,   0.0f,  0.0f  },
+    { "straight -100",        STRAIGHT_LIMITS, -100.0f, 0.0f, 0.0f  },
+    { "straight blend out",   STRAIGHT_LIMITS, 70.0f,  0.0f,  40.0f },
+    { "straight blend in",    STRAIGHT_LIMITS, 70.0f,  40.0f, 0.0f  },
+    { "straight blend both",  STRAIGHT_LIMITS, 85.0f,  60.0f, 60.0f },
+    { "straight short fast",  STRAIGHT_LIMITS, 10.0f,  60.0f, 0.0f  },
+    { "turn 90",              TURN_LIMITS,     90.0f,  0.0f,  0.0f  },
+    { "turn -46",             TURN_LIMITS,     -46.0f, 0.0f,  0.0f  },
+    { "turn 180",             TURN_LIMITS,     180.0f, 0.0f,  0.0f  },
+};
+
+static float min_time(const motion_limits_t *lim, float distance) {
+    return fabsf(distance) / lim->v_max + lim->v_max / lim->a_max + lim->a_max / lim->j_max;
+}
+
+static void run_case(const profile_case_t *c) {
+    const motion_limits_t *lim = &c->lim;
+    motion_profile_t mp;
+    float dir = (c->distance < 0.0f) ? -1.0f : 1.0f;
+    float max_v = 0.0f, max_a = 0.0f, max_da = 0.0f, max_over = 0.0f;
+    float last_v = c->v_start, last_a = 0.0f, end_jump = 0.0f;
+    int steps = 0;
+
+    motion_profile_start(&mp, lim, c->distance, c->v_start, c->v_end);
+    while (!motion_profile_done(&mp) && steps < MAX_STEPS) {
+        motion_profile_step(&mp);
+        steps++;
+        if (motion_profile_done(&mp)) {
+            end_jump = fabsf(mp.vel - last_v);
+            break;
+        }
+        max_v = fmaxf(max_v, fabsf(mp.vel));
+        max_a = fmaxf(max_a, fabsf(mp.acc));
+        max_da = fmaxf(max_da, fabsf(mp.acc - last_a));
+        max_over = fmaxf(max_over, dir * (mp.pos - c->distance));
+        last_v = mp.vel;
+        last_a = mp.acc;
+    }
+
+    float t = steps * lim->dt;
+    printf("%-22s %6.2fs  v %6.1f  a %7.1f  da/dt %8.0f  end jump %5.2f\n", c->name, t, max_v, max_a,
+           max_da / lim->dt, end_jump);
+
+    CHECK(motion_profile_done(&mp), "profile finishes");
+    CHECK(max_v <= fmaxf(lim->v_max, fabsf(c->v_start)) + 1e-3f, "speed limit");
+    CHECK(max_a <= lim->a_max + 1e-3f, "acceleration limit");
+    CHECK(max_da <= lim->j_max * lim->dt * 1.001f, "jerk limit");
+    CHECK(max_over <= 0.0f, "setpoint overshoots the end point by %.3f", max_over);
+    CHECK(fabsf(mp.pos - c->distance) <= c->v_end * lim->dt + 1e-3f, "ends at the end point");
+    CHECK(fabsf(mp.vel - dir * c->v_end) < 1e-4f, "ends at the end speed");
+    CHECK(end_jump <= lim->a_max * lim->dt, "speed jump at the end %.2f", end_jump);
+    if (c->v_start == 0.0f && c->v_end == 0.0f && fabsf(c->distance) >= 100.0f) {
+        float tmin = min_time(lim, c->distance);
+        CHECK(t <= tmin * TIME_SLACK, "time %.2fs vs minimum %.2fs", t, tmin);
+    }
+
+    // 结束后按终点速度继续推进, 等待下一段
+    float pos = mp.pos;
+    motion_profile_step(&mp);
+    CHECK(fabsf(mp.pos - (pos + dir * c->v_end * lim->dt)) < 1e-4f, "holds the end speed after the end");
+}
+
+static void run_stop_speed_case(float distance) {
+    const motion_limits_t lim = STRAIGHT_LIMITS;
+    motion_profile_t mp;
+    float v = motion_profile_stop_speed(&lim, distance);
+    float max_over = 0.0f;
+
+    motion_profile_start(&mp, &lim, distance, v, 0.0f);
+    for (int k = 0; k < MAX_STEPS && !motion_profile_done(&mp); k++) {
+        motion_profile_step(&mp);
+        max_over = fmaxf(max_over, mp.pos - distance);
+    }
+    printf("stop speed %5.1fcm     %6.1fcm/s  overshoot %.3f\n", distance, v, max_over);
+    CHECK(max_over < 0.01f, "stops within %.1fcm from %.1fcm/s", distance, v);
+}
+
+int main(void) {
+    for (unsigned i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        run_case(&cases[i]);
+    }
+    run_stop_speed_case(5.0f);
+    run_stop_speed_case(20.0f);
+    run_stop_speed_case(80.0f);
+    return host_check_summary();
+}
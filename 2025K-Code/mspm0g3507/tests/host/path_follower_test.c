@@ -0,0 +1,129 @@
+/**
+ * @file path_follower_test.c
+ * @brief 纯追踪路径跟踪的主机端测试
+ *
+ * 用带一阶轮速滞后的差速运动学模型跟踪几条折线 (含 Play Part 2 的路线), 检查:
+ *  - 到达终点 (误差不超过容差 + 一拍行程), 终点航向与末段方向相差不超过 3°;
+ *  - 全程离折线的最大距离 (拐角切角) 不超过 MAX_DEVIATION_CM;
+ *  - 单轮速度不超过上限, 中途 (起步与终点减速之外) 不停车;
+ *  - 路径从车身后方开始时先原地转向, 不倒车.
+ *
+ * 构建 (在 mspm0g3507 目录下):
+ *   gcc -O2 -Icustom_src/application/control tests/host/path_follower_test.c \
+ *       custom_src/application/control/path_follower.c -lm -o path_follower_test
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include "path_follower.h"
+#include "host_check.h"
+
+#define PI_F                3.14159265359f
+#define DT                  0.02f
+#define WHEEL_BASE          24.0f
+#define WHEEL_TAU           0.08f       // 轮速一阶滞后 (与 SIL 默认模型相同)
+#define SPEED               76.0f
+#define LOOKAHEAD           20.0f
+#define MAX_DEVIATION_CM    8.0f
+#define HEADING_TOL_DEG     3.0f
+#define MAX_STEPS           3000
+
+typedef struct {
+    const char *name;
+    const path_point_t *points;
+    uint8_t count;
+    float start_heading_deg;
+} path_case_t;
+
+static const path_point_t straight[] = { {0, 0}, {150, 0} };
+static const path_point_t square[] = { {0, 0}, {100, 0}, {100, 100}, {0, 100}, {0, 0} };
+static const path_point_t zigzag[] = { {0, 0}, {60, 30}, {120, -30}, {180, 30}, {240, 0} };
+static const path_point_t path1[] = {
+    {0, 0}, {87, 0}, {87, 45}, {135, 45}, {135, 95}, {230, 95}, {230, 35}, {300, 35},
+};
+static const path_point_t path4[] = {
+    {0, 0}, {85, 0}, {85, -50}, {188, -50}, {188, 0}, {238, 0}, {238, 57}, {318, 57},
+};
+
+#define CASE(n, p, h)   { n, p, (uint8_t)(sizeof(p) / sizeof(p[0])), h }
+
+static const path_case_t cases[] = {
+    CASE("straight", straight, 0.0f),
+    CASE("square", square, 0.0f),
+    CASE("zigzag", zigzag, 0.0f),
+    CASE("play part2 path1", path1, 0.0f),
+    CASE("play part2 path4", path4, 0.0f),
+    CASE("start facing back", straight, 180.0f),
+};
+
+static float distance_to_path(const path_point_t *p, uint8_t n, float x, float y) {
+    float best = 1e9f;
+    for (uint8_t i = 0; i + 1 < n; i++) {
+        float ex = p[i + 1].x - p[i].x, ey = p[i + 1].y - p[i].y;
+        float t = ((x - p[i].x) * ex + (y - p[i].y) * ey) / (ex * ex + ey * ey);
+        t = (t < 0.0f) ? 0.0f : (t > 1.0f ? 1.0f : t);
+        best = fminf(best, hypotf(x - (p[i].x + t * ex), y - (p[i].y + t * ey)));
+    }
+    return best;
+}
+
+static void run_case(const path_case_t *c) {
+    path_follower_t pf;
+    float x = c->points[0].x, y = c->points[0].y, th = c->start_heading_deg * PI_F / 180.0f;
+    float wl = 0.0f, wr = 0.0f;
+    float max_dev = 0.0f, max_wheel = 0.0f, min_mid_speed = 1e9f, min_forward = 0.0f;
+    int steps = 0;
+
+    path_follower_init(&pf, c->points, c->count, SPEED, LOOKAHEAD, WHEEL_BASE, DT);
+    float path_len = 0.0f;
+    for (uint8_t i = 0; i + 1 < c->count; i++) {
+        path_len += hypotf(c->points[i + 1].x - c->points[i].x, c->points[i + 1].y - c->points[i].y);
+    }
+
+    for (; steps < MAX_STEPS; steps++) {
+        float left, right;
+        if (path_follower_step(&pf, x, y, th, &left, &right)) {
+            break;
+        }
+        max_wheel = fmaxf(max_wheel, fmaxf(fabsf(left), fabsf(right)));
+        // 轮速一阶滞后, 然后按中点航向积分
+        wl += (left - wl) * DT / WHEEL_TAU;
+        wr += (right - wr) * DT / WHEEL_TAU;
+        float v = 0.5f * (wl + wr), w = (wr - wl) / WHEEL_BASE;
+        x += v * DT * cosf(th + 0.5f * w * DT);
+        y += v * DT * sinf(th + 0.5f * w * DT);
+        th += w * DT;
+
+        min_forward = fminf(min_forward, 0.5f * (left + right));
+        max_dev = fmaxf(max_dev, distance_to_path(c->points, c->count, x, y));
+        if (pf.remaining_cm > 30.0f && pf.remaining_cm < path_len - 30.0f) {
+            min_mid_speed = fminf(min_mid_speed, pf.v);
+        }
+    }
+
+    const path_point_t *goal = &c->points[c->count - 1];
+    const path_point_t *prev = &c->points[c->count - 2];
+    float end_err = hypotf(x - goal->x, y - goal->y);
+    float seg_heading = atan2f(goal->y - prev->y, goal->x - prev->x);
+    float head_err = fabsf(remainderf(th - seg_heading, 2.0f * PI_F)) * 180.0f / PI_F;
+    printf("%-20s %6.2fs  end err %4.2fcm  heading err %4.2fdeg  max dev %4.2fcm  wheel %5.1f  mid v %5.1f\n",
+           c->name, steps * DT, end_err, head_err, max_dev, max_wheel, min_mid_speed);
+
+    CHECK(pf.done, "path finishes");
+    CHECK(end_err <= pf.goal_tolerance_cm + SPEED * DT, "end point error %.2f", end_err);
+    CHECK(head_err <= HEADING_TOL_DEG, "end heading along the last segment");
+    CHECK(max_dev <= MAX_DEVIATION_CM, "deviation from the polyline %.2f", max_dev);
+    CHECK(max_wheel <= pf.max_wheel_cmps + 1e-3f, "wheel speed limit");
+    CHECK(min_forward >= 0.0f, "never drives backwards");
+    if (c->start_heading_deg == 0.0f && c->count > 2) {
+        CHECK(min_mid_speed >= 20.0f, "keeps moving through the corners, min %.1f", min_mid_speed);
+    }
+}
+
+int main(void) {
+    for (unsigned i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        run_case(&cases[i]);
+    }
+    return host_check_summary();
+}
@@ -0,0 +1,134 @@
+/**
+ * @file pid_q16_test.c
+ * @brief 定点 PID 与浮点 PID 的主机端等价性测试
+ *
+ * 用 task25k_car_pid_parameter.c 中的整定参数 (外加死区/增量式配置) 配置两组控制器,
+ * 以同一组目标/反馈序列驱动 (反馈来自浮点控制器闭环驱动的一阶对象 + 噪声),
+ * 逐拍比较输出, 误差超过输出范围的 0.5% 时返回非 0.
+ * 主机有 FPU, 这里的耗时只作参考; M0+ 上的周期数见 tests/unit_tests/pid_q16_test.c.
+ *
+ * 构建 (在 mspm0g3507 目录下):
+ *   gcc -O2 -Icustom_src/application/control tests/host/pid_q16_test.c \
+ *       custom_src/application/control/pid.c custom_src/application/control/pid_q16.c \
+ *       -lm -o pid_q16_test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "pid.h"
+#include "pid_q16.h"
+
+#define STEPS               5000
+#define TOLERANCE_RATIO     0.005f      // 允许误差 = 输出范围 * 0.5%
+
+typedef struct {
+    const char *name;
+    PID_Type_e type;
+    float kp, ki, kd;
+    float out_limit;
+    float int_limit;        // 0 表示不限幅
+    float separation;       // 0 表示不分离
+    float deadzone;
+    float target_amp;       // 目标值幅度
+    float plant_gain;       // 一阶对象: y += (gain * u - y) * 0.2
+} pid_case_t;
+
+static const pid_case_t cases[] = {
+    { "speed",     PID_TYPE_POSITION, 55.0f, 5.0f, 3.0f, 3000.0f, 3000.0f, 0.0f, 0.0f, 60.0f,  0.03f },
+    { "mileage",   PID_TYPE_POSITION, 5.0f,  0.4f, 0.0f, 76.0f,   76.0f,   5.0f, 0.0f, 100.0f, 1.0f  },
+    { "straight",  PID_TYPE_POSITION, 2.9f,  0.0f, 0.7f, 75.0f,   0.0f,    0.0f, 0.0f, 30.0f,  0.5f  },
+    { "angle",     PID_TYPE_POSITION, 3.0f,  0.0f, 0.5f, 60.0f,   0.0f,    0.0f, 0.0f, 90.0f,  0.5f  },
+    { "track",     PID_TYPE_POSITION, 6.0f,  0.0f, 0.1f, 20.0f,   0.0f,    0.0f, 0.0f, 4.0f,   0.2f  },
+    { "deadzone",  PID_TYPE_POSITION, 8.0f,  1.0f, 0.5f, 500.0f,  200.0f,  0.0f, 0.5f, 40.0f,  0.1f  },
+    { "increment", PID_TYPE_INCREMENT, 2.0f, 0.5f, 0.2f, 1000.0f, 0.0f,    0.0f, 0.0f, 50.0f,  0.05f },
+};
+
+static void configure(const pid_case_t *c, PID_Controller_t *f, PIDQ_Controller_t *q) {
+    PID_Init(f, c->type);
+    PID_SetParams(f, c->kp, c->ki, c->kd);
+    PID_SetOutputLimit(f, c->out_limit, -c->out_limit);
+    if (c->int_limit > 0.0f) PID_SetIntegralLimit(f, c->int_limit, -c->int_limit);
+    if (c->separation > 0.0f) PID_SetIntegralSeparation(f, c->separation);
+    if (c->deadzone > 0.0f) PID_SetDeadzone(f, c->deadzone);
+    PIDQ_InitFromFloat(q, f);
+}
+
+static float noise(void) {
+    return ((float)rand() / RAND_MAX - 0.5f) * 0.2f;
+}
+
+static int run_case(const pid_case_t *c) {
+    PID_Controller_t f;
+    PIDQ_Controller_t q;
+    float y = 0.0f, max_diff = 0.0f;
+    float tol = c->out_limit * 2.0f * TOLERANCE_RATIO;
+
+    configure(c, &f, &q);
+    srand(42);
+    for (int k = 0; k < STEPS; k++) {
+        // 阶跃 + 反向阶跃 + 正弦, 覆盖饱和、积分分离和稳态
+        float target = (k < 1500) ? c->target_amp :
+                       (k < 3000) ? -c->target_amp :
+                       c->target_amp * sinf((float)k * 0.01f);
+        float feedback = y + noise();
+
+        float uf = PID_Calculate(target, feedback, &f);
+        float uq = q16_to_float(PIDQ_Calculate(q16_from_float(target), q16_from_float(feedback), &q));
+
+        float diff = fabsf(uf - uq);
+        if (diff > max_diff) max_diff = diff;
+
+        y += (c->plant_gain * uf - y) * 0.2f;
+    }
+
+    int ok = max_diff <= tol;
+    printf("%-10s max |float - q16| = %9.5f (tol %7.3f) %s\n", c->name, max_diff, tol, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+static double bench_ns(int fixed) {
+    PID_Controller_t f;
+    PIDQ_Controller_t q;
+    volatile float sink_f = 0.0f;
+    volatile q16_t sink_q = 0;
+    const int n = 2000000;
+
+    configure(&cases[0], &f, &q);
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < n; i++) {
+        if (fixed) {
+            sink_q = PIDQ_Calculate(Q16(50.0), (q16_t)(i & 0x3FFFFF), &q);
+        } else {
+            sink_f = PID_Calculate(50.0f, (float)(i & 0x3FFFFF) * (1.0f / 65536.0f), &f);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    (void)sink_f;
+    (void)sink_q;
+    return ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / n;
+}
+
+int main(void) {
+    int failures = 0;
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        failures += run_case(&cases[i]);
+    }
+
+    // 饱和: 超出范围的积分不应回绕成相反符号
+    PIDQ_Controller_t q;
+    PIDQ_Init(&q, PID_TYPE_POSITION);
+    PIDQ_SetParams(&q, 0.0f, 1.0f, 0.0f);
+    for (int i = 0; i < 100; i++) {
+        PIDQ_Calculate(Q16(30000.0), 0, &q);
+    }
+    if (q.integral <= 0) {
+        printf("integral wrapped on overflow: %d\n", (int)q.integral);
+        failures++;
+    }
+
+    printf("host reference: float %.1f ns/call, q16 %.1f ns/call\n", bench_ns(0), bench_ns(1));
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file pose_estimator_test.c
+ * @brief 位姿估计 EKF 的主机端测试
+ *
+ *  - 无噪声时直线、圆弧推算与解析解一致;
+ *  - 一侧编码器有 2% 刻度误差时, 航向观测把横向误差压到纯里程计的 1/5 以下;
+ *  - 航向观测在 ±180° 处按折叠后的新息更新;
+ *  - 协方差与蒙特卡洛统计出的误差方差相符 (比值在 0.7~1.4), 航向观测后保持对称、对角非负.
+ *
+ * 构建 (在 mspm0g3507 目录下):
+ *   gcc -O2 -Icustom_src/application/control tests/host/pose_estimator_test.c \
+ *       custom_src/application/control/pose_estimator.c -lm -o pose_estimator_test
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include "pose_estimator.h"
+#include "host_check.h"
+
+#define PI_F            3.14159265359f
+#define WHEEL_BASE      24.0f
+#define WHEEL_VAR       0.02f
+#define YAW_VAR         7.6e-5f
+#define MC_RUNS         2000
+
+static uint32_t rng_state = 12345u;
+
+static float uniform(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return ((rng_state >> 8) + 0.5f) / 16777216.0f;
+}
+
+static float gaussian(void) {
+    return sqrtf(-2.0f * logf(uniform())) * cosf(2.0f * PI_F * uniform());
+}
+
+static void test_straight_and_arc(void) {
+    pose_estimator_t pe;
+
+    pose_estimator_init(&pe, WHEEL_BASE, WHEEL_VAR, YAW_VAR, 0.0f, 0.0f, 0.0f);
+    for (int i = 0; i < 50; i++) {
+        pose_estimator_predict(&pe, 2.0f, 2.0f);
+    }
+    printf("straight 100cm        (%.3f, %.3f) Pxx %.3f\n", pe.x, pe.y, pe.P[0][0]);
+    CHECK(fabsf(pe.x - 100.0f) < 1e-3f && fabsf(pe.y) < 1e-3f, "straight end point");
+    // 两轮各 0.02·2 cm² 每拍, x 方向各取一半: 0.25·(2·0.04)·50
+    CHECK(fabsf(pe.P[0][0] - 1.0f) < 1e-3f, "longitudinal variance %.4f", pe.P[0][0]);
+    CHECK(pe.P[1][1] > 0.0f && pe.P[2][2] > 0.0f, "lateral and heading variance grow");
+
+    // 半径 50cm 逆时针四分之一圆, 100 拍
+    float r = 50.0f, dth = 0.5f * PI_F / 100.0f;
+    pose_estimator_reset(&pe, 0.0f, 0.0f, 0.0f);
+    for (int i = 0; i < 100; i++) {
+        pose_estimator_predict(&pe, (r - WHEEL_BASE / 2) * dth, (r + WHEEL_BASE / 2) * dth);
+    }
+    printf("quarter arc R50       (%.3f, %.3f) %.2fdeg\n", pe.x, pe.y, pe.theta * 180.0f / PI_F);
+    CHECK(fabsf(pe.x - r) < 0.05f && fabsf(pe.y - r) < 0.05f, "arc end point");
+    CHECK(fabsf(pe.theta - 0.5f * PI_F) < 1e-4f, "arc end heading");
+}
+
+static void test_scale_error(void) {
+    pose_estimator_t odo, fused;
+
+    pose_estimator_init(&odo, WHEEL_BASE, WHEEL_VAR, YAW_VAR, 0.0f, 0.0f, 0.0f);
+    pose_estimator_init(&fused, WHEEL_BASE, WHEEL_VAR, YAW_VAR, 0.0f, 0.0f, 0.0f);
+    // 实际直行 200cm, 右轮编码器多计 2%, 陀螺仪给出真实航向 0
+    for (int i = 0; i < 100; i++) {
+        pose_estimator_predict(&odo, 2.0f, 2.04f);
+        pose_estimator_predict(&fused, 2.0f, 2.04f);
+        pose_estimator_update_heading(&fused, 0.0f);
+    }
+    printf("2%% scale error        odometry y %.2fcm, fused y %.2fcm\n", odo.y, fused.y);
+    CHECK(fabsf(fused.y) < 0.2f * fabsf(odo.y), "heading observation bounds lateral drift");
+    CHECK(fabsf(fused.theta) < fabsf(odo.theta), "heading observation corrects heading");
+}
+
+static void test_wrap(void) {
+    pose_estimator_t pe;
+
+    pose_estimator_init(&pe, WHEEL_BASE, WHEEL_VAR, YAW_VAR, 0.0f, 0.0f, 179.0f * PI_F / 180.0f);
+    pe.P[2][2] = YAW_VAR;
+    pose_estimator_update_heading(&pe, -179.0f * PI_F / 180.0f);
+    float deg = pe.theta * 180.0f / PI_F;
+    printf("wrap 179 <- -179      %.2fdeg\n", deg);
+    CHECK(fabsf(fabsf(deg) - 180.0f) < 0.1f, "update across ±180 moves toward 180, got %.2f", deg);
+}
+
+/**
+ * @brief 按模型注入轮行程噪声, 比较误差的样本方差与 EKF 协方差
+ */
+static void test_covariance(bool with_heading) {
+    pose_estimator_t ref;
+    double sum[3] = {0}, sq[3] = {0};
+
+    // 名义轨迹: 直行 60cm 后半径 40cm 左转 90°, 协方差只依赖名义行程
+    pose_estimator_init(&ref, WHEEL_BASE, WHEEL_VAR, YAW_VAR, 0.0f, 0.0f, 0.0f);
+    for (int run = 0; run < MC_RUNS; run++) {
+        pose_estimator_t est;
+        float tx = 0.0f, ty = 0.0f, tth = 0.0f;
+
+        pose_estimator_init(&est, WHEEL_BASE, WHEEL_VAR, YAW_VAR, 0.0f, 0.0f, 0.0f);
+        for (int i = 0; i < 90; i++) {
+            float dl, dr;
+            if (i < 30) {
+                dl = dr = 2.0f;
+            } else {
+                float dth = 0.5f * PI_F / 60.0f;
+                dl = (40.0f - WHEEL_BASE / 2) * dth;
+                dr = (40.0f + WHEEL_BASE / 2) * dth;
+            }
+            // 真实运动
+            float th = tth + 0.5f * (dr - dl) / WHEEL_BASE;
+            tx += 0.5f * (dl + dr) * cosf(th);
+            ty += 0.5f * (dl + dr) * sinf(th);
+            tth += (dr - dl) / WHEEL_BASE;
+
+            float nl = dl + sqrtf(WHEEL_VAR * fabsf(dl)) * gaussian();
+            float nr = dr + sqrtf(WHEEL_VAR * fabsf(dr)) * gaussian();
+            pose_estimator_predict(&est, nl, nr);
+            if (run == 0) {
+                pose_estimator_predict(&ref, dl, dr);
+            }
+            if (with_heading) {
+                float z = tth + sqrtf(YAW_VAR) * gaussian();
+                pose_estimator_update_heading(&est, z);
+                if (run == 0) {
+                    pose_estimator_update_heading(&ref, z);
+                }
+            }
+        }
+        float e[3] = { est.x - tx, est.y - ty, pose_estimator_wrap(est.theta - tth) };
+        for (int k = 0; k < 3; k++) {
+            sum[k] += e[k];
+            sq[k] += (double)e[k] * e[k];
+        }
+    }
+
+    const char *names[3] = { "x", "y", "th" };
+    printf("covariance %-10s", with_heading ? "fused" : "odometry");
+    for (int k = 0; k < 3; k++) {
+        double mean = sum[k] / MC_RUNS;
+        double var = sq[k] / MC_RUNS - mean * mean;
+        double ratio = var / ref.P[k][k];
+        printf("  %s %.2e/%.2e (%.2f)", names[k], var, (double)ref.P[k][k], ratio);
+        CHECK(ratio > 0.7 && ratio < 1.4, "%s variance matches the covariance, ratio %.2f", names[k], ratio);
+    }
+    printf("\n");
+
+    for (int a = 0; a < 3; a++) {
+        CHECK(ref.P[a][a] >= 0.0f, "non-negative diagonal");
+        for (int b = 0; b < 3; b++) {
+            CHECK(ref.P[a][b] == ref.P[b][a], "symmetric covariance");
+        }
+    }
+}
+
+int main(void) {
+    test_straight_and_arc();
+    test_scale_error();
+    test_wrap();
+    test_covariance(false);
+    test_covariance(true);
+    return host_check_summary();
+}
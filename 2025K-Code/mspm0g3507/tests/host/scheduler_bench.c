@@ -0,0 +1,142 @@
+/**
+ * @file scheduler_bench.c
+ * @brief 周期任务调度器主机端基准测试
+ *
+ * 对比旧的线性扫描调度与截止时间堆调度在不同任务数下的开销:
+ *  - idle: 没有任务到期时一次 periodic_event_task_process() 的耗时
+ *  - dispatch: 每执行一个任务摊到调度器本身的耗时
+ *
+ * 构建 (在 mspm0g3507 目录下):
+ *   gcc -O2 -DPERIODIC_TASK_MAX=128 -Itests/host/sim_hal -Icustom_src/core/system \
+ *       -Icustom_src/utils -Icustom_src/hal/uart \
+ *       tests/host/scheduler_bench.c custom_src/core/system/periodic_event_task.c \
+ *       custom_src/core/system/event_queue.c -o scheduler_bench
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "periodic_event_task.h"
+
+#define SIM_TIME_MS         20000   // 每组模拟的毫秒数
+#define LOOPS_PER_MS        8       // 每毫秒主循环空转次数
+
+static uint32_t fake_ms;
+static uint32_t dispatch_count;
+
+uint32_t get_ms(void) {
+    return fake_ms;
+}
+
+static void dummy_task(void) {
+    dispatch_count++;
+}
+
+static const uint32_t period_choices[] = { 1, 2, 5, 10, 20, 50, 100, 500 };
+
+static period_task_t table[PERIODIC_TASK_MAX];
+
+// ====================  旧实现 (线性扫描) 的参考副本  ====================
+
+static void linear_process(period_task_t *tasks, int count) {
+    uint32_t current_time = get_ms();
+    for (int i = 0; i < count; i++) {
+        period_task_t *task = &tasks[i];
+        if (task->is_running == RUN && task->task_handler != NULL) {
+            uint32_t time_since_last_run = current_time - task->last_run_time_ms;
+            if (time_since_last_run >= task->period_ms) {
+                task->task_handler();
+                task->last_run_time_ms = current_time;
+            }
+        }
+    }
+}
+
+// ====================  计时工具  ====================
+
+static inline uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void fill_table(int count) {
+    srand(1234);
+    for (int i = 0; i < count; i++) {
+        table[i].id = (EVENT_IDS)i;
+        table[i].is_running = RUN;
+        table[i].task_handler = dummy_task;
+        // 最短周期任务只保留一个, 模拟 camera_process 这种 1ms 轮询
+        table[i].period_ms = (i == 0) ? 1 : period_choices[1 + rand() % 7];
+        table[i].last_run_time_ms = 0;
+        table[i].next_run_time_ms = 0;
+    }
+}
+
+typedef struct {
+    double idle_ns;         // 空转调用平均耗时
+    double dispatch_ns;     // 平均每次任务分发的调度开销
+    uint32_t dispatches;
+} bench_result_t;
+
+static bench_result_t run_bench(int count, int use_heap) {
+    bench_result_t r = {0};
+    uint64_t idle_total = 0, busy_total = 0;
+    uint32_t idle_calls = 0;
+
+    fake_ms = 0;
+    dispatch_count = 0;
+    fill_table(count);
+    if (use_heap) {
+        init_task_scheduler(table, (uint8_t)count);
+    }
+
+    for (fake_ms = 1; fake_ms <= SIM_TIME_MS; fake_ms++) {
+        for (int loop = 0; loop < LOOPS_PER_MS; loop++) {
+            uint32_t before = dispatch_count;
+            uint64_t t0 = now_ns();
+            if (use_heap) {
+                periodic_event_task_process();
+            } else {
+                linear_process(table, count);
+            }
+            uint64_t dt = now_ns() - t0;
+            if (dispatch_count == before) {
+                idle_total += dt;
+                idle_calls++;
+            } else {
+                busy_total += dt;
+            }
+        }
+    }
+
+    r.dispatches = dispatch_count;
+    r.idle_ns = idle_calls ? (double)idle_total / idle_calls : 0.0;
+    r.dispatch_ns = dispatch_count ? (double)busy_total / dispatch_count : 0.0;
+    return r;
+}
+
+int main(void) {
+    static const int counts[] = { 4, 8, 12, 16, 32, 64, 128 };
+
+    printf("%6s | %12s %12s | %12s %12s | %10s\n",
+           "tasks", "linear idle", "heap idle", "linear disp", "heap disp", "dispatches");
+    printf("-------+---------------------------+---------------------------+-----------\n");
+
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        int n = counts[i];
+        if (n > PERIODIC_TASK_MAX) {
+            break;
+        }
+        bench_result_t lin = run_bench(n, 0);
+        bench_result_t heap = run_bench(n, 1);
+
+        if (lin.dispatches != heap.dispatches) {
+            printf("dispatch count mismatch at %d tasks: linear %u, heap %u\n",
+                   n, lin.dispatches, heap.dispatches);
+            return 1;
+        }
+        printf("%6d | %9.1f ns %9.1f ns | %9.1f ns %9.1f ns | %10u\n",
+               n, lin.idle_ns, heap.idle_ns, lin.dispatch_ns, heap.dispatch_ns, heap.dispatches);
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file scheduler_profile_test.c
+ * @brief PERIODIC_TASK_PROFILE=1 时调度器运行统计的主机端测试
+ *
+ * 目标板默认不打开统计, 这里单独以 -DPERIODIC_TASK_PROFILE=1 编译调度器, 检查
+ * 执行时间 (min/mean/max)、启动抖动直方图、错过截止时间计数, 以及 dump_periodic_task_profile() 的输出.
+ *
+ * 构建 (在 mspm0g3507 目录下):
+ *   gcc -O2 -DPERIODIC_TASK_PROFILE=1 -Itests/host/sim_hal -Icustom_src/core/system \
+ *       -Icustom_src/utils -Icustom_src/hal/uart tests/host/scheduler_profile_test.c \
+ *       custom_src/core/system/periodic_event_task.c custom_src/core/system/event_queue.c \
+ *       -o scheduler_profile_test
+ */
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include "periodic_event_task.h"
+#include "hal_uart.h"
+#include "host_check.h"
+
+#if !PERIODIC_TASK_PROFILE
+#error "build with -DPERIODIC_TASK_PROFILE=1"
+#endif
+
+// ====================  虚拟时钟与串口  ====================
+
+static uint32_t sim_us;
+
+uint32_t get_ms(void) { return sim_us / 1000; }
+uint32_t get_us(void) { return sim_us; }
+
+UART_Regs sim_uart0, sim_uart3;     // 不链接 sim_hal.c, 只需要 UART_0_INST 的地址
+
+static char uart_text[2048];
+static size_t uart_len;
+
+void usart_printf(UART_Regs* uart, const char* format, ...) {
+    (void)uart;
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(uart_text + uart_len, sizeof(uart_text) - uart_len, format, args);
+    va_end(args);
+    if (n > 0) {
+        uart_len += (size_t)n;
+        if (uart_len >= sizeof(uart_text)) {
+            uart_len = sizeof(uart_text) - 1;
+        }
+    }
+}
+
+// ====================  任务  ====================
+
+static uint32_t slow_runs;
+
+// 固定 200us
+static void fast_task(void) {
+    sim_us += 200;
+}
+
+// 每 10 次有一次 12ms, 超过自身 10ms 周期
+static void slow_task(void) {
+    sim_us += (++slow_runs % 10 == 0) ? 12000 : 1000;
+}
+
+static period_task_t tasks[] = {
+    PERIOD_TASK(EVENT_IMU_UPDATE, RUN, fast_task, 5,  CATCHUP_RUN_ONCE),
+    PERIOD_TASK(EVENT_CAR,        RUN, slow_task, 10, CATCHUP_RUN_ONCE),
+};
+
+int main(void) {
+    sim_us = 0;
+    init_task_scheduler(tasks, sizeof(tasks) / sizeof(tasks[0]));
+    clear_periodic_task_profile();
+
+    // 主循环每 100us 轮询一次, 共 1s
+    while (sim_us < 1000000) {
+        periodic_event_task_process();
+        sim_us += 100;
+    }
+
+    const task_profile_t *fast = get_periodic_task_profile(EVENT_IMU_UPDATE);
+    const task_profile_t *slow = get_periodic_task_profile(EVENT_CAR);
+    CHECK(fast != NULL && slow != NULL, "profiles available");
+    CHECK(get_periodic_task_profile(NUM_PERIOD_TASKS) == NULL, "out of range id rejected");
+
+    CHECK(fast->run_count >= 180 && fast->run_count <= 200, "fast task ran about every 5ms");
+    CHECK(fast->min_us == 200 && fast->max_us == 200, "fast task min/max execution time");
+    CHECK(fast->total_us == (uint64_t)fast->run_count * 200, "fast task total time");
+    CHECK(slow->min_us == 1000 && slow->max_us == 12000, "slow task min/max execution time");
+    CHECK(slow->missed_deadlines > 0 && slow->missed_deadlines <= slow->run_count / 10 + 1,
+          "12ms runs of a 10ms task counted as missed deadlines");
+    // 慢任务的 12ms 执行推迟了快任务, 抖动直方图的高档应有计数
+    uint32_t hist_total = 0, late = 0;
+    for (int b = 0; b < TASK_JITTER_BINS; b++) {
+        hist_total += fast->jitter_hist[b];
+        if (b >= 3) {
+            late += fast->jitter_hist[b];
+        }
+    }
+    CHECK(hist_total == fast->run_count, "jitter histogram covers every run");
+    CHECK(late > 0 && fast->max_jitter_us >= 2000, "long slow-task runs show up as fast-task jitter");
+
+    uart_len = 0;
+    dump_periodic_task_profile();
+    printf("%s", uart_text);
+    CHECK(strncmp(uart_text, "id  period", 10) == 0, "dump header");
+    int rows = 0;
+    for (const char *p = uart_text; (p = strstr(p, "\r\n")) != NULL; p += 2) {
+        rows++;
+    }
+    CHECK(rows == 3, "dump has header plus one row per task");
+
+    clear_periodic_task_profile();
+    CHECK(get_periodic_task_profile(EVENT_CAR)->run_count == 0, "profile cleared");
+
+    return host_check_summary();
+}
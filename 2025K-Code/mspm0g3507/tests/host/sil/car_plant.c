@@ -0,0 +1,291 @@
+/**
+ * @file car_plant.c
+ * @brief 差速小车被控对象模型, 接口说明见 car_plant.h
+ */
+#include <math.h>
+#include <string.h>
+#include "car_plant.h"
+#include "sim_hal.h"
+#include "car_config.h"
+
+#define PLANT_PWM_FULL_SCALE    3000.0f     // motor_user.c 中 tb6612_cfg.max_pwm_value
+#define GW_GRAY_ADDR            0x4C        // gray_detection.h: GW_GRAY_ADDR_DEF
+#define GW_GRAY_DIGITAL_REG     0xDD        // gray_detection.h: GW_GRAY_DIGITAL_MODE
+#define GRAY_CHANNELS           8
+
+#define DEG_PER_RAD             (180.0f / (float)M_PI)
+
+// 编码器计数增加方向的正交时序 (bit0 = A 相, bit1 = B 相)
+static const uint8_t quadrature_seq[4] = { 0x0, 0x2, 0x3, 0x1 };
+
+static const struct {
+    uint32_t pin_a, pin_b;
+} encoder_pins[2] = {
+    { PORTB_ENCODER_1_PIN, PORTB_ENCODER_2_PIN },   // encoder_user.c: 编码器 0
+    { PORTB_ENCODER_4_PIN, PORTB_ENCODER_3_PIN },   // encoder_user.c: 编码器 1
+};
+
+// WIT Z 轴置零命令 (wit_jyxx.c: cmd_calibration_z)
+static const uint8_t wit_zero_cmd[5] = { 0xFF, 0xAA, 0x01, 0x04, 0x00 };
+
+static struct {
+    car_plant_config_t cfg;
+    const track_map_t *map;
+    car_plant_state_t state;
+
+    float lag_alpha;                // 一阶惯性离散系数 1 - exp(-dt / tau)
+    double counts_per_cm;
+
+    // 74HC595: 移位寄存器与锁存输出
+    uint8_t hc595_shift;
+    uint8_t hc595_latch;
+
+    // 编码器: 连续计数、已输出到引脚的整数计数、当前时序相位
+    double enc_pos[2];
+    int64_t enc_emitted[2];
+    uint8_t enc_phase[2];
+
+    // 陀螺仪
+    float yaw_ref_deg;
+    float drift_deg;
+    uint32_t imu_elapsed_us;
+    uint8_t uart0_window[sizeof(wit_zero_cmd)];
+
+    // 灰度板 I2C 设备
+    sim_i2c_device_t gray_dev;
+    uint8_t gray_pointer;
+} plant;
+
+void car_plant_default_config(car_plant_config_t *cfg) {
+    cfg->v_max_cmps = 150.0f;
+    cfg->tau_s = 0.08f;
+    cfg->deadzone = 0.03f;
+    cfg->wheel_radius_cm = WHEEL_RADIUS_CM;
+    cfg->counts_per_rev = PULSE_NUM_PER_CIRCLE;
+    cfg->track_width_cm = WHEEL_BASE_CM;
+    cfg->gray_offset_cm = 10.0f;
+    cfg->gray_spacing_cm = 1.5f;
+    cfg->gyro_drift_dps = 0.0f;
+    cfg->imu_period_ms = 10;
+    cfg->step_us = 500;
+}
+
+// ====================  执行器  ====================
+
+static void hc595_hook(GPIO_Regs *gpio, uint32_t changed) {
+    if ((changed & PORTA_HC595_SHCP_PIN) && (gpio->dout & PORTA_HC595_SHCP_PIN)) {
+        plant.hc595_shift = (uint8_t)((plant.hc595_shift << 1) | ((gpio->dout & PORTA_HC595_DS_PIN) ? 1 : 0));
+    }
+    if ((changed & PORTA_HC595_STCP_PIN) && (gpio->dout & PORTA_HC595_STCP_PIN)) {
+        plant.hc595_latch = plant.hc595_shift;
+    }
+}
+
+/**
+ * @brief 电机 i 的带方向占空比
+ * @note tb6612_cfg 的 polarity 为 false: 正转 IN2 (bit 2i+1) 置位, 反转 IN1 (bit 2i) 置位, 其余为停
+ */
+static float motor_duty(int i) {
+    uint8_t in = (uint8_t)((plant.hc595_latch >> (2 * i)) & 0x3);
+    float duty = Motor_PWM1_INST->running ? (float)Motor_PWM1_INST->cc[i] / PLANT_PWM_FULL_SCALE : 0.0f;
+
+    if (duty > 1.0f) {
+        duty = 1.0f;
+    }
+    if (in == 0x2) {
+        return duty;
+    } else if (in == 0x1) {
+        return -duty;
+    }
+    return 0.0f;
+}
+
+// ====================  传感器  ====================
+
+static void encoder_emit(int i) {
+    int64_t target = (int64_t)floor(plant.enc_pos[i]);
+
+    while (plant.enc_emitted[i] != target) {
+        int dir = (target > plant.enc_emitted[i]) ? 1 : -1;
+        plant.enc_emitted[i] += dir;
+        plant.enc_phase[i] = (uint8_t)((plant.enc_phase[i] + 4 + dir) % 4);
+
+        uint8_t s = quadrature_seq[plant.enc_phase[i]];
+        sim_gpio_set_input(PORTB_PORT, encoder_pins[i].pin_a, s & 0x1);
+        sim_gpio_set_input(PORTB_PORT, encoder_pins[i].pin_b, (s >> 1) & 0x1);
+    }
+}
+
+static float wrap_deg(float deg) {
+    deg = fmodf(deg, 360.0f);
+    if (deg > 180.0f) {
+        deg -= 360.0f;
+    } else if (deg <= -180.0f) {
+        deg += 360.0f;
+    }
+    return deg;
+}
+
+/**
+ * @brief 发送一帧 WIT 角度输出 (0x55 0x53, 角度 = 原始值 / 32768 * 180)
+ */
+static void imu_send_frame(void) {
+    float yaw = wrap_deg(plant.state.heading_deg - plant.yaw_ref_deg + plant.drift_deg);
+    int16_t raw = (int16_t)lrintf(yaw / 180.0f * 32768.0f);
+    uint8_t frame[11] = { 0x55, 0x53, 0, 0, 0, 0, (uint8_t)(raw & 0xFF), (uint8_t)((uint16_t)raw >> 8), 0, 0, 0 };
+
+    for (int i = 0; i < 10; i++) {
+        frame[10] = (uint8_t)(frame[10] + frame[i]);
+    }
+    sim_uart_rx(UART_0_INST, frame, sizeof(frame));
+}
+
+static void imu_uart_tx_hook(uint8_t byte) {
+    memmove(plant.uart0_window, plant.uart0_window + 1, sizeof(plant.uart0_window) - 1);
+    plant.uart0_window[sizeof(plant.uart0_window) - 1] = byte;
+    if (memcmp(plant.uart0_window, wit_zero_cmd, sizeof(wit_zero_cmd)) == 0) {
+        car_plant_zero_yaw();
+    }
+}
+
+/**
+ * @brief 按当前位姿采样 8 路灰度, bit k 的探头在车身中线左侧 (k - 3.5) * 间距处
+ */
+static uint8_t gray_sample(void) {
+    uint8_t byte = 0;
+    if (plant.map == NULL) {
+        return 0;
+    }
+
+    float h = plant.state.heading_deg / DEG_PER_RAD;
+    float c = cosf(h), s = sinf(h);
+    float fx = plant.state.x_cm + plant.cfg.gray_offset_cm * c;
+    float fy = plant.state.y_cm + plant.cfg.gray_offset_cm * s;
+
+    for (int k = 0; k < GRAY_CHANNELS; k++) {
+        float lateral = ((float)k - 3.5f) * plant.cfg.gray_spacing_cm;
+        if (track_map_is_black(plant.map, fx - lateral * s, fy + lateral * c)) {
+            byte |= (uint8_t)(1u << k);
+        }
+    }
+    return byte;
+}
+
+static void gray_i2c_write(sim_i2c_device_t *dev, const uint8_t *data, uint32_t len) {
+    (void)dev;
+    if (len > 0) {
+        plant.gray_pointer = data[0];
+    }
+}
+
+/**
+ * @brief 感为板输出: 低电平表示黑线, 且位序与 gray_byte 相反 (gray_read_byte 中取反再翻转)
+ */
+static void gray_i2c_read(sim_i2c_device_t *dev, uint8_t *data, uint32_t len) {
+    (void)dev;
+    uint8_t raw = 0;
+
+    if (plant.gray_pointer == GW_GRAY_DIGITAL_REG) {
+        uint8_t byte = gray_sample();
+        plant.state.gray_byte = byte;
+        for (int k = 0; k < GRAY_CHANNELS; k++) {
+            if (byte & (1u << k)) {
+                raw |= (uint8_t)(0x80u >> k);
+            }
+        }
+        raw = (uint8_t)~raw;
+    }
+    memset(data, raw, len);
+}
+
+// ====================  积分  ====================
+
+static void plant_step(void) {
+    float dt = (float)plant.cfg.step_us * 1e-6f;
+    car_plant_state_t *st = &plant.state;
+
+    for (int i = 0; i < 2; i++) {
+        float duty = motor_duty(i);
+        float mag = fabsf(duty);
+        float v_cmd = 0.0f;
+
+        if (mag > plant.cfg.deadzone) {
+            v_cmd = copysignf((mag - plant.cfg.deadzone) / (1.0f - plant.cfg.deadzone), duty) * plant.cfg.v_max_cmps;
+        }
+        st->duty[i] = duty;
+        st->wheel_cmps[i] += (v_cmd - st->wheel_cmps[i]) * plant.lag_alpha;
+        plant.enc_pos[i] += (double)st->wheel_cmps[i] * dt * plant.counts_per_cm;
+    }
+
+    // 差速运动学, 航向取步长中点
+    float v = 0.5f * (st->wheel_cmps[0] + st->wheel_cmps[1]);
+    float w = (st->wheel_cmps[1] - st->wheel_cmps[0]) / plant.cfg.track_width_cm;     // rad/s
+    float h_mid = st->heading_deg / DEG_PER_RAD + 0.5f * w * dt;
+
+    st->x_cm += v * cosf(h_mid) * dt;
+    st->y_cm += v * sinf(h_mid) * dt;
+    st->heading_deg += w * dt * DEG_PER_RAD;
+    st->distance_cm += fabsf(v) * dt;
+    plant.drift_deg += plant.cfg.gyro_drift_dps * dt;
+
+    for (int i = 0; i < 2; i++) {
+        encoder_emit(i);
+    }
+
+    plant.imu_elapsed_us += plant.cfg.step_us;
+    if (plant.imu_elapsed_us >= plant.cfg.imu_period_ms * 1000U) {
+        plant.imu_elapsed_us = 0;
+        imu_send_frame();
+    }
+}
+
+// ====================  接口  ====================
+
+void car_plant_attach(const car_plant_config_t *cfg, const track_map_t *map) {
+    memset(&plant, 0, sizeof(plant));
+    plant.cfg = *cfg;
+    plant.map = map;
+    plant.lag_alpha = 1.0f - expf(-(float)cfg->step_us * 1e-6f / cfg->tau_s);
+    plant.counts_per_cm = (double)cfg->counts_per_rev / (2.0 * M_PI * cfg->wheel_radius_cm);
+
+    // 编码器引脚从时序第 0 相开始
+    for (int i = 0; i < 2; i++) {
+        sim_gpio_set_input(PORTB_PORT, encoder_pins[i].pin_a | encoder_pins[i].pin_b, false);
+    }
+
+    PORTA_PORT->out_hook = hc595_hook;
+    UART_0_INST->tx_hook = imu_uart_tx_hook;
+
+    plant.gray_dev.addr = GW_GRAY_ADDR;
+    plant.gray_dev.write = gray_i2c_write;
+    plant.gray_dev.read = gray_i2c_read;
+    sim_i2c_attach(&plant.gray_dev);
+
+    sim_hal_set_tick_hook(plant_step, cfg->step_us);
+}
+
+void car_plant_reconfigure(const car_plant_config_t *cfg) {
+    plant.cfg = *cfg;
+    plant.lag_alpha = 1.0f - expf(-(float)cfg->step_us * 1e-6f / cfg->tau_s);
+    plant.counts_per_cm = (double)cfg->counts_per_rev / (2.0 * M_PI * cfg->wheel_radius_cm);
+    sim_hal_set_tick_hook(plant_step, cfg->step_us);
+}
+
+void car_plant_place(float x_cm, float y_cm, float heading_deg) {
+    car_plant_state_t *st = &plant.state;
+
+    st->x_cm = x_cm;
+    st->y_cm = y_cm;
+    st->heading_deg = heading_deg;
+    st->wheel_cmps[0] = st->wheel_cmps[1] = 0.0f;
+    st->distance_cm = 0.0f;
+}
+
+void car_plant_zero_yaw(void) {
+    plant.yaw_ref_deg = plant.state.heading_deg;
+    plant.drift_deg = 0.0f;
+}
+
+const car_plant_state_t *car_plant_state(void) {
+    return &plant.state;
+}
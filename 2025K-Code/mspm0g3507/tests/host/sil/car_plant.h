@@ -0,0 +1,81 @@
+/**
+ * @file car_plant.h
+ * @brief 差速小车被控对象模型 (软件在环仿真)
+ *
+ * 挂在 sim_hal 上, 固件代码不做任何修改:
+ *  - 电机: 从 74HC595 移位寄存器 (PORTA DS/SHCP/STCP) 解出方向, 从 Motor_PWM1 的比较值取占空比,
+ *          一阶惯性环节 (电机 + 车轮 + 车体惯量合并) 得到轮速
+ *  - 编码器: 轮子转过的计数按正交时序驱动 PORTB 编码器引脚, 走真实的 GROUP1 中断计数路径
+ *  - 陀螺仪: 按 WIT 协议从 UART0 送出欧拉角帧; 收到固件发出的 Z 轴置零命令时重置航向基准
+ *  - 灰度: 感为 8 路板的 I2C 模型 (地址 GW_GRAY_ADDR_DEF), 传感器位置在 track_map_t 上查询黑线
+ *
+ * 坐标系: 单位 cm, x 沿发车方向, y 指向车身左侧, 航向逆时针为正 (与 WIT 偏航角方向一致).
+ * 电机/编码器 0 为左轮, 1 为右轮 (与 car_controller 的 i < motor_count / 2 为左轮一致).
+ */
+#ifndef CAR_PLANT_H__
+#define CAR_PLANT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "track_map.h"
+
+typedef struct {
+    // 动力学
+    float v_max_cmps;           // 满占空比空载轮速
+    float tau_s;                // 轮速一阶时间常数
+    float deadzone;             // 占空比死区 (0~1), 静摩擦
+    // 几何 (默认取 car_config.h)
+    float wheel_radius_cm;
+    uint32_t counts_per_rev;    // 编码器一圈计数 (4 倍频后)
+    float track_width_cm;       // 左右轮距
+    // 灰度板
+    float gray_offset_cm;       // 传感器排到驱动轮轴的前向距离
+    float gray_spacing_cm;      // 相邻探头间距
+    // 陀螺仪
+    float gyro_drift_dps;       // 零漂, 度/秒
+    uint32_t imu_period_ms;     // 角度帧输出周期
+    // 积分
+    uint32_t step_us;           // 模型步长
+} car_plant_config_t;
+
+typedef struct {
+    float x_cm, y_cm;
+    float heading_deg;          // 真实航向, 逆时针为正, 不做 ±180 折叠
+    float wheel_cmps[2];        // 左, 右
+    float duty[2];              // 当前驱动占空比 (带方向)
+    float distance_cm;          // 车体中心累计行驶路程
+    uint8_t gray_byte;          // 最近一次灰度板输出 (bit7 在最左侧, 1 = 黑线)
+} car_plant_state_t;
+
+/**
+ * @brief 用 car_config.h 的几何参数和一组典型的 N20/TT 电机参数填充配置
+ */
+void car_plant_default_config(car_plant_config_t *cfg);
+
+/**
+ * @brief 把模型挂到仿真 HAL 上 (GPIO 输出钩子、UART0 发送钩子、I2C 设备、周期节拍)
+ * @param map 黑线地图, 为 NULL 时灰度全白
+ * @note 必须在 sim_hal_reset() 之后调用; 小车放在原点, 航向 0
+ */
+void car_plant_attach(const car_plant_config_t *cfg, const track_map_t *map);
+
+/**
+ * @brief 运行中更换模型参数 (位姿、编码器相位、HAL 挂接不变)
+ * @note 几何参数 (轮径、编码器分辨率、轮距) 应与固件 car_config.h 一致, 一般只改动力学部分
+ */
+void car_plant_reconfigure(const car_plant_config_t *cfg);
+
+/**
+ * @brief 把小车静止地放到指定位置 (相当于人手搬回发车区)
+ * @note 航向基准不变: 放到 heading_deg 时陀螺仪输出 heading_deg 相对于上一次置零的角度
+ */
+void car_plant_place(float x_cm, float y_cm, float heading_deg);
+
+/**
+ * @brief 重置陀螺仪航向基准, 效果与固件发送 Z 轴置零命令相同
+ */
+void car_plant_zero_yaw(void);
+
+const car_plant_state_t *car_plant_state(void);
+
+#endif
@@ -0,0 +1,292 @@
+/**
+ * @file pid_tuner.c
+ * @brief 主机侧 PID 批量整定: 在软件在环模型上反复跑比赛任务, 搜索一组参数使总用时与超调最小
+ *
+ * 两步:
+ *  1. 继电器辨识: 在模型上依次执行固件的 car_autotune() (与车上 "PID Auto Tune" 菜单是同一段代码),
+ *     由内到外 (速度 -> 里程 -> 直行 -> 转向 -> 循迹) 得到各环 Ku/Tu 和按规则换算的参数;
+ *  2. 模式搜索: 从默认表与继电器表中代价较小的一张出发, 每个参数按倍率 (1 + step) 放大或缩小试探,
+ *     有改进就接受, 一轮没有改进时步长减半.
+ *
+ * 代价 = Σ 任务用时(s) + 航向超调(deg) × W_OVERSHOOT + 终点误差(cm) × W_POSITION
+ *        + 循迹用时 + 循迹最大离线(cm) × W_TRACK_OFFSET, 任务超时或终点超差再加罚分.
+ * 每组参数在名义模型和一个 "电机偏弱" 的模型上各跑一遍, 避免结果只适合名义参数.
+ *
+ * 输出 car_pid_default_table 的 C 定义, 可整段替换 task25k_car_pid_parameter.c 中的同名定义.
+ *
+ * 用法: pid_tuner [--evals N] [--plant v_max,tau,deadzone] [--out FILE]
+ *   --evals  搜索阶段的代价评估次数上限 (默认 300, 约半分钟)
+ *   --plant  名义模型改用实车测得的电机参数: 满占空比轮速 cm/s, 一阶时间常数 s, 死区占空比
+ *   --out    表写入文件, 默认只打印
+ * ctest 以 --evals 12 运行, 检查继电器辨识全部成功且搜索结果的代价不高于默认表.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <math.h>
+#include "sil_harness.h"
+#include "sim_hal.h"
+#include "common_include.h"
+
+#define DEFAULT_EVALS           300
+#define RELAY_TIMEOUT_US        (20ULL * 1000000ULL)
+
+#define W_OVERSHOOT             0.2         // s / deg
+#define W_POSITION              0.1         // s / cm
+#define W_TRACK_OFFSET          1.0         // s / cm
+#define PENALTY_FAILED          100.0       // 超时、终点航向超差或冲出黑线
+#define HEADING_TOL_DEG         5.0f
+#define TRACK_OFFSET_LIMIT_CM   4.0f
+
+#define STEP_INITIAL            0.3
+#define STEP_MIN                0.02
+
+// 参与搜索的参数; 默认表里为 0 的项 (例如角度环 Ki) 保持为 0
+typedef struct {
+    const char *name;
+    size_t offset;
+} tune_param_t;
+
+#define PARAM(field)    { #field, offsetof(car_pid_table_t, field) }
+
+static const tune_param_t params[] = {
+    PARAM(speed.kp), PARAM(speed.ki), PARAM(speed.kd),
+    PARAM(mileage.kp), PARAM(mileage.ki), PARAM(mileage.kd),
+    PARAM(straight.kp), PARAM(straight.ki), PARAM(straight.kd),
+    PARAM(angle.kp), PARAM(angle.ki), PARAM(angle.kd),
+    PARAM(track.kp), PARAM(track.ki), PARAM(track.kd),
+};
+
+#define PARAM_COUNT     (int)(sizeof(params) / sizeof(params[0]))
+
+static car_plant_config_t plant_variants[2];
+static int eval_count;
+
+static float *param_ref(car_pid_table_t *table, int i) {
+    return (float *)((char *)table + params[i].offset);
+}
+
+// ====================  代价  ====================
+
+static double evaluate_variant(const car_plant_config_t *cfg, const car_pid_table_t *table, bool verbose) {
+    double cost = 0.0;
+    sil_mission_result_t m;
+    sil_track_result_t t;
+
+    sil_set_plant(cfg);
+    car_apply_pid_table(table);
+
+    for (int i = 0; i < sil_mission_case_count; i++) {
+        sil_run_mission(&sil_mission_cases[i], &m);
+        cost += m.sim_s + W_OVERSHOOT * m.heading_overshoot_deg + W_POSITION * m.pos_err_cm;
+        if (!m.done || fabsf(m.heading_err_deg) > HEADING_TOL_DEG) {
+            cost += PENALTY_FAILED;
+        }
+        if (verbose) {
+            printf("  %-24s %6.2fs  overshoot %5.2fdeg  end err %5.1fcm%s\n", sil_mission_label(&sil_mission_cases[i]),
+                   m.sim_s, m.heading_overshoot_deg, m.pos_err_cm, m.done ? "" : "  TIMEOUT");
+        }
+    }
+
+    sil_run_track(&t);
+    cost += t.sim_s + W_TRACK_OFFSET * t.max_offset_cm;
+    if (!t.done || t.max_offset_cm > TRACK_OFFSET_LIMIT_CM) {
+        cost += PENALTY_FAILED;
+    }
+    if (verbose) {
+        printf("  %-24s %6.2fs  max line offset %.2fcm%s\n", "Track S-curve", t.sim_s, t.max_offset_cm,
+               t.done ? "" : "  TIMEOUT");
+    }
+    return cost;
+}
+
+static double evaluate(const car_pid_table_t *table, bool verbose) {
+    double cost = 0.0;
+
+    eval_count++;
+    for (int v = 0; v < 2; v++) {
+        if (verbose) {
+            printf(" plant %d: v_max %.0fcm/s tau %.3fs deadzone %.3f\n", v, plant_variants[v].v_max_cmps,
+                   plant_variants[v].tau_s, plant_variants[v].deadzone);
+        }
+        cost += evaluate_variant(&plant_variants[v], table, verbose);
+    }
+    return cost;
+}
+
+// ====================  继电器辨识  ====================
+
+static const char *const loop_names[CAR_TUNE_LOOP_COUNT] = {
+    "speed", "mileage", "straight", "angle", "track",
+};
+
+/**
+ * @brief 在名义模型上依次整定各环, 结果已由 car_autotune() 写入 PID, 最后读出整张表
+ * @return 全部成功返回 true
+ */
+static bool relay_identify(car_pid_table_t *table) {
+    bool ok = true;
+
+    printf("relay identification:\n");
+    for (int loop = 0; loop < CAR_TUNE_LOOP_COUNT; loop++) {
+        if (loop == CAR_TUNE_TRACK) {
+            sil_place_on_line();
+        } else {
+            sil_place(0.0f, 0.0f, 0.0f);
+        }
+        car_path_init();
+        sim_uart_tx_clear(UART_0_INST);
+        car_add_autotune((CAR_TUNE_LOOPS)loop);
+        car_set_loop(1);
+        sil_start_actions();
+        bool finished = sil_run_until_done(RELAY_TIMEOUT_US);
+        sil_clear_track();
+
+        const car_tune_result_t *r = &car_tune_result[loop];
+        if (!finished || !r->valid) {
+            printf("  %-9s failed\n", loop_names[loop]);
+            ok = false;
+            continue;
+        }
+        printf("  %-9s Ku %9.3f  Tu %6.3fs  ->  kp %8.3f  ki %7.4f  kd %7.3f\n", loop_names[loop],
+               r->ku, r->tu, r->kp, r->ki, r->kd);
+        // 车上看不到 printf, 结果须由固件自己报到 UART_0
+        char report[SIM_UART_TX_LOG + 1], expect[32];
+        memcpy(report, UART_0_INST->tx_log, UART_0_INST->tx_len);
+        report[UART_0_INST->tx_len] = '\0';
+        snprintf(expect, sizeof(expect), "autotune %s: Ku=", loop_names[loop]);
+        if (strstr(report, expect) == NULL) {
+            printf("  %-9s result not reported on UART_0\n", loop_names[loop]);
+            ok = false;
+        }
+    }
+    car_pid_get_table(table);
+    return ok;
+}
+
+// ====================  搜索  ====================
+
+static void pattern_search(car_pid_table_t *best, double *best_cost, int max_evals) {
+    double step = STEP_INITIAL;
+    int start = eval_count;
+
+    while (eval_count - start < max_evals && step >= STEP_MIN) {
+        bool improved = false;
+
+        for (int i = 0; i < PARAM_COUNT && eval_count - start < max_evals; i++) {
+            if (*param_ref(best, i) == 0.0f) {
+                continue;
+            }
+            for (int dir = 0; dir < 2 && eval_count - start < max_evals; dir++) {
+                car_pid_table_t cand = *best;
+                float *p = param_ref(&cand, i);
+                *p = (dir == 0) ? *p * (float)(1.0 + step) : *p / (float)(1.0 + step);
+
+                double cost = evaluate(&cand, false);
+                if (cost < *best_cost) {
+                    printf("  [%3d] step %.3f  %-12s %9.4f  cost %.3f\n", eval_count, step, params[i].name, *p, cost);
+                    *best = cand;
+                    *best_cost = cost;
+                    improved = true;
+                    break;
+                }
+            }
+        }
+        if (!improved) {
+            step *= 0.5;
+        }
+    }
+}
+
+static void print_table(FILE *out, const car_pid_table_t *t, double cost) {
+    fprintf(out, "// pid_tuner: cost %.3f\n", cost);
+    fprintf(out, "const car_pid_table_t car_pid_default_table = {\n");
+    fprintf(out, "    .speed    = { %.4ff, %.4ff, %.4ff },\n", t->speed.kp, t->speed.ki, t->speed.kd);
+    fprintf(out, "    .mileage  = { %.4ff, %.4ff, %.4ff },\n", t->mileage.kp, t->mileage.ki, t->mileage.kd);
+    fprintf(out, "    .straight = { %.4ff, %.4ff, %.4ff },\n", t->straight.kp, t->straight.ki, t->straight.kd);
+    fprintf(out, "    .angle    = { %.4ff, %.4ff, %.4ff },\n", t->angle.kp, t->angle.ki, t->angle.kd);
+    fprintf(out, "    .track    = { %.4ff, %.4ff, %.4ff },\n", t->track.kp, t->track.ki, t->track.kd);
+    fprintf(out, "};\n");
+}
+
+int main(int argc, char **argv) {
+    int max_evals = DEFAULT_EVALS;
+    const char *out_path = NULL;
+
+    car_plant_default_config(&plant_variants[0]);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--evals") == 0 && i + 1 < argc) {
+            max_evals = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--plant") == 0 && i + 1 < argc) {
+            car_plant_config_t *cfg = &plant_variants[0];
+            if (sscanf(argv[++i], "%f,%f,%f", &cfg->v_max_cmps, &cfg->tau_s, &cfg->deadzone) != 3) {
+                fprintf(stderr, "--plant expects v_max,tau,deadzone\n");
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--evals N] [--plant v_max,tau,deadzone] [--out FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+    // 鲁棒性校核: 电机弱 15%, 惯性大 50%, 静摩擦翻倍
+    plant_variants[1] = plant_variants[0];
+    plant_variants[1].v_max_cmps *= 0.85f;
+    plant_variants[1].tau_s *= 1.5f;
+    plant_variants[1].deadzone *= 2.0f;
+
+    double w0 = sil_wall_seconds();
+    car_pid_table_t relay_table;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    sil_boot(&plant_variants[0]);
+    bool relay_ok = relay_identify(&relay_table);
+
+    printf("default table:\n");
+    double default_cost = evaluate(&car_pid_default_table, true);
+    printf(" cost %.3f\n", default_cost);
+
+    car_pid_table_t best = car_pid_default_table;
+    double best_cost = default_cost;
+    if (relay_ok) {
+        printf("relay table:\n");
+        double relay_cost = evaluate(&relay_table, true);
+        printf(" cost %.3f\n", relay_cost);
+        if (relay_cost < best_cost) {
+            best = relay_table;
+            best_cost = relay_cost;
+        }
+    }
+
+    printf("pattern search (%d evaluations max):\n", max_evals);
+    pattern_search(&best, &best_cost, max_evals);
+
+    printf("best:\n");
+    best_cost = evaluate(&best, true);
+    printf(" cost %.3f (default %.3f), %d evaluations, wall %.1fs\n\n", best_cost, default_cost,
+           eval_count, sil_wall_seconds() - w0);
+    print_table(stdout, &best, best_cost);
+
+    if (out_path != NULL) {
+        FILE *f = fopen(out_path, "w");
+        if (f == NULL) {
+            perror(out_path);
+            return 1;
+        }
+        print_table(f, &best, best_cost);
+        fclose(f);
+    }
+
+    if (!relay_ok) {
+        printf("FAIL: relay identification\n");
+        return 1;
+    }
+    if (best_cost > default_cost) {
+        printf("FAIL: tuned table worse than default\n");
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
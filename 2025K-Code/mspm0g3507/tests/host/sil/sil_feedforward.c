@@ -0,0 +1,181 @@
+/**
+ * @file sil_feedforward.c
+ * @brief 软件在环: 速度环前馈的标定与效果
+ *
+ * 在名义模型和 "电机偏弱" 模型上各做一遍:
+ *  1. 不带前馈 (car_speed_ff[] 未标定) 跑一组直行阶跃和全部比赛任务, 记录用时;
+ *  2. 执行固件的 car_ff_calibrate() (与菜单 "Calib Speed FF" 相同), 标定结果与模型真值比较;
+ *  3. 带前馈重跑同一组用例.
+ *
+ * 检查项: 标定出的死区、PWM-轮速斜率、时间常数与模型参数相符; 带前馈后直行阶跃的总用时缩短,
+ * 比赛任务全部完成且总用时不超过不带前馈时的 MISSION_SLACK 倍, 每个任务的终点误差
+ * 不比不带前馈时大 END_ERR_SLACK_CM 以上 (曾因绕圈追赶过猛, 电机偏弱时 Base Part 03 由 36.7cm 变为 46.8cm).
+ * 外环参数是按不带前馈的速度环整定的, 名义模型上转向收尾略慢, 任务总用时只要求持平;
+ * 电机偏弱时前馈补上死区与增益差, 任务用时明显缩短.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "sil_harness.h"
+#include "sim_hal.h"
+#include "common_include.h"
+#include "host_check.h"
+
+#define CALIB_TIMEOUT_US        (10ULL * 1000000ULL)
+#define STEP_TIMEOUT_US         (10ULL * 1000000ULL)
+#define PWM_FULL_SCALE          3000.0f
+
+#define DEADBAND_TOL_PWM        40.0f
+#define SLOPE_TOL_RATIO         0.10f
+#define TAU_TOL_RATIO           0.35f
+#define MISSION_SLACK           1.02
+#define END_ERR_SLACK_CM        2.0f
+#define MAX_MISSION_CASES       16
+
+static const float step_distances_cm[] = { 20.0f, 50.0f, 100.0f, 150.0f };
+#define STEP_COUNT  (int)(sizeof(step_distances_cm) / sizeof(step_distances_cm[0]))
+
+typedef struct {
+    double step_s;          // 直行阶跃总用时
+    float step_overshoot;   // 直行阶跃越过终点的最大值, cm
+    double mission_s;       // 比赛任务总用时
+    float end_err_cm[MAX_MISSION_CASES];
+    bool all_done;
+} ff_run_result_t;
+
+static void run_cases(const char *label, ff_run_result_t *r) {
+    const car_plant_state_t *st = car_plant_state();
+    sil_mission_result_t m;
+
+    r->step_s = 0.0;
+    r->step_overshoot = 0.0f;
+    r->mission_s = 0.0;
+    r->all_done = true;
+
+    printf(" %s:\n", label);
+    for (int i = 0; i < STEP_COUNT; i++) {
+        float target = step_distances_cm[i];
+        float overshoot = 0.0f;
+
+        sil_place(0.0f, 0.0f, 0.0f);
+        car_path_init();
+        car_add_straight(target);
+        car_set_loop(1);
+        sil_start_actions();
+
+        uint64_t t0 = sim_time_us();
+        bool done = false;
+        while (sim_time_us() - t0 < STEP_TIMEOUT_US) {
+            sil_run_for(ENCODER_PERIOD_MS * 1000ULL);
+            if (st->x_cm - target > overshoot) {
+                overshoot = st->x_cm - target;
+            }
+            if (!car_is_running()) {
+                done = true;
+                break;
+            }
+        }
+        double t = (double)(sim_time_us() - t0) * 1e-6;
+        printf("  straight %5.0fcm      %6.2fs  overshoot %5.2fcm%s\n", target, t, overshoot,
+               done ? "" : "  TIMEOUT");
+        r->step_s += t;
+        r->all_done &= done;
+        if (overshoot > r->step_overshoot) {
+            r->step_overshoot = overshoot;
+        }
+    }
+
+    for (int i = 0; i < sil_mission_case_count; i++) {
+        sil_run_mission(&sil_mission_cases[i], &m);
+        printf("  %-22s %6.2fs  end err %5.1fcm%s\n", sil_mission_label(&sil_mission_cases[i]), m.sim_s,
+               m.pos_err_cm, m.done ? "" : "  TIMEOUT");
+        r->mission_s += m.sim_s;
+        r->end_err_cm[i] = m.pos_err_cm;
+        r->all_done &= m.done;
+    }
+    printf("  total: steps %.2fs, missions %.2fs\n", r->step_s, r->mission_s);
+}
+
+static void calibrate(const car_plant_config_t *cfg) {
+    // 模型真值: 占空比超过死区后轮速线性上升, 满占空比 v_max
+    float deadband = cfg->deadzone * PWM_FULL_SCALE;
+    float slope = PWM_FULL_SCALE * (1.0f - cfg->deadzone) / cfg->v_max_cmps;
+
+    sil_place(0.0f, 0.0f, 0.0f);
+    car_path_init();
+    sim_uart_tx_clear(UART_0_INST);
+    car_add_ff_calibrate();
+    car_set_loop(1);
+    sil_start_actions();
+    CHECK(sil_run_until_done(CALIB_TIMEOUT_US), "calibration finishes");
+
+    // 车上看不到 printf, 标定结果须由固件按 car_speed_ff_default 的定义报到 UART_0
+    char report[SIM_UART_TX_LOG + 1];
+    memcpy(report, UART_0_INST->tx_log, UART_0_INST->tx_len);
+    report[UART_0_INST->tx_len] = '\0';
+    CHECK(strstr(report, "const speed_ff_model_t car_speed_ff_default[motor_count] = {") != NULL &&
+          strstr(report, "};") != NULL, "calibrated map reported on UART_0");
+
+    for (int i = 0; i < motor_count; i++) {
+        const speed_ff_model_t *m = &car_speed_ff[i];
+        CHECK(m->valid, "calibration produced a model");
+        if (!m->valid) {
+            continue;
+        }
+        float m_slope = (m->pwm[m->count - 1] - m->deadband_pwm) / m->speed_cmps[m->count - 1];
+        float tau = m->accel_gain / m_slope;
+        printf("  motor %d: %d points, deadband %6.1f (model %6.1f)  slope %6.2f (%6.2f) pwm/cm/s  tau %.3fs (%.3fs)\n",
+               i, m->count, m->deadband_pwm, deadband, m_slope, slope, tau, cfg->tau_s);
+        CHECK(fabsf(m->deadband_pwm - deadband) < DEADBAND_TOL_PWM, "deadband");
+        CHECK(fabsf(m_slope - slope) < SLOPE_TOL_RATIO * slope, "pwm / speed slope");
+        CHECK(fabsf(tau - cfg->tau_s) < TAU_TOL_RATIO * cfg->tau_s, "time constant");
+    }
+}
+
+static void run_variant(const car_plant_config_t *cfg) {
+    const speed_ff_model_t none[motor_count] = {0};
+    ff_run_result_t off, on;
+
+    printf("plant: v_max %.0fcm/s tau %.3fs deadzone %.3f\n", cfg->v_max_cmps, cfg->tau_s, cfg->deadzone);
+    sil_set_plant(cfg);
+    car_apply_speed_ff(none);
+    run_cases("without feed-forward", &off);
+
+    printf(" calibration:\n");
+    calibrate(cfg);
+    run_cases("with feed-forward", &on);
+
+    printf(" straight steps %.2fs -> %.2fs, missions %.2fs -> %.2fs\n", off.step_s, on.step_s,
+           off.mission_s, on.mission_s);
+    CHECK(off.all_done && on.all_done, "all cases finish");
+    CHECK(on.step_s < off.step_s, "feed-forward shortens straight moves");
+    CHECK(on.mission_s <= off.mission_s * MISSION_SLACK, "feed-forward does not slow the missions down");
+    for (int i = 0; i < sil_mission_case_count; i++) {
+        if (on.end_err_cm[i] > off.end_err_cm[i] + END_ERR_SLACK_CM) {
+            printf("  %s: end err %.1fcm -> %.1fcm\n", sil_mission_label(&sil_mission_cases[i]),
+                   off.end_err_cm[i], on.end_err_cm[i]);
+            CHECK(false, "feed-forward does not move the mission end point further off");
+        }
+    }
+}
+
+int main(void) {
+    car_plant_config_t nominal, weak;
+
+    car_plant_default_config(&nominal);
+    weak = nominal;
+    weak.v_max_cmps *= 0.85f;
+    weak.tau_s *= 1.5f;
+    weak.deadzone *= 2.0f;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    if (sil_mission_case_count > MAX_MISSION_CASES) {
+        printf("FAIL: raise MAX_MISSION_CASES to %d\n", sil_mission_case_count);
+        return 1;
+    }
+    sil_boot(&nominal);
+    run_variant(&nominal);
+    run_variant(&weak);
+
+    return host_check_summary();
+}
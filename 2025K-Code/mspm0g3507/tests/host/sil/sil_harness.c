@@ -0,0 +1,391 @@
+/**
+ * @file sil_harness.c
+ * @brief 软件在环公共部分, 接口说明见 sil_harness.h
+ */
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "sil_harness.h"
+#include "sim_hal.h"
+#include "common_include.h"
+#include "lwpkt.h"
+#include "lwrb.h"
+
+#define CAMERA_REPLY_DELAY_US   (300ULL * 1000ULL)      // 摄像头识别耗时
+#define TRACK_START_X_CM        (-10.0f)                // 灰度排正好压在线起点
+#define GRAY_OFFSET_CM          10.0f                   // 与 car_plant_default_config() 一致
+
+static track_map_t track;
+
+// ====================  摄像头应答模型  ====================
+
+static struct {
+    lwpkt_t pkt;
+    lwrb_t tx_rb, rx_rb;
+    uint8_t tx_buf[128], rx_buf[256];
+    uint8_t reply_cmd;              // 收到 START 后回复的命令码
+    const uint8_t *reply_colors;    // 非 NULL 时随命令码回二进制圆柱识别结果, 否则只回命令消息
+    uint8_t seq;
+    bool reply_pending;
+    uint64_t reply_at_us;
+} cam;
+
+static void cam_uart_tx_hook(uint8_t byte) {
+    lwrb_write(&cam.rx_rb, &byte, 1);
+}
+
+static void cam_evt(lwpkt_t *pkt, lwpkt_evt_type_t evt) {
+    // reply_cmd 为 0 时模拟摄像头不回复
+    if (evt == LWPKT_EVT_PKT && pkt->m.len == 5 && memcmp(pkt->data, "START", 5) == 0 && cam.reply_cmd != 0) {
+        cam.reply_pending = true;
+        cam.reply_at_us = sim_time_us() + CAMERA_REPLY_DELAY_US;
+    }
+}
+
+static void cam_model_init(void) {
+    memset(&cam, 0, sizeof(cam));
+    lwrb_init(&cam.tx_rb, cam.tx_buf, sizeof(cam.tx_buf));
+    lwrb_init(&cam.rx_rb, cam.rx_buf, sizeof(cam.rx_buf));
+    lwpkt_init(&cam.pkt, &cam.tx_rb, &cam.rx_rb);
+    lwpkt_set_evt_fn(&cam.pkt, cam_evt);
+    UART_1_INST->tx_hook = cam_uart_tx_hook;
+}
+
+static void cam_model_poll(void) {
+    uint8_t frame[64];
+
+    if (lwrb_get_full(&cam.rx_rb) > 0) {
+        lwpkt_process(&cam.pkt, get_ms());
+    }
+    if (cam.reply_pending && sim_time_us() >= cam.reply_at_us) {
+        uint8_t reply[CAM_BIN_OVERHEAD + sizeof(cam_msg_cylinders_t)];
+        size_t len;
+        cam.reply_pending = false;
+        if (cam.reply_colors != NULL) {
+            cam_msg_cylinders_t result = { cam.reply_cmd, 0, { { 0, 0 } } };
+            for (int i = 0; i < CAM_CYLINDER_COUNT; i++) {
+                result.items[i].color = cam.reply_colors[i];
+                result.items[i].confidence = 100;
+            }
+            len = cam_protocol_encode(CAM_MSG_CYLINDERS, cam.seq++, &result, sizeof(result), reply, sizeof(reply));
+        } else {
+            cam_msg_command_t command = { cam.reply_cmd };
+            len = cam_protocol_encode(CAM_MSG_COMMAND, cam.seq++, &command, sizeof(command), reply, sizeof(reply));
+        }
+        lwpkt_write(&cam.pkt, reply, len);
+        size_t n = lwrb_read(&cam.tx_rb, frame, sizeof(frame));
+        sim_uart_rx(UART_1_INST, frame, n);
+    }
+}
+
+// ====================  上电与主循环  ====================
+
+void sil_boot(const car_plant_config_t *cfg) {
+    car_plant_config_t defaults;
+
+    if (cfg == NULL) {
+        car_plant_default_config(&defaults);
+        cfg = &defaults;
+    }
+    sil_clear_track();
+
+    sim_hal_reset();
+    sim_gpio_set_input(PORTB_PORT, PORTB_KEY1_PIN | PORTB_KEY2_PIN | PORTB_KEY3_PIN | PORTB_KEY4_PIN, true);
+    car_plant_attach(cfg, &track);
+    cam_model_init();
+
+    // 与 main.c 中 system_init() + main_task_init() 的顺序一致
+    SYSCFG_DL_init();
+    hal_math_init();
+    beep_init();
+    systick_init();
+    car_init();
+    wit_imu_init();
+    wit_imu_set_yaw_zero();
+    camera_init();
+    setup_cam_protocol();
+    menu_init_and_create();
+    init_task_table();
+    car_init();
+    gray_detection_init();
+    create_periodic_event_task();
+#if CAR_CONTROL_IN_ISR
+    realtime_task_start();
+#endif
+}
+
+void sil_set_plant(const car_plant_config_t *cfg) {
+    car_plant_reconfigure(cfg);
+}
+
+static void main_loop_once(void) {
+    periodic_event_task_process();
+    cam_model_poll();
+    low_power_idle();
+}
+
+void sil_run_for(uint64_t us) {
+    uint64_t end = sim_time_us() + us;
+    while (sim_time_us() < end) {
+        main_loop_once();
+    }
+}
+
+bool sil_run_until_done(uint64_t timeout_us) {
+    uint64_t end = sim_time_us() + timeout_us;
+    while (car_is_running()) {
+        if (sim_time_us() >= end) {
+            return false;
+        }
+        main_loop_once();
+    }
+    return true;
+}
+
+double sil_wall_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+void sil_place(float x_cm, float y_cm, float heading_deg) {
+    car_plant_place(x_cm, y_cm, heading_deg);
+    sil_run_for(SIL_SETTLE_US);
+}
+
+void sil_start_actions(void) {
+    car_start();
+    enable_periodic_task(EVENT_CAR_STATE_MACHINE);
+    enable_periodic_task(EVENT_CAR);
+}
+
+// ====================  比赛任务  ====================
+
+static const sil_leg_t base1_legs[] = { {0, 240}, {90, 50}, {0, 50} };
+static const sil_leg_t base2_legs[] = { {0, 70}, {46, 70}, {-46, 72}, {46, 65}, {0, 85} };
+// 顺时针 270 度 (R35) 的弦: (-35, -35); 顺时针 360 度 (R38) 回到原处
+static const sil_leg_t base3_legs[] = { {0, 115}, {-135, 49.5f}, {90, 44}, {0, 205} };
+static const sil_leg_t play1_legs[] = { {0, 90}, {90, 95}, {0, 100}, {-90, 42}, {0, 100} };
+static const sil_leg_t path1_legs[] = { {0, 87}, {90, 45}, {0, 48}, {90, 50}, {0, 95}, {-90, 60}, {0, 70} };
+static const sil_leg_t path2_legs[] = { {0, 97}, {90, 100}, {0, 95}, {-90, 50}, {0, 90} };
+static const sil_leg_t path3_legs[] = { {0, 142}, {-90, 50}, {0, 100}, {90, 100}, {0, 70} };
+static const sil_leg_t path4_legs[] = { {0, 85}, {-90, 50}, {0, 103}, {90, 50}, {0, 50}, {90, 57}, {0, 80} };
+// 车上规划: 名义路线取起点到 TASK25K_PART2_GOAL 的弦, 终点航向为规划路线最后一段的方向
+static const sil_leg_t planned_legs[] = { {9.46f, 304.1f} };
+static const uint8_t planned_colors[CAM_CYLINDER_COUNT] = { 0, 1, 1, 1, 1, 1 };     // (1,1) 白, 命令字 0x01
+
+#define LEGS(a)     a, (int)(sizeof(a) / sizeof(a[0]))
+
+const sil_mission_case_t sil_mission_cases[] = {
+    { TASK25K_BASE_PART1, 0,    LEGS(base1_legs), 0, NULL },
+    { TASK25K_BASE_PART2, 0,    LEGS(base2_legs), 0, NULL },
+    { TASK25K_BASE_PART3, 0,    LEGS(base3_legs), 0, NULL },
+    { TASK25K_PLAY_PART1, 0,    LEGS(play1_legs), 0, NULL },
+    { TASK25K_PLAY_PART2, 0x01, LEGS(path1_legs), 0, NULL },
+    { TASK25K_PLAY_PART2, 0x02, LEGS(path2_legs), 0, NULL },
+    { TASK25K_PLAY_PART2, 0x03, LEGS(path3_legs), 0, NULL },
+    { TASK25K_PLAY_PART2, 0x04, LEGS(path4_legs), 0, NULL },
+    { TASK25K_PLAY_PART2, 0x01, LEGS(planned_legs), 12.4f, planned_colors },
+};
+
+const int sil_mission_case_count = (int)(sizeof(sil_mission_cases) / sizeof(sil_mission_cases[0]));
+
+static float wrap_deg(float deg) {
+    deg = fmodf(deg, 360.0f);
+    if (deg > 180.0f) {
+        deg -= 360.0f;
+    } else if (deg <= -180.0f) {
+        deg += 360.0f;
+    }
+    return deg;
+}
+
+const char *sil_mission_label(const sil_mission_case_t *mc) {
+    static char label[32];
+    if (mc->mission == TASK25K_PLAY_PART2 && mc->camera_cmd == 0) {
+        snprintf(label, sizeof(label), "%s (no reply)", task25k_mission_name(mc->mission));
+    } else if (mc->mission == TASK25K_PLAY_PART2 && mc->camera_colors != NULL) {
+        snprintf(label, sizeof(label), "%s (planned)", task25k_mission_name(mc->mission));
+    } else if (mc->mission == TASK25K_PLAY_PART2) {
+        snprintf(label, sizeof(label), "%s (C:0x%02X)", task25k_mission_name(mc->mission), mc->camera_cmd);
+    } else {
+        snprintf(label, sizeof(label), "%s", task25k_mission_name(mc->mission));
+    }
+    return label;
+}
+
+/**
+ * @brief 航向越过目标角的幅度: 每次 car.target_angle 改变时记下误差方向, 之后误差反号的部分计为超调
+ */
+typedef struct {
+    float target;
+    int sign;
+    float max_overshoot;
+} overshoot_monitor_t;
+
+static void overshoot_sample(overshoot_monitor_t *m) {
+    if (car.state == CAR_STATE_CIRCLE) {
+        m->sign = 0;                    // 绕圈不跟踪目标角, 之后重新记方向
+        return;
+    }
+    float err = wrap_deg(car.target_angle - jy61p.yaw);
+    if (car.target_angle != m->target || m->sign == 0) {
+        m->target = car.target_angle;
+        m->sign = (fabsf(err) < 1.0f) ? 0 : (err > 0.0f ? 1 : -1);
+        return;
+    }
+    if (err * (float)m->sign < 0.0f) {
+        m->max_overshoot = fmaxf(m->max_overshoot, fabsf(err));
+    }
+}
+
+static const int16_t cylinder_pos_cm[CAM_CYLINDER_COUNT][2] = TASK25K_CYLINDER_POS_CM;
+
+static float cylinder_gap(const car_plant_state_t *st) {
+    float gap = INFINITY;
+    for (int i = 0; i < CAM_CYLINDER_COUNT; i++) {
+        gap = fminf(gap, hypotf(st->x_cm - cylinder_pos_cm[i][0], st->y_cm - cylinder_pos_cm[i][1]));
+    }
+    return gap;
+}
+
+void sil_run_mission(const sil_mission_case_t *mc, sil_mission_result_t *result) {
+    overshoot_monitor_t monitor = { 0.0f, 0, 0.0f };
+    const car_plant_state_t *st = car_plant_state();
+    float gap = INFINITY;
+    float nx = 0.0f, ny = 0.0f, total = 0.0f;
+
+    for (int i = 0; i < mc->leg_count; i++) {
+        float h = mc->legs[i].heading_deg * (float)M_PI / 180.0f;
+        nx += mc->legs[i].length_cm * cosf(h);
+        ny += mc->legs[i].length_cm * sinf(h);
+        total += mc->legs[i].length_cm;
+    }
+
+    sil_place(0.0f, 0.0f, 0.0f);
+    maix_cam.num = 0;
+    maix_cam.cmd = 0;
+    maix_cam.obstacle_count = 0;
+    maix_cam.cylinders_valid = 0;
+    cam.reply_cmd = mc->camera_cmd;
+    cam.reply_colors = mc->camera_colors;
+
+    uint64_t t0 = sim_time_us();
+    uint64_t end = t0 + SIL_MISSION_TIMEOUT_US;
+    double w0 = sil_wall_seconds();
+    run_task25k_mission(mc->mission);
+    result->done = true;
+    while (car_is_running()) {
+        if (sim_time_us() >= end) {
+            result->done = false;
+            break;
+        }
+        main_loop_once();
+        overshoot_sample(&monitor);
+        if (mc->mission == TASK25K_PLAY_PART2) {
+            gap = fminf(gap, cylinder_gap(st));
+        }
+    }
+    result->sim_s = (double)(sim_time_us() - t0) * 1e-6;
+    result->wall_s = sil_wall_seconds() - w0;
+
+    result->nominal_x = nx;
+    result->nominal_y = ny;
+    result->path_cm = total;
+    result->pos_err_cm = hypotf(st->x_cm - nx, st->y_cm - ny);
+    result->heading_err_deg = wrap_deg(st->heading_deg - mc->final_heading_deg);
+    result->heading_overshoot_deg = monitor.max_overshoot;
+    result->pose_err_cm = hypotf(car_pose.x - st->x_cm, car_pose.y - st->y_cm);
+    result->cylinder_gap_cm = gap;
+}
+
+// ====================  目标点  ====================
+
+void sil_run_goto(const float (*points)[2], int count, sil_goto_result_t *result) {
+    const car_plant_state_t *st = car_plant_state();
+
+    sil_place(0.0f, 0.0f, 0.0f);
+    car_path_init();
+    for (int i = 0; i < count; i++) {
+        car_add_goto(points[i][0], points[i][1]);
+    }
+    car_set_loop(1);
+    sil_start_actions();
+
+    uint64_t t0 = sim_time_us();
+    uint8_t last_phase = 0;
+    int reached = 0;
+    result->max_err_cm = 0.0f;
+    result->max_pose_err_cm = 0.0f;
+    while (car_is_running() && sim_time_us() - t0 < SIL_MISSION_TIMEOUT_US) {
+        main_loop_once();
+        // 直行阶段结束 (goto_phase 2 -> 0) 即到达一个目标点
+        if (last_phase == 2 && car.goto_phase == 0 && reached < count) {
+            result->max_err_cm = fmaxf(result->max_err_cm,
+                                       hypotf(st->x_cm - points[reached][0], st->y_cm - points[reached][1]));
+            result->max_pose_err_cm = fmaxf(result->max_pose_err_cm,
+                                            hypotf(st->x_cm - car_pose.x, st->y_cm - car_pose.y));
+            reached++;
+        }
+        last_phase = car.goto_phase;
+    }
+    result->done = !car_is_running() && reached == count;
+    result->sim_s = (double)(sim_time_us() - t0) * 1e-6;
+}
+
+// ====================  循迹  ====================
+
+void sil_place_on_track(void) {
+    track_map_init(&track, 1.8f);
+    track_map_begin(&track, 0.0f, 0.0f);
+    track_map_line_to(&track, 30.0f, 0.0f);
+    track_map_add_arc(&track, 60.0f, 40.0f);
+    track_map_add_arc(&track, 60.0f, -40.0f);
+    track_map_add_arc(&track, 80.0f, -30.0f);
+    track_map_line_to(&track, 400.0f, -80.0f);
+
+    sil_place(TRACK_START_X_CM, 0.0f, 0.0f);
+}
+
+void sil_place_on_line(void) {
+    track_map_init(&track, 1.8f);
+    track_map_begin(&track, 0.0f, 0.0f);
+    track_map_line_to(&track, 400.0f, 0.0f);
+
+    sil_place(TRACK_START_X_CM, 0.0f, 0.0f);
+}
+
+void sil_run_track(sil_track_result_t *result) {
+    const car_plant_state_t *st = car_plant_state();
+
+    sil_place_on_track();
+    car_path_init();
+    car_add_track(150);
+    car_set_loop(1);
+    sil_start_actions();
+
+    uint64_t t0 = sim_time_us();
+    double w0 = sil_wall_seconds();
+    result->max_offset_cm = 0.0f;
+    while (car_is_running() && sim_time_us() - t0 < SIL_MISSION_TIMEOUT_US) {
+        periodic_event_task_process();
+        low_power_idle();
+
+        float h = st->heading_deg * (float)M_PI / 180.0f;
+        float offset = track_map_distance(&track, st->x_cm + GRAY_OFFSET_CM * cosf(h),
+                                          st->y_cm + GRAY_OFFSET_CM * sinf(h));
+        result->max_offset_cm = fmaxf(result->max_offset_cm, offset);
+    }
+    result->done = !car_is_running();
+    result->sim_s = (double)(sim_time_us() - t0) * 1e-6;
+    result->wall_s = sil_wall_seconds() - w0;
+    result->distance_cm = st->distance_cm;
+
+    // 地图清空, 之后的比赛任务不受黑线影响
+    sil_clear_track();
+}
+
+void sil_clear_track(void) {
+    track_map_init(&track, 1.8f);
+}
@@ -0,0 +1,126 @@
+/**
+ * @file sil_harness.h
+ * @brief 软件在环公共部分: 按 main.c 顺序上电、摄像头应答模型、主循环推进、比赛任务与循迹用例
+ *
+ * sil_missions (回归检查) 与 pid_tuner (参数整定) 共用. 所有用例在同一次上电内顺序执行,
+ * 每个用例开始前把小车放回起点.
+ */
+#ifndef SIL_HARNESS_H__
+#define SIL_HARNESS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "car_plant.h"
+#include "track_map.h"
+#include "task25k_config.h"
+
+#define SIL_MISSION_TIMEOUT_US      (90ULL * 1000000ULL)
+#define SIL_SETTLE_US               (300ULL * 1000ULL)      // 放车后等待 IMU 帧刷新
+
+// 名义路线: 按目标航向拼接的直线段 (圆弧用弦代替), 只用于估计终点
+typedef struct {
+    float heading_deg;
+    float length_cm;
+} sil_leg_t;
+
+typedef struct {
+    task25k_mission_t mission;
+    uint8_t camera_cmd;             // 仅 Play Part 2 使用, 0 = 摄像头不回复
+    const sil_leg_t *legs;
+    int leg_count;
+    float final_heading_deg;
+    const uint8_t *camera_colors;   // 非 NULL: 回二进制识别结果 (六个圆柱的颜色 + 命令字), 车上规划路线; NULL: 只回命令字
+} sil_mission_case_t;
+
+typedef struct {
+    bool done;                      // 超时前结束
+    double sim_s;
+    double wall_s;
+    float nominal_x, nominal_y;     // 名义终点
+    float path_cm;                  // 名义总路程
+    float pos_err_cm;               // 终点与名义终点的距离
+    float heading_err_deg;          // 终点航向误差
+    float heading_overshoot_deg;    // 航向越过目标角的最大值 (每次目标角改变后计, 绕圈段除外)
+    float pose_err_cm;              // 终点处 car_pose 估计与真实位置的距离
+    float cylinder_gap_cm;          // Play Part 2: 车体中心离 TASK25K_CYLINDER_POS_CM 各圆柱中心的最近距离
+} sil_mission_result_t;
+
+typedef struct {
+    bool done;
+    double sim_s;
+    double wall_s;
+    float distance_cm;
+    float max_offset_cm;            // 灰度排中心离线的最大距离
+} sil_track_result_t;
+
+extern const sil_mission_case_t sil_mission_cases[];
+extern const int sil_mission_case_count;
+
+/**
+ * @brief 复位仿真 HAL, 挂上小车模型和摄像头模型, 按 main.c 的顺序初始化固件
+ * @param cfg 小车模型参数, NULL 为 car_plant_default_config()
+ * @note 每个进程只能调用一次: 固件的静态变量 (状态机、实时层注册等) 不会随 sim_hal_reset() 复位
+ */
+void sil_boot(const car_plant_config_t *cfg);
+
+/**
+ * @brief 上电后更换小车模型参数, 见 car_plant_reconfigure()
+ */
+void sil_set_plant(const car_plant_config_t *cfg);
+
+void sil_run_for(uint64_t us);
+
+/**
+ * @brief 跑到状态机结束或超时
+ * @return 是否在超时前结束
+ */
+bool sil_run_until_done(uint64_t timeout_us);
+
+/**
+ * @brief 静止放车并等待 IMU 刷新
+ */
+void sil_place(float x_cm, float y_cm, float heading_deg);
+
+/**
+ * @brief 用状态机启动一组动作 (调用前先 car_path_init() 并添加动作)
+ */
+void sil_start_actions(void);
+
+void sil_run_mission(const sil_mission_case_t *mc, sil_mission_result_t *result);
+
+typedef struct {
+    bool done;
+    double sim_s;
+    float max_err_cm;               // 各目标点处真实位置与目标点的最大距离
+    float max_pose_err_cm;          // 各目标点处 car_pose 估计的最大误差
+} sil_goto_result_t;
+
+/**
+ * @brief 用 car_add_goto() 依次驶过一组目标点 (car_start() 时的坐标系), 每到一点记一次误差
+ */
+void sil_run_goto(const float (*points)[2], int count, sil_goto_result_t *result);
+
+/**
+ * @brief 在 S 形黑线上循迹 150cm
+ */
+void sil_run_track(sil_track_result_t *result);
+
+/**
+ * @brief 在地图上铺 S 形黑线, 并把小车放到灰度排压在线起点的位置
+ */
+void sil_place_on_track(void);
+
+/**
+ * @brief 在地图上铺一条 4m 长的直黑线, 小车放在线起点 (循迹环整定用)
+ */
+void sil_place_on_line(void);
+
+/**
+ * @brief 清空黑线 (上电后地图为空)
+ */
+void sil_clear_track(void);
+
+const char *sil_mission_label(const sil_mission_case_t *mc);
+double sil_wall_seconds(void);
+
+#endif
@@ -0,0 +1,210 @@
+/**
+ * @file sil_missions.c
+ * @brief 软件在环: 在差速小车模型上无界面地跑 25K 的比赛任务并计时
+ *
+ * 固件按 main.c 的顺序上电, car_plant 提供电机/编码器/陀螺仪/灰度的闭环响应, 摄像头由 sil_harness.c
+ * 里的一个 lwpkt 应答模型代替 (收到 "START" 后回命令字 0xNN, 或带六个圆柱颜色的二进制识别结果). 每个任务开始前把小车放回原点、航向 0,
+ * 然后循环 periodic_event_task_process() + low_power_idle() 直到 car_is_running() 变为 false.
+ *
+ * 检查项 (宽松, 只判断闭环是否正常): 任务在超时前完成; 终点航向与脚本一致; 终点位置与按脚本
+ * 直线段拼接出的名义终点相差不超过总路程的一定比例; 终点处全局位姿估计 (car_pose) 与真实位置相差不超过
+ * 总路程的 3%. 另外按全局坐标用 car_add_goto() 走一个矩形, 并在一条 S 形黑线上跑一次循迹.
+ * 摄像头不回复时 Play Part 2 应在超时后按 TASK25K_PART2_FALLBACK_CMD 的路线跑完. 只收到命令字时 Play Part 2
+ * 走对应的固定路线; 收到圆柱颜色时走车上规划的路线, 且离各圆柱不小于规划保证的间距.
+ *
+ * 每个任务另输出状态机的动作耗时统计: 有计划耗时的动作 (S 形曲线、延时) 的计划与实际合计,
+ * 以及超出计划最多的动作, 用来找拖慢整趟的环节.
+ *
+ * 运行: ctest --test-dir build -R sil_missions -V   (输出每个任务的仿真时间、耗时和加速比)
+ */
+#include <stdio.h>
+#include <math.h>
+#include "sil_harness.h"
+#include "sim_hal.h"
+#include "car_controller.h"
+#include "car_state_machine.h"
+#include "grid_planner.h"
+#include "host_check.h"
+
+#define HEADING_TOL_DEG         5.0f
+#define POSITION_TOL_RATIO      0.08f                   // 终点误差 / 总路程
+#define POSE_TOL_RATIO          0.03f                   // 位姿估计误差 / 总路程
+#define GOTO_TOL_CM             5.0f
+// 规划路线保证的间距 (避让半径减半个格子) 再留 1cm 跟踪误差; 固定路线由纯追踪切角, 只输出不检查
+#define CYLINDER_GAP_CM         (GRID_PLANNER_CLEARANCE_WHITE_CM - GRID_PLANNER_CELL_CM / 2 - 1.0f)
+#define FORK_JOIN_LEG_CM        50.0f
+#define FORK_JOIN_TOL_CM        5.0f
+#define FORK_JOIN_WAIT_US       (4ULL * 1000000ULL)     // 远长于第一段直线的耗时
+
+static void print_action_stats(void) {
+    uint8_t count;
+    const car_action_stat_t *stats = car_action_stats(&count);
+    uint32_t planned = 0, actual = 0, unplanned = 0;
+    int worst = -1, worst_over = 0, aborted = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (stats[i].result != CAR_ACTION_DONE) {
+            aborted++;
+        }
+        if (stats[i].planned_ms == 0) {
+            unplanned += stats[i].actual_ms;
+            continue;
+        }
+        planned += stats[i].planned_ms;
+        actual += stats[i].actual_ms;
+        int over = (int)stats[i].actual_ms - (int)stats[i].planned_ms;
+        if (worst < 0 || over > worst_over) {
+            worst = i;
+            worst_over = over;
+        }
+    }
+    printf("%-24s %2d actions  profiled plan %5.2fs real %5.2fs  other %5.2fs  aborted %d", "",
+           count, planned * 1e-3, actual * 1e-3, unplanned * 1e-3, aborted);
+    if (worst >= 0) {
+        printf("  worst %+dms (#%d type %d)", worst_over, stats[worst].index, stats[worst].type);
+    }
+    printf("\n");
+}
+
+static void run_mission_case(const sil_mission_case_t *mc) {
+    sil_mission_result_t r;
+    const car_plant_state_t *st = car_plant_state();
+
+    sil_run_mission(mc, &r);
+    printf("%-24s sim %6.2fs  wall %7.3fs  x%-8.0f end (%6.1f, %6.1f) %6.1fdeg  nominal (%6.1f, %6.1f)  err %5.1fcm"
+           "  pose err %4.1fcm\n",
+           sil_mission_label(mc), r.sim_s, r.wall_s, r.wall_s > 0 ? r.sim_s / r.wall_s : 0.0,
+           st->x_cm, st->y_cm, st->heading_deg, r.nominal_x, r.nominal_y, r.pos_err_cm, r.pose_err_cm);
+    print_action_stats();
+
+    CHECK(r.done, "mission finishes before timeout");
+    CHECK(fabsf(r.heading_err_deg) <= HEADING_TOL_DEG, "final heading");
+    CHECK(r.pos_err_cm <= POSITION_TOL_RATIO * r.path_cm, "final position near nominal end point");
+    CHECK(r.pose_err_cm <= POSE_TOL_RATIO * r.path_cm, "pose estimate follows the car");
+
+    if (mc->mission == TASK25K_PLAY_PART2 && mc->camera_cmd != 0) {
+        uint8_t route = task25k_part2_route();
+        printf("%-24s route %d  closest cylinder %.1fcm\n", "", route, r.cylinder_gap_cm);
+        if (mc->camera_colors != NULL) {
+            CHECK(route == TASK25K_PART2_ROUTE_PLANNED, "cylinder colours select the planned route");
+            CHECK(r.cylinder_gap_cm >= CYLINDER_GAP_CM, "planned route keeps clear of the cylinders");
+        } else {
+            CHECK(route == mc->camera_cmd - 1, "command selects the fixed route");
+        }
+    }
+}
+
+/**
+ * @brief 摄像头不回复: JOIN 超时后走恢复子程序, 按默认命令字的路线跑完
+ */
+static void run_camera_timeout_case(void) {
+    for (int i = 0; i < sil_mission_case_count; i++) {
+        const sil_mission_case_t *mc = &sil_mission_cases[i];
+        if (mc->mission == TASK25K_PLAY_PART2 && mc->camera_cmd == TASK25K_PART2_FALLBACK_CMD) {
+            sil_mission_case_t silent = *mc;
+            silent.camera_cmd = 0;
+            run_mission_case(&silent);
+
+            uint8_t count;
+            const car_action_stat_t *stats = car_action_stats(&count);
+            bool timed_out = false;
+            for (uint8_t j = 0; j < count; j++) {
+                timed_out |= (stats[j].type == ACTION_JOIN && stats[j].result == CAR_ACTION_TIMEOUT &&
+                              stats[j].actual_ms >= TASK25K_CAM_TIMEOUT_MS);
+            }
+            CHECK(timed_out, "camera wait ends with a timeout");
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 按全局坐标走一个 1m x 0.8m 的矩形回到起点, 每个角点误差不超过 GOTO_TOL_CM
+ */
+static void run_goto_case(void) {
+    static const float points[][2] = { {100, 0}, {100, 80}, {0, 80}, {0, 0} };
+    sil_goto_result_t r;
+    const car_plant_state_t *st = car_plant_state();
+
+    sil_run_goto(points, (int)(sizeof(points) / sizeof(points[0])), &r);
+    printf("%-24s sim %6.2fs  end (%6.1f, %6.1f) %6.1fdeg  pose (%6.1f, %6.1f)  max err %.1fcm  pose err %.1fcm\n",
+           "Go-to rectangle", r.sim_s, st->x_cm, st->y_cm, st->heading_deg, car_pose.x, car_pose.y,
+           r.max_err_cm, r.max_pose_err_cm);
+
+    CHECK(r.done, "go-to sequence finishes");
+    CHECK(r.max_err_cm <= GOTO_TOL_CM, "reaches every waypoint");
+    CHECK(r.max_pose_err_cm <= GOTO_TOL_CM, "pose estimate at the waypoints");
+}
+
+static bool fork_gate;
+
+static bool fork_gate_open(void) {
+    return fork_gate;
+}
+
+static const car_action_t fork_wait_actions[] = { CAR_ACT_WAIT_TRUE(fork_gate_open) };
+static const car_program_t fork_wait_program = CAR_PROGRAM(fork_wait_actions);
+
+/**
+ * @brief 直线 -> FORK -> JOIN -> 直线: 直线段不能融合穿过 JOIN, 后台没结束时小车停在第一段终点等待
+ */
+static void run_fork_join_case(void) {
+    const car_plant_state_t *st = car_plant_state();
+
+    sil_place(0.0f, 0.0f, 0.0f);
+    fork_gate = false;
+    car_path_init();
+    car_add_turn(0.0f);                 // 上一个用例结束时的目标航向不是 0
+    car_add_straight(FORK_JOIN_LEG_CM);
+    car_add_fork(&fork_wait_program);
+    car_add_join(0);
+    car_add_straight(FORK_JOIN_LEG_CM);
+    car_set_loop(1);
+    sil_start_actions();
+
+    sil_run_for(FORK_JOIN_WAIT_US);
+    float wait_x = st->x_cm;
+    float wait_speed = fabsf(st->wheel_cmps[0]) + fabsf(st->wheel_cmps[1]);
+    fork_gate = true;
+    bool done = sil_run_until_done(SIL_MISSION_TIMEOUT_US);
+    printf("%-24s waiting at %6.1fcm (%4.1fcm/s)  end %6.1fcm\n", "Straight-fork-join", wait_x, wait_speed,
+           st->x_cm);
+
+    CHECK(fabsf(wait_x - FORK_JOIN_LEG_CM) <= FORK_JOIN_TOL_CM && wait_speed < 1.0f,
+          "car stops at the join while the background runs");
+    CHECK(done && fabsf(st->x_cm - 2.0f * FORK_JOIN_LEG_CM) <= FORK_JOIN_TOL_CM, "second leg runs after the join");
+}
+
+/**
+ * @brief 在 S 形黑线上循迹 150cm, 灰度排中心离线不超过 4cm (8 路探头半宽 5.25cm)
+ */
+static void run_track_case(void) {
+    sil_track_result_t r;
+    const car_plant_state_t *st = car_plant_state();
+
+    sil_run_track(&r);
+    printf("%-24s sim %6.2fs  wall %7.3fs  x%-8.0f end (%6.1f, %6.1f) %6.1fdeg  max line offset %.2fcm\n",
+           "Track S-curve", r.sim_s, r.wall_s, r.wall_s > 0 ? r.sim_s / r.wall_s : 0.0, st->x_cm, st->y_cm,
+           st->heading_deg, r.max_offset_cm);
+
+    CHECK(r.done, "track action finishes");
+    CHECK(r.distance_cm > 140.0f, "travelled the requested distance");
+    CHECK(r.max_offset_cm < 4.0f, "sensor bar stays on the line");
+}
+
+int main(void) {
+    double w0 = sil_wall_seconds();
+
+    sil_boot(NULL);
+    for (int i = 0; i < sil_mission_case_count; i++) {
+        run_mission_case(&sil_mission_cases[i]);
+    }
+    run_camera_timeout_case();
+    run_goto_case();
+    run_fork_join_case();
+    run_track_case();
+
+    printf("total: sim %.1fs, wall %.3fs\n", (double)sim_time_us() * 1e-6, sil_wall_seconds() - w0);
+
+    return host_check_summary();
+}
@@ -0,0 +1,97 @@
+/**
+ * @file track_map.c
+ * @brief 场地黑线地图, 接口说明见 track_map.h
+ */
+#include <math.h>
+#include <string.h>
+#include "track_map.h"
+
+#define ARC_STEP_DEG        3.0f        // 圆弧离散步长, 半径 100cm 时弦高约 0.03cm
+
+void track_map_init(track_map_t *map, float line_width_cm) {
+    memset(map, 0, sizeof(*map));
+    map->line_width_cm = line_width_cm;
+}
+
+bool track_map_begin(track_map_t *map, float x, float y) {
+    if (map->line_count >= TRACK_MAP_MAX_LINES || map->point_count >= TRACK_MAP_MAX_POINTS) {
+        return false;
+    }
+    track_polyline_t *line = &map->lines[map->line_count++];
+    line->first = map->point_count;
+    line->count = 1;
+    map->points[map->point_count++] = (track_point_t){ x, y };
+    return true;
+}
+
+bool track_map_line_to(track_map_t *map, float x, float y) {
+    if (map->line_count == 0 || map->point_count >= TRACK_MAP_MAX_POINTS) {
+        return false;
+    }
+    map->lines[map->line_count - 1].count++;
+    map->points[map->point_count++] = (track_point_t){ x, y };
+    return true;
+}
+
+bool track_map_add_arc(track_map_t *map, float radius_cm, float sweep_deg) {
+    if (map->line_count == 0) {
+        return false;
+    }
+    const track_polyline_t *line = &map->lines[map->line_count - 1];
+    const track_point_t *end = &map->points[line->first + line->count - 1];
+    float heading = 0.0f;
+
+    if (line->count >= 2) {
+        const track_point_t *prev = end - 1;
+        heading = atan2f(end->y - prev->y, end->x - prev->x);
+    }
+
+    // 圆心在行进方向的左侧 (左转) 或右侧 (右转)
+    float side = (sweep_deg >= 0.0f) ? 1.0f : -1.0f;
+    float cx = end->x - side * radius_cm * sinf(heading);
+    float cy = end->y + side * radius_cm * cosf(heading);
+    float start = atan2f(end->y - cy, end->x - cx);
+
+    int steps = (int)ceilf(fabsf(sweep_deg) / ARC_STEP_DEG);
+    for (int i = 1; i <= steps; i++) {
+        float a = start + (sweep_deg * (float)M_PI / 180.0f) * (float)i / (float)steps;
+        if (!track_map_line_to(map, cx + radius_cm * cosf(a), cy + radius_cm * sinf(a))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static float segment_distance(const track_point_t *a, const track_point_t *b, float x, float y) {
+    float dx = b->x - a->x;
+    float dy = b->y - a->y;
+    float len2 = dx * dx + dy * dy;
+    float t = 0.0f;
+
+    if (len2 > 0.0f) {
+        t = ((x - a->x) * dx + (y - a->y) * dy) / len2;
+        t = (t < 0.0f) ? 0.0f : (t > 1.0f) ? 1.0f : t;
+    }
+    return hypotf(a->x + t * dx - x, a->y + t * dy - y);
+}
+
+float track_map_distance(const track_map_t *map, float x, float y) {
+    float best = 1e9f;
+
+    for (uint16_t l = 0; l < map->line_count; l++) {
+        const track_polyline_t *line = &map->lines[l];
+        const track_point_t *p = &map->points[line->first];
+        if (line->count == 1) {
+            best = fminf(best, hypotf(p->x - x, p->y - y));
+            continue;
+        }
+        for (uint16_t i = 0; i + 1 < line->count; i++) {
+            best = fminf(best, segment_distance(&p[i], &p[i + 1], x, y));
+        }
+    }
+    return best;
+}
+
+bool track_map_is_black(const track_map_t *map, float x, float y) {
+    return track_map_distance(map, x, y) <= map->line_width_cm * 0.5f;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file track_map.h
+ * @brief 场地黑线地图: 若干条折线 + 统一线宽, 供灰度传感器模型查询
+ *
+ * 坐标系与 car_plant.h 一致: 单位 cm, 发车点为原点, x 沿发车方向, y 指向车身左侧.
+ * 圆弧用折线近似, 见 track_map_add_arc().
+ */
+#ifndef TRACK_MAP_H__
+#define TRACK_MAP_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef TRACK_MAP_MAX_POINTS
+#define TRACK_MAP_MAX_POINTS        512
+#endif
+
+#ifndef TRACK_MAP_MAX_LINES
+#define TRACK_MAP_MAX_LINES         16
+#endif
+
+typedef struct {
+    float x, y;
+} track_point_t;
+
+typedef struct {
+    uint16_t first;                 // 在 points[] 中的起始下标
+    uint16_t count;
+} track_polyline_t;
+
+typedef struct {
+    track_point_t points[TRACK_MAP_MAX_POINTS];
+    uint16_t point_count;
+    track_polyline_t lines[TRACK_MAP_MAX_LINES];
+    uint16_t line_count;
+    float line_width_cm;
+} track_map_t;
+
+/**
+ * @brief 清空地图
+ * @param line_width_cm 黑线宽度 (赛道胶带一般 1.8cm)
+ */
+void track_map_init(track_map_t *map, float line_width_cm);
+
+/**
+ * @brief 开始一条新折线, 起点为 (x, y)
+ * @return false 表示折线或点数已满
+ */
+bool track_map_begin(track_map_t *map, float x, float y);
+
+/**
+ * @brief 当前折线延伸到 (x, y)
+ */
+bool track_map_line_to(track_map_t *map, float x, float y);
+
+/**
+ * @brief 当前折线沿圆弧延伸
+ * @param radius_cm 半径
+ * @param sweep_deg 扫过的角度, 正值向左 (逆时针) 转, 负值向右转
+ * @note 圆弧与当前最后一段相切; 当前折线只有一个点时按 x 正方向出发
+ */
+bool track_map_add_arc(track_map_t *map, float radius_cm, float sweep_deg);
+
+/**
+ * @brief 点 (x, y) 到最近黑线中心的距离, 地图为空时返回一个很大的值
+ */
+float track_map_distance(const track_map_t *map, float x, float y);
+
+/**
+ * @brief 点 (x, y) 是否落在黑线上
+ */
+bool track_map_is_black(const track_map_t *map, float x, float y);
+
+#endif
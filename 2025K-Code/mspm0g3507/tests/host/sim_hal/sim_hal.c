@@ -0,0 +1,356 @@
+/**
+ * @file sim_hal.c
+ * @brief 主机仿真 HAL: 外设 "寄存器" 实例、虚拟时钟、中断注入
+ * @note 替代目标板上的 systick.c / hal_timer.c / ti_msp_dl_config.c, 接口说明见 sim_hal.h
+ */
+#include <string.h>
+#include "sim_hal.h"
+#include "systick.h"
+#include "hal_timer.h"
+
+#define SIM_WEAK                __attribute__((weak))
+
+#define CYCLES_PER_US           (CPUCLK_FREQ / 1000000U)
+#define CYCLES_PER_MS           (CPUCLK_FREQ / 1000U)
+
+// 中断处理函数 (mspm0g3507_it.c)
+void UART_0_INST_IRQHandler(void);
+void UART_1_INST_IRQHandler(void);
+void GROUP1_IRQHandler(void);
+void CONTROL_TIMER_INST_IRQHandler(void);
+
+GPIO_Regs sim_gpioa, sim_gpiob;
+UART_Regs sim_uart0, sim_uart3;
+GPTIMER_Regs sim_tima0, sim_timg0, sim_timg7, sim_timg8;
+SPI_Regs sim_spi1;
+ADC12_Regs sim_adc0;
+DMA_Regs sim_dma;
+
+// 可挂起的中断源
+enum {
+    SIM_IRQ_UART0   = 1u << 0,
+    SIM_IRQ_UART3   = 1u << 1,
+    SIM_IRQ_GROUP1  = 1u << 2,
+    SIM_IRQ_CONTROL = 1u << 3,
+};
+
+static uint64_t sim_cycles;
+static uint32_t sim_primask;
+static uint32_t irq_pending;
+static uint32_t irq_active;         // 正在执行的中断, 同一中断不嵌套
+
+// 控制定时器: 周期与下一次到期时刻 (周期数)
+static uint64_t control_period_cycles;
+static uint64_t control_next_cycles;
+static bool control_irq_flag;
+
+// 外部模型节拍 (被控对象仿真), 不是中断, 不受 PRIMASK 影响
+static void (*tick_hook)(void);
+static uint64_t tick_period_cycles;
+static uint64_t tick_next_cycles;
+
+static bool wfi_sleeping;           // 正在 __WFI 中睡眠
+static bool wfi_woken;              // 睡眠期间有中断执行过
+
+// ====================  中断分发  ====================
+
+static void dispatch_pending(void) {
+    static const struct {
+        uint32_t mask;
+        void (*handler)(void);
+    } irq_table[] = {
+        { SIM_IRQ_GROUP1,  GROUP1_IRQHandler },         // 优先级与目标板一致: 编码器/串口先于控制定时器
+        { SIM_IRQ_UART0,   UART_0_INST_IRQHandler },
+        { SIM_IRQ_UART3,   UART_1_INST_IRQHandler },
+        { SIM_IRQ_CONTROL, CONTROL_TIMER_INST_IRQHandler },
+    };
+
+    bool again = true;
+    while (again && sim_primask == 0) {
+        again = false;
+        for (size_t i = 0; i < sizeof(irq_table) / sizeof(irq_table[0]); i++) {
+            uint32_t mask = irq_table[i].mask;
+            if ((irq_pending & mask) && !(irq_active & mask)) {
+                irq_pending &= ~mask;
+                irq_active |= mask;
+                irq_table[i].handler();
+                irq_active &= ~mask;
+                wfi_woken = true;
+                // 串口接收中断是电平触发: FIFO 里还有数据时再次挂起
+                if ((mask == SIM_IRQ_UART0 && sim_uart_pending_mask(&sim_uart0) != 0) ||
+                    (mask == SIM_IRQ_UART3 && sim_uart_pending_mask(&sim_uart3) != 0)) {
+                    irq_pending |= mask;
+                }
+                again = true;
+                break;
+            }
+        }
+    }
+}
+
+static void raise_irq(uint32_t mask) {
+    irq_pending |= mask;
+    dispatch_pending();
+}
+
+SIM_WEAK void sim_disable_irq(void) {
+    sim_primask = 1;
+}
+
+SIM_WEAK void sim_enable_irq(void) {
+    sim_primask = 0;
+    dispatch_pending();
+}
+
+SIM_WEAK uint32_t sim_get_primask(void) {
+    return sim_primask;
+}
+
+SIM_WEAK void sim_set_primask(uint32_t primask) {
+    sim_primask = primask & 1u;
+    dispatch_pending();
+}
+
+/**
+ * @brief 睡眠到下一个定时器事件; 没有定时器在运行时睡 1ms (对应 SysTick). 任一中断执行后立即唤醒
+ * @note 固件按 __disable_irq(); __WFI(); __enable_irq(); 的惯用法睡眠, 硬件上挂起的中断先唤醒 WFI,
+ *       开中断后立刻进入处理函数. 这里在睡眠期间直接放开 PRIMASK 分发中断, 效果相同;
+ *       否则同一个模型节拍里的多个编码器边沿会被合并成一次挂起而丢计数.
+ */
+SIM_WEAK void sim_wfi(void) {
+    uint32_t saved_primask = sim_primask;
+    uint64_t target = sim_cycles + CYCLES_PER_MS;
+
+    if (control_period_cycles != 0 && control_next_cycles < target) {
+        target = control_next_cycles;
+    }
+    sim_primask = 0;
+    wfi_sleeping = true;
+    wfi_woken = false;
+    dispatch_pending();
+    if (!wfi_woken) {
+        sim_time_advance_cycles(target > sim_cycles ? target - sim_cycles : 1);
+    }
+    wfi_sleeping = false;
+    sim_primask = saved_primask;
+}
+
+// ====================  虚拟时钟  ====================
+
+uint64_t sim_time_cycles(void) {
+    return sim_cycles;
+}
+
+uint64_t sim_time_us(void) {
+    return sim_cycles / CYCLES_PER_US;
+}
+
+void sim_time_advance_cycles(uint64_t cycles) {
+    uint64_t end = sim_cycles + cycles;
+
+    for (;;) {
+        bool control_due = control_period_cycles != 0 && control_next_cycles <= end;
+        bool tick_due = tick_period_cycles != 0 && tick_next_cycles <= end;
+
+        // 同一时刻先推进模型, 再进中断, 中断里读到的是当前时刻的对象状态
+        if (tick_due && (!control_due || tick_next_cycles <= control_next_cycles)) {
+            sim_cycles = tick_next_cycles;
+            tick_next_cycles += tick_period_cycles;
+            tick_hook();
+            if (wfi_sleeping && wfi_woken) {
+                return;
+            }
+        } else if (control_due) {
+            sim_cycles = control_next_cycles;
+            control_next_cycles += control_period_cycles;
+            control_irq_flag = true;
+            raise_irq(SIM_IRQ_CONTROL);
+        } else {
+            break;
+        }
+    }
+    if (end > sim_cycles) {
+        sim_cycles = end;
+    }
+}
+
+void sim_time_advance_us(uint64_t us) {
+    sim_time_advance_cycles(us * CYCLES_PER_US);
+}
+
+void sim_hal_set_tick_hook(void (*hook)(void), uint32_t period_us) {
+    tick_hook = hook;
+    tick_period_cycles = (hook != NULL) ? (uint64_t)period_us * CYCLES_PER_US : 0;
+    tick_next_cycles = sim_cycles + tick_period_cycles;
+}
+
+void delay_cycles(uint32_t cycles) {
+    sim_time_advance_cycles(cycles);
+}
+
+SIM_WEAK void systick_init(void) {
+}
+
+SIM_WEAK uint32_t get_ms(void) {
+    return (uint32_t)(sim_cycles / CYCLES_PER_MS);
+}
+
+SIM_WEAK uint64_t get_us64(void) {
+    return sim_cycles / CYCLES_PER_US;
+}
+
+SIM_WEAK uint32_t get_us(void) {
+    return (uint32_t)get_us64();
+}
+
+SIM_WEAK uint64_t get_cycles(void) {
+    return sim_cycles;
+}
+
+void SYSCFG_DL_init(void) {
+}
+
+// ====================  控制定时器 (TIMG0)  ====================
+
+SIM_WEAK void hal_control_timer_init(uint32_t period_us) {
+    sim_timg0.load = period_us - 1U;
+    sim_timg0.running = false;
+    control_period_cycles = 0;
+}
+
+SIM_WEAK void hal_control_timer_start(void) {
+    sim_timg0.running = true;
+    control_period_cycles = (uint64_t)(sim_timg0.load + 1U) * CYCLES_PER_US;
+    control_next_cycles = sim_cycles + control_period_cycles;
+}
+
+SIM_WEAK void hal_control_timer_stop(void) {
+    sim_timg0.running = false;
+    control_period_cycles = 0;
+    irq_pending &= ~SIM_IRQ_CONTROL;
+}
+
+SIM_WEAK bool hal_control_timer_ack_irq(void) {
+    bool fired = control_irq_flag;
+    control_irq_flag = false;
+    return fired;
+}
+
+// ====================  GPIO / UART 激励  ====================
+
+void sim_gpio_set_input(GPIO_Regs *gpio, uint32_t pins, bool level) {
+    uint32_t old = gpio->din;
+    gpio->din = level ? (old | pins) : (old & ~pins);
+
+    uint32_t changed = (old ^ gpio->din) & ~gpio->doe;
+    if (changed == 0) {
+        return;
+    }
+    gpio->int_pending |= changed;
+    if (gpio == &sim_gpiob) {
+        raise_irq(SIM_IRQ_GROUP1);
+    }
+}
+
+static uint32_t uart_irq_mask(UART_Regs *uart) {
+    return (uart == &sim_uart0) ? SIM_IRQ_UART0 : SIM_IRQ_UART3;
+}
+
+// 置位 UART 中断标志, 使能了的才进入中断
+static void uart_raise(UART_Regs *uart, uint32_t flag) {
+    uart->ris |= flag;
+    if (uart->imask & flag) {
+        raise_irq(uart_irq_mask(uart));
+    }
+}
+
+void sim_uart_tx_event(UART_Regs *uart) {
+    uart_raise(uart, DL_UART_MAIN_INTERRUPT_TX);
+}
+
+void sim_dma_service(DMA_Regs *dma, uint8_t channel) {
+    sim_dma_channel_t *ch = &dma->ch[channel];
+    UART_Regs *uart = (ch->trigger == DMA_UART0_RX_TRIG) ? &sim_uart0 :
+                      (ch->trigger == DMA_UART3_RX_TRIG) ? &sim_uart3 : NULL;
+    if (uart == NULL || !(uart->dma_rx & DL_UART_MAIN_DMA_INTERRUPT_RX)) {
+        return;
+    }
+    // 单次传输: 每个触发搬 1 字节, FIFO 降到门限以下就不再触发
+    while (ch->enabled && ch->size > 0 && sim_uart_rx_count(uart) >= sim_uart_rx_trigger_level(uart)) {
+        *(uint8_t *)ch->dst = DL_UART_Main_receiveData(uart);
+        ch->dst++;
+        if (--ch->size == 0) {
+            ch->enabled = false;        // 单次传输模式: 计数到 0 自动关闭通道
+            uart_raise(uart, DL_UART_MAIN_INTERRUPT_DMA_DONE_RX);
+        }
+    }
+}
+
+static void uart_dma_service(UART_Regs *uart) {
+    uint32_t trigger = (uart == &sim_uart0) ? DMA_UART0_RX_TRIG : DMA_UART3_RX_TRIG;
+    for (uint8_t i = 0; i < SIM_DMA_CHANNELS; i++) {
+        if (sim_dma.ch[i].enabled && sim_dma.ch[i].trigger == trigger) {
+            sim_dma_service(&sim_dma, i);
+        }
+    }
+}
+
+size_t sim_uart_rx(UART_Regs *uart, const uint8_t *data, size_t len) {
+    size_t accepted = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        uint16_t next = (uint16_t)((uart->rx_head + 1) % SIM_UART_RX_FIFO);
+        if (next == uart->rx_tail) {
+            continue;                   // FIFO 溢出, 丢弃
+        }
+        uart->rx_fifo[uart->rx_head] = data[i];
+        uart->rx_head = next;
+        accepted++;
+        if (uart->dma_rx) {
+            uart_dma_service(uart);     // 接收事件交给 DMA, 不进 CPU 中断
+        } else {
+            raise_irq(uart_irq_mask(uart));
+        }
+    }
+    // 一串字节之后线路空闲; 同硬件, 只有 FIFO 里还留着数据时才产生 RX 超时
+    if (accepted > 0 && uart->rx_timeout > 0 && sim_uart_rx_available(uart)) {
+        uart_raise(uart, DL_UART_MAIN_INTERRUPT_RX_TIMEOUT_ERROR);
+    }
+    return accepted;
+}
+
+void sim_uart_tx_clear(UART_Regs *uart) {
+    uart->tx_len = 0;
+}
+
+// ====================  复位  ====================
+
+void sim_hal_reset(void) {
+    memset(&sim_gpioa, 0, sizeof(sim_gpioa));
+    memset(&sim_gpiob, 0, sizeof(sim_gpiob));
+    memset(&sim_uart0, 0, sizeof(sim_uart0));
+    memset(&sim_uart3, 0, sizeof(sim_uart3));
+    memset(&sim_tima0, 0, sizeof(sim_tima0));
+    memset(&sim_timg0, 0, sizeof(sim_timg0));
+    memset(&sim_timg7, 0, sizeof(sim_timg7));
+    memset(&sim_timg8, 0, sizeof(sim_timg8));
+    memset(&sim_spi1, 0, sizeof(sim_spi1));
+    memset(&sim_adc0, 0, sizeof(sim_adc0));
+    memset(&sim_dma, 0, sizeof(sim_dma));
+    sim_uart0.imask = DL_UART_MAIN_INTERRUPT_RX;
+    sim_uart3.imask = DL_UART_MAIN_INTERRUPT_RX;
+
+    sim_cycles = 0;
+    sim_primask = 0;
+    irq_pending = 0;
+    irq_active = 0;
+    control_period_cycles = 0;
+    control_next_cycles = 0;
+    control_irq_flag = false;
+    tick_hook = NULL;
+    wfi_sleeping = false;
+    wfi_woken = false;
+    tick_period_cycles = 0;
+    tick_next_cycles = 0;
+    sim_i2c_reset();
+}
@@ -0,0 +1,93 @@
+/**
+ * @file sim_hal.h
+ * @brief 主机仿真 HAL 的测试接口
+ *
+ * 固件代码照常调用 DL_* / get_ms / soft_iic_* / 中断处理函数, 这里提供测试程序一侧的入口:
+ *  - 虚拟时钟: 以 80MHz CPU 周期计, delay_cycles / system_time_delay_ms / __WFI 都会推进它
+ *  - 中断注入: 引脚电平变化、串口收到字节、控制定时器到期时调用 mspm0g3507_it.c 中的处理函数,
+ *    __disable_irq() 期间产生的中断挂起, 开中断时补发; __WFI 睡眠中有中断执行即唤醒
+ *  - 外部模型: sim_hal_set_tick_hook() 注册的周期节拍与 GPIO_Regs::out_hook / UART_Regs::tx_hook,
+ *    用于搭建闭环的被控对象 (见 sil/car_plant.c)
+ *  - I2C 设备: 按 7 位地址挂接设备模型, 未挂接的地址不应答 (读到 0xFF)
+ *
+ * get_ms/get_us 和 hal_control_timer_* 在 sim_hal.c 中是弱定义,
+ * 需要自己时间模型的测试程序 (如 two_tier_sim.c) 可以直接覆盖.
+ */
+#ifndef SIM_HAL_H__
+#define SIM_HAL_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "ti_msp_dl_config.h"
+
+// ====================  虚拟时钟  ====================
+
+/**
+ * @brief 复位全部仿真外设、挂接的 I2C 设备和虚拟时钟
+ */
+void sim_hal_reset(void);
+
+uint64_t sim_time_cycles(void);
+uint64_t sim_time_us(void);
+
+/**
+ * @brief 推进虚拟时钟, 期间到期的控制定时器中断按时间顺序触发
+ */
+void sim_time_advance_cycles(uint64_t cycles);
+void sim_time_advance_us(uint64_t us);
+
+/**
+ * @brief 注册外部模型的周期节拍 (如 sil/car_plant.c 的被控对象积分), hook 为 NULL 时取消
+ * @note 节拍在 sim_time_advance_cycles 中按时间顺序调用, 与中断同一时刻到期时先于中断执行;
+ *       它不是中断, 不受 __disable_irq() 影响. sim_hal_reset() 会清除注册.
+ */
+void sim_hal_set_tick_hook(void (*hook)(void), uint32_t period_us);
+
+// ====================  GPIO  ====================
+
+/**
+ * @brief 设置外部输入电平
+ * @note 电平发生变化的引脚置中断标志; PORTB 上有新标志时触发 GROUP1_IRQHandler
+ *       输出方向的变化可通过 GPIO_Regs::out_hook 观察 (如 74HC595 移位寄存器模型)
+ */
+void sim_gpio_set_input(GPIO_Regs *gpio, uint32_t pins, bool level);
+
+// ====================  UART  ====================
+
+/**
+ * @brief 模拟串口收到一串字节, 每个字节触发一次对应的串口中断
+ * @note 使能了 DMA 接收的串口由绑定的 DMA 通道直接搬走 (计数到 0 时置 DMA_DONE_RX), 不进 RX 中断,
+ *       FIFO 打开时只搬到低于 RX FIFO 门限为止; 设置了 RX 超时的串口在这串字节之后, 若 FIFO 中
+ *       还有数据则置 RX 超时标志 (线路空闲)
+ * @return 实际放入接收 FIFO 的字节数 (FIFO 满时丢弃, 与硬件溢出一致)
+ */
+size_t sim_uart_rx(UART_Regs *uart, const uint8_t *data, size_t len);
+
+void sim_uart_tx_clear(UART_Regs *uart);
+
+// ====================  I2C  ====================
+
+typedef struct sim_i2c_device {
+    uint8_t addr;                                                   // 7 位地址
+    void (*write)(struct sim_i2c_device *dev, const uint8_t *data, uint32_t len);  // 一次写事务 (不含地址字节)
+    void (*read)(struct sim_i2c_device *dev, uint8_t *data, uint32_t len);         // 一次读事务
+    struct sim_i2c_device *next;
+} sim_i2c_device_t;
+
+/**
+ * @brief 常见的 "寄存器指针 + 自增" 型设备
+ * 写事务的第一个字节设置寄存器指针, 其余字节依次写入; 读事务从指针处依次读出
+ */
+typedef struct {
+    sim_i2c_device_t dev;           // 必须是第一个成员
+    uint8_t regs[256];
+    uint8_t pointer;
+    uint32_t write_count;           // 写入的数据字节数 (不含寄存器地址)
+} sim_i2c_regmap_t;
+
+void sim_i2c_attach(sim_i2c_device_t *dev);
+void sim_i2c_reset(void);                   // 卸下全部设备
+void sim_i2c_regmap_init(sim_i2c_regmap_t *map, uint8_t addr);
+
+#endif
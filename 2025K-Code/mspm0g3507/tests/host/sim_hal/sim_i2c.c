@@ -0,0 +1,259 @@
+/**
+ * @file sim_i2c.c
+ * @brief hal_soft_i2c.h 的主机实现: 按事务把数据交给挂接的设备模型
+ * @note 目标板上的 hal_soft_i2c.c 逐位翻转 GPIO, 这里直接在字节层面模拟,
+ *       起始/停止/应答时序不再建模. 设备只按地址区分, 不区分总线.
+ *       返回值与原实现一致: 0 成功, 2 设备地址无应答.
+ */
+#include <string.h>
+#include "hal_soft_i2c.h"
+#include "sim_hal.h"
+
+#define SIM_I2C_MAX_TRANSFER    1024        // 单次写事务最大字节数, 超出部分丢弃
+
+static sim_i2c_device_t *device_list;
+static uint8_t tx_buffer[SIM_I2C_MAX_TRANSFER];
+
+void sim_i2c_attach(sim_i2c_device_t *dev) {
+    dev->next = device_list;
+    device_list = dev;
+}
+
+void sim_i2c_reset(void) {
+    device_list = NULL;
+}
+
+static sim_i2c_device_t *find_device(uint8_t addr) {
+    for (sim_i2c_device_t *dev = device_list; dev != NULL; dev = dev->next) {
+        if (dev->addr == addr) {
+            return dev;
+        }
+    }
+    return NULL;
+}
+
+// ====================  事务原语  ====================
+
+static bool bus_write(soft_iic_info_struct *obj, const uint8_t *data, uint32_t len) {
+    sim_i2c_device_t *dev = find_device(obj->addr);
+    if (dev == NULL) {
+        return false;
+    }
+    if (dev->write != NULL) {
+        dev->write(dev, data, len);
+    }
+    return true;
+}
+
+static bool bus_read(soft_iic_info_struct *obj, uint8_t *data, uint32_t len) {
+    sim_i2c_device_t *dev = find_device(obj->addr);
+    if (dev == NULL || dev->read == NULL) {
+        memset(data, 0xFF, len);        // 无应答时 SDA 保持上拉
+        return dev != NULL;
+    }
+    dev->read(dev, data, len);
+    return true;
+}
+
+/**
+ * @brief 拼接 "寄存器地址 + 数据" 后作为一次写事务发送
+ */
+static bool bus_write_prefixed(soft_iic_info_struct *obj, const uint8_t *prefix, uint32_t prefix_len,
+                               const uint8_t *data, uint32_t len) {
+    uint32_t total = prefix_len;
+
+    memcpy(tx_buffer, prefix, prefix_len);
+    for (uint32_t i = 0; i < len && total < SIM_I2C_MAX_TRANSFER; i++) {
+        tx_buffer[total++] = data[i];
+    }
+    return bus_write(obj, tx_buffer, total);
+}
+
+static uint32_t pack_u16(const uint16_t *data, uint32_t len, uint32_t offset) {
+    uint32_t total = offset;
+    for (uint32_t i = 0; i < len && total + 2 <= SIM_I2C_MAX_TRANSFER; i++) {
+        tx_buffer[total++] = (uint8_t)(data[i] >> 8);
+        tx_buffer[total++] = (uint8_t)(data[i] & 0xFF);
+    }
+    return total;
+}
+
+static void unpack_u16(const uint8_t *bytes, uint16_t *data, uint32_t len) {
+    for (uint32_t i = 0; i < len; i++) {
+        data[i] = (uint16_t)((bytes[2 * i] << 8) | bytes[2 * i + 1]);
+    }
+}
+
+static void read_u16_array(soft_iic_info_struct *obj, uint16_t *data, uint32_t len) {
+    // 高字节在前; 超过缓冲区的部分只能拆成多个读事务
+    while (len > 0) {
+        uint32_t n = (len > SIM_I2C_MAX_TRANSFER / 2) ? SIM_I2C_MAX_TRANSFER / 2 : len;
+        bus_read(obj, tx_buffer, n * 2);
+        unpack_u16(tx_buffer, data, n);
+        data += n;
+        len -= n;
+    }
+}
+
+// ====================  hal_soft_i2c.h 接口  ====================
+
+void soft_iic_write_8bit(soft_iic_info_struct *soft_iic_obj, const uint8_t data) {
+    bus_write(soft_iic_obj, &data, 1);
+}
+
+void soft_iic_write_8bit_array(soft_iic_info_struct *soft_iic_obj, const uint8_t *data, uint32_t len) {
+    bus_write(soft_iic_obj, data, len);
+}
+
+void soft_iic_write_16bit(soft_iic_info_struct *soft_iic_obj, const uint16_t data) {
+    soft_iic_write_16bit_array(soft_iic_obj, &data, 1);
+}
+
+void soft_iic_write_16bit_array(soft_iic_info_struct *soft_iic_obj, const uint16_t *data, uint32_t len) {
+    bus_write(soft_iic_obj, tx_buffer, pack_u16(data, len, 0));
+}
+
+void soft_iic_write_8bit_register(soft_iic_info_struct *soft_iic_obj, const uint8_t register_name, const uint8_t data) {
+    bus_write_prefixed(soft_iic_obj, &register_name, 1, &data, 1);
+}
+
+void soft_iic_write_8bit_registers(soft_iic_info_struct *soft_iic_obj, const uint8_t register_name, const uint8_t *data,
+                                   uint32_t len) {
+    bus_write_prefixed(soft_iic_obj, &register_name, 1, data, len);
+}
+
+void soft_iic_write_16bit_register(soft_iic_info_struct *soft_iic_obj, const uint16_t register_name,
+                                   const uint16_t data) {
+    soft_iic_write_16bit_registers(soft_iic_obj, register_name, &data, 1);
+}
+
+void soft_iic_write_16bit_registers(soft_iic_info_struct *soft_iic_obj, const uint16_t register_name,
+                                    const uint16_t *data, uint32_t len) {
+    tx_buffer[0] = (uint8_t)(register_name >> 8);
+    tx_buffer[1] = (uint8_t)(register_name & 0xFF);
+    bus_write(soft_iic_obj, tx_buffer, pack_u16(data, len, 2));
+}
+
+uint8_t soft_iic_read_8bit(soft_iic_info_struct *soft_iic_obj) {
+    uint8_t data;
+    bus_read(soft_iic_obj, &data, 1);
+    return data;
+}
+
+void soft_iic_read_8bit_array(soft_iic_info_struct *soft_iic_obj, uint8_t *data, uint32_t len) {
+    bus_read(soft_iic_obj, data, len);
+}
+
+uint16_t soft_iic_read_16bit(soft_iic_info_struct *soft_iic_obj) {
+    uint16_t data;
+    read_u16_array(soft_iic_obj, &data, 1);
+    return data;
+}
+
+void soft_iic_read_16bit_array(soft_iic_info_struct *soft_iic_obj, uint16_t *data, uint32_t len) {
+    read_u16_array(soft_iic_obj, data, len);
+}
+
+uint8_t soft_iic_read_8bit_register(soft_iic_info_struct *soft_iic_obj, const uint8_t register_name) {
+    uint8_t data;
+    soft_iic_read_8bit_registers(soft_iic_obj, register_name, &data, 1);
+    return data;
+}
+
+void soft_iic_read_8bit_registers(soft_iic_info_struct *soft_iic_obj, const uint8_t register_name, uint8_t *data,
+                                  uint32_t len) {
+    bus_write(soft_iic_obj, &register_name, 1);
+    bus_read(soft_iic_obj, data, len);
+}
+
+uint16_t soft_iic_read_16bit_register(soft_iic_info_struct *soft_iic_obj, const uint16_t register_name) {
+    uint16_t data;
+    soft_iic_read_16bit_registers(soft_iic_obj, register_name, &data, 1);
+    return data;
+}
+
+void soft_iic_read_16bit_registers(soft_iic_info_struct *soft_iic_obj, const uint16_t register_name, uint16_t *data,
+                                   uint32_t len) {
+    uint8_t reg[2] = { (uint8_t)(register_name >> 8), (uint8_t)(register_name & 0xFF) };
+    bus_write(soft_iic_obj, reg, 2);
+    read_u16_array(soft_iic_obj, data, len);
+}
+
+void soft_iic_transfer_8bit_array(soft_iic_info_struct *soft_iic_obj, const uint8_t *write_data, uint32_t write_len,
+                                  uint8_t *read_data, uint32_t read_len) {
+    bus_write(soft_iic_obj, write_data, write_len);
+    if (read_len) {
+        bus_read(soft_iic_obj, read_data, read_len);
+    }
+}
+
+void soft_iic_transfer_16bit_array(soft_iic_info_struct *soft_iic_obj, const uint16_t *write_data, uint32_t write_len,
+                                   uint16_t *read_data, uint32_t read_len) {
+    bus_write(soft_iic_obj, tx_buffer, pack_u16(write_data, write_len, 0));
+    if (read_len) {
+        read_u16_array(soft_iic_obj, read_data, read_len);
+    }
+}
+
+void soft_iic_sccb_write_register(soft_iic_info_struct *soft_iic_obj, const uint8_t register_name, uint8_t data) {
+    soft_iic_write_8bit_register(soft_iic_obj, register_name, data);
+}
+
+uint8_t soft_iic_sccb_read_register(soft_iic_info_struct *soft_iic_obj, const uint8_t register_name) {
+    return soft_iic_read_8bit_register(soft_iic_obj, register_name);
+}
+
+uint8_t soft_iic_write_16bit_register_addr_only(soft_iic_info_struct *soft_iic_obj, uint16_t reg_addr) {
+    return soft_iic_write_16bit_register_with_data(soft_iic_obj, reg_addr, NULL, 0);
+}
+
+uint8_t soft_iic_write_16bit_register_with_data(soft_iic_info_struct *soft_iic_obj, uint16_t reg_addr, const uint8_t *data, uint32_t len) {
+    if (soft_iic_obj == NULL || (len > 0 && data == NULL)) {
+        return 1;
+    }
+    uint8_t reg[2] = { (uint8_t)(reg_addr >> 8), (uint8_t)(reg_addr & 0xFF) };
+    return bus_write_prefixed(soft_iic_obj, reg, 2, data, len) ? 0 : 2;
+}
+
+uint8_t soft_iic_read_continue(soft_iic_info_struct *soft_iic_obj, uint32_t len, uint8_t *data) {
+    if (soft_iic_obj == NULL || data == NULL || len == 0) {
+        return 1;
+    }
+    return bus_read(soft_iic_obj, data, len) ? 0 : 2;
+}
+
+void soft_iic_init(soft_iic_info_struct *soft_iic_obj) {
+    // 空闲电平: SCL/SDA 输出高
+    DL_GPIO_enableOutput(soft_iic_obj->sclPort, soft_iic_obj->sclPin);
+    DL_GPIO_setPins(soft_iic_obj->sclPort, soft_iic_obj->sclPin);
+    DL_GPIO_enableOutput(soft_iic_obj->sdaPort, soft_iic_obj->sdaPin);
+    DL_GPIO_setPins(soft_iic_obj->sdaPort, soft_iic_obj->sdaPin);
+}
+
+// ====================  寄存器型设备模型  ====================
+
+static void regmap_write(sim_i2c_device_t *dev, const uint8_t *data, uint32_t len) {
+    sim_i2c_regmap_t *map = (sim_i2c_regmap_t *)dev;
+    if (len == 0) {
+        return;
+    }
+    map->pointer = data[0];
+    for (uint32_t i = 1; i < len; i++) {
+        map->regs[map->pointer++] = data[i];
+        map->write_count++;
+    }
+}
+
+static void regmap_read(sim_i2c_device_t *dev, uint8_t *data, uint32_t len) {
+    sim_i2c_regmap_t *map = (sim_i2c_regmap_t *)dev;
+    for (uint32_t i = 0; i < len; i++) {
+        data[i] = map->regs[map->pointer++];
+    }
+}
+
+void sim_i2c_regmap_init(sim_i2c_regmap_t *map, uint8_t addr) {
+    memset(map, 0, sizeof(*map));
+    map->dev.addr = addr;
+    map->dev.write = regmap_write;
+    map->dev.read = regmap_read;
+}
@@ -0,0 +1,494 @@
+/**
+ * @file ti_msp_dl_config.h
+ * @brief 主机 (x86-64) 构建用的 SysConfig + driverlib 替身
+ * @note 只提供 custom_src 中用到的外设名、引脚宏和 DL_* 接口, 不访问任何真实外设.
+ *       外设 "寄存器" 是 sim_hal.c 中的普通结构体, 测试程序通过 sim_hal.h 注入输入、读取输出.
+ *       引脚/实例名与 project/config/ti_msp_dl_config.h 保持一致, SysConfig 改动后需要同步.
+ */
+#ifndef ti_msp_dl_config_h
+#define ti_msp_dl_config_h
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define SIM_HAL                                                                1
+
+#define POWER_STARTUP_DELAY                                                 (16)
+#define CPUCLK_FREQ                                                     80000000
+
+// ====================  外设 "寄存器"  ====================
+
+typedef struct GPIO_Regs {
+    uint32_t dout;              // 输出锁存
+    uint32_t din;               // 外部输入电平 (由测试程序驱动)
+    uint32_t doe;               // 输出使能
+    uint32_t int_pending;       // 边沿中断标志
+    void (*out_hook)(struct GPIO_Regs *gpio, uint32_t changed);    // 可选: 输出锁存变化时调用
+} GPIO_Regs;
+
+#define SIM_UART_RX_FIFO                                                    64
+#define SIM_UART_HW_FIFO                                                     4  // 目标板 UART 硬件 FIFO 深度, 用于换算触发门限
+#define SIM_UART_TX_LOG                                                   4096
+
+typedef struct UART_Regs {
+    uint32_t RXDATA;                    // 仅用作 DMA 源地址, DMA 实际从 rx_fifo 取数
+    uint8_t rx_fifo[SIM_UART_RX_FIFO];
+    uint16_t rx_head, rx_tail;
+    uint32_t imask;                     // 中断使能 (DL_UART_MAIN_INTERRUPT_*), 复位后为 RX (同 SysConfig)
+    uint32_t ris;                       // 已置位的 RX 超时 / DMA 完成标志
+    uint32_t dma_rx;                    // DMA 接收触发使能
+    uint32_t rx_timeout;                // RX 超时位数, 0 为关闭
+    bool fifo_enabled;                  // FIFO 关闭时接收只有 1 字节, DMA 每字节触发
+    uint32_t rx_fifo_level;             // DL_UART_RX_FIFO_LEVEL, FIFO 打开时的 RX/DMA 触发门限
+    uint8_t tx_log[SIM_UART_TX_LOG];    // 发送记录, 满后丢弃新字节
+    size_t tx_len;
+    void (*tx_hook)(uint8_t byte);      // 可选: 每发送一个字节调用一次
+    bool tx_stalled;                    // 测试用: 线路堵住, 发送 FIFO 一直满
+} UART_Regs;
+
+typedef struct GPTIMER_Regs {
+    uint32_t cc[4];             // 比较值 (PWM 占空比)
+    uint32_t load;
+    bool running;
+} GPTIMER_Regs;
+
+typedef struct SPI_Regs {
+    uint32_t tx_count;
+    uint8_t last_tx;
+} SPI_Regs;
+
+typedef struct ADC12_Regs {
+    uint16_t result;            // 下一次转换结果 (由测试程序设置)
+    bool enabled;
+} ADC12_Regs;
+
+extern GPIO_Regs sim_gpioa, sim_gpiob;
+extern UART_Regs sim_uart0, sim_uart3;
+extern GPTIMER_Regs sim_tima0, sim_timg0, sim_timg7, sim_timg8;
+extern SPI_Regs sim_spi1;
+extern ADC12_Regs sim_adc0;
+
+#define SIM_DMA_CHANNELS                                                     7
+
+typedef struct {
+    uint32_t trigger;
+    uintptr_t src, dst;
+    uint16_t size;              // 剩余传输次数
+    bool enabled;
+} sim_dma_channel_t;
+
+typedef struct DMA_Regs {
+    sim_dma_channel_t ch[SIM_DMA_CHANNELS];
+} DMA_Regs;
+
+extern DMA_Regs sim_dma;
+
+#define GPIOA                                                       (&sim_gpioa)
+#define GPIOB                                                       (&sim_gpiob)
+#define UART0                                                       (&sim_uart0)
+#define UART3                                                       (&sim_uart3)
+#define TIMA0                                                       (&sim_tima0)
+#define TIMG0                                                       (&sim_timg0)
+#define TIMG7                                                       (&sim_timg7)
+#define TIMG8                                                       (&sim_timg8)
+#define SPI1                                                         (&sim_spi1)
+#define ADC0                                                         (&sim_adc0)
+#define DMA                                                           (&sim_dma)
+
+typedef enum {
+    GPIOB_INT_IRQn = 1,
+    TIMG8_INT_IRQn = 2,
+    UART3_INT_IRQn = 3,
+    ADC0_INT_IRQn = 4,
+    SPI1_INT_IRQn = 10,
+    UART0_INT_IRQn = 15,
+    TIMG0_INT_IRQn = 16,
+    TIMA0_INT_IRQn = 18,
+    TIMG7_INT_IRQn = 20,
+} IRQn_Type;
+
+// ====================  SysConfig 外设与引脚名  ====================
+
+#define DL_GPIO_PIN_0    (0x00000001U)
+#define DL_GPIO_PIN_1    (0x00000002U)
+#define DL_GPIO_PIN_2    (0x00000004U)
+#define DL_GPIO_PIN_3    (0x00000008U)
+#define DL_GPIO_PIN_4    (0x00000010U)
+#define DL_GPIO_PIN_5    (0x00000020U)
+#define DL_GPIO_PIN_6    (0x00000040U)
+#define DL_GPIO_PIN_7    (0x00000080U)
+#define DL_GPIO_PIN_8    (0x00000100U)
+#define DL_GPIO_PIN_9    (0x00000200U)
+#define DL_GPIO_PIN_10   (0x00000400U)
+#define DL_GPIO_PIN_11   (0x00000800U)
+#define DL_GPIO_PIN_12   (0x00001000U)
+#define DL_GPIO_PIN_13   (0x00002000U)
+#define DL_GPIO_PIN_14   (0x00004000U)
+#define DL_GPIO_PIN_15   (0x00008000U)
+#define DL_GPIO_PIN_16   (0x00010000U)
+#define DL_GPIO_PIN_17   (0x00020000U)
+#define DL_GPIO_PIN_18   (0x00040000U)
+#define DL_GPIO_PIN_19   (0x00080000U)
+#define DL_GPIO_PIN_20   (0x00100000U)
+#define DL_GPIO_PIN_22   (0x00400000U)
+#define DL_GPIO_PIN_23   (0x00800000U)
+#define DL_GPIO_PIN_24   (0x01000000U)
+#define DL_GPIO_PIN_25   (0x02000000U)
+#define DL_GPIO_PIN_26   (0x04000000U)
+#define DL_GPIO_PIN_27   (0x08000000U)
+#define DL_GPIO_PIN_29   (0x20000000U)
+#define DL_GPIO_PIN_30   (0x40000000U)
+
+// GPIO 中断索引: DIOn 对应 n + 1 (与 driverlib 一致)
+#define DL_GPIO_IIDX_DIO(n)                                           ((n) + 1)
+
+#define IOMUX_PINCM(n)                                                 ((n) - 1)
+
+#define Motor_PWM1_INST                                                    TIMA0
+#define Motor_PWM1_INST_IRQHandler                              TIMA0_IRQHandler
+#define Motor_PWM1_INST_INT_IRQN                                (TIMA0_INT_IRQn)
+#define Motor_PWM1_INST_CLK_FREQ                                        10000000
+#define Motor_PWM2_INST                                                    TIMG8
+#define Motor_PWM2_INST_IRQHandler                              TIMG8_IRQHandler
+#define Motor_PWM2_INST_INT_IRQN                                (TIMG8_INT_IRQn)
+#define Motor_PWM2_INST_CLK_FREQ                                         5000000
+#define BEEP_PWM_INST                                                      TIMG7
+#define BEEP_PWM_INST_IRQHandler                                TIMG7_IRQHandler
+#define BEEP_PWM_INST_INT_IRQN                                  (TIMG7_INT_IRQn)
+#define BEEP_PWM_INST_CLK_FREQ                                             32768
+
+#define UART_1_INST                                                        UART3
+#define UART_1_INST_FREQUENCY                                           80000000
+#define UART_1_INST_IRQHandler                                  UART3_IRQHandler
+#define UART_1_INST_INT_IRQN                                      UART3_INT_IRQn
+#define UART_1_BAUD_RATE                                                (115200)
+#define UART_0_INST                                                        UART0
+#define UART_0_INST_FREQUENCY                                           40000000
+#define UART_0_INST_IRQHandler                                  UART0_IRQHandler
+#define UART_0_INST_INT_IRQN                                      UART0_INT_IRQn
+#define UART_0_BAUD_RATE                                                (115200)
+
+#define SPI_0_INST                                                         SPI1
+#define SPI_0_INST_IRQHandler                                   SPI1_IRQHandler
+#define SPI_0_INST_INT_IRQN                                       SPI1_INT_IRQn
+#define GPIO_SPI_0_PICO_PORT                                              GPIOB
+#define GPIO_SPI_0_PICO_PIN                                      DL_GPIO_PIN_15
+#define GPIO_SPI_0_IOMUX_PICO                                   (IOMUX_PINCM(32))
+#define GPIO_SPI_0_SCLK_PORT                                              GPIOA
+#define GPIO_SPI_0_SCLK_PIN                                      DL_GPIO_PIN_17
+#define GPIO_SPI_0_IOMUX_SCLK                                   (IOMUX_PINCM(39))
+
+// SysConfig 中没有配置 ADC, hal_adc.c 使用的实例名在这里补齐
+#define ADC12_0_INST                                                        ADC0
+#define ADC12_0_ADCMEM_ADC12_0                                                 0
+
+#define PORTB_PORT                                                       (GPIOB)
+#define PORTB_LED_R_PIN                                         (DL_GPIO_PIN_26)
+#define PORTB_LED_G_PIN                                         (DL_GPIO_PIN_27)
+#define PORTB_LED_B_PIN                                         (DL_GPIO_PIN_22)
+#define PORTB_OLED_RST_PIN                                      (DL_GPIO_PIN_16)
+#define PORTB_OLED_DC_PIN                                       (DL_GPIO_PIN_17)
+#define PORTB_OLED_CS_PIN                                       (DL_GPIO_PIN_20)
+#define PORTB_KEY1_PIN                                          (DL_GPIO_PIN_12)
+#define PORTB_KEY2_PIN                                           (DL_GPIO_PIN_8)
+#define PORTB_KEY3_PIN                                           (DL_GPIO_PIN_9)
+#define PORTB_KEY4_PIN                                          (DL_GPIO_PIN_10)
+#define PORTB_INT_IRQN                                          (GPIOB_INT_IRQn)
+#define PORTB_INT_IIDX                          (DL_INTERRUPT_GROUP1_IIDX_GPIOB)
+#define PORTB_ENCODER_1_IIDX                                 (DL_GPIO_IIDX_DIO(4))
+#define PORTB_ENCODER_1_PIN                                      (DL_GPIO_PIN_4)
+#define PORTB_ENCODER_2_IIDX                                 (DL_GPIO_IIDX_DIO(5))
+#define PORTB_ENCODER_2_PIN                                      (DL_GPIO_PIN_5)
+#define PORTB_ENCODER_3_IIDX                                 (DL_GPIO_IIDX_DIO(6))
+#define PORTB_ENCODER_3_PIN                                      (DL_GPIO_PIN_6)
+#define PORTB_ENCODER_4_IIDX                                 (DL_GPIO_IIDX_DIO(7))
+#define PORTB_ENCODER_4_PIN                                      (DL_GPIO_PIN_7)
+#define PORTB_ENCODER_5_IIDX                                (DL_GPIO_IIDX_DIO(19))
+#define PORTB_ENCODER_5_PIN                                     (DL_GPIO_PIN_19)
+#define PORTB_ENCODER_6_IIDX                                (DL_GPIO_IIDX_DIO(18))
+#define PORTB_ENCODER_6_PIN                                     (DL_GPIO_PIN_18)
+#define PORTB_ENCODER_7_IIDX                                (DL_GPIO_IIDX_DIO(23))
+#define PORTB_ENCODER_7_PIN                                     (DL_GPIO_PIN_23)
+#define PORTB_ENCODER_8_IIDX                                (DL_GPIO_IIDX_DIO(13))
+#define PORTB_ENCODER_8_PIN                                     (DL_GPIO_PIN_13)
+
+#define PORTA_PORT                                                       (GPIOA)
+#define PORTA_SCL1_PIN                                          (DL_GPIO_PIN_12)
+#define PORTA_SCL1_IOMUX                                        (IOMUX_PINCM(34))
+#define PORTA_SDA1_PIN                                          (DL_GPIO_PIN_13)
+#define PORTA_SDA1_IOMUX                                        (IOMUX_PINCM(35))
+#define PORTA_SCL2_PIN                                           (DL_GPIO_PIN_8)
+#define PORTA_SCL2_IOMUX                                        (IOMUX_PINCM(19))
+#define PORTA_SDA2_PIN                                          (DL_GPIO_PIN_26)
+#define PORTA_SDA2_IOMUX                                        (IOMUX_PINCM(59))
+#define PORTA_HC595_DS_PIN                                      (DL_GPIO_PIN_25)
+#define PORTA_HC595_SHCP_PIN                                    (DL_GPIO_PIN_15)
+#define PORTA_HC595_STCP_PIN                                    (DL_GPIO_PIN_14)
+#define PORTA_GW_ADDR0_PIN                                      (DL_GPIO_PIN_24)
+#define PORTA_GW_ADDR1_PIN                                      (DL_GPIO_PIN_30)
+#define PORTA_GW_ADDR2_PIN                                      (DL_GPIO_PIN_29)
+
+void SYSCFG_DL_init(void);
+
+// ====================  CMSIS 内核接口  ====================
+
+// 中断屏蔽/睡眠由 sim_hal.c 提供弱定义, 主机程序可以自行实现以接入自己的时间模型
+void sim_disable_irq(void);
+void sim_enable_irq(void);
+void sim_wfi(void);
+uint32_t sim_get_primask(void);
+void sim_set_primask(uint32_t primask);
+
+#define __disable_irq()                                     sim_disable_irq()
+#define __enable_irq()                                      sim_enable_irq()
+#define __WFI()                                             sim_wfi()
+#define __get_PRIMASK()                                     sim_get_primask()
+#define __set_PRIMASK(p)                                    sim_set_primask(p)
+#define __DMB()                                             __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __NOP()                                             ((void)0)
+
+static inline void NVIC_EnableIRQ(IRQn_Type irq) { (void)irq; }
+static inline void NVIC_DisableIRQ(IRQn_Type irq) { (void)irq; }
+static inline void NVIC_ClearPendingIRQ(IRQn_Type irq) { (void)irq; }
+static inline void NVIC_SetPriority(IRQn_Type irq, uint32_t priority) { (void)irq; (void)priority; }
+static inline uint32_t SysTick_Config(uint32_t ticks) { (void)ticks; return 0; }
+
+// 忙等待: 推进虚拟时钟 (见 sim_hal.c)
+void delay_cycles(uint32_t cycles);
+
+// ====================  GPIO  ====================
+
+typedef enum { DL_GPIO_INVERSION_DISABLE = 0, DL_GPIO_INVERSION_ENABLE } DL_GPIO_INVERSION;
+typedef enum { DL_GPIO_RESISTOR_NONE = 0, DL_GPIO_RESISTOR_PULL_UP, DL_GPIO_RESISTOR_PULL_DOWN } DL_GPIO_RESISTOR;
+typedef enum { DL_GPIO_DRIVE_STRENGTH_LOW = 0, DL_GPIO_DRIVE_STRENGTH_HIGH } DL_GPIO_DRIVE_STRENGTH;
+typedef enum { DL_GPIO_HIZ_DISABLE = 0, DL_GPIO_HIZ_ENABLE } DL_GPIO_HIZ;
+typedef enum { DL_GPIO_HYSTERESIS_DISABLE = 0, DL_GPIO_HYSTERESIS_ENABLE } DL_GPIO_HYSTERESIS;
+typedef enum { DL_GPIO_WAKEUP_DISABLE = 0, DL_GPIO_WAKEUP_ENABLE } DL_GPIO_WAKEUP;
+
+static inline void sim_gpio_write_dout(GPIO_Regs *gpio, uint32_t dout) {
+    uint32_t changed = gpio->dout ^ dout;
+    gpio->dout = dout;
+    if (changed != 0 && gpio->out_hook != NULL) {
+        gpio->out_hook(gpio, changed);
+    }
+}
+
+static inline void DL_GPIO_setPins(GPIO_Regs *gpio, uint32_t pins) { sim_gpio_write_dout(gpio, gpio->dout | pins); }
+static inline void DL_GPIO_clearPins(GPIO_Regs *gpio, uint32_t pins) { sim_gpio_write_dout(gpio, gpio->dout & ~pins); }
+static inline void DL_GPIO_togglePins(GPIO_Regs *gpio, uint32_t pins) { sim_gpio_write_dout(gpio, gpio->dout ^ pins); }
+static inline void DL_GPIO_enableOutput(GPIO_Regs *gpio, uint32_t pins) { gpio->doe |= pins; }
+static inline void DL_GPIO_disableOutput(GPIO_Regs *gpio, uint32_t pins) { gpio->doe &= ~pins; }
+
+// 输出使能的引脚读回输出锁存, 其余读外部电平
+static inline uint32_t DL_GPIO_readPins(GPIO_Regs *gpio, uint32_t pins) {
+    return ((gpio->dout & gpio->doe) | (gpio->din & ~gpio->doe)) & pins;
+}
+
+static inline uint32_t DL_GPIO_getEnabledInterruptStatus(GPIO_Regs *gpio, uint32_t pins) {
+    return gpio->int_pending & pins;
+}
+static inline void DL_GPIO_clearInterruptStatus(GPIO_Regs *gpio, uint32_t pins) { gpio->int_pending &= ~pins; }
+
+static inline void DL_GPIO_initDigitalOutput(uint32_t pincm) { (void)pincm; }
+static inline void DL_GPIO_enableHiZ(uint32_t pincm) { (void)pincm; }
+static inline void DL_GPIO_initDigitalOutputFeatures(uint32_t pincm, DL_GPIO_INVERSION inversion,
+        DL_GPIO_RESISTOR resistor, DL_GPIO_DRIVE_STRENGTH strength, DL_GPIO_HIZ hiz) {
+    (void)pincm; (void)inversion; (void)resistor; (void)strength; (void)hiz;
+}
+static inline void DL_GPIO_initDigitalInputFeatures(uint32_t pincm, DL_GPIO_INVERSION inversion,
+        DL_GPIO_RESISTOR resistor, DL_GPIO_HYSTERESIS hysteresis, DL_GPIO_WAKEUP wakeup) {
+    (void)pincm; (void)inversion; (void)resistor; (void)hysteresis; (void)wakeup;
+}
+
+typedef enum { DL_INTERRUPT_GROUP_0 = 0, DL_INTERRUPT_GROUP_1 } DL_INTERRUPT_GROUP;
+#define DL_INTERRUPT_GROUP1_IIDX_GPIOB                                        2
+
+static inline bool DL_Interrupt_getStatusGroup(DL_INTERRUPT_GROUP group, uint32_t iidx) {
+    return group == DL_INTERRUPT_GROUP_1 && iidx == DL_INTERRUPT_GROUP1_IIDX_GPIOB && sim_gpiob.int_pending != 0;
+}
+
+// ====================  UART  ====================
+
+// 中断号与屏蔽位同 driverlib: IIDX 越小优先级越高, 屏蔽位为 1 << (IIDX - 1)
+typedef enum {
+    DL_UART_IIDX_NO_INTERRUPT = 0,
+    DL_UART_IIDX_RX_TIMEOUT_ERROR = 1,
+    DL_UART_IIDX_RX = 11,
+    DL_UART_IIDX_TX = 12,
+    DL_UART_IIDX_DMA_DONE_RX = 16,
+} DL_UART_IIDX;
+
+#define DL_UART_MAIN_INTERRUPT_RX_TIMEOUT_ERROR                        (1u << 0)
+#define DL_UART_MAIN_INTERRUPT_RX                                     (1u << 10)
+#define DL_UART_MAIN_INTERRUPT_TX                                     (1u << 11)
+#define DL_UART_MAIN_INTERRUPT_DMA_DONE_RX                            (1u << 15)
+#define DL_UART_MAIN_DMA_INTERRUPT_RX                                 (1u << 10)
+
+typedef enum {
+    DL_UART_RX_FIFO_LEVEL_ONE_ENTRY = 0x70,
+    DL_UART_RX_FIFO_LEVEL_FULL = 0x50,
+    DL_UART_RX_FIFO_LEVEL_3_4_FULL = 0x30,
+    DL_UART_RX_FIFO_LEVEL_1_2_FULL = 0x20,
+    DL_UART_RX_FIFO_LEVEL_1_4_FULL = 0x10,
+} DL_UART_RX_FIFO_LEVEL;
+
+static inline bool sim_uart_rx_available(UART_Regs *uart) { return uart->rx_head != uart->rx_tail; }
+
+static inline uint16_t sim_uart_rx_count(UART_Regs *uart) {
+    return (uint16_t)((uart->rx_head + SIM_UART_RX_FIFO - uart->rx_tail) % SIM_UART_RX_FIFO);
+}
+
+// DMA 接收触发所需的 FIFO 字节数
+static inline uint16_t sim_uart_rx_trigger_level(UART_Regs *uart) {
+    if (!uart->fifo_enabled) {
+        return 1;
+    }
+    switch (uart->rx_fifo_level) {
+        case DL_UART_RX_FIFO_LEVEL_FULL:        return SIM_UART_HW_FIFO;
+        case DL_UART_RX_FIFO_LEVEL_3_4_FULL:    return SIM_UART_HW_FIFO * 3 / 4;
+        case DL_UART_RX_FIFO_LEVEL_1_2_FULL:    return SIM_UART_HW_FIFO / 2;
+        case DL_UART_RX_FIFO_LEVEL_1_4_FULL:    return SIM_UART_HW_FIFO / 4;
+        default:                                return 1;
+    }
+}
+
+static inline uint32_t sim_uart_pending_mask(UART_Regs *uart) {
+    uint32_t ris = uart->ris;
+    if (sim_uart_rx_available(uart) && !uart->dma_rx) {
+        ris |= DL_UART_MAIN_INTERRUPT_RX;
+    }
+    return ris & uart->imask;
+}
+
+// 读中断号即清除对应标志 (RX 标志由读数据清除)
+static inline DL_UART_IIDX DL_UART_getPendingInterrupt(UART_Regs *uart) {
+    uint32_t pending = sim_uart_pending_mask(uart);
+    if (pending == 0) {
+        return DL_UART_IIDX_NO_INTERRUPT;
+    }
+    uint32_t bit = pending & (~pending + 1u);
+    uart->ris &= ~bit;
+    return (DL_UART_IIDX)(__builtin_ctz(bit) + 1);
+}
+static inline void DL_UART_clearInterruptStatus(UART_Regs *uart, uint32_t mask) { (void)uart; (void)mask; }
+
+static inline void DL_UART_Main_enableInterrupt(UART_Regs *uart, uint32_t mask) { uart->imask |= mask; }
+static inline void DL_UART_Main_disableInterrupt(UART_Regs *uart, uint32_t mask) { uart->imask &= ~mask; }
+static inline void DL_UART_Main_enableDMAReceiveEvent(UART_Regs *uart, uint32_t mask) { uart->dma_rx |= mask; }
+static inline void DL_UART_Main_setRXInterruptTimeout(UART_Regs *uart, uint32_t timeout) { uart->rx_timeout = timeout; }
+static inline void DL_UART_Main_changeConfig(UART_Regs *uart) { (void)uart; }
+static inline void DL_UART_Main_enable(UART_Regs *uart) { (void)uart; }
+static inline void DL_UART_Main_enableFIFOs(UART_Regs *uart) { uart->fifo_enabled = true; }
+static inline void DL_UART_Main_setRXFIFOThreshold(UART_Regs *uart, DL_UART_RX_FIFO_LEVEL level) { uart->rx_fifo_level = level; }
+static inline bool DL_UART_Main_isRXFIFOEmpty(UART_Regs *uart) { return !sim_uart_rx_available(uart); }
+static inline bool DL_UART_Main_isTXFIFOFull(UART_Regs *uart) { return uart->tx_stalled; }
+static inline bool DL_UART_Main_isBusy(UART_Regs *uart) { (void)uart; return false; }
+
+static inline uint8_t DL_UART_Main_receiveData(UART_Regs *uart) {
+    uint8_t byte = 0;
+    if (sim_uart_rx_available(uart)) {
+        byte = uart->rx_fifo[uart->rx_tail];
+        uart->rx_tail = (uint16_t)((uart->rx_tail + 1) % SIM_UART_RX_FIFO);
+    }
+    return byte;
+}
+
+// 发送缓冲 "立即" 发空: 每写一个字节置一次 TX 标志, 打开了 TX 中断时进入中断 (sim_hal.c)
+void sim_uart_tx_event(UART_Regs *uart);
+
+static inline void DL_UART_Main_transmitDataBlocking(UART_Regs *uart, uint8_t data) {
+    if (uart->tx_len < SIM_UART_TX_LOG) {
+        uart->tx_log[uart->tx_len++] = data;
+    }
+    if (uart->tx_hook != NULL) {
+        uart->tx_hook(data);
+    }
+    sim_uart_tx_event(uart);
+}
+static inline void DL_UART_Main_transmitData(UART_Regs *uart, uint8_t data) {
+    DL_UART_Main_transmitDataBlocking(uart, data);
+}
+
+// ====================  DMA  ====================
+// 只模拟单次传输模式下由 UART 接收触发的通道: 源数据取自对应 UART 的接收 FIFO (见 sim_hal.c)
+
+#define DMA_UART0_RX_TRIG                                                   14
+#define DMA_UART3_RX_TRIG                                                   16
+
+typedef enum { DL_DMA_TRIGGER_TYPE_EXTERNAL = 0, DL_DMA_TRIGGER_TYPE_INTERNAL } DL_DMA_TRIGGER_TYPE;
+typedef enum { DL_DMA_SINGLE_TRANSFER_MODE = 0, DL_DMA_SINGLE_BLOCK_TRANSFER_MODE } DL_DMA_TRANSFER_MODE;
+typedef enum { DL_DMA_NORMAL_MODE = 0 } DL_DMA_EXTENDED_MODE;
+typedef enum { DL_DMA_WIDTH_BYTE = 0, DL_DMA_WIDTH_HALF_WORD, DL_DMA_WIDTH_WORD } DL_DMA_WIDTH;
+typedef enum { DL_DMA_ADDR_UNCHANGED = 0, DL_DMA_ADDR_INCREMENT, DL_DMA_ADDR_DECREMENT } DL_DMA_INCREMENT;
+
+typedef struct {
+    uint32_t trigger;
+    DL_DMA_TRIGGER_TYPE triggerType;
+    DL_DMA_TRANSFER_MODE transferMode;
+    DL_DMA_EXTENDED_MODE extendedMode;
+    DL_DMA_WIDTH destWidth;
+    DL_DMA_WIDTH srcWidth;
+    DL_DMA_INCREMENT destIncrement;
+    DL_DMA_INCREMENT srcIncrement;
+} DL_DMA_Config;
+
+// 通道使能后立即搬运 FIFO 中已有的字节, 搬到低于触发门限为止 (sim_hal.c)
+void sim_dma_service(DMA_Regs *dma, uint8_t channel);
+
+static inline void DL_DMA_initChannel(DMA_Regs *dma, uint8_t channel, const DL_DMA_Config *config) {
+    dma->ch[channel].trigger = config->trigger;
+    dma->ch[channel].enabled = false;
+}
+static inline void DL_DMA_setSrcAddr(DMA_Regs *dma, uint8_t channel, uintptr_t addr) { dma->ch[channel].src = addr; }
+static inline void DL_DMA_setDestAddr(DMA_Regs *dma, uint8_t channel, uintptr_t addr) { dma->ch[channel].dst = addr; }
+static inline void DL_DMA_setTransferSize(DMA_Regs *dma, uint8_t channel, uint16_t size) { dma->ch[channel].size = size; }
+static inline uint16_t DL_DMA_getTransferSize(DMA_Regs *dma, uint8_t channel) { return dma->ch[channel].size; }
+static inline bool DL_DMA_isChannelEnabled(DMA_Regs *dma, uint8_t channel) { return dma->ch[channel].enabled; }
+static inline void DL_DMA_disableChannel(DMA_Regs *dma, uint8_t channel) { dma->ch[channel].enabled = false; }
+static inline void DL_DMA_enableChannel(DMA_Regs *dma, uint8_t channel) {
+    dma->ch[channel].enabled = true;
+    sim_dma_service(dma, channel);
+}
+
+// ====================  定时器 (PWM)  ====================
+
+typedef enum {
+    DL_TIMER_CC_0_INDEX = 0,
+    DL_TIMER_CC_1_INDEX = 1,
+    DL_TIMER_CC_2_INDEX = 2,
+    DL_TIMER_CC_3_INDEX = 3,
+} DL_TIMER_CC_INDEX;
+
+static inline void DL_Timer_setCaptureCompareValue(GPTIMER_Regs *gptimer, uint32_t value, DL_TIMER_CC_INDEX cc) {
+    gptimer->cc[cc & 3] = value;
+}
+static inline void DL_Timer_startCounter(GPTIMER_Regs *gptimer) { gptimer->running = true; }
+static inline void DL_Timer_stopCounter(GPTIMER_Regs *gptimer) { gptimer->running = false; }
+static inline void DL_Timer_setLoadValue(GPTIMER_Regs *gptimer, uint32_t value) { gptimer->load = value; }
+
+#define DL_TimerG_setCaptureCompareValue    DL_Timer_setCaptureCompareValue
+#define DL_TimerA_setCaptureCompareValue    DL_Timer_setCaptureCompareValue
+#define DL_TimerG_startCounter              DL_Timer_startCounter
+#define DL_TimerG_stopCounter               DL_Timer_stopCounter
+#define DL_TimerG_setLoadValue              DL_Timer_setLoadValue
+
+// ====================  SPI  ====================
+
+static inline bool DL_SPI_isBusy(SPI_Regs *spi) { (void)spi; return false; }
+static inline bool DL_SPI_isRXFIFOEmpty(SPI_Regs *spi) { (void)spi; return false; }
+static inline void DL_SPI_transmitData8(SPI_Regs *spi, uint8_t data) { spi->last_tx = data; spi->tx_count++; }
+static inline uint8_t DL_SPI_receiveData8(SPI_Regs *spi) { (void)spi; return 0xFF; }
+
+// ====================  ADC  ====================
+
+#define DL_ADC12_STATUS_CONVERSION_IDLE                                       0
+
+static inline void DL_ADC12_enableConversions(ADC12_Regs *adc) { adc->enabled = true; }
+static inline void DL_ADC12_disableConversions(ADC12_Regs *adc) { adc->enabled = false; }
+static inline void DL_ADC12_startConversion(ADC12_Regs *adc) { (void)adc; }
+static inline void DL_ADC12_stopConversion(ADC12_Regs *adc) { (void)adc; }
+static inline uint32_t DL_ADC12_getStatus(ADC12_Regs *adc) { (void)adc; return DL_ADC12_STATUS_CONVERSION_IDLE; }
+static inline uint16_t DL_ADC12_getMemResult(ADC12_Regs *adc, uint32_t idx) { (void)idx; return adc->result; }
+
+#endif /* ti_msp_dl_config_h */
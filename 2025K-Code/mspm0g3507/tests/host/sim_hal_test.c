@@ -0,0 +1,540 @@
+/**
+ * @file sim_hal_test.c
+ * @brief 仿真 HAL 与固件主机构建的冒烟测试
+ *
+ * 链接 firmware_host (Keil 工程里除 main.c 外的全部 custom_src + u8g2), 通过 sim_hal.h 注入外设激励:
+ *  1. 摄像头: lwpkt 帧经 UART 回环 -> UART_1 中断 -> lwrb -> camera_process -> cam_protocol 回调
+ *     (ASCII 兼容消息与二进制消息, 二进制消息的 CRC/版本/长度校验)
+ *  2. 编码器: PORTB 正交信号 -> GROUP1 中断 -> encoder.c 计数
+ *  3. 电机: motor_set_pwms -> TIMA0 比较值
+ *  4. 循迹: 感为灰度板的 I2C 寄存器模型 -> gray_get_position
+ *  5. 实时层: 控制定时器中断, 关中断期间挂起、开中断后补发
+ *  6. 上电: 按 main.c 的顺序初始化后跑 2s 主循环 (UI、调度器、小车状态机)
+ *  7. 动作程序: const 动作表的子程序调用、按选择函数分支、循环次数, 后台子程序的 FORK/JOIN 与超时,
+ *     动作的守护条件与恢复子程序、耗时统计
+ *  8. 串口 DMA 接收: 陀螺仪帧经 DMA 写入 lwrb, 每帧一次空闲中断, 环回续接, 缓冲区满时溢出计数与恢复
+ *  9. 异步发送: 线路堵住时写入立即返回、队列满丢弃计数, TX 中断接力发完, 关中断时 usart_flush 轮询发送
+ * 10. 蓝牙: lwpkt 帧经 UART_0 接收 -> EVENT_BLUETOOTH -> 调度器执行 bluetooth_process -> 收包回调
+ *
+ * 构建/运行 (在 mspm0g3507 目录下):
+ *   cmake -S . -B build && cmake --build build -j && ctest --test-dir build --output-on-failure
+ */
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "sim_hal.h"
+#include "common_include.h"
+#include "task25k_config.h"
+#include "host_check.h"
+
+// ====================  1. 摄像头串口  ====================
+
+static void test_camera(void) {
+    sim_hal_reset();
+    camera_init();
+    setup_cam_protocol();
+
+    // camera_send_string 把数据按 lwpkt 打包后从 UART_1 发出, 原样回灌到接收端
+    const char *frames[] = { "T:0x33", "N:42", "C:0x02", "O:1,60,-25;0,150,25;" };
+    for (size_t i = 0; i < sizeof(frames) / sizeof(frames[0]); i++) {
+        sim_uart_tx_clear(UART_1_INST);
+        CHECK(camera_send_string(frames[i]) == CAMERA_OK, "camera_send_string");
+        CHECK(UART_1_INST->tx_len > strlen(frames[i]), "lwpkt frame written to UART");
+        CHECK(sim_uart_rx(UART_1_INST, UART_1_INST->tx_log, UART_1_INST->tx_len) == UART_1_INST->tx_len,
+              "frame accepted by RX FIFO");
+        camera_process();
+    }
+#if UART_RX_DMA
+    const uart_rx_stats_t *rx = camera_get_rx_stats();
+    // 低于 DMA 门限的帧尾留在 FIFO 里, 使 RX 超时得以产生, 由空闲中断读出
+    CHECK(rx->idle_events == 4 && rx->cpu_bytes == 4u * (sim_uart_rx_trigger_level(UART_1_INST) - 1u),
+          "camera frames received by DMA, one interrupt each");
+#endif
+    CHECK(maix_cam.track_data == 0x33, "track callback");
+    CHECK(maix_cam.num == 42, "number callback");
+    CHECK(maix_cam.cmd == CAM_CMD_GO_RIGHT, "command callback");
+    CHECK(maix_cam.obstacle_count == 2 && maix_cam.obstacles[0].color == 1 && maix_cam.obstacles[0].y_cm == -25 &&
+          maix_cam.obstacles[1].x_cm == 150 && maix_cam.obstacles[1].y_cm == 25, "obstacle callback");
+
+    cam_protocol_data_t parsed;
+    CHECK(cam_protocol_parse((const uint8_t *)"O:1,60", 6, &parsed) == CAM_PARSE_INVALID_FORMAT, "truncated obstacle");
+
+    // 二进制消息: 同样经 lwpkt 回环, 回调参数直接指向接收缓冲区
+    uint8_t msg[CAM_BIN_OVERHEAD + sizeof(cam_msg_obstacles_t)];
+    cam_msg_track_t track = { 0x5A };
+    cam_msg_number_t number = { -1234 };
+    cam_msg_obstacles_t layout = { 2, 0, { { 90, -40, 0, 80 }, { 200, 30, 1, 95 } } };
+    cam_msg_cylinders_t cylinders = { 0x04, 0, { {1, 100}, {0, 67}, {1, 100}, {0, 100}, {1, 67}, {0, 100} } };
+    struct { cam_msg_type_t type; const void *body; uint8_t len; } bin[] = {
+        { CAM_MSG_TRACK, &track, sizeof(track) },
+        { CAM_MSG_NUMBER, &number, sizeof(number) },
+        { CAM_MSG_OBSTACLES, &layout, 2 + 2 * sizeof(cam_obstacle_t) },
+        { CAM_MSG_CYLINDERS, &cylinders, sizeof(cylinders) },
+    };
+    const cam_protocol_stats_t *stats = cam_protocol_get_stats();
+    maix_cam.num = 0;
+    for (size_t i = 0; i < sizeof(bin) / sizeof(bin[0]); i++) {
+        size_t n = cam_protocol_encode(bin[i].type, (uint8_t)i, bin[i].body, bin[i].len, msg, sizeof(msg));
+        sim_uart_tx_clear(UART_1_INST);
+        CHECK(n == (size_t)(CAM_BIN_OVERHEAD + bin[i].len) && camera_send_data(msg, n) == CAMERA_OK, "binary message sent");
+        sim_uart_rx(UART_1_INST, UART_1_INST->tx_log, UART_1_INST->tx_len);
+        camera_process();
+    }
+    CHECK(stats->frames == 4 && stats->crc_errors == 0 && stats->seq_gaps == 0, "binary frames counted");
+    CHECK(maix_cam.track_data == 0x5A, "binary track");
+    CHECK(maix_cam.num == (uint8_t)-1234, "binary number");
+    CHECK(maix_cam.obstacle_count == 2 && maix_cam.obstacles[0].x_cm == 90 && maix_cam.obstacles[0].y_cm == -40 &&
+          maix_cam.obstacles[1].color == 1 && maix_cam.obstacles[1].confidence == 95, "binary obstacle layout");
+    CHECK(maix_cam.cmd == 0x04 && maix_cam.cylinders[1].confidence == 67 && maix_cam.cylinders[4].color == 1,
+          "binary cylinder result");
+
+    // 校验: CRC-16/CCITT-FALSE 标准校验值 (与 MaixCam 端 binascii.crc_hqx(data, 0xFFFF) 一致), 改一个字节 CRC 不过, 版本不符, 长度与类型不符
+    CHECK(cam_protocol_crc16((const uint8_t *)"123456789", 9) == 0x29B1, "crc16 check value");
+    cam_parse_result_t result;
+    size_t n = cam_protocol_encode(CAM_MSG_COMMAND, 9, &(cam_msg_command_t){ 0x02 }, 1, msg, sizeof(msg));
+    CHECK(cam_protocol_check(msg, n, &result) != NULL && result == CAM_PARSE_OK, "valid command message");
+    msg[4] ^= 0x01;
+    CHECK(cam_protocol_process(msg, n) == CAM_PARSE_CRC_ERROR && stats->crc_errors == 1, "corrupted body rejected");
+    CHECK(maix_cam.cmd == 0x04, "rejected message has no effect");
+    msg[4] ^= 0x01;
+    msg[0] = 0xB2;
+    CHECK(cam_protocol_check(msg, n, &result) == NULL && result == CAM_PARSE_BAD_VERSION, "other version rejected");
+    n = cam_protocol_encode(CAM_MSG_COMMAND, 9, &number, sizeof(number), msg, sizeof(msg));
+    CHECK(cam_protocol_check(msg, n, &result) == NULL && result == CAM_PARSE_INVALID_FORMAT, "body length checked");
+    CHECK(cam_protocol_check(msg, n - 1, &result) == NULL && result == CAM_PARSE_INVALID_LENGTH, "frame length checked");
+}
+
+// ====================  2. 编码器  ====================
+
+extern encoder_manager_t robot_encoder_manager;
+
+// 正交信号: A 超前 B 90 度, 一个周期 4 个边沿
+static void encoder_cycles(uint32_t pin_a, uint32_t pin_b, int cycles, bool forward) {
+    static const uint8_t seq[4] = { 0x1, 0x3, 0x2, 0x0 };      // bit0 = A, bit1 = B
+    for (int c = 0; c < cycles; c++) {
+        for (int k = 0; k < 4; k++) {
+            uint8_t s = seq[forward ? k : (6 - k) % 4];        // 反向: 0x2 0x3 0x1 0x0
+            sim_gpio_set_input(PORTB_PORT, pin_a, s & 1);
+            sim_gpio_set_input(PORTB_PORT, pin_b, (s >> 1) & 1);
+        }
+    }
+}
+
+static void test_encoder(void) {
+    sim_hal_reset();
+    encoder_application_init();
+
+    encoder_cycles(PORTB_ENCODER_1_PIN, PORTB_ENCODER_2_PIN, 100, true);
+    int32_t fwd = encoder_manager_read_and_reset(&robot_encoder_manager, 0);
+    encoder_cycles(PORTB_ENCODER_1_PIN, PORTB_ENCODER_2_PIN, 100, false);
+    int32_t rev = encoder_manager_read_and_reset(&robot_encoder_manager, 0);
+
+    CHECK(fwd == 400 || fwd == -400, "4 counts per quadrature cycle");
+    CHECK(rev == -fwd, "reverse direction counts back");
+    CHECK(encoder_manager_read(&robot_encoder_manager, 1) == 0, "other wheel untouched");
+    CHECK(PORTB_PORT->int_pending == 0, "ISR clears pin interrupt flags");
+}
+
+// ====================  3. 电机 PWM  ====================
+
+static void test_motor(void) {
+    int pwms[4] = { 1200, -5000, 0, 0 };
+
+    sim_hal_reset();
+    motor_init();
+    CHECK(Motor_PWM1_INST->running, "PWM timer started");
+
+    motor_set_pwms(pwms);
+    CHECK(Motor_PWM1_INST->cc[DL_TIMER_CC_0_INDEX] == 1200, "left duty");
+    CHECK(Motor_PWM1_INST->cc[DL_TIMER_CC_1_INDEX] == 3000, "right duty clamped to max_pwm_value");
+
+    motor_stop();
+    CHECK(!Motor_PWM1_INST->running && Motor_PWM1_INST->cc[DL_TIMER_CC_0_INDEX] == 0, "motor_stop");
+}
+
+// ====================  4. 循迹 (I2C)  ====================
+
+static void test_gray(void) {
+    static sim_i2c_regmap_t gw_board;
+
+    sim_hal_reset();
+    gray_detection_init();
+
+    // 没有挂接设备: 读到 0xFF, 取反后为 0 (全白), 保持上一次的位置
+    gray_get_position();
+    CHECK(gray_byte == 0, "unattached device reads as no line");
+
+    sim_i2c_regmap_init(&gw_board, GW_GRAY_ADDR_DEF);
+    sim_i2c_attach(&gw_board.dev);
+
+    // 感为板输出低电平有效且位序相反: 原始 0xF7 -> gray_byte 0x10 (中心)
+    gw_board.regs[GW_GRAY_DIGITAL_MODE] = 0xF7;
+    CHECK(fabsf(gray_get_position()) < 1e-6f, "centre position");
+    CHECK(gray_byte == 0x10, "bit order");
+
+    gw_board.regs[GW_GRAY_DIGITAL_MODE] = 0x7F;         // -> 0x01, 最左端
+    CHECK(fabsf(gray_get_position() + 3.5f) < 1e-6f, "left-most position");
+}
+
+// ====================  5. 实时层定时器  ====================
+
+static volatile uint32_t realtime_runs;
+
+static void realtime_job(void) {
+    realtime_runs++;
+}
+
+static void test_realtime(void) {
+    sim_hal_reset();
+    realtime_runs = 0;
+    realtime_task_register(realtime_job, 1);
+    realtime_task_start();
+
+    sim_time_advance_us(10 * REALTIME_TICK_US);
+    CHECK(realtime_runs == 10, "one job run per tick");
+
+    // 关中断期间到期的节拍挂起, 开中断时只补发一次 (与 NVIC 挂起位一致)
+    __disable_irq();
+    sim_time_advance_us(3 * REALTIME_TICK_US);
+    CHECK(realtime_runs == 10, "masked while PRIMASK set");
+    __enable_irq();
+    CHECK(realtime_runs == 11, "pending tick delivered on unmask");
+
+    realtime_task_stop();
+    sim_time_advance_us(10 * REALTIME_TICK_US);
+    CHECK(realtime_runs == 11, "stopped timer does not fire");
+}
+
+// ====================  6. 上电与主循环  ====================
+
+static void test_boot(void) {
+    sim_hal_reset();
+    // 按键上拉, 松开为高电平
+    sim_gpio_set_input(PORTB_PORT, PORTB_KEY1_PIN | PORTB_KEY2_PIN | PORTB_KEY3_PIN | PORTB_KEY4_PIN, true);
+
+    // 与 main.c 中 system_init() + main_task_init() 的顺序一致
+    SYSCFG_DL_init();
+    hal_math_init();
+    beep_init();
+    systick_init();
+    car_init();
+    wit_imu_init();
+    wit_imu_set_yaw_zero();
+    camera_init();
+    setup_cam_protocol();
+    menu_init_and_create();
+    init_task_table();
+    car_init();
+    gray_detection_init();
+    create_periodic_event_task();
+
+    CHECK(sim_time_us() >= 3200000, "wit_imu_set_yaw_zero delays advance the virtual clock");
+    CHECK(UART_0_INST->tx_len > 0, "IMU commands sent");
+    CHECK(SPI_0_INST->tx_count >= 1024, "first menu frame sent to OLED over SPI");
+
+    // 主循环跑 2s, 中途短按一次 KEY1, 菜单应重绘
+    uint32_t spi_before = SPI_0_INST->tx_count;
+    uint64_t start_us = sim_time_us();
+    while (sim_time_us() - start_us < 2000000) {
+        uint64_t t = sim_time_us() - start_us;
+        sim_gpio_set_input(PORTB_PORT, PORTB_KEY1_PIN, !(t >= 500000 && t < 600000));
+        periodic_event_task_process();
+        low_power_idle();
+    }
+    CHECK(SPI_0_INST->tx_count > spi_before, "key press redraws the menu");
+}
+
+// ====================  7. 动作程序  ====================
+
+static char trace[32];
+static uint8_t trace_len;
+static uint8_t branch;
+
+static void mark_a(void) { trace[trace_len++] = 'a'; }
+static void mark_b(void) { trace[trace_len++] = 'b'; }
+static void mark_c(void) { trace[trace_len++] = 'c'; }
+static uint8_t select_branch(void) { return branch; }
+
+static const car_action_t sub_b_actions[] = { CAR_ACT_FUNCTION(mark_b) };
+static const car_program_t sub_b = CAR_PROGRAM(sub_b_actions);
+static const car_action_t sub_c_actions[] = { CAR_ACT_FUNCTION(mark_c), CAR_ACT_CALL(&sub_b) };
+static const car_program_t sub_c = CAR_PROGRAM(sub_c_actions);
+static const car_program_t *const branches[] = { &sub_b, &sub_c };
+static const car_action_t main_actions[] = {
+    CAR_ACT_FUNCTION(mark_a),
+    CAR_ACT_SWITCH(select_branch, branches),
+    CAR_ACT_CALL(&sub_c),
+    CAR_ACT_FUNCTION(mark_a),
+};
+static const car_program_t main_program = CAR_PROGRAM(main_actions);
+
+// 前台在等 fg_gate (代表一段运动) 时, 后台子程序独立推进
+static bool fg_gate, bg_gate;
+static bool wait_fg_gate(void) { return fg_gate; }
+static bool wait_bg_gate(void) { return bg_gate; }
+
+static const car_action_t bg_actions[] = {
+    CAR_ACT_FUNCTION(mark_b),
+    CAR_ACT_STRAIGHT(50),           // 后台不动车, 直接跳过
+    CAR_ACT_WAIT_TRUE(wait_bg_gate),
+    CAR_ACT_FUNCTION(mark_c),
+};
+static const car_program_t bg_program = CAR_PROGRAM(bg_actions);
+static const car_action_t fork_actions[] = {
+    CAR_ACT_FORK(&bg_program),
+    CAR_ACT_FUNCTION(mark_a),
+    CAR_ACT_WAIT_TRUE(wait_fg_gate),
+    CAR_ACT_JOIN(100),
+    CAR_ACT_FUNCTION(mark_a),
+};
+static const car_program_t fork_program = CAR_PROGRAM(fork_actions);
+
+// 守护条件 (bg_gate) 不成立时中止等待, 走恢复子程序 sub_b
+static const car_action_opts_t guarded_opts = { 0, wait_bg_gate, &sub_b };
+static const car_action_t guarded_actions[] = {
+    CAR_ACT_EX(&guarded_opts, ACTION_WAIT_FUNC_TRUE, .wait_func_true = { wait_fg_gate }),
+    CAR_ACT_FUNCTION(mark_a),
+};
+static const car_program_t guarded_program = CAR_PROGRAM(guarded_actions);
+
+static void start_fork_program(void) {
+    fg_gate = bg_gate = false;
+    trace_len = 0;
+    car_load_program(&fork_program, 1);
+    car_start();
+}
+
+static const char *run_program(uint8_t selected, uint8_t loops) {
+    branch = selected;
+    trace_len = 0;
+    car_load_program(&main_program, loops);
+    car_start();
+    for (int i = 0; i < 100 && car_is_running(); i++) {
+        car_state_machine();
+    }
+    trace[trace_len] = '\0';
+    return trace;
+}
+
+static void test_program(void) {
+    CHECK(strcmp(run_program(0, 1), "abcba") == 0, "switch case 0, nested call returns to the caller");
+    CHECK(strcmp(run_program(1, 1), "acbcba") == 0, "switch case 1");
+    CHECK(strcmp(run_program(7, 1), "acba") == 0, "switch index out of range skips");
+    CHECK(strcmp(run_program(0, 2), "abcbaabcba") == 0, "top-level program loops");
+    CHECK(!car_is_running(), "program finishes");
+
+    // car_add_*() 的 RAM 表照常可用
+    car_path_init();
+    car_add_function(mark_c);
+    car_set_loop(1);
+    trace_len = 0;
+    car_start();
+    car_state_machine();
+    car_state_machine();
+    CHECK(trace_len == 1 && trace[0] == 'c' && !car_is_running(), "runtime action list");
+
+    // 超出 MAX_ACTIONS 的动作被拒绝, 截断的动作表不启动
+    car_path_init();
+    bool accepted = true;
+    for (int i = 0; i < MAX_ACTIONS; i++) {
+        accepted = accepted && car_add_function(mark_c);
+    }
+    CHECK(accepted && !car_add_function(mark_a), "action past MAX_ACTIONS rejected");
+    car_start();
+    CHECK(!car_is_running(), "overflowed action list does not start");
+    car_path_init();
+    CHECK(car_add_function(mark_c), "car_path_init clears the overflow");
+
+    // FORK/JOIN: 即时动作同一拍执行完, 前后台各自等待, JOIN 等后台结束
+    start_fork_program();
+    car_state_machine();
+    CHECK(trace_len == 2 && memcmp(trace, "ab", 2) == 0, "fork starts in the same tick as the foreground");
+    CHECK(car.state == CAR_STATE_STOP && car_background_busy(), "background skips motion and waits");
+    fg_gate = true;
+    car_state_machine();
+    CHECK(trace_len == 2 && car_is_running(), "join waits for the background");
+    bg_gate = true;
+    car_state_machine();
+    car_state_machine();
+    CHECK(trace_len == 4 && memcmp(trace, "abca", 4) == 0 && !car_is_running(), "join passes after the background ends");
+
+    // JOIN 超时: 取消后台, 前台继续
+    start_fork_program();
+    fg_gate = true;
+    car_state_machine();
+    car_state_machine();
+    sim_time_advance_us(150000);
+    car_state_machine();
+    CHECK(trace_len == 3 && memcmp(trace, "aba", 3) == 0 && !car_background_busy(), "join timeout cancels the background");
+    CHECK(!car_is_running(), "program finishes after a join timeout");
+
+    // 守护条件: 成立时照常等待, 不成立时中止并执行恢复子程序, 再接着执行下一个动作
+    fg_gate = false;
+    bg_gate = true;
+    trace_len = 0;
+    car_load_program(&guarded_program, 1);
+    car_start();
+    car_state_machine();
+    CHECK(trace_len == 0 && car_is_running(), "guarded action waits while the guard holds");
+    bg_gate = false;
+    car_state_machine();
+    CHECK(trace_len == 2 && memcmp(trace, "ba", 2) == 0 && !car_is_running(), "guard failure runs the recovery");
+#if CAR_ACTION_STATS
+    uint8_t count;
+    const car_action_stat_t *stats = car_action_stats(&count);
+    CHECK(count == 1 && stats[0].result == CAR_ACTION_GUARD && stats[0].index == 0 &&
+          stats[0].program == &guarded_program, "aborted action recorded, instant actions not");
+#endif
+}
+
+// ====================  8. 串口 DMA 接收  ====================
+
+// WIT 欧拉角帧: 55 53, roll/pitch/yaw/温度 (小端, 32768 对应 180°), 校验和
+static void wit_frame(uint8_t frame[11], float yaw_deg) {
+    uint16_t raw = (uint16_t)(int16_t)(yaw_deg / 180.0f * 32768.0f);
+    memset(frame, 0, 11);
+    frame[0] = 0x55;
+    frame[1] = 0x53;
+    frame[6] = (uint8_t)raw;
+    frame[7] = (uint8_t)(raw >> 8);
+    for (int i = 0; i < 10; i++) {
+        frame[10] += frame[i];
+    }
+}
+
+static void test_uart_rx(void) {
+    sim_hal_reset();
+    wit_imu_init();
+    const uart_rx_stats_t *stats = wit_imu_get_rx_stats();
+    uint8_t frame[11];
+
+    // 40 帧共 440 字节, 超过 256 字节的接收缓冲区: 环回处 DMA 整段传完后接着布置下一段
+    for (int i = 0; i < 40; i++) {
+        wit_frame(frame, (float)i);
+        sim_uart_rx(UART_0_INST, frame, sizeof(frame));
+        wit_imu_process();
+    }
+    CHECK(fabsf(jy61p.yaw - 39.0f) < 0.01f, "gyro frames parsed");
+#if UART_RX_DMA
+    CHECK(stats->idle_events == 40 && stats->dma_blocks >= 1 && stats->overflows == 0 &&
+          stats->cpu_bytes == 40u * (sim_uart_rx_trigger_level(UART_0_INST) - 1u),
+          "one interrupt per frame, no per-byte interrupts");
+
+    // 主循环来不及读: 25 帧 275 字节, 缓冲区存满 255 字节后 DMA 停下, 其余在空闲中断里计为溢出
+    uint8_t burst[25 * 11];
+    for (int i = 0; i < 25; i++) {
+        wit_frame(&burst[i * 11], 100.0f);
+    }
+    sim_uart_rx(UART_0_INST, burst, sizeof(burst));
+    CHECK(stats->overflows == sizeof(burst) - 255, "bytes beyond the full buffer counted as overflow");
+    CHECK(fabsf(jy61p.yaw - 39.0f) < 0.01f, "nothing parsed before the main loop runs");
+
+    // 读走数据后自动重新布置 DMA, 解析器跳过残帧后恢复
+    wit_imu_process();
+    CHECK(fabsf(jy61p.yaw - 100.0f) < 0.01f, "frames held in the buffer parsed");
+    for (int i = 0; i < 2; i++) {
+        wit_frame(frame, -45.0f);
+        sim_uart_rx(UART_0_INST, frame, sizeof(frame));
+    }
+    wit_imu_process();
+    CHECK(fabsf(jy61p.yaw + 45.0f) < 0.01f, "reception resumes after the overflow");
+#endif
+}
+
+// ====================  9. 异步发送  ====================
+
+static void test_uart_tx(void) {
+#if UART_TX_ASYNC
+    sim_hal_reset();
+    const usart_tx_stats_t *stats = usart_tx_get_stats(UART_0_INST);
+    usart_tx_stats_t before = *stats;
+    static uint8_t data[UART_0_TX_QUEUE_SIZE + 100];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 7);
+    }
+
+    // 线路堵住: 写入立即返回, 只收下队列放得下的部分 (lwrb 容量为大小减 1)
+    UART_0_INST->tx_stalled = true;
+    size_t n = usart_send_bytes(UART_0_INST, data, sizeof(data));
+    CHECK(n == UART_0_TX_QUEUE_SIZE - 1 && UART_0_INST->tx_len == 0, "writer returns without waiting for the line");
+    CHECK(stats->dropped - before.dropped == sizeof(data) - n && stats->full_events - before.full_events == 1 &&
+          stats->peak == n, "back-pressure counted");
+    CHECK(UART_0_INST->imask & DL_UART_MAIN_INTERRUPT_TX, "TX interrupt armed while bytes are queued");
+
+    // 发送缓冲空出来: TX 中断接力发完后关掉 TX 中断
+    UART_0_INST->tx_stalled = false;
+    sim_uart_tx_event(UART_0_INST);
+    CHECK(UART_0_INST->tx_len == n && memcmp(UART_0_INST->tx_log, data, n) == 0, "queue drained in order by the TX interrupt");
+    CHECK(!(UART_0_INST->imask & DL_UART_MAIN_INTERRUPT_TX), "TX interrupt off once the queue is empty");
+
+    // 关中断 (如异常处理中): usart_flush 轮询发送
+    sim_uart_tx_clear(UART_0_INST);
+    UART_0_INST->tx_stalled = true;
+    usart_send_bytes(UART_0_INST, data, 10);
+    __disable_irq();
+    UART_0_INST->tx_stalled = false;
+    CHECK(usart_flush(UART_0_INST, 0) && UART_0_INST->tx_len == 10, "flush polls with interrupts masked");
+    __enable_irq();
+    CHECK(stats->queued - before.queued == n + 10, "queued bytes counted");
+#endif
+}
+
+// ====================  10. 蓝牙  ====================
+
+static uint8_t bt_received[32];
+static size_t bt_received_len;
+
+void bluetooth_data_received(const uint8_t *data, size_t length) {
+    bt_received_len = (length < sizeof(bt_received)) ? length : sizeof(bt_received);
+    memcpy(bt_received, data, bt_received_len);
+}
+
+// 本构建 UART_0 接的是 WIT 陀螺仪 (TASK25K_UART0_BLUETOOTH 为 0), 这里按蓝牙配置的路由手动分发接收中断
+static void bt_uart_rx(const uint8_t *data, size_t len) {
+    __disable_irq();
+    sim_uart_rx(UART_0_INST, data, len);
+    DL_UART_IIDX idx;
+    while ((idx = DL_UART_getPendingInterrupt(UART_0_INST)) != DL_UART_IIDX_NO_INTERRUPT) {
+        if (idx != DL_UART_IIDX_TX) {
+            bluetooth_irq_handler(idx);
+        }
+    }
+    __enable_irq();
+}
+
+static void test_bluetooth(void) {
+    sim_hal_reset();
+    CHECK(bluetooth_init() == BLUETOOTH_OK, "bluetooth_init");
+    init_task_table();
+    create_periodic_event_task();
+
+    const char payload[] = "go 120";
+    sim_uart_tx_clear(UART_0_INST);
+    CHECK(bluetooth_send_data((const uint8_t *)payload, sizeof(payload)) == BLUETOOTH_OK, "bluetooth_send_data");
+    uint8_t frame[64];
+    size_t len = UART_0_INST->tx_len;
+    CHECK(len > sizeof(payload) && len <= sizeof(frame), "lwpkt frame written to UART_0");
+    memcpy(frame, UART_0_INST->tx_log, len);
+
+    bt_received_len = 0;
+    bt_uart_rx(frame, len);
+    CHECK(bt_received_len == 0, "nothing parsed inside the interrupt");
+    periodic_event_task_process();
+    CHECK(bt_received_len == sizeof(payload) && memcmp(bt_received, payload, sizeof(payload)) == 0,
+          "EVENT_BLUETOOTH runs bluetooth_process from the task table");
+}
+
+int main(void) {
+    test_camera();
+    test_encoder();
+    test_motor();
+    test_gray();
+    test_realtime();
+    test_boot();
+    test_program();
+    test_uart_rx();
+    test_uart_tx();
+    test_bluetooth();
+
+    return host_check_summary();
+}
@@ -0,0 +1,212 @@
+/**
+ * @file two_tier_sim.c
+ * @brief 实时中断层 + 协作式主循环的主机端时序仿真
+ *
+ * 用虚拟时钟驱动真实的 periodic_event_task.c 与 realtime_task.c:
+ *  - 软任务按估算耗时推进虚拟时间 (OLED 整屏刷新、阻塞串口打印等)
+ *  - 虚拟时间跨过定时器节拍时立即进入 realtime_task_isr(), 模拟硬件抢占
+ * 分别统计 "速度环放在 car_task 里" 与 "速度环放在定时器中断里" 两种方案下
+ * 速度环启动时刻相对理想 20ms 网格的偏差, 中断方案超过界限时返回非 0.
+ *
+ * 构建 (在 mspm0g3507 目录下):
+ *   gcc -O2 -Itests/host/sim_hal -Icustom_src/core/system -Icustom_src/utils \
+ *       -Icustom_src/hal/uart -Icustom_src/hal/timer tests/host/two_tier_sim.c \
+ *       custom_src/core/system/periodic_event_task.c custom_src/core/system/realtime_task.c \
+ *       custom_src/core/system/event_queue.c -o two_tier_sim
+ */
+#include <stdio.h>
+#include <stdbool.h>
+#include "periodic_event_task.h"
+#include "realtime_task.h"
+#include "double_buffer.h"
+
+#define SIM_DURATION_US         (20ULL * 1000 * 1000)   // 仿真 20s
+#define CONTROL_PERIOD_MS       20
+#define IDLE_LOOP_US            5                       // 主循环空转一圈的耗时
+#define ISR_ENTRY_US            1                       // 中断进入开销
+#define RT_BOUND_US             (ISR_ENTRY_US + 5)      // 实时层允许的最大启动偏差
+
+// 估算的任务耗时 (us)
+#define COST_BUTTON_US          30
+#define COST_MENU_US            9000    // draw_menu 整屏 SPI 传输
+#define COST_DEBUG_PRINT_US     5200    // 60 字节 log_i @115200 阻塞发送
+#define COST_ALERT_US           10
+#define COST_MUSIC_US           10
+#define COST_IMU_US             300
+#define COST_CAMERA_US          40
+#define COST_OUTER_LOOP_US      120     // car_task 外环 (直行/转向 PID)
+#define COST_SPEED_LOOP_US      60      // 编码器采样 + 速度 PID + PWM
+
+// ====================  虚拟时钟与硬件替身  ====================
+
+static uint64_t sim_us;
+static uint64_t next_tick_us;
+static bool timer_running;
+static bool in_isr;
+
+uint32_t get_ms(void) { return (uint32_t)(sim_us / 1000); }
+uint32_t get_us(void) { return (uint32_t)sim_us; }
+
+void hal_control_timer_init(uint32_t period_us) { (void)period_us; }
+void hal_control_timer_start(void) { timer_running = true; next_tick_us = sim_us + REALTIME_TICK_US; }
+void hal_control_timer_stop(void) { timer_running = false; }
+bool hal_control_timer_ack_irq(void) { return true; }
+
+/**
+ * @brief 推进虚拟时间, 途中跨过定时器节拍时进入中断
+ */
+static void consume(uint32_t us) {
+    uint64_t end = sim_us + us;
+    while (timer_running && !in_isr && next_tick_us <= end) {
+        sim_us = next_tick_us;
+        next_tick_us += REALTIME_TICK_US;
+
+        in_isr = true;
+        uint64_t resume = sim_us;
+        sim_us += ISR_ENTRY_US;
+        realtime_task_isr();
+        // 中断占用的时间顺延主循环
+        end += sim_us - resume;
+        in_isr = false;
+    }
+    sim_us = end;
+}
+
+// ====================  速度环启动时刻统计  ====================
+
+typedef struct {
+    uint64_t first_us;
+    uint32_t samples;
+    uint32_t max_late_us;       // 相对理想网格的最大延迟
+    uint32_t max_interval_us;
+    uint32_t min_interval_us;
+    uint64_t last_us;
+} timing_stats_t;
+
+static void timing_record(timing_stats_t *st, uint64_t t) {
+    if (st->samples == 0) {
+        st->first_us = t;
+        st->min_interval_us = UINT32_MAX;
+    } else {
+        uint32_t interval = (uint32_t)(t - st->last_us);
+        if (interval > st->max_interval_us) st->max_interval_us = interval;
+        if (interval < st->min_interval_us) st->min_interval_us = interval;
+        uint64_t ideal = st->first_us + (uint64_t)st->samples * CONTROL_PERIOD_MS * 1000;
+        uint32_t late = (t > ideal) ? (uint32_t)(t - ideal) : 0;
+        if (late > st->max_late_us) st->max_late_us = late;
+    }
+    st->last_us = t;
+    st->samples++;
+}
+
+// ====================  被调度的任务  ====================
+
+typedef struct {
+    float target_speed[2];
+    uint32_t seq;
+} sim_command_t;
+
+static sim_command_t command_slots[2];
+static double_buffer_t command_buffer;
+static bool speed_loop_in_isr;
+static timing_stats_t speed_loop_timing;
+static uint32_t torn_reads;
+static uint32_t command_seq;
+
+static void speed_loop(void) {
+    sim_command_t cmd;
+    double_buffer_read(&command_buffer, &cmd);
+    // 两个目标速度总是按同一序号写入, 不一致说明读到半更新的数据
+    if (cmd.target_speed[0] != (float)cmd.seq || cmd.target_speed[1] != -(float)cmd.seq) {
+        torn_reads++;
+    }
+    timing_record(&speed_loop_timing, sim_us);
+    consume(COST_SPEED_LOOP_US);
+}
+
+static void car_task(void) {
+    sim_command_t cmd;
+    consume(COST_OUTER_LOOP_US);
+    command_seq++;
+    cmd.seq = command_seq;
+    cmd.target_speed[0] = (float)command_seq;
+    cmd.target_speed[1] = -(float)command_seq;
+    double_buffer_write(&command_buffer, &cmd);
+    if (!speed_loop_in_isr) {
+        speed_loop();
+    }
+}
+
+static void button_task(void) { consume(COST_BUTTON_US); }
+static void menu_task(void)   { consume(COST_MENU_US); }
+static void debug_task(void)  { consume(COST_DEBUG_PRINT_US); }
+static void alert_task(void)  { consume(COST_ALERT_US); }
+static void music_task(void)  { consume(COST_MUSIC_US); }
+static void imu_task(void)    { consume(COST_IMU_US); }
+static void camera_task(void) { consume(COST_CAMERA_US); }
+
+// 与 task25k_mission_table.c 中的 task_table[] 保持一致 (调试打印打开)
+static period_task_t task_table[] = {
+   PERIOD_TASK(EVENT_KEY_STATE_UPDATE,  RUN,  button_task,  20,  CATCHUP_RUN_ALL),
+   PERIOD_TASK(EVENT_MENU_VAR_UPDATE,   RUN,  menu_task,    20,  CATCHUP_SKIP),
+   PERIOD_TASK(EVENT_PERIOD_PRINT,      RUN,  debug_task,   500, CATCHUP_SKIP),
+   PERIOD_TASK(EVENT_ALERT,             RUN,  alert_task,   10,  CATCHUP_RUN_ALL),
+   PERIOD_TASK(EVENT_CAR,               RUN,  car_task,     20,  CATCHUP_RUN_ONCE),
+   PERIOD_TASK(EVENT_MUSIC_PLAYER,      RUN,  music_task,   5,   CATCHUP_RUN_ALL),
+   PERIOD_TASK(EVENT_IMU_UPDATE,        RUN,  imu_task,     10,  CATCHUP_RUN_ONCE),
+   PERIOD_TASK(EVENT_MAIXCAM,           RUN,  camera_task,  1,   CATCHUP_RUN_ONCE),
+};
+
+static timing_stats_t run_sim(bool isr_mode) {
+    sim_us = 0;
+    timer_running = false;
+    in_isr = false;
+    torn_reads = 0;
+    command_seq = 0;
+    speed_loop_in_isr = isr_mode;
+    speed_loop_timing = (timing_stats_t){0};
+    double_buffer_init(&command_buffer, &command_slots[0], &command_slots[1], sizeof(sim_command_t));
+
+    init_task_scheduler(task_table, sizeof(task_table) / sizeof(task_table[0]));
+    create_periodic_event_task();
+    if (isr_mode) {
+        realtime_task_register(speed_loop, REALTIME_DIVIDER_MS(CONTROL_PERIOD_MS));
+        realtime_task_start();
+    }
+
+    while (sim_us < SIM_DURATION_US) {
+        uint64_t before = sim_us;
+        periodic_event_task_process();
+        if (sim_us == before) {
+            consume(IDLE_LOOP_US);
+        }
+    }
+
+    realtime_task_stop();
+    return speed_loop_timing;
+}
+
+static void print_row(const char *name, const timing_stats_t *st) {
+    printf("%-22s %8u %12u %12u %12u\n", name, st->samples,
+           st->min_interval_us, st->max_interval_us, st->max_late_us);
+}
+
+int main(void) {
+    timing_stats_t coop = run_sim(false);
+    timing_stats_t rt = run_sim(true);
+    const realtime_stats_t *rt_stats = realtime_task_get_stats();
+
+    printf("speed loop timing over %llu s (ideal period %d ms)\n",
+           (unsigned long long)(SIM_DURATION_US / 1000000), CONTROL_PERIOD_MS);
+    printf("%-22s %8s %12s %12s %12s\n", "scheme", "runs", "min int(us)", "max int(us)", "max late(us)");
+    print_row("cooperative car_task", &coop);
+    print_row("timer ISR tier", &rt);
+    printf("ISR max duration %u us, torn command reads %u\n", rt_stats->max_isr_us, torn_reads);
+
+    if (rt.max_late_us > RT_BOUND_US || torn_reads != 0) {
+        printf("FAIL: ISR tier exceeded %d us bound\n", RT_BOUND_US);
+        return 1;
+    }
+    printf("PASS: ISR tier start deviation <= %d us under UI load\n", RT_BOUND_US);
+    return 0;
+}
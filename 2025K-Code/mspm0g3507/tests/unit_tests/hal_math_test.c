@@ -0,0 +1,46 @@
+#include "tests.h"
+#include "common_include.h"
+#include "log_config.h"
+#include "log.h"
+#include "hal_math.h"
+#include <math.h>
+
+#define MATH_BENCH_ROUNDS 500
+
+/**
+ * @brief libm 软浮点与 hal_math (MATHACL) 的单次调用周期数及最大误差对比
+ * @note 在 test_task() 中调用, 需先执行 hal_math_init(); 结果每秒从调试串口输出一次
+ */
+void hal_math_test(void) {
+    volatile float sink = 0.0f;
+    float max_err = 0.0f;
+
+    // 精度: 扫描单位圆上的 atan2 与 [0, 4) 上的 sqrt
+    for (int i = 0; i < 360; i++) {
+        float a = (float)i * HAL_MATH_DEG2RAD - HAL_MATH_PI;
+        float s = sinf(a), c = cosf(a);
+        float err = fabsf(hal_atan2f(s * 3.0f, c * 3.0f) - atan2f(s, c));
+        if (err > max_err && err < HAL_MATH_PI) max_err = err;
+        err = fabsf(hal_sqrtf((float)i / 90.0f) - sqrtf((float)i / 90.0f));
+        if (err > max_err) max_err = err;
+    }
+
+    while (1) {
+        uint64_t start = get_cycles();
+        for (int i = 0; i < MATH_BENCH_ROUNDS; i++) {
+            sink = atan2f((float)(i - 250), 123.0f) + sqrtf((float)i) + asinf((float)i * 0.001f);
+        }
+        uint32_t libm_cycles = (uint32_t)(get_cycles() - start) / MATH_BENCH_ROUNDS;
+
+        start = get_cycles();
+        for (int i = 0; i < MATH_BENCH_ROUNDS; i++) {
+            sink = hal_atan2f((float)(i - 250), 123.0f) + hal_sqrtf((float)i) + hal_asinf((float)i * 0.001f);
+        }
+        uint32_t hal_cycles = (uint32_t)(get_cycles() - start) / MATH_BENCH_ROUNDS;
+
+        usart_printf(UART_0_INST, "atan2+sqrt+asin cycles: libm %lu, hal %lu (mathacl %s, max err %.2e) %.3f\r\n",
+                     (unsigned long)libm_cycles, (unsigned long)hal_cycles,
+                     hal_math_is_accelerated() ? "on" : "off", max_err, sink);
+        delay_ms(1000);
+    }
+}
@@ -0,0 +1,44 @@
+#include "tests.h"
+#include "common_include.h"
+#include "log_config.h"
+#include "log.h"
+#include "pid.h"
+#include "pid_q16.h"
+
+#define PID_BENCH_ROUNDS 1000
+
+/**
+ * @brief 浮点 PID 与 Q16 定点 PID 的单次计算周期数对比
+ * @note 使用速度环参数; 在 test_task() 中调用, 结果每秒从调试串口输出一次
+ */
+void pid_q16_test(void) {
+    PID_Controller_t fpid;
+    PIDQ_Controller_t qpid;
+    volatile float fout = 0.0f;
+    volatile q16_t qout = 0;
+
+    PID_Init(&fpid, PID_TYPE_POSITION);
+    PID_SetParams(&fpid, 55.0f, 5.0f, 3.0f);
+    PID_SetOutputLimit(&fpid, 3000.0f, -3000.0f);
+    PID_SetIntegralLimit(&fpid, 3000.0f, -3000.0f);
+    PIDQ_InitFromFloat(&qpid, &fpid);
+
+    while (1) {
+        uint64_t start = get_cycles();
+        for (int i = 0; i < PID_BENCH_ROUNDS; i++) {
+            fout = PID_Calculate(40.0f, (float)(i & 63), &fpid);
+        }
+        uint32_t float_cycles = (uint32_t)(get_cycles() - start) / PID_BENCH_ROUNDS;
+
+        start = get_cycles();
+        for (int i = 0; i < PID_BENCH_ROUNDS; i++) {
+            qout = PIDQ_Calculate(Q16(40.0), q16_from_int(i & 63), &qpid);
+        }
+        uint32_t q16_cycles = (uint32_t)(get_cycles() - start) / PID_BENCH_ROUNDS;
+
+        usart_printf(UART_0_INST, "PID cycles/call: float %lu, q16 %lu (out %.2f / %.2f)\r\n",
+                     (unsigned long)float_cycles, (unsigned long)q16_cycles,
+                     fout, q16_to_float(qout));
+        delay_ms(1000);
+    }
+}
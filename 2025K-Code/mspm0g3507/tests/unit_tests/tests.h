@@ -19,4 +19,8 @@ void no_mcu_ganv_test(void);
 int cam_test(void);
 // lsm6dsv16x 测试
 void lsm6dsv16x_test(void);
+// 浮点/定点 PID 周期数对比
+void pid_q16_test(void);
+// libm / MATHACL 数学运算周期数对比
+void hal_math_test(void);
 #endif